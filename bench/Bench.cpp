@@ -0,0 +1,490 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// opt-in microbenchmarks (cmake -DBUILD_BENCH=ON), the old and the new paths on the same fonts
+// usage : ImGuiFontStudio_Bench [font files], the fonts of samples_Fonts by default
+// each path is run few times and the best time is kept, like Compress::MeasureCodec
+
+#include <Generator/Compress.h>
+#include <Generator/MemoryStream.h>
+#include <ImguiImpl/freetype/imgui_freetype.h>
+
+#include <ctools/cTools.h>
+#include <imgui/imgui.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+static double MeasureBestTimeInMs(const std::function<void()>& vFunc, int vCountRuns = 20)
+{
+	double best = 0.0;
+	for (int i = 0; i < vCountRuns; i++)
+	{
+		auto start = std::chrono::steady_clock::now();
+		vFunc();
+		double t = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		best = (i == 0) ? t : ct::mini(best, t);
+	}
+	return best;
+}
+
+static void PrintResult(const char* vLabel, double vOldTimeInMs, double vNewTimeInMs, bool vSameOutput)
+{
+	printf("  %-28s old %9.3f ms  new %9.3f ms  x%6.2f  %s\n",
+		vLabel, vOldTimeInMs, vNewTimeInMs,
+		(vNewTimeInMs > 0.0) ? vOldTimeInMs / vNewTimeInMs : 0.0,
+		vSameOutput ? "same output" : "OUTPUT DIFFERS");
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+//// BASE85 ///////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+static char OldEncode85Byte(unsigned int x)
+{
+	x = (x % 85) + 35;
+	return (char)((x >= (uint32_t)'\\') ? x + 1 : x);
+}
+
+// the encode loop of Compress::GetCompressedBase85BytesArray before the lookup tables
+// (only the read of the group is done by memcpy, for not read unaligned)
+static std::string OldEncodeBase85(const std::string& vLang, const char* vDatas, int vDatasSize, bool vGenerateByteArray)
+{
+	std::string content;
+
+	char prev_c = 0;
+	for (int src_i = 0; src_i < vDatasSize; src_i += 4)
+	{
+		unsigned int d = 0;
+		memcpy(&d, vDatas + src_i, sizeof(d));
+		for (unsigned int n5 = 0; n5 < 5; n5++, d /= 85)
+		{
+			char c = OldEncode85Byte(d);
+			if (vGenerateByteArray)
+			{
+				char buf[20];
+				int len = snprintf(buf, 19, "%02x", c);
+				if (len)
+				{
+					content += "0x" + std::string(buf, len) + ", ";
+				}
+			}
+			else
+			{
+				content += (c == '?' && prev_c == '?') ? "\\" + ct::toStr(c) : ct::toStr(c);
+			}
+
+			prev_c = c;
+		}
+		if ((src_i % 112) == 112 - 4)
+		{
+			if (vGenerateByteArray)
+			{
+				content += "\n";
+				if (vLang == "c#")
+				{
+					content += "\t\t\t";
+				}
+			}
+			else
+			{
+				if (vLang == "c#")
+				{
+					content += "\" +\n\t\t\t\"";
+				}
+				else if (
+					vLang == "cpp" ||
+					vLang == "c")
+				{
+					content += "\"\n    \"";
+				}
+			}
+		}
+	}
+
+	return content;
+}
+
+static void BenchBase85(const std::vector<uint8_t>& vFontDatas)
+{
+	std::vector<uint8_t> compressed;
+	if (!Compress::GetCompressedDatas(COMPRESS_CODEC_STB, vFontDatas.data(), vFontDatas.size(), &compressed))
+	{
+		printf("  base85 : stb_compress failed\n");
+		return;
+	}
+	const int compressedSize = (int)compressed.size();
+	compressed.resize(compressed.size() + 4U, 0U); // the encoders read the last group entirely
+
+	printf("  base85 of %i stb compressed bytes\n", compressedSize);
+
+	const char* langs[] = { "c", "cpp", "c#" };
+	for (const char* lang : langs)
+	{
+		for (int mode = 0; mode < 2; mode++)
+		{
+			const bool generateByteArray = (mode == 1);
+			std::string oldContent, newContent;
+			double oldTime = MeasureBestTimeInMs([&]() {
+				oldContent = OldEncodeBase85(lang, (const char*)compressed.data(), compressedSize, generateByteArray); });
+			double newTime = MeasureBestTimeInMs([&]() {
+				newContent = Compress::EncodeBase85(lang, (const char*)compressed.data(), compressedSize, generateByteArray); });
+			std::string label = ct::toStr("%s %s", lang, generateByteArray ? "byte array" : "string");
+			PrintResult(label.c_str(), oldTime, newTime, oldContent == newContent);
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+//// GLYF WRITE ///////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+// a simple glyph, like FontGenerator::ReScale_Glyph have it before the write
+struct BenchGlyph
+{
+	int16_t bbox[4] = { 0, 0, 0, 0 };
+	std::vector<int16_t> endPts;
+	std::vector<uint8_t> onCurve;
+	std::vector<int16_t> dx; // relative points
+	std::vector<int16_t> dy;
+};
+
+// the simple glyphs of the font, read from loca / glyf
+// the composite glyphs are not re written by ReScale_Glyph, so they are skipped
+static std::vector<BenchGlyph> ReadSimpleGlyphs(const std::vector<uint8_t>& vFontDatas)
+{
+	std::vector<BenchGlyph> res;
+
+	MemoryStream mem;
+	mem.SetView(vFontDatas.data(), vFontDatas.size());
+
+	uint32_t headOffset = 0, maxpOffset = 0, locaOffset = 0, glyfOffset = 0, glyfLength = 0;
+	mem.SetPos(4);
+	const int32_t numTables = mem.ReadUShort();
+	for (int32_t i = 0; i < numTables; i++)
+	{
+		mem.SetPos(12U + (size_t)i * 16U);
+		const std::string tag = mem.ReadString(4);
+		mem.ReadULongAsInt(); // checksum
+		const uint32_t offset = mem.ReadULongAsInt();
+		const uint32_t length = mem.ReadULongAsInt();
+		if (tag == "head") headOffset = offset;
+		else if (tag == "maxp") maxpOffset = offset;
+		else if (tag == "loca") locaOffset = offset;
+		else if (tag == "glyf") { glyfOffset = offset; glyfLength = length; }
+	}
+	if (!headOffset || !maxpOffset || !locaOffset || !glyfOffset)
+		return res;
+
+	mem.SetPos(headOffset + 50U);
+	const bool longOffsets = (mem.ReadShort() == 1);
+	mem.SetPos(maxpOffset + 4U);
+	const int32_t numGlyphs = mem.ReadUShort();
+
+	std::vector<uint32_t> offsets((size_t)numGlyphs + 1U);
+	mem.SetPos(locaOffset);
+	for (auto& offset : offsets)
+		offset = longOffsets ? mem.ReadULongAsInt() : (uint32_t)mem.ReadUShort() * 2U;
+
+	for (int32_t g = 0; g < numGlyphs; g++)
+	{
+		if (offsets[g + 1] <= offsets[g] || offsets[g + 1] > glyfLength)
+			continue;
+
+		mem.SetPos(glyfOffset + offsets[g]);
+		const int32_t countContours = mem.ReadShort();
+		if (countContours <= 0)
+			continue;
+
+		BenchGlyph glyph;
+		for (auto& v : glyph.bbox)
+			v = (int16_t)mem.ReadShort();
+		for (int32_t c = 0; c < countContours; c++)
+			glyph.endPts.push_back((int16_t)mem.ReadUShort());
+		const size_t countPoints = (size_t)(uint16_t)glyph.endPts.back() + 1U;
+		mem.SetPos(mem.GetPos() + (size_t)mem.ReadUShort()); // instructions
+
+		std::vector<uint8_t> flags;
+		while (flags.size() < countPoints)
+		{
+			uint8_t flag = mem.ReadByte();
+			flags.push_back(flag);
+			if (flag & 8) // repeat
+			{
+				uint8_t count = mem.ReadByte();
+				while (count-- && flags.size() < countPoints)
+					flags.push_back(flag);
+			}
+		}
+
+		glyph.dx.resize(countPoints);
+		glyph.dy.resize(countPoints);
+		for (int axis = 0; axis < 2; axis++)
+		{
+			const uint8_t shortBit = axis ? 4 : 2;
+			const uint8_t sameBit = axis ? 32 : 16;
+			std::vector<int16_t>& deltas = axis ? glyph.dy : glyph.dx;
+			for (size_t p = 0; p < countPoints; p++)
+			{
+				if (flags[p] & shortBit)
+					deltas[p] = (int16_t)((flags[p] & sameBit) ? mem.ReadByte() : -mem.ReadByte());
+				else
+					deltas[p] = (int16_t)((flags[p] & sameBit) ? 0 : mem.ReadShort());
+			}
+		}
+
+		glyph.onCurve.resize(countPoints);
+		for (size_t p = 0; p < countPoints; p++)
+			glyph.onCurve[p] = flags[p] & 1;
+
+		res.push_back(glyph);
+	}
+
+	return res;
+}
+
+// the write of ReScale_Glyph before the arrays : 4 streams written byte by byte
+// (WriteShort was 2 WriteByte), then copied one after the other in the glyph datas
+static void OldWriteGlyph(const BenchGlyph& vGlyph, std::vector<uint8_t>* vOut)
+{
+	MemoryStream headerStream;
+	MemoryStream flagStream;
+	MemoryStream xCoordStream;
+	MemoryStream yCoordStream;
+
+	for (size_t p = 0; p < vGlyph.onCurve.size(); p++)
+	{
+		uint8_t flag = 0;
+		if (vGlyph.onCurve[p])
+			flag = flag | (1 << 0);
+		flagStream.WriteByte(flag);
+
+		xCoordStream.WriteByte((uint8_t)((vGlyph.dx[p] >> 8) & 0xff));
+		xCoordStream.WriteByte((uint8_t)(vGlyph.dx[p] & 0xff));
+		yCoordStream.WriteByte((uint8_t)((vGlyph.dy[p] >> 8) & 0xff));
+		yCoordStream.WriteByte((uint8_t)(vGlyph.dy[p] & 0xff));
+	}
+
+	std::vector<int16_t> header;
+	header.push_back((int16_t)vGlyph.endPts.size());
+	header.insert(header.end(), vGlyph.bbox, vGlyph.bbox + 4);
+	header.insert(header.end(), vGlyph.endPts.begin(), vGlyph.endPts.end());
+	header.push_back(0);
+	for (auto v : header)
+	{
+		headerStream.WriteByte((uint8_t)((v >> 8) & 0xff));
+		headerStream.WriteByte((uint8_t)(v & 0xff));
+	}
+
+	vOut->resize(headerStream.Size() + flagStream.Size() + xCoordStream.Size() + yCoordStream.Size());
+	size_t offset = 0;
+	memcpy(vOut->data() + offset, headerStream.Get(), headerStream.Size()); offset += headerStream.Size();
+	memcpy(vOut->data() + offset, flagStream.Get(), flagStream.Size()); offset += flagStream.Size();
+	memcpy(vOut->data() + offset, xCoordStream.Get(), xCoordStream.Size()); offset += xCoordStream.Size();
+	memcpy(vOut->data() + offset, yCoordStream.Get(), yCoordStream.Size());
+}
+
+// the write of ReScale_Glyph now : arrays, then one reserved stream by WriteArray
+static void NewWriteGlyph(const BenchGlyph& vGlyph, std::vector<uint8_t>* vOut)
+{
+	const size_t countPoints = vGlyph.onCurve.size();
+
+	std::vector<int16_t> header;
+	std::vector<uint8_t> flags;
+	std::vector<int16_t> xCoords;
+	std::vector<int16_t> yCoords;
+	header.reserve(6U + vGlyph.endPts.size());
+	flags.reserve(countPoints);
+	xCoords.reserve(countPoints);
+	yCoords.reserve(countPoints);
+
+	for (size_t p = 0; p < countPoints; p++)
+	{
+		uint8_t flag = 0;
+		if (vGlyph.onCurve[p])
+			flag = flag | (1 << 0);
+		flags.push_back(flag);
+		xCoords.push_back(vGlyph.dx[p]);
+		yCoords.push_back(vGlyph.dy[p]);
+	}
+
+	header.push_back((int16_t)vGlyph.endPts.size());
+	header.insert(header.end(), vGlyph.bbox, vGlyph.bbox + 4);
+	header.insert(header.end(), vGlyph.endPts.begin(), vGlyph.endPts.end());
+	header.push_back(0);
+
+	MemoryStream glyfStream;
+	glyfStream.Reserve(header.size() * 2U + flags.size() + xCoords.size() * 2U + yCoords.size() * 2U);
+	glyfStream.WriteArray(header);
+	glyfStream.WriteArray(flags);
+	glyfStream.WriteArray(xCoords);
+	glyfStream.WriteArray(yCoords);
+
+	vOut->assign(glyfStream.Get(), glyfStream.Get() + glyfStream.Size());
+}
+
+static void BenchGlyfWrite(const std::vector<uint8_t>& vFontDatas)
+{
+	auto glyphs = ReadSimpleGlyphs(vFontDatas);
+	size_t countPoints = 0U;
+	for (const auto& glyph : glyphs)
+		countPoints += glyph.onCurve.size();
+
+	printf("  glyf write of %u simple glyphs, %u points\n", (uint32_t)glyphs.size(), (uint32_t)countPoints);
+	if (glyphs.empty())
+		return;
+
+	std::vector<std::vector<uint8_t>> oldDatas(glyphs.size()), newDatas(glyphs.size());
+	double oldTime = MeasureBestTimeInMs([&]() {
+		for (size_t i = 0; i < glyphs.size(); i++)
+			OldWriteGlyph(glyphs[i], &oldDatas[i]); });
+	double newTime = MeasureBestTimeInMs([&]() {
+		for (size_t i = 0; i < glyphs.size(); i++)
+			NewWriteGlyph(glyphs[i], &newDatas[i]); });
+	PrintResult("all glyphs", oldTime, newTime, oldDatas == newDatas);
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+//// FREETYPE /////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+// the atlas is built like FontInfos do it, the pixels are returned for compare the atlas
+static bool BuildFreeTypeAtlas(const std::vector<uint8_t>& vFontDatas, float vFontSize, std::vector<uint8_t>* vPixels)
+{
+	static const ImWchar ranges[] = { 0x0020, 0xFFFF, 0 };
+
+	ImFontAtlas atlas;
+	ImFontConfig cfg;
+	cfg.FontDataOwnedByAtlas = false;
+	if (!atlas.AddFontFromMemoryTTF((void*)vFontDatas.data(), (int)vFontDatas.size(), vFontSize, &cfg, ranges))
+		return false;
+
+	ImGuiFreeType::FT_Error freetypeError = 0;
+	if (!ImGuiFreeType::BuildFontAtlas(&atlas, ImGuiFreeType::FreeType_Default, &freetypeError))
+		return false;
+
+	const size_t countPixels = (size_t)atlas.TexWidth * (size_t)atlas.TexHeight;
+	if (atlas.TexPixelsRGBA32)
+		vPixels->assign((const uint8_t*)atlas.TexPixelsRGBA32, (const uint8_t*)atlas.TexPixelsRGBA32 + countPixels * 4U);
+	else if (atlas.TexPixelsAlpha8)
+		vPixels->assign(atlas.TexPixelsAlpha8, atlas.TexPixelsAlpha8 + countPixels);
+
+	return true;
+}
+
+// build the atlas on vCountLoaders threads at once, like FontLoader, each with vRasterizerThreadsCount
+static bool BuildFreeTypeAtlasOnLoaders(const std::vector<uint8_t>& vFontDatas, float vFontSize,
+	size_t vCountLoaders, unsigned int vRasterizerThreadsCount, std::vector<std::vector<uint8_t>>* vPixels)
+{
+	vPixels->resize(vCountLoaders);
+	std::vector<int> results(vCountLoaders, 0);
+	std::vector<std::thread> loaders;
+	for (size_t i = 0; i < vCountLoaders; i++)
+	{
+		loaders.emplace_back([&, i]()
+		{
+			ImGuiFreeType::SetRasterizerThreadsCount(vRasterizerThreadsCount); // per thread
+			results[i] = BuildFreeTypeAtlas(vFontDatas, vFontSize, &(*vPixels)[i]) ? 1 : 0;
+		});
+	}
+	for (auto& loader : loaders)
+		loader.join();
+
+	for (auto r : results)
+		if (!r)
+			return false;
+	return true;
+}
+
+static void BenchFreeType(const std::vector<uint8_t>& vFontDatas)
+{
+	const float fontSize = 32.0f;
+	const unsigned int countCores = ct::maxi(std::thread::hardware_concurrency(), 1U);
+	printf("  freetype atlas, size %.0f, %u cores\n", fontSize, countCores);
+
+	// one atlas : the serial rasterizer vs the rasterizer threads
+	std::vector<uint8_t> serialPixels, threadedPixels;
+	bool ok = true;
+	ImGuiFreeType::SetRasterizerThreadsCount(1);
+	double oldTime = MeasureBestTimeInMs([&]() {
+		ok &= BuildFreeTypeAtlas(vFontDatas, fontSize, &serialPixels); }, 5);
+	ImGuiFreeType::SetRasterizerThreadsCount(0);
+	double newTime = MeasureBestTimeInMs([&]() {
+		ok &= BuildFreeTypeAtlas(vFontDatas, fontSize, &threadedPixels); }, 5);
+	if (!ok)
+	{
+		printf("  freetype : the atlas build failed\n");
+		return;
+	}
+	PrintResult("1 atlas, serial vs threads", oldTime, newTime, serialPixels == threadedPixels);
+
+	// one atlas per loading thread : the rasterizer threads in each one (cores * cores threads) vs 1 per loader
+	std::vector<std::vector<uint8_t>> nestedPixels, loaderPixels;
+	oldTime = MeasureBestTimeInMs([&]() {
+		ok &= BuildFreeTypeAtlasOnLoaders(vFontDatas, fontSize, countCores, 0U, &nestedPixels); }, 5);
+	newTime = MeasureBestTimeInMs([&]() {
+		ok &= BuildFreeTypeAtlasOnLoaders(vFontDatas, fontSize, countCores, 1U, &loaderPixels); }, 5);
+	bool same = ok;
+	for (const auto& pixels : nestedPixels)
+		same &= (pixels == serialPixels);
+	for (const auto& pixels : loaderPixels)
+		same &= (pixels == serialPixels);
+	std::string label = ct::toStr("%u loaders, nested vs 1", countCores);
+	PrintResult(label.c_str(), oldTime, newTime, same);
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+//// MAIN /////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char** argv)
+{
+	std::vector<std::string> fontFiles;
+	for (int i = 1; i < argc; i++)
+		fontFiles.push_back(argv[i]);
+	if (fontFiles.empty())
+	{
+		fontFiles.push_back(std::string(PROJECT_PATH) + "/samples_Fonts/fontawesome-webfont.ttf");
+		fontFiles.push_back(std::string(PROJECT_PATH) + "/samples_Fonts/forkawesome-webfont.ttf");
+	}
+
+	int res = 0;
+	for (const auto& file : fontFiles)
+	{
+		std::vector<uint8_t> fontDatas;
+		if (!Compress::ReadFileDatas(file, &fontDatas))
+		{
+			printf("can't read %s\n", file.c_str());
+			res = 1;
+			continue;
+		}
+
+		printf("%s (%u bytes)\n", file.c_str(), (uint32_t)fontDatas.size());
+		BenchBase85(fontDatas);
+		BenchGlyfWrite(fontDatas);
+		BenchFreeType(fontDatas);
+	}
+
+	return res;
+}
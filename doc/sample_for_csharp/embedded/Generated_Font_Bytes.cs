@@ -5,7 +5,7 @@ namespace IconFonts
 {
 	public static class IGFS_Bytes
 	{ 
-		public static readonly string compressed_data_base85 = 
+		public static readonly string IGFS_compressed_data_base85 = 
 			"7])#######;6h2U'/###W),##*Mc##f/5##EI[^I132k#H4)=-XNE/1-2JuB>jJ-k.>uu#=rEn/)`[FHEbX-$ofG<-u*.m/xe@UCHMR8%XfG<-(7T;-QF%U.4tw<6rhG<-M).m/Q-0%J" +
 			"^SV+mB1*N2dXkr-*PV=B0/'mr<->>#47T;-G;u8Ms6:[-M`Xk4S#sk#VmRv$#Kb$0M>>uu%=Ds%uW<nL2AK;-e_@U.qk[%#XOVX-n(U0GqbjV73cNh#x0[0#p:[0#(P/.$F5E/LmEn-$" +
 			"x4+gLBcP8.^8[W$atF_/PoQl+9kZ;%#r#Z$CFt-$6BO2(#s,v?CQ8:)*`'dM?xSfL:aMA.n@0>$7OC^#g>;mLMhrr$)0d_/i)HREJ/###SXiiL=d[^RJBN+MuqJfLI0gfLL@$##4Dc>#" +
@@ -8,6 +8,7 @@
 
 #include <ctools/FileHelper.h>
 #include <MainFrame.h>
+#include <Helper/CommandLine.h>
 #include <Res/CustomFont.cpp>
 #include <Res/Roboto_Medium.cpp>
 #include <ImguiImpl/freetype/imgui_freetype.h>
@@ -41,9 +42,26 @@ static void glfw_window_close_callback(GLFWwindow* window)
 	MainFrame::Instance()->IWantToCloseTheApp();
 }
 
-int main(int, char**argv)
+int main(int argc, char**argv)
 {
 	FileHelper::Instance()->SetAppPath(std::string(argv[0]));
+
+	if (!CommandLine::Instance()->Parse(argc, argv))
+		return 1;
+
+	// headless generation : no window, no opengl context, no atlas build
+	// the current directory is kept, for resolve the relative paths of the command line
+	if (CommandLine::Instance()->IsHeadless())
+	{
+		IMGUI_CHECKVERSION();
+		ImGui::CreateContext();
+		// the card generation use the font datas of the imgui atlas for the labels (not built here)
+		ImGui::GetIO().Fonts->AddFontFromMemoryCompressedBase85TTF(FONT_ICON_BUFFER_NAME_RM, 15.0f);
+		int res = CommandLine::Instance()->RunHeadlessGeneration();
+		ImGui::DestroyContext();
+		return res;
+	}
+
 #ifdef _DEBUG
     FileHelper::Instance()->SetCurDirectory(PROJECT_PATH);
 #else
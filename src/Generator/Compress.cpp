@@ -20,6 +20,10 @@
 #include "Compress.h"
 
 #include <ctools/cTools.h>
+#include <Generator/LZ4Codec.h>
+
+#include <cstring>
+#include <chrono>
 
 #pragma warning( disable : 4244 )
 
@@ -28,6 +32,8 @@
 typedef unsigned int stb_uint;
 typedef unsigned char stb_uchar;
 stb_uint stb_compress(stb_uchar *out, stb_uchar *in, stb_uint len);
+static stb_uint stb_decompress_length(const stb_uchar *input);
+static stb_uint stb_decompress(stb_uchar *output, const stb_uchar *input, stb_uint length);
 
 static char Encode85Byte(unsigned int x)
 {
@@ -35,6 +41,101 @@ static char Encode85Byte(unsigned int x)
 	return (char)((x >= (uint32_t)'\\') ? x + 1 : x);
 }
 
+// lookup tables, for not format each byte with snprintf
+struct Base85Tables
+{
+	char alphabet[85]; // base85 digit => char
+	char hexa[256][2]; // char => 2 hexa digits
+
+	Base85Tables()
+	{
+		for (unsigned int i = 0; i < 85; i++)
+			alphabet[i] = Encode85Byte(i);
+		const char* digits = "0123456789abcdef";
+		for (unsigned int i = 0; i < 256; i++)
+		{
+			hexa[i][0] = digits[i >> 4];
+			hexa[i][1] = digits[i & 15];
+		}
+	}
+};
+static const Base85Tables s_Base85Tables;
+
+// encode the compressed datas in one preallocated buffer
+// the line break is inserted each 28 groups of 5 chars (112 bytes of datas)
+// byte array mode : 6 chars per digit "0x00, " (exact size)
+// string mode : 1 char per digit, 2 if escaped (the buffer is sized for the worst case, then shrinked)
+std::string Compress::EncodeBase85(const std::string& vLang, const char* vDatas, int vDatasSize, bool vGenerateByteArray)
+{
+	std::string content;
+
+	if (!vDatas || vDatasSize <= 0)
+		return content;
+
+	std::string lineBreak;
+	if (vGenerateByteArray)
+	{
+		lineBreak = "\n";
+		if (vLang == "c#")
+			lineBreak += "\t\t\t";
+	}
+	else if (vLang == "c#")
+	{
+		lineBreak = "\" +\n\t\t\t\"";
+	}
+	else if (
+		vLang == "cpp" ||
+		vLang == "c")
+	{
+		lineBreak = "\"\n    \"";
+	}
+
+	const size_t countGroups = ((size_t)vDatasSize + 3U) / 4U;
+	const size_t countLineBreaks = countGroups / 28U;
+	const size_t maxDigitSize = vGenerateByteArray ? 6U : 2U;
+	content.resize(countGroups * 5U * maxDigitSize + countLineBreaks * lineBreak.size());
+
+	char* out = &content[0];
+	char prev_c = 0;
+	for (size_t group = 0; group < countGroups; group++)
+	{
+		// the datas are padded with zeros, so the last group can be read entirely
+		unsigned int d = 0;
+		memcpy(&d, vDatas + group * 4U, sizeof(d));
+
+		for (unsigned int n5 = 0; n5 < 5; n5++, d /= 85)
+		{
+			char c = s_Base85Tables.alphabet[d % 85];
+			if (vGenerateByteArray)
+			{
+				const char* hexa = s_Base85Tables.hexa[(uint8_t)c];
+				*out++ = '0'; *out++ = 'x';
+				*out++ = hexa[0]; *out++ = hexa[1];
+				*out++ = ','; *out++ = ' ';
+			}
+			else
+			{
+				// This is made a little more complicated by the fact that ??X sequences are interpreted as trigraphs by old C/C++ compilers. So we need to escape pairs of ??.
+				if (c == '?' && prev_c == '?')
+					*out++ = '\\';
+				*out++ = c;
+			}
+
+			prev_c = c;
+		}
+
+		if ((group % 28U) == 27U && !lineBreak.empty())
+		{
+			memcpy(out, lineBreak.data(), lineBreak.size());
+			out += lineBreak.size();
+		}
+	}
+
+	content.resize((size_t)(out - content.data()));
+
+	return content;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////
 //// UTILS ////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////
@@ -48,8 +149,6 @@ std::string Compress::GetCompressedBase85BytesArray(
 	std::string *vBufferName, 
 	size_t *vBufferSize)
 {
-	UNUSED(vPrefix);
-
 	std::string res;
 
 	// Read file
@@ -69,10 +168,35 @@ std::string Compress::GetCompressedBase85BytesArray(
 	memset((void*)(((char*)data) + data_sz), 0, 4);
 	fclose(f);
 
+	res = GetCompressedBase85BytesArray(vLang, (const uint8_t*)data, (size_t)data_sz, vPrefix, vBufferName, vBufferSize);
+
+	// Cleanup
+	SAFE_DELETE_ARRAY(data);
+
+	return res;
+}
+
+// same as the file version, but from font datas already in memory (no temporary file)
+std::string Compress::GetCompressedBase85BytesArray(
+	const std::string& vLang,
+	const uint8_t* vDatas,
+	const size_t& vDatasSize,
+	const std::string& vPrefix,
+	std::string* vBufferName,
+	size_t* vBufferSize)
+{
+	std::string res;
+
+	if (!vDatas || !vDatasSize)
+		return res;
+
+	int data_sz = (int)vDatasSize;
+
 	// Compress
+	// stb_compress only read the input datas, so the const_cast is safe
 	int maxlen = data_sz + 512 + (data_sz >> 2) + sizeof(int); // total guess
 	char* compressed = new char[maxlen];
-	int compressed_sz = stb_compress((stb_uchar*)compressed, (stb_uchar*)data, data_sz);
+	int compressed_sz = stb_compress((stb_uchar*)compressed, const_cast<stb_uchar*>(vDatas), data_sz);
 	memset(compressed + compressed_sz, 0, maxlen - compressed_sz);
 
 	// Output as Base85 encoded
@@ -83,7 +207,7 @@ std::string Compress::GetCompressedBase85BytesArray(
 	std::string bufferName;
 	if (vLang == "c#")
 	{
-		bufferName = "compressed_data_base85";
+		bufferName = vPrefix + "_compressed_data_base85";
 		if (generateByteArray)
 		{
 			res += ct::toStr("\t\tpublic static readonly IReadOnlyList<byte> %s = new byte[] {", bufferName.c_str());
@@ -100,7 +224,7 @@ std::string Compress::GetCompressedBase85BytesArray(
 		vLang == "cpp" || 
 		vLang == "c")
 	{
-		bufferName = "compressed_data_base85";
+		bufferName = vPrefix + "_compressed_data_base85";
 		res += "static const char " + bufferName + "[" + ct::toStr(bufferSize) + "+1] =";
 		if (generateByteArray)
 		{
@@ -114,69 +238,24 @@ std::string Compress::GetCompressedBase85BytesArray(
 
 	if (vBufferName) *vBufferName = bufferName;
 
-	std::string content;
+	std::string content = EncodeBase85(vLang, compressed, compressed_sz, generateByteArray);
+
+	res.reserve(res.size() + content.size() + 16U);
 
-	char prev_c = 0;
-	for (int src_i = 0; src_i < compressed_sz; src_i += 4)
-	{
-		// This is made a little more complicated by the fact that ??X sequences are interpreted as trigraphs by old C/C++ compilers. So we need to escape pairs of ??.
-		unsigned int d = *(unsigned int*)(compressed + src_i);
-		for (unsigned int n5 = 0; n5 < 5; n5++, d /= 85)
-		{
-			char c = Encode85Byte(d);
-			if (generateByteArray)
-			{
-				char buf[20];
-				int len = snprintf(buf, 19, "%02x", c);
-				if (len)
-				{
-					content += "0x" + std::string(buf, len) + ", ";
-				}
-			}
-			else
-			{
-				content += (c == '?' && prev_c == '?') ? "\\" + ct::toStr(c) : ct::toStr(c);
-			}
-			
-			prev_c = c;
-		}
-		if ((src_i % 112) == 112 - 4)
-		{
-			if (generateByteArray)
-			{
-				content += "\n";
-				if (vLang == "c#")
-				{
-					content += "\t\t\t";
-				}
-			}
-			else
-			{
-				if (vLang == "c#")
-				{
-					content += "\" +\n\t\t\t\"";
-				}
-				else if (
-					vLang == "cpp" || 
-					vLang == "c")
-				{
-					content += "\"\n    \"";
-				}
-			}
-		}
-	}
-	
 	if (generateByteArray)
 	{
-		content = content.substr(0, content.size() - 2);
+		if (content.size() >= 2U)
+			content.resize(content.size() - 2U);
 		if (vLang == "cpp" || 
 			vLang == "c")
 		{
-			res += content + "};\n";
+			res += content;
+			res += "};\n";
 		}
 		else if (vLang == "c#")
 		{
-			res += content + "\n\t\t};\n";
+			res += content;
+			res += "\n\t\t};\n";
 		}
 	}
 	else
@@ -184,21 +263,349 @@ std::string Compress::GetCompressedBase85BytesArray(
 		if (vLang == "cpp" || 
 			vLang == "c")
 		{
-			res += content + "\";\n\n";
+			res += content;
+			res += "\";\n\n";
 		}
 		else if (vLang == "c#")
 		{
-			res += content + "\";\n";
+			res += content;
+			res += "\";\n";
 		}
 	}
 
 	// Cleanup
-	SAFE_DELETE_ARRAY(data);
 	SAFE_DELETE_ARRAY(compressed);
 
 	return res;
 }
 
+const char* Compress::GetCodecName(CompressCodecEnum vCodec)
+{
+	switch (vCodec)
+	{
+	case COMPRESS_CODEC_NONE: return "None";
+	case COMPRESS_CODEC_STB: return "Stb + Base85";
+	case COMPRESS_CODEC_LZ4: return "LZ4";
+	default: break;
+	}
+	return "";
+}
+
+bool Compress::ReadFileDatas(const std::string& vFilePathName, std::vector<uint8_t>* vDatas)
+{
+	if (!vDatas)
+		return false;
+
+#ifdef MSVC
+	FILE *f = 0;
+	errno_t err = fopen_s(&f, vFilePathName.c_str(), "rb");
+	if (err) return false;
+#else
+	FILE* f = fopen(vFilePathName.c_str(), "rb");
+	if (!f) return false;
+#endif
+
+	long data_sz;
+	if (fseek(f, 0, SEEK_END) || (data_sz = ftell(f)) <= 0 || fseek(f, 0, SEEK_SET)) { fclose(f); return false; }
+	vDatas->resize((size_t)data_sz);
+	bool res = (fread(vDatas->data(), 1, (size_t)data_sz, f) == (size_t)data_sz);
+	fclose(f);
+
+	if (!res)
+		vDatas->clear();
+
+	return res;
+}
+
+std::string Compress::GetCompressedBytesArray(
+	CompressCodecEnum vCodec,
+	const std::string& vLang,
+	const uint8_t* vDatas,
+	const size_t& vDatasSize,
+	const std::string& vPrefix,
+	std::string* vBufferName,
+	size_t* vBufferSize,
+	size_t* vDecompressedSize)
+{
+	std::string res;
+
+	if (!vDatas || !vDatasSize)
+		return res;
+
+	if (vDecompressedSize) *vDecompressedSize = vDatasSize;
+
+	if (vCodec == COMPRESS_CODEC_NONE)
+	{
+		std::string bufferName = vPrefix + "_raw_data";
+		res = GetRawBytesArray(vLang, vDatas, vDatasSize, bufferName, 16U);
+		if (vBufferName) *vBufferName = bufferName;
+		if (vBufferSize) *vBufferSize = vDatasSize;
+	}
+	else if (vCodec == COMPRESS_CODEC_LZ4)
+	{
+		res = GetLZ4BytesArray(vLang, vDatas, vDatasSize, vPrefix, vBufferName, vBufferSize, vDecompressedSize);
+	}
+	else // COMPRESS_CODEC_STB
+	{
+		// stb_compress can read 4 bytes after the end of the datas, so a padded copy
+		std::vector<uint8_t> datas(vDatasSize + 4U, 0U);
+		memcpy(datas.data(), vDatas, vDatasSize);
+		res = GetCompressedBase85BytesArray(vLang, datas.data(), vDatasSize, vPrefix, vBufferName, vBufferSize);
+	}
+
+	return res;
+}
+
+bool Compress::GetCompressedDatas(
+	CompressCodecEnum vCodec,
+	const uint8_t* vDatas,
+	const size_t& vDatasSize,
+	std::vector<uint8_t>* vCompressedDatas)
+{
+	if (!vDatas || !vDatasSize || !vCompressedDatas)
+		return false;
+
+	if (vCodec == COMPRESS_CODEC_NONE)
+	{
+		vCompressedDatas->assign(vDatas, vDatas + vDatasSize);
+		return true;
+	}
+	else if (vCodec == COMPRESS_CODEC_LZ4)
+	{
+		return LZ4Codec::Compress(vDatas, vDatasSize, vCompressedDatas);
+	}
+	
+	// COMPRESS_CODEC_STB, for ImGui AddFontFromMemoryCompressedTTF
+	std::vector<uint8_t> datas(vDatasSize + 4U, 0U);
+	memcpy(datas.data(), vDatas, vDatasSize);
+	int data_sz = (int)vDatasSize;
+	int maxlen = data_sz + 512 + (data_sz >> 2) + sizeof(int); // total guess
+	vCompressedDatas->resize((size_t)maxlen);
+	int compressed_sz = stb_compress(vCompressedDatas->data(), datas.data(), data_sz);
+	vCompressedDatas->resize((size_t)compressed_sz);
+
+	return (compressed_sz > 0);
+}
+
+// vAlignment : alignment of the array in c/cpp, 0 for the default
+std::string Compress::GetRawBytesArray(
+	const std::string& vLang,
+	const uint8_t* vDatas,
+	const size_t& vDatasSize,
+	const std::string& vBufferName,
+	const size_t& vAlignment)
+{
+	std::string res;
+
+	if (!vDatas || !vDatasSize)
+		return res;
+
+	std::string lineStart;
+	if (vLang == "c#")
+	{
+		lineStart = "\t\t\t";
+		res += ct::toStr("\t\tpublic static readonly IReadOnlyList<byte> %s = new byte[] {\n", vBufferName.c_str());
+	}
+	else if (
+		vLang == "cpp" ||
+		vLang == "c")
+	{
+		lineStart = "    ";
+		if (vAlignment)
+		{
+			// no alignas, for stay compatible with c99 and c++98
+			res += ct::toStr("// aligned on %u bytes\n", (uint32_t)vAlignment);
+			res += "#if defined(_MSC_VER)\n";
+			res += ct::toStr("__declspec(align(%u))\n", (uint32_t)vAlignment);
+			res += "#endif\n";
+			res += "static const unsigned char " + vBufferName + "[" + ct::toStr(vDatasSize) + "]\n";
+			res += "#if defined(__GNUC__) || defined(__clang__)\n";
+			res += ct::toStr("__attribute__((aligned(%u)))\n", (uint32_t)vAlignment);
+			res += "#endif\n";
+			res += "= {\n";
+		}
+		else
+		{
+			res += "static const unsigned char " + vBufferName + "[" + ct::toStr(vDatasSize) + "] = {\n";
+		}
+	}
+	else
+	{
+		return res;
+	}
+
+	// 16 bytes per line, "0x00, " per byte
+	const size_t countLines = (vDatasSize + 15U) / 16U;
+	const size_t offset = res.size();
+	res.resize(offset + vDatasSize * 6U + countLines * (lineStart.size() + 1U));
+
+	char* out = &res[offset];
+	for (size_t i = 0; i < vDatasSize; i++)
+	{
+		if ((i % 16U) == 0U)
+		{
+			memcpy(out, lineStart.data(), lineStart.size());
+			out += lineStart.size();
+		}
+
+		const char* hexa = s_Base85Tables.hexa[vDatas[i]];
+		*out++ = '0'; *out++ = 'x';
+		*out++ = hexa[0]; *out++ = hexa[1];
+		*out++ = ',';
+
+		if ((i % 16U) == 15U || i == vDatasSize - 1U)
+			*out++ = '\n';
+		else
+			*out++ = ' ';
+	}
+	res.resize((size_t)(out - res.data()));
+
+	if (vLang == "c#")
+		res += "\t\t};\n";
+	else
+		res += "};\n\n";
+
+	return res;
+}
+
+std::string Compress::GetLZ4BytesArray(
+	const std::string& vLang,
+	const uint8_t* vDatas,
+	const size_t& vDatasSize,
+	const std::string& vPrefix,
+	std::string* vBufferName,
+	size_t* vBufferSize,
+	size_t* vDecompressedSize)
+{
+	std::string res;
+
+	std::vector<uint8_t> compressed;
+	if (LZ4Codec::Compress(vDatas, vDatasSize, &compressed))
+	{
+		std::string bufferName = vPrefix + "_lz4_compressed_data";
+
+		res += GetRawBytesArray(vLang, compressed.data(), compressed.size(), bufferName, 0U);
+		if (!res.empty())
+		{
+			if (vLang == "c#")
+				res += "\n";
+			res += LZ4Codec::GetDecoderSource(vLang, LZ4Codec::GetDecoderName(vPrefix));
+		}
+
+		if (vBufferName) *vBufferName = bufferName;
+		if (vBufferSize) *vBufferSize = compressed.size();
+		if (vDecompressedSize) *vDecompressedSize = vDatasSize;
+	}
+
+	return res;
+}
+
+static double GetElapsedTimeInMs(const std::chrono::steady_clock::time_point& vStart)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - vStart).count();
+}
+
+static unsigned int Decode85Byte(char c)
+{
+	return (unsigned int)((c >= '\\') ? c - 36 : c - 35);
+}
+
+// imported from imgui_draw.cpp
+static void Decode85(const unsigned char* src, unsigned char* dst)
+{
+	while (*src)
+	{
+		unsigned int tmp = Decode85Byte(src[0]) + 85 * (Decode85Byte(src[1]) + 85 * (Decode85Byte(src[2]) + 85 * (Decode85Byte(src[3]) + 85 * Decode85Byte(src[4]))));
+		dst[0] = ((tmp >> 0) & 0xFF); dst[1] = ((tmp >> 8) & 0xFF); dst[2] = ((tmp >> 16) & 0xFF); dst[3] = ((tmp >> 24) & 0xFF);   // We can't assume little-endianness.
+		src += 5;
+		dst += 4;
+	}
+}
+
+// the decode is done the same way as the app will do it at startup
+// (ImGui::AddFontFromMemoryCompressedBase85TTF for stb, the generated decoder for lz4)
+// the best time of few runs is kept
+bool Compress::MeasureCodec(
+	CompressCodecEnum vCodec,
+	const uint8_t* vDatas,
+	const size_t& vDatasSize,
+	CompressCodecStats* vStats)
+{
+	if (!vDatas || !vDatasSize || !vStats)
+		return false;
+
+	*vStats = CompressCodecStats();
+	vStats->datasSize = vDatasSize;
+
+	const int countRuns = 5;
+	std::vector<uint8_t> decoded(vDatasSize);
+
+	if (vCodec == COMPRESS_CODEC_NONE)
+	{
+		// no decode and no copy, the static array is given to ImGui with FontDataOwnedByAtlas = false
+		vStats->compressedSize = vDatasSize;
+		vStats->valid = true;
+	}
+	else if (vCodec == COMPRESS_CODEC_STB)
+	{
+		auto start = std::chrono::steady_clock::now();
+		std::vector<uint8_t> datas(vDatasSize + 4U, 0U);
+		memcpy(datas.data(), vDatas, vDatasSize);
+		int data_sz = (int)vDatasSize;
+		int maxlen = data_sz + 512 + (data_sz >> 2) + sizeof(int); // total guess
+		std::vector<uint8_t> compressed((size_t)maxlen, 0U);
+		int compressed_sz = stb_compress(compressed.data(), datas.data(), data_sz);
+		// plain base85, no escape or line break, like the string the compiler will produce
+		const size_t countGroups = ((size_t)compressed_sz + 3U) / 4U;
+		std::vector<uint8_t> base85(countGroups * 5U + 1U, 0U);
+		for (size_t group = 0; group < countGroups; group++)
+		{
+			unsigned int d = 0;
+			memcpy(&d, compressed.data() + group * 4U, sizeof(d));
+			for (unsigned int n5 = 0; n5 < 5; n5++, d /= 85)
+				base85[group * 5U + n5] = (uint8_t)s_Base85Tables.alphabet[d % 85];
+		}
+		vStats->compressTimeInMs = GetElapsedTimeInMs(start);
+		vStats->compressedSize = countGroups * 5U;
+
+		std::vector<uint8_t> decoded85(countGroups * 4U);
+		for (int i = 0; i < countRuns; i++)
+		{
+			start = std::chrono::steady_clock::now();
+			Decode85(base85.data(), decoded85.data());
+			stb_uint len = stb_decompress_length(decoded85.data());
+			if (len != vDatasSize)
+				return false;
+			if (stb_decompress(decoded.data(), decoded85.data(), (stb_uint)decoded85.size()) != len)
+				return false;
+			double t = GetElapsedTimeInMs(start);
+			vStats->decodeTimeInMs = (i == 0) ? t : ct::mini(vStats->decodeTimeInMs, t);
+		}
+		vStats->valid = (memcmp(decoded.data(), vDatas, vDatasSize) == 0);
+	}
+	else if (vCodec == COMPRESS_CODEC_LZ4)
+	{
+		auto start = std::chrono::steady_clock::now();
+		std::vector<uint8_t> compressed;
+		if (!LZ4Codec::Compress(vDatas, vDatasSize, &compressed))
+			return false;
+		vStats->compressTimeInMs = GetElapsedTimeInMs(start);
+		vStats->compressedSize = compressed.size();
+
+		for (int i = 0; i < countRuns; i++)
+		{
+			start = std::chrono::steady_clock::now();
+			if (!LZ4Codec::Decompress(compressed.data(), compressed.size(), decoded.data(), decoded.size()))
+				return false;
+			double t = GetElapsedTimeInMs(start);
+			vStats->decodeTimeInMs = (i == 0) ? t : ct::mini(vStats->decodeTimeInMs, t);
+		}
+		vStats->valid = (memcmp(decoded.data(), vDatas, vDatasSize) == 0);
+	}
+
+	return vStats->valid;
+}
+
 // imported from https://github.com/ocornut/imgui/blob/master/misc/fonts/binary_to_compressed_c.cpp
 // stb_compress* from stb.h - definition
 //////////////////// compressor ///////////////////////
@@ -243,10 +650,11 @@ static unsigned int stb_matchlen(stb_uchar *m1, stb_uchar *m2, stb_uint maxlen)
 }
 
 // simple implementation that just takes the source data in a big block
+// the compressor state is thread_local, so many fonts can be compressed in same time (batch generation)
 
-static stb_uchar *stb__out;
-static FILE      *stb__outfile;
-static stb_uint   stb__outbytes;
+static thread_local stb_uchar *stb__out;
+static thread_local FILE      *stb__outfile;
+static thread_local stb_uint   stb__outbytes;
 
 static void stb__write(unsigned char v)
 {
@@ -299,7 +707,7 @@ static  stb_uint stb__hashsize = 32768;
 #define stb__hc2(q,h,c,d)   (((h) << 14) + ((h) >> 18) + (q[c] << 7) + q[d])
 #define stb__hc3(q,c,d,e)   ((q[c] << 14) + (q[d] << 7) + q[e])
 
-static unsigned int stb__running_adler;
+static thread_local unsigned int stb__running_adler;
 
 static int stb_compress_chunk(stb_uchar *history,
 	stb_uchar *start,
@@ -456,4 +864,86 @@ stb_uint stb_compress(stb_uchar *out, stb_uchar *input, stb_uint length)
 	stb_compress_inner(input, length);
 
 	return stb__out - out;
-}
\ No newline at end of file
+}
+
+// imported from https://github.com/ocornut/imgui/blob/master/imgui_draw.cpp
+// stb_decompress* from stb.h - definition
+// only used for measure the decoding time of the stb codec
+//////////////////// decompressor ///////////////////////
+
+static stb_uint stb_decompress_length(const stb_uchar *input)
+{
+	return (input[8] << 24) + (input[9] << 16) + (input[10] << 8) + input[11];
+}
+
+static thread_local stb_uchar *stb__barrier_out_e, *stb__barrier_out_b;
+static thread_local const stb_uchar *stb__barrier_in_b;
+static thread_local stb_uchar *stb__dout;
+
+static void stb__match(const stb_uchar *data, stb_uint length)
+{
+	// INVERSE of memmove... write each byte before copying the next...
+	if (stb__dout + length > stb__barrier_out_e) { stb__dout += length; return; }
+	if (data < stb__barrier_out_b) { stb__dout = stb__barrier_out_e + 1; return; }
+	while (length--) *stb__dout++ = *data++;
+}
+
+static void stb__lit(const stb_uchar *data, stb_uint length)
+{
+	if (stb__dout + length > stb__barrier_out_e) { stb__dout += length; return; }
+	if (data < stb__barrier_in_b) { stb__dout = stb__barrier_out_e + 1; return; }
+	memcpy(stb__dout, data, length);
+	stb__dout += length;
+}
+
+#define stb__in2(x)   ((i[x] << 8) + i[(x)+1])
+#define stb__in3(x)   ((i[x] << 16) + stb__in2((x)+1))
+#define stb__in4(x)   ((i[x] << 24) + stb__in3((x)+1))
+
+static const stb_uchar *stb_decompress_token(const stb_uchar *i)
+{
+	if (*i >= 0x20) { // use fewer if's for cases that expand small
+		if (*i >= 0x80)       stb__match(stb__dout - i[1] - 1, i[0] - 0x80 + 1), i += 2;
+		else if (*i >= 0x40)  stb__match(stb__dout - (stb__in2(0) - 0x4000 + 1), i[2] + 1), i += 3;
+		else /* *i >= 0x20 */ stb__lit(i + 1, i[0] - 0x20 + 1), i += 1 + (i[0] - 0x20 + 1);
+	}
+	else { // more ifs for cases that expand large, since overhead is amortized
+		if (*i >= 0x18)       stb__match(stb__dout - (stb__in3(0) - 0x180000 + 1), i[3] + 1), i += 4;
+		else if (*i >= 0x10)  stb__match(stb__dout - (stb__in3(0) - 0x100000 + 1), stb__in2(3) + 1), i += 5;
+		else if (*i >= 0x08)  stb__lit(i + 2, stb__in2(0) - 0x0800 + 1), i += 2 + (stb__in2(0) - 0x0800 + 1);
+		else if (*i == 0x07)  stb__lit(i + 3, stb__in2(1) + 1), i += 3 + (stb__in2(1) + 1);
+		else if (*i == 0x06)  stb__match(stb__dout - (stb__in3(1) + 1), i[4] + 1), i += 5;
+		else if (*i == 0x04)  stb__match(stb__dout - (stb__in3(1) + 1), stb__in2(4) + 1), i += 6;
+	}
+	return i;
+}
+
+static stb_uint stb_decompress(stb_uchar *output, const stb_uchar *i, stb_uint /*length*/)
+{
+	if (stb__in4(0) != 0x57bC0000) return 0;
+	if (stb__in4(4) != 0)          return 0; // error! stream is > 4GB
+	const stb_uint olen = stb_decompress_length(i);
+	stb__barrier_in_b = i;
+	stb__barrier_out_e = output + olen;
+	stb__barrier_out_b = output;
+	i += 16;
+
+	stb__dout = output;
+	for (;;) {
+		const stb_uchar *old_i = i;
+		i = stb_decompress_token(i);
+		if (i == old_i) {
+			if (*i == 0x05 && i[1] == 0xfa) {
+				if (stb__dout != output + olen) return 0;
+				if (stb_adler32(1, output, olen) != (stb_uint)stb__in4(2))
+					return 0;
+				return olen;
+			}
+			else {
+				return 0; /* NOTREACHED */
+			}
+		}
+		if (stb__dout > output + olen)
+			return 0;
+	}
+}
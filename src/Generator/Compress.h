@@ -17,15 +17,93 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include <cstdint>
 
+enum CompressCodecEnum
+{
+	COMPRESS_CODEC_NONE = 0,	// raw bytes array, aligned, for AddFontFromMemoryTTF without decode and copy
+	COMPRESS_CODEC_STB,			// stb_compress + base85 (ImGui AddFontFromMemoryCompressedBase85TTF)
+	COMPRESS_CODEC_LZ4,			// lz4 block bytes array, the decoder is generated with
+	COMPRESS_CODEC_Count
+};
+
+struct CompressCodecStats
+{
+	bool valid = false;
+	size_t datasSize = 0; // size of the font
+	size_t compressedSize = 0; // size of the embedded buffer
+	double compressTimeInMs = 0.0;
+	double decodeTimeInMs = 0.0;
+};
+
 class Compress
 {
 public:
+	static const char* GetCodecName(CompressCodecEnum vCodec);
+	static bool ReadFileDatas(const std::string& vFilePathName, std::vector<uint8_t>* vDatas);
+
+	// embedded source of the font datas, according to the codec
+	// vBufferSize is the size of the embedded buffer, vDecompressedSize the size of the font (for the codecs who need it)
+	static std::string GetCompressedBytesArray(
+		CompressCodecEnum vCodec,
+		const std::string& vLang,
+		const uint8_t* vDatas,
+		const size_t& vDatasSize,
+		const std::string& vPrefix,
+		std::string* vBufferName,
+		size_t* vBufferSize = 0,
+		size_t* vDecompressedSize = 0);
+
+	// the compressed datas in binary, for the linked datas (stb without base85)
+	static bool GetCompressedDatas(
+		CompressCodecEnum vCodec,
+		const uint8_t* vDatas,
+		const size_t& vDatasSize,
+		std::vector<uint8_t>* vCompressedDatas);
+
+	// compress then decode the datas, for compare the codecs
+	static bool MeasureCodec(
+		CompressCodecEnum vCodec,
+		const uint8_t* vDatas,
+		const size_t& vDatasSize,
+		CompressCodecStats* vStats);
+
 	static std::string GetCompressedBase85BytesArray(
 		const std::string& vLang,
 		const std::string& vFilePathName,
 		const std::string& vPrefix,
 		std::string* vBufferName,
 		size_t* vBufferSize = 0);
+	static std::string GetCompressedBase85BytesArray(
+		const std::string& vLang,
+		const uint8_t* vDatas,
+		const size_t& vDatasSize,
+		const std::string& vPrefix,
+		std::string* vBufferName,
+		size_t* vBufferSize = 0);
+
+	// base85 of datas already compressed, the datas must be padded with 4 zeros
+	// vGenerateByteArray : "0x00, " per digit, else a string with the trigraphs escaped
+	static std::string EncodeBase85(
+		const std::string& vLang,
+		const char* vDatas,
+		int vDatasSize,
+		bool vGenerateByteArray);
+
+private:
+	static std::string GetRawBytesArray(
+		const std::string& vLang,
+		const uint8_t* vDatas,
+		const size_t& vDatasSize,
+		const std::string& vBufferName,
+		const size_t& vAlignment);
+	static std::string GetLZ4BytesArray(
+		const std::string& vLang,
+		const uint8_t* vDatas,
+		const size_t& vDatasSize,
+		const std::string& vPrefix,
+		std::string* vBufferName,
+		size_t* vBufferSize,
+		size_t* vDecompressedSize);
 };
\ No newline at end of file
@@ -41,6 +41,10 @@
 
 #include "MemoryStream.h"
 
+#include <Helper/CommandLine.h>
+#include <Helper/FontDataService.h>
+#include <Helper/FontParser.h>
+
 #include <ctools/FileHelper.h>
 #include <ctools/cTools.h>
 #include <ctools/Logger.h>
@@ -50,7 +54,6 @@
 
 #include <sfntly/font_factory.h>
 #include <sfntly/port/memory_output_stream.h>
-#include <sfntly/port/file_input_stream.h>
 #include <sfntly/table/core/maximum_profile_table.h>
 #include <sfntly/table/core/horizontal_header_table.h>
 #include <sfntly/table/core/horizontal_metrics_table.h>
@@ -83,11 +86,14 @@ bool FontGenerator::OpenFontFile(
 	{
 		FontInstance fontInstance;
 
-		fontInstance.m_Font.Attach(LoadFontFile(vFontFilePathName.c_str()));
+		// parsed once per file, shared with the glyph pane and the others generations
+		fontInstance.m_Font = FontDataService::Instance()->GetFont(vFontFilePathName);
 		if (fontInstance.m_Font)
 		{
 			sfntly::Ptr<sfntly::CMapTable> cmap_table = down_cast<sfntly::CMapTable*>(fontInstance.m_Font->GetTable(sfntly::Tag::cmap));
-			fontInstance.m_CMapTable.Attach(cmap_table->GetCMap(sfntly::CMapTable::WINDOWS_BMP));
+			fontInstance.m_CMapTable.Attach(cmap_table->GetCMap(sfntly::CMapTable::WINDOWS_UCS4)); // the codepoints over U+FFFF are only here
+			if (!fontInstance.m_CMapTable)
+				fontInstance.m_CMapTable.Attach(cmap_table->GetCMap(sfntly::CMapTable::WINDOWS_BMP));
 			if (fontInstance.m_CMapTable)
 			{
 				fontInstance.m_GlyfTable = down_cast<sfntly::GlyphTable*>(fontInstance.m_Font->GetTable(sfntly::Tag::glyf));
@@ -127,7 +133,32 @@ bool FontGenerator::GenerateFontFile(
 {
 	bool res = false;
 
-	if (!m_Fonts.empty())
+	auto ps = FileHelper::Instance()->ParsePathFileName(vFontFilePathName);
+	if (ps.isOk)
+	{
+		std::string filePathName = ps.name + ".ttf";
+		if (!ps.path.empty())
+			filePathName = ps.path + FileHelper::Instance()->m_SlashType + filePathName;
+
+		std::vector<uint8_t> fontBuffer;
+		if (GenerateFontBuffer(&fontBuffer, vUsePostTable, filePathName))
+		{
+			res = WriteFontFile(filePathName.c_str(), fontBuffer);
+		}
+	}
+
+	return res;
+}
+
+// same as GenerateFontFile but the font file stay in memory (used by the source generation)
+bool FontGenerator::GenerateFontBuffer(
+	std::vector<uint8_t>* vFontBuffer,
+	bool vUsePostTable,
+	const std::string& vFontName)
+{
+	bool res = false;
+
+	if (vFontBuffer && !m_Fonts.empty())
 	{
 		// en mode merge de plusieurs fonts
 		// merge des codepoint, c'est la que c'est important d'avoir un codepoint unique
@@ -139,13 +170,13 @@ bool FontGenerator::GenerateFontFile(
 			newFont.Attach(AssembleFont(vUsePostTable));
 			if (newFont)
 			{
-				auto ps = FileHelper::Instance()->ParsePathFileName(vFontFilePathName);
-				if (ps.isOk)
+				res = SerializeFont(newFont, vFontBuffer);
+
+				// checksums and structure of the serialized font, before to write it
+				if (res && CommandLine::Instance()->IsValidationNeeded())
 				{
-					std::string filePathName = ps.name + ".ttf";
-					if (!ps.path.empty())
-						filePathName = ps.path + FileHelper::Instance()->m_SlashType + filePathName;
-					res = SerializeFont(filePathName.c_str(), newFont);
+					res = FontParser::ValidateFontDatas(vFontBuffer->data(), vFontBuffer->size(),
+						vFontName.empty() ? "Generated font" : vFontName);
 				}
 			}
 		}
@@ -346,14 +377,49 @@ sfntly::Font* FontGenerator::AssembleFont(bool vUsePostTable)
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// the new glyph ids are given in the codepoint order, so consecutive codepoints have consecutive glyph ids
+// and the cmap can use id deltas instead of a glyph id array (see Assemble_CMap_Table)
+// - the first resolved glyph stay the glyph 0 (.notdef)
+// - then the glyphs of the codepoints, a glyph used by many codepoints take the id of the first one
+// - then the others resolved glyphs (composite elements, .notdef of the merged fonts)
+void FontGenerator::ComputeNewGlyphOrder()
+{
+	m_OldToNewGlyfId.clear();
+	m_NewToOldGlyfId.clear();
+
+	if (m_ResolvedSet.empty())
+		return;
+
+	auto addGlyph = [this](const FontGlyphId& vFontGlyphId)
+	{
+		if (m_ResolvedSet.find(vFontGlyphId) != m_ResolvedSet.end() &&
+			m_OldToNewGlyfId.find(vFontGlyphId) == m_OldToNewGlyfId.end())
+		{
+			m_OldToNewGlyfId[vFontGlyphId] = (GlyphId)m_NewToOldGlyfId.size();
+			m_NewToOldGlyfId.push_back(vFontGlyphId);
+		}
+	};
+
+	addGlyph(*m_ResolvedSet.begin());
+
+	for (const auto& it : m_CharMap)
+	{
+		addGlyph(it.second);
+	}
+
+	for (const auto& it : m_ResolvedSet)
+	{
+		addGlyph(it);
+	}
+}
+
 /* based on https://github.com/rillig/sfntly/blob/master/cpp/src/sample/subtly/font_assembler.cc*/
 bool FontGenerator::Assemble_Glyf_Loca_Maxp_Tables()
 {
 	auto baseFontInstance = GetBaseFontInstance();
 	if (baseFontInstance)
 	{
-		m_OldToNewGlyfId.clear();
-		m_NewToOldGlyfId.clear();
+		ComputeNewGlyphOrder();
 
 		sfntly::Ptr<sfntly::LocaTable::Builder> loca_table_builder = down_cast<sfntly::LocaTable::Builder*>(m_FontBuilder->NewTableBuilder(sfntly::Tag::loca));
 		sfntly::Ptr<sfntly::GlyphTable::Builder> glyph_table_builder = down_cast<sfntly::GlyphTable::Builder*>(m_FontBuilder->NewTableBuilder(sfntly::Tag::glyf));
@@ -363,14 +429,11 @@ bool FontGenerator::Assemble_Glyf_Loca_Maxp_Tables()
 		int32_t glyphOffset = 0;
 		my_loca_list.emplace_back(glyphOffset);
 		int32_t fontId = 0;
-		int32_t new_glyphid = 0;
-		for (const auto & it : m_ResolvedSet)
+		for (const auto & it : m_NewToOldGlyfId)
 		{
 			// Get the glyph for this resolved_glyph_id.
 			fontId = it.first;
 			int32_t resolved_glyph_id = it.second;
-			m_OldToNewGlyfId[it] = new_glyphid++;
-			m_NewToOldGlyfId[fontId].push_back(resolved_glyph_id);
 
 			// we will need to scale the glyph contours here or somewhere for merging mode
 			// bounding box cant be the sames between fonts
@@ -485,10 +548,19 @@ sfntly::Ptr<sfntly::WritableFontData> FontGenerator::ReScale_Glyph(
 					// https://developer.apple.com/fonts/TrueType-Reference-Manual/RM06/Chap6glyf.html
 					/////////////////////////////////////////////////////////////////////////////////////////////
 
-					MemoryStream headerStream;
-					MemoryStream flagStream;
-					MemoryStream xCoordStream;
-					MemoryStream yCoordStream;
+					// the parts are filled by arrays, then swapped in big endian by array in one stream
+					size_t countPoints = 0U;
+					for (auto &contour : simpleGlyph.coords)
+						countPoints += contour.size();
+
+					std::vector<int16_t> header;
+					std::vector<uint8_t> flags;
+					std::vector<int16_t> xCoords;
+					std::vector<int16_t> yCoords;
+					header.reserve(6U + (size_t)ct::maxi(countContours, 0));
+					flags.reserve(countPoints);
+					xCoords.reserve(countPoints);
+					yCoords.reserve(countPoints);
 
 					ct::iAABB boundingBox(
 						glyphInfos->simpleGlyph.rc.xy(), 
@@ -508,11 +580,11 @@ sfntly::Ptr<sfntly::WritableFontData> FontGenerator::ReScale_Glyph(
 							uint8_t flag = 0;
 							if (simpleGlyph.onCurve[contourIdx][pointIdx])
 								flag = flag | (1 << 0);
-							flagStream.WriteByte(flag);
+							flags.push_back(flag);
 
 							// relative points
-							xCoordStream.WriteShort(dv.x);
-							yCoordStream.WriteShort(dv.y);
+							xCoords.push_back((int16_t)dv.x);
+							yCoords.push_back((int16_t)dv.y);
 
 							// conbine absolute points
 							boundingBox.Combine(pt);
@@ -529,27 +601,28 @@ sfntly::Ptr<sfntly::WritableFontData> FontGenerator::ReScale_Glyph(
 
 					m_FontBoundingBox.Combine(boundingBox);
 
-					headerStream.WriteShort(countContours);
-					headerStream.WriteShort(inf.x);
-					headerStream.WriteShort(inf.y);
-					headerStream.WriteShort(sup.x);
-					headerStream.WriteShort(sup.y);
+					header.push_back((int16_t)countContours);
+					header.push_back((int16_t)inf.x);
+					header.push_back((int16_t)inf.y);
+					header.push_back((int16_t)sup.x);
+					header.push_back((int16_t)sup.y);
 					for (int contour = 0; contour < countContours; contour++)
-						headerStream.WriteShort(sglyph->ContourEndPoint(contour));
-					headerStream.WriteShort(0);
+						header.push_back((int16_t)sglyph->ContourEndPoint(contour));
+					header.push_back(0); // instructionLength
+
+					MemoryStream glyfStream;
+					glyfStream.Reserve(header.size() * 2U + flags.size() + xCoords.size() * 2U + yCoords.size() * 2U);
+					glyfStream.WriteArray(header);
+					glyfStream.WriteArray(flags);
+					glyfStream.WriteArray(xCoords);
+					glyfStream.WriteArray(yCoords);
 
 					/////////////////////////////////////////////////////////////////////////////////////////////
 					/////////////////////////////////////////////////////////////////////////////////////////////
 
 					sfntly::Ptr<sfntly::WritableFontData> finalStream;
-					size_t new_lengthInBytes = headerStream.Size() + flagStream.Size() + xCoordStream.Size() + yCoordStream.Size();
-					finalStream.Attach(sfntly::WritableFontData::CreateWritableFontData((int32_t)new_lengthInBytes));
-
-					int32_t offset = 0;
-					finalStream->WriteBytes(offset, headerStream.Get(), 0, (int32_t)headerStream.Size()); offset += (int32_t)headerStream.Size();
-					finalStream->WriteBytes(offset, flagStream.Get(), 0, (int32_t)flagStream.Size()); offset += (int32_t)flagStream.Size();
-					finalStream->WriteBytes(offset, xCoordStream.Get(), 0, (int32_t)xCoordStream.Size()); offset += (int32_t)xCoordStream.Size();
-					finalStream->WriteBytes(offset, yCoordStream.Get(), 0, (int32_t)yCoordStream.Size());
+					finalStream.Attach(sfntly::WritableFontData::CreateWritableFontData((int32_t)glyfStream.Size()));
+					finalStream->WriteBytes(0, glyfStream.Get(), 0, (int32_t)glyfStream.Size());
 
 					/////////////////////////////////////////////////////////////////////////////////////////////
 					/////////////////////////////////////////////////////////////////////////////////////////////
@@ -579,87 +652,231 @@ sfntly::Ptr<sfntly::WritableFontData> FontGenerator::ReScale_Glyph(
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-/* based on https://github.com/rillig/sfntly/blob/master/cpp/src/sample/subtly/font_assembler.cc*/
-bool FontGenerator::Assemble_CMap_Table()
+// https://docs.microsoft.com/en-us/typography/opentype/spec/cmap
+// each writer return false if the format can't encode the mapping
+typedef std::vector<std::pair<uint32_t, uint32_t>> CMapEntries; // codepoint / new glyph id, ordered by codepoint
+
+// segments of consecutive codepoints, with id delta if the glyph ids are consecutive too, else with the glyph id array
+// only the codepoints under 0xFFFF, the others are in the format 12
+static bool WriteCMapFormat4(const CMapEntries& vEntries, MemoryStream* vStream)
 {
-	// Creating the new CMapTable and the new format 4 CMap
-	sfntly::Ptr<sfntly::CMapTable::Builder> cmap_table_builder =
-		down_cast<sfntly::CMapTable::Builder*>
-		(m_FontBuilder->NewTableBuilder(sfntly::Tag::cmap));
-	if (!cmap_table_builder)
+	struct Segment
+	{
+		uint32_t start = 0;
+		uint32_t end = 0;
+		int32_t delta = 0;
+		bool useArray = false;
+		size_t arrayStart = 0;
+	};
+
+	std::vector<Segment> segments;
+	std::vector<uint32_t> glyphIdArray;
+
+	size_t runStart = 0;
+	while (runStart < vEntries.size())
+	{
+		if (vEntries[runStart].first >= 0xFFFF) // 0xFFFF is the last segment, the codepoints are ordered
+			break;
+
+		// run of consecutive codepoints, stopped before 0xFFFF
+		size_t runEnd = runStart + 1;
+		while (runEnd < vEntries.size() && vEntries[runEnd].first < 0xFFFF &&
+			vEntries[runEnd].first == vEntries[runEnd - 1].first + 1)
+			runEnd++;
+
+		// pieces of constant delta in the run
+		std::vector<Segment> pieces;
+		for (size_t i = runStart; i < runEnd; i++)
+		{
+			const int32_t delta = (int32_t)vEntries[i].second - (int32_t)vEntries[i].first;
+			if (pieces.empty() || pieces.back().delta != delta)
+			{
+				Segment seg;
+				seg.start = vEntries[i].first;
+				seg.delta = delta;
+				pieces.push_back(seg);
+			}
+			pieces.back().end = vEntries[i].first;
+		}
+
+		// 8 bytes per segment, 2 bytes per glyph id in the array
+		const size_t runLength = runEnd - runStart;
+		if (pieces.size() == 1U || pieces.size() * 8U <= 8U + runLength * 2U)
+		{
+			segments.insert(segments.end(), pieces.begin(), pieces.end());
+		}
+		else
+		{
+			Segment seg;
+			seg.start = vEntries[runStart].first;
+			seg.end = vEntries[runEnd - 1].first;
+			seg.useArray = true;
+			seg.arrayStart = glyphIdArray.size();
+			for (size_t i = runStart; i < runEnd; i++)
+				glyphIdArray.push_back(vEntries[i].second);
+			segments.push_back(seg);
+		}
+
+		runStart = runEnd;
+	}
+
+	// required last segment
+	Segment lastSeg;
+	lastSeg.start = 0xFFFF;
+	lastSeg.end = 0xFFFF;
+	lastSeg.delta = 1;
+	segments.push_back(lastSeg);
+
+	const size_t segCount = segments.size();
+	const size_t length = 16U + segCount * 8U + glyphIdArray.size() * 2U;
+	if (length > 0xFFFF)
 		return false;
 
-	sfntly::Ptr<sfntly::CMapTable::CMapFormat4::Builder> cmap_builder =
-		down_cast<sfntly::CMapTable::CMapFormat4::Builder*>
-		(cmap_table_builder->NewCMapBuilder(sfntly::CMapFormat::kFormat4,
-			sfntly::CMapTable::WINDOWS_BMP));
-	if (!cmap_builder)
+	uint32_t searchRange = 2U;
+	uint32_t entrySelector = 0U;
+	while (searchRange * 2U <= segCount * 2U)
+	{
+		searchRange *= 2U;
+		entrySelector++;
+	}
+
+	vStream->Reserve(length);
+	vStream->WriteUShort(4); // format
+	vStream->WriteUShort((int32_t)length);
+	vStream->WriteUShort(0); // language
+	vStream->WriteUShort((int32_t)segCount * 2);
+	vStream->WriteUShort((int32_t)searchRange);
+	vStream->WriteUShort((int32_t)entrySelector);
+	vStream->WriteUShort((int32_t)(segCount * 2U - searchRange)); // rangeShift
+	for (const auto& seg : segments)
+		vStream->WriteUShort((int32_t)seg.end);
+	vStream->WriteUShort(0); // reservedPad
+	for (const auto& seg : segments)
+		vStream->WriteUShort((int32_t)seg.start);
+	for (const auto& seg : segments)
+		vStream->WriteUShort(seg.delta & 0xFFFF); // modulo 65536
+	for (size_t i = 0; i < segCount; i++)
+	{
+		// offset from this idRangeOffset to the first glyph id of the segment in the array
+		if (segments[i].useArray)
+			vStream->WriteUShort((int32_t)((segCount - i) * 2U + segments[i].arrayStart * 2U));
+		else
+			vStream->WriteUShort(0);
+	}
+	for (auto glyphId : glyphIdArray)
+		vStream->WriteUShort((int32_t)glyphId);
+
+	return true;
+}
+
+// groups of consecutive codepoints with consecutive glyph ids, for the codepoints over the bmp
+static bool WriteCMapFormat12(const CMapEntries& vEntries, MemoryStream* vStream)
+{
+	if (vEntries.empty())
 		return false;
 
-	// Creating the segments and the glyph id array
-	auto* segment_list = new sfntly::SegmentList;
-    auto* new_glyph_id_array = new sfntly::IntegerList;
-	int32_t last_chararacter = -2;
-	int32_t last_offset = 0;
-	sfntly::Ptr<sfntly::CMapTable::CMapFormat4::Builder::Segment> current_segment;
-
-	// For simplicity, we will have one segment per contiguous range.
-	// To test the algorithm, we've replaced the original CMap with the CMap
-	// generated by this code without removing any character.
-	// Tuffy.ttf: CMap went from 3146 to 3972 bytes (1.7% to 2.17% of file)
-	// AnonymousPro.ttf: CMap went from 1524 to 1900 bytes (0.96% to 1.2%)
-	for (auto & it : m_CharMap)
+	struct Group
 	{
-		int32_t character = it.first;
-		if (character != last_chararacter + 1)
-		{  // new segment
-			if (current_segment != nullptr)
+		uint32_t start = 0;
+		uint32_t end = 0;
+		uint32_t glyphId = 0;
+	};
+
+	std::vector<Group> groups;
+	for (const auto& entry : vEntries)
+	{
+		if (!groups.empty() && groups.back().end + 1U == entry.first)
+		{
+			const Group& last = groups.back();
+			if (entry.second == last.glyphId + (entry.first - last.start))
 			{
-				current_segment->set_end_count(last_chararacter);
-				segment_list->push_back(current_segment);
+				groups.back().end = entry.first;
+				continue;
 			}
-			// start_code = character
-			// end_code = -1 (unknown for now)
-			// id_delta = 0 (we don't use id_delta for this representation)
-			// id_range_offset = last_offset (offset into the glyph_id_array)
-			current_segment =
-				new sfntly::CMapTable::CMapFormat4::Builder::
-				Segment(character, -1, 0, last_offset);
 		}
-		int32_t old_fontid = it.second.first;
-		int32_t old_glyphid = it.second.second;
-		new_glyph_id_array->push_back(m_OldToNewGlyfId[FontGlyphId(old_fontid,old_glyphid)]);
-		last_offset += sfntly::DataSize::kSHORT;
-		last_chararacter = character;
+
+		Group group;
+		group.start = entry.first;
+		group.end = entry.first;
+		group.glyphId = entry.second;
+		groups.push_back(group);
 	}
 
-	// The last segment is still open.
-	if (current_segment != nullptr)
+	vStream->Reserve(16U + groups.size() * 12U);
+	vStream->WriteUShort(12); // format
+	vStream->WriteUShort(0); // reserved
+	vStream->WriteULong(16 + (int64_t)groups.size() * 12); // length
+	vStream->WriteULong(0); // language
+	vStream->WriteULong((int64_t)groups.size());
+	for (const auto& group : groups)
+	{
+		vStream->WriteULong(group.start);
+		vStream->WriteULong(group.end);
+		vStream->WriteULong(group.glyphId);
+	}
+
+	return true;
+}
+
+// the windows bmp subtable (3,1) is always a format 4, required by the spec and by windows
+// the windows ucs4 subtable (3,10) format 12 is added only for the codepoints over the bmp
+bool FontGenerator::Assemble_CMap_Table()
+{
+	CMapEntries entries;
+	for (const auto& it : m_CharMap)
 	{
-		current_segment->set_end_count(last_chararacter);
-		segment_list->push_back(current_segment);
+		if (it.first < 0)
+			continue;
+		auto itGlyph = m_OldToNewGlyfId.find(it.second);
+		if (itGlyph != m_OldToNewGlyfId.end())
+			entries.emplace_back((uint32_t)it.first, (uint32_t)itGlyph->second);
 	}
 
-	// Updating the id_range_offset for every segment.
-	for (int32_t i = 0, num_segs = (int32_t)segment_list->size(); i < num_segs; ++i)
+	MemoryStream bmpSubTable;
+	const bool bmpDone = WriteCMapFormat4(entries, &bmpSubTable); // only the codepoints under 0xFFFF
+
+	MemoryStream ucs4SubTable;
+	bool ucs4Done = false;
+	if (!entries.empty() && (entries.back().first > 0xFFFF || !bmpDone))
+		ucs4Done = WriteCMapFormat12(entries, &ucs4SubTable);
+
+	if (!bmpDone)
+		LogStr("The cmap format 4 is too big, only the format 12 is emitted");
+
+	if (!bmpDone && !ucs4Done)
+		return false;
+
+	const int32_t countSubTables = (bmpDone ? 1 : 0) + (ucs4Done ? 1 : 0);
+
+	// encoding records ordered by platform then encoding
+	MemoryStream cmapStream;
+	cmapStream.WriteUShort(0); // version
+	cmapStream.WriteUShort(countSubTables); // numTables
+	int64_t subTableOffset = 4 + 8 * countSubTables;
+	if (bmpDone)
 	{
-		sfntly::Ptr<sfntly::CMapTable::CMapFormat4::Builder::Segment> segment = segment_list->at(i);
-		segment->set_id_range_offset(segment->id_range_offset()
-			+ (num_segs - i + 1) * sfntly::DataSize::kSHORT);
+		cmapStream.WriteUShort(3); // platform windows
+		cmapStream.WriteUShort(1); // encoding bmp
+		cmapStream.WriteULong(subTableOffset);
+		subTableOffset += (int64_t)bmpSubTable.Size();
+	}
+	if (ucs4Done)
+	{
+		cmapStream.WriteUShort(3); // platform windows
+		cmapStream.WriteUShort(10); // encoding ucs4
+		cmapStream.WriteULong(subTableOffset);
 	}
 	
-	// Adding the final, required segment.
-	current_segment =
-		new sfntly::CMapTable::CMapFormat4::Builder::Segment(0xffff, 0xffff, 1, 0);
-	new_glyph_id_array->push_back(0);//traitement des limites
-	segment_list->push_back(current_segment);
-	
-	// Writing the segments and glyph id array to the CMap
-	cmap_builder->set_segments(segment_list);
-	cmap_builder->set_glyph_id_array(new_glyph_id_array);
-	delete segment_list;
-	delete new_glyph_id_array;
-	
+	sfntly::WritableFontDataPtr data;
+	data.Attach(sfntly::WritableFontData::CreateWritableFontData((int32_t)(cmapStream.Size() + bmpSubTable.Size() + ucs4SubTable.Size())));
+	int32_t offset = 0;
+	offset += data->WriteBytes(offset, cmapStream.Get(), 0, (int32_t)cmapStream.Size());
+	if (bmpDone)
+		offset += data->WriteBytes(offset, bmpSubTable.Get(), 0, (int32_t)bmpSubTable.Size());
+	if (ucs4Done)
+		data->WriteBytes(offset, ucs4SubTable.Get(), 0, (int32_t)ucs4SubTable.Size());
+	m_FontBuilder->NewTableBuilder(sfntly::Tag::cmap, data);
+
 	return true;
 }
 
@@ -680,39 +897,43 @@ bool FontGenerator::Assemble_Hmtx_Hhea_Tables()
 	{
 		std::vector<LongHorMetric> metrics;
 
-		FontId fontId = 0;
+		std::vector<sfntly::HorizontalMetricsTablePtr> origMetricsPerFont;
 		for (auto &font : m_Fonts)
 		{
-			if (m_NewToOldGlyfId.find(fontId) != m_NewToOldGlyfId.end())
-			{
-				sfntly::HorizontalMetricsTablePtr origMetrics =
-					down_cast<sfntly::HorizontalMetricsTable*>(font.m_Font->GetTable(sfntly::Tag::hmtx));
-				if (origMetrics == nullptr)
-				{
-					return false;
-				}
+			origMetricsPerFont.push_back(down_cast<sfntly::HorizontalMetricsTable*>(font.m_Font->GetTable(sfntly::Tag::hmtx)));
+		}
 
-				for (size_t i = 0; i < m_NewToOldGlyfId[fontId].size(); ++i)
-				{
-					int32_t origGlyphId = m_NewToOldGlyfId[fontId][i];
-					int32_t advanceWidth = origMetrics->AdvanceWidth(origGlyphId);
-					int32_t lsb = origMetrics->LeftSideBearing(origGlyphId);
+		// in the new glyph order
+		for (const auto& it : m_NewToOldGlyfId)
+		{
+			FontId fontId = it.first;
+			int32_t origGlyphId = it.second;
 
-					auto glyphInfos = GetGlyphInfosFromGlyphId(fontId, origGlyphId);
-					if (glyphInfos)
-					{
-						if (glyphInfos->simpleGlyph.isValid)
-						{
-							advanceWidth = (int32_t)ct::floor(advanceWidth * glyphInfos->simpleGlyph.m_Scale.x);
-							lsb = (int32_t)ct::floor(lsb * glyphInfos->simpleGlyph.m_Scale.x);
-						}
-					}
+			sfntly::HorizontalMetricsTablePtr origMetrics = origMetricsPerFont[fontId];
+			if (origMetrics == nullptr)
+			{
+				return false;
+			}
+
+			int32_t advanceWidth = origMetrics->AdvanceWidth(origGlyphId);
+			int32_t lsb = origMetrics->LeftSideBearing(origGlyphId);
 
-					metrics.push_back(LongHorMetric{ advanceWidth, lsb });
+			auto glyphInfos = GetGlyphInfosFromGlyphId(fontId, origGlyphId);
+			if (glyphInfos)
+			{
+				if (glyphInfos->simpleGlyph.isValid)
+				{
+					advanceWidth = (int32_t)ct::floor(advanceWidth * glyphInfos->simpleGlyph.m_Scale.x);
+					lsb = (int32_t)ct::floor(lsb * glyphInfos->simpleGlyph.m_Scale.x);
 				}
 			}
 
-			fontId++;
+			metrics.push_back(LongHorMetric{ advanceWidth, lsb });
+		}
+
+		if (metrics.empty())
+		{
+			return false;
 		}
 
         auto lastWidth = metrics.back().advanceWidth;
@@ -763,28 +984,21 @@ bool FontGenerator::Assemble_Post_Table(std::map<CodePoint, std::string> vSelect
 	}
 
 	std::vector<std::string> names;
-	for (FontId fontId = 0; fontId < (FontId)m_Fonts.size(); fontId++)
+	for (const auto& fgid : m_NewToOldGlyfId) // in the new glyph order
 	{
-		if (m_NewToOldGlyfId.find(fontId) != m_NewToOldGlyfId.end())
+		int32_t id = fgid.second;
+		if (m_ReversedCharMap.find(fgid) != m_ReversedCharMap.end()) // found
 		{
-			for (size_t i = 0; i < m_NewToOldGlyfId[fontId].size(); ++i)
+			int32_t codepoint = m_ReversedCharMap[fgid];
+			if (vSelection.find(codepoint) != vSelection.end()) // found
 			{
-				int32_t id = m_NewToOldGlyfId[fontId][i];
-				FontGlyphId fgid = FontGlyphId(fontId, id);
-				if (m_ReversedCharMap.find(fgid) != m_ReversedCharMap.end()) // found
-				{
-					int32_t codepoint = m_ReversedCharMap[fgid];
-					if (vSelection.find(codepoint) != vSelection.end()) // found
-					{
-						names.push_back(vSelection[codepoint]);
-					}
-				}
-				else
-				{
-					names.emplace_back(sfntly::PostScriptTable::STANDARD_NAMES[id]);
-				}
+				names.push_back(vSelection[codepoint]);
 			}
 		}
+		else
+		{
+			names.emplace_back(sfntly::PostScriptTable::STANDARD_NAMES[id]);
+		}
 	}
 
 	if (names.empty())
@@ -947,64 +1161,64 @@ std::unordered_map<std::string, int32_t> FontGenerator::InvertNameMap()
 }
 
 /* based on https://github.com/rillig/sfntly/blob/master/cpp/src/sample/subtly/utils.cc*/
-sfntly::Font* FontGenerator::LoadFontFile(const char* font_path)
-{
-	sfntly::Ptr<sfntly::FontFactory> font_factory;
-	font_factory.Attach(sfntly::FontFactory::GetInstance());
-	sfntly::FontArray fonts;
-	LoadFontFiles(font_path, font_factory, &fonts);
-	return fonts[0].Detach();
-}
-
 /* based on https://github.com/rillig/sfntly/blob/master/cpp/src/sample/subtly/utils.cc*/
-void FontGenerator::LoadFontFiles(const char* font_path, sfntly::FontFactory* factory, sfntly::FontArray* fonts)
+bool FontGenerator::SerializeFont(sfntly::Font* font, std::vector<uint8_t>* vFontBuffer)
 {
-	sfntly::FileInputStream input_stream;
-	input_stream.Open(font_path);
-	factory->LoadFonts(&input_stream, fonts);
-	input_stream.Close();
-}
-
-/* based on https://github.com/rillig/sfntly/blob/master/cpp/src/sample/subtly/utils.cc*/
-bool FontGenerator::SerializeFont(const char* font_path, sfntly::Font* font)
-{
-	if (!font_path)
-		return false;
 	sfntly::FontFactoryPtr font_factory;
 	font_factory.Attach(sfntly::FontFactory::GetInstance());
-	return SerializeFont(font_path, font_factory, font);
+	return SerializeFont(font_factory, font, vFontBuffer);
 }
 
 /* based on https://github.com/rillig/sfntly/blob/master/cpp/src/sample/subtly/utils.cc*/
-bool FontGenerator::SerializeFont(const char* font_path, sfntly::FontFactory* factory, sfntly::Font* font)
+bool FontGenerator::SerializeFont(sfntly::FontFactory* factory, sfntly::Font* font, std::vector<uint8_t>* vFontBuffer)
 {
-    bool res = false;
+	bool res = false;
 
-	if (!font_path || !factory || !font)
+	if (!factory || !font || !vFontBuffer)
 		return res;
 
 	// Serializing the font to a stream.
 	sfntly::MemoryOutputStream output_stream;
 	factory->SerializeFont(font, &output_stream);
-    
+
 	size_t bufferLen = output_stream.Size();
 	if (bufferLen > 0)
 	{
-		FILE* output_file = nullptr;
+		vFontBuffer->assign(output_stream.Get(), output_stream.Get() + bufferLen);
+		res = true;
+	}
+
+	return res;
+}
+
+bool FontGenerator::WriteFontFile(const char* font_path, const std::vector<uint8_t>& vFontBuffer)
+{
+	bool res = false;
+
+	if (!font_path || vFontBuffer.empty())
+		return res;
+
+	// the file can be mapped by FontDataService (a font of the project generated over itself)
+	// so it is not rewritten in place, a temp file is written then renamed over it
+	const std::string tmpFilePathName = std::string(font_path) + ".tmp";
+
+	FILE* output_file = nullptr;
 #if defined(MSVC)
-		fopen_s(&output_file, font_path, "wb");
+	fopen_s(&output_file, tmpFilePathName.c_str(), "wb");
 #else
-		output_file = fopen(font_path, "wb");
+	output_file = fopen(tmpFilePathName.c_str(), "wb");
 #endif
-		if (output_file != reinterpret_cast<FILE*>(NULL))
-		{
-			fwrite(output_stream.Get(), 1, bufferLen, output_file);
-			fflush(output_file);
-			fclose(output_file);
-			res = true;
-		}
+	if (output_file != reinterpret_cast<FILE*>(NULL))
+	{
+		res = (fwrite(vFontBuffer.data(), 1, vFontBuffer.size(), output_file) == vFontBuffer.size());
+		res &= (fclose(output_file) == 0);
+
+		if (res)
+			res = FontDataService::Instance()->ReplaceFontFile(tmpFilePathName, font_path);
+		if (!res)
+			remove(tmpFilePathName.c_str());
 	}
- 
+
 	return res;
 }
 
@@ -21,6 +21,7 @@
 #include <string>
 #include <set>
 #include <map>
+#include <vector>
 #include <unordered_map>
 #include <memory>
 
@@ -84,6 +85,7 @@ public:
 		std::map<CodePoint, std::shared_ptr<GlyphInfos>> vNewGlyphInfos,
 		bool vBaseFontFileToMergeIn);
 	bool GenerateFontFile(const std::string& vFontFilePathName, bool vUsePostTable);
+	bool GenerateFontBuffer(std::vector<uint8_t>* vFontBuffer, bool vUsePostTable, const std::string& vFontName = ""); // vFontName for the validation messages
 
 private:
 	size_t m_BaseFontIdx = 0;
@@ -99,7 +101,7 @@ private:
 	std::map<CodePoint, std::string> m_GlyphNames;
 	std::set<FontGlyphId> m_ResolvedSet; // set of font id / glyph id
 	std::map<FontGlyphId, GlyphId> m_OldToNewGlyfId;
-	std::map<GlyphId, std::vector<GlyphId>> m_NewToOldGlyfId;
+	std::vector<FontGlyphId> m_NewToOldGlyfId; // new glyph id to font id / old glyph id
 
 private: // post table - version / count / size / offsets
 	const int32_t table_Version = 0x20000;
@@ -109,16 +111,14 @@ private: // post table - version / count / size / offsets
 	static std::unordered_map<std::string, int32_t> InvertNameMap();
 	int32_t MergeCharacterMaps();
 
-public:
-	static sfntly::Font* LoadFontFile(const char* font_path);
-
 private: // imported/based or/modified from sfntly
-	static void LoadFontFiles(const char* font_path, sfntly::FontFactory* factory, sfntly::FontArray* fonts);
-	static bool SerializeFont(const char* font_path, sfntly::Font* font);
-	static bool SerializeFont(const char* font_path, sfntly::FontFactory* factory, sfntly::Font* font);
+	static bool SerializeFont(sfntly::Font* font, std::vector<uint8_t>* vFontBuffer);
+	static bool SerializeFont(sfntly::FontFactory* factory, sfntly::Font* font, std::vector<uint8_t>* vFontBuffer);
+	static bool WriteFontFile(const char* font_path, const std::vector<uint8_t>& vFontBuffer);
 	sfntly::Font* AssembleFont(bool vUsePostTable);
 
 private:
+	void ComputeNewGlyphOrder();
 	bool Assemble_Glyf_Loca_Maxp_Tables();
 	sfntly::Ptr<sfntly::WritableFontData> ReScale_Glyph(const int32_t& vFontId, const int32_t& vGlyphId, const sfntly::Ptr<sfntly::ReadableFontData>& vReadableFontData);
 	static void FillResolvedCompositeGlyphs(FontInstance *vFontInstance, const std::map<CodePoint, int32_t>& chars_to_glyph_ids);
@@ -20,6 +20,7 @@
 #include "Generator.h"
 
 #include <Generator/Compress.h>
+#include <Generator/ObjectFileGenerator.h>
 
 #include <imgui/imgui.h>
 #define IMGUI_DEFINE_MATH_OPERATORS
@@ -36,11 +37,16 @@
 #include <stdlib.h>
 #include <assert.h>
 
+#include <thread>
+#include <atomic>
+
 #include <ctools/cTools.h>
 #include <ctools/FileHelper.h>
 #include <ctools/Logger.h>
 #include <Generator/FontGenerator.h>
 #include <Helper/Messaging.h>
+#include <Helper/CommandLine.h>
+#include <Helper/FontLoader.h>
 #include <MainFrame.h>
 #include <Panes/SourceFontPane.h>
 #include <Panes/ParamsPane.h>
@@ -67,6 +73,9 @@ bool Generator::Generate(
 
 	if (vProjectFile)
 	{
+		// the fonts in loading are out of m_Fonts, they would be missing in the generated files
+		FontLoader::Instance()->WaitAndFinishAll(vProjectFile);
+
 		PathStruct mainPS(vProjectFile->m_LastGeneratedPath, vProjectFile->m_LastGeneratedFileName, "");
 		
 		if (!vFilePath.empty()) mainPS.path = vFilePath;
@@ -84,21 +93,19 @@ bool Generator::Generate(
 			}
 			else if (vProjectFile->IsGenMode(GENERATOR_MODE_BATCH))
 			{
-				for (auto font : vProjectFile->m_Fonts)
+				res = GenerateBatch(vProjectFile, [this, vProjectFile, &vFilePath](std::shared_ptr<FontInfos> vFontInfos) -> bool
 				{
-					if (font.second)
+					auto ps = FileHelper::Instance()->ParsePathFileName(vFontInfos->m_FontFileName);
+					if (ps.isOk)
 					{
-						auto ps = FileHelper::Instance()->ParsePathFileName(font.second->m_FontFileName);
-						if (ps.isOk)
-						{
-							GenerateSource_One(
-								ps.GetFPNE_WithPath(vFilePath),
-								vProjectFile,
-								font.second,
-								vProjectFile->m_GenModeFlags);
-						}
+						return GenerateSource_One(
+							ps.GetFPNE_WithPath(vFilePath),
+							vProjectFile,
+							vFontInfos,
+							vProjectFile->m_GenModeFlags);
 					}
-				}
+					return false;
+				});
 			}
 			else if (vProjectFile->IsGenMode(GENERATOR_MODE_MERGED))
 			{
@@ -118,31 +125,30 @@ bool Generator::Generate(
 					vProjectFile->m_SelectedFont, 
 					vProjectFile->m_GenModeFlags);
 #ifdef AUTO_OPEN_FONT_IN_APP_AFTER_GENERATION_FOR_DEBUG_PURPOSE
-				if (res)
+				if (res && !CommandLine::Instance()->IsHeadless())
 					ParamsPane::Instance()->OpenFont(vProjectFile, mainPS.GetFPNE(), false); // directly load the generated font file
 #endif
 			}
 			else if (vProjectFile->IsGenMode(GENERATOR_MODE_BATCH))
 			{
-				for (auto font : vProjectFile->m_Fonts)
+				res = GenerateBatch(vProjectFile, [this, vProjectFile, &vFilePath](std::shared_ptr<FontInfos> vFontInfos) -> bool
 				{
-					if (font.second)
+					auto ps = FileHelper::Instance()->ParsePathFileName(vFontInfos->m_FontFileName);
+					if (ps.isOk)
 					{
-						auto ps = FileHelper::Instance()->ParsePathFileName(font.second->m_FontFileName);
-						if (ps.isOk)
-						{
-							res = GenerateFontFile_One(
-								ps.GetFPNE_WithPath(vFilePath),
-								vProjectFile,
-								font.second,
-								vProjectFile->m_GenModeFlags);
+						return GenerateFontFile_One(
+							ps.GetFPNE_WithPath(vFilePath),
+							vProjectFile,
+							vFontInfos,
+							vProjectFile->m_GenModeFlags);
+					}
+					return false;
+				});
 #ifdef AUTO_OPEN_FONT_IN_APP_AFTER_GENERATION_FOR_DEBUG_PURPOSE
-							if (res)
-								ParamsPane::Instance()->OpenFont(vProjectFile, mainPS.GetFPNE(), false); // directly load the generated font file
+				// done after the batch, the font loading is not thread safe (opengl texture)
+				if (res && !CommandLine::Instance()->IsHeadless())
+					ParamsPane::Instance()->OpenFont(vProjectFile, mainPS.GetFPNE(), false); // directly load the generated font file
 #endif
-						}
-					}
-				}
 			}
 			else if (vProjectFile->IsGenMode(GENERATOR_MODE_MERGED))
 			{
@@ -151,7 +157,7 @@ bool Generator::Generate(
 					vProjectFile,
 					vProjectFile->m_GenModeFlags);
 #ifdef AUTO_OPEN_FONT_IN_APP_AFTER_GENERATION_FOR_DEBUG_PURPOSE
-				if (res)
+				if (res && !CommandLine::Instance()->IsHeadless())
 					ParamsPane::Instance()->OpenFont(vProjectFile, mainPS.GetFPNE(), false); // directly load the generated font file
 #endif
 			}
@@ -168,21 +174,19 @@ bool Generator::Generate(
 			}
 			else if (vProjectFile->IsGenMode(GENERATOR_MODE_BATCH))
 			{
-				for (auto font : vProjectFile->m_Fonts)
+				res = GenerateBatch(vProjectFile, [this, vProjectFile, &vFilePath](std::shared_ptr<FontInfos> vFontInfos) -> bool
 				{
-					if (font.second)
+					auto ps = FileHelper::Instance()->ParsePathFileName(vFontInfos->m_FontFileName);
+					if (ps.isOk)
 					{
-						auto ps = FileHelper::Instance()->ParsePathFileName(font.second->m_FontFileName);
-						if (ps.isOk)
-						{
-							res = GenerateCard_One(
-								ps.GetFPNE_WithPathExt(vFilePath, ".png"),
-								font.second,
-								vProjectFile->m_CardGlyphHeightInPixel,
-								vProjectFile->m_CardCountRowsMax);
-						}
+						return GenerateCard_One(
+							ps.GetFPNE_WithPathExt(vFilePath, ".png"),
+							vFontInfos,
+							vProjectFile->m_CardGlyphHeightInPixel,
+							vProjectFile->m_CardCountRowsMax);
 					}
-				}
+					return false;
+				});
 			}
 			else if (vProjectFile->IsGenMode(GENERATOR_MODE_MERGED))
 			{
@@ -198,6 +202,77 @@ bool Generator::Generate(
 	return res;
 }
 
+///////////////////////////////////////////////////////////////////////////////////
+//// BATCH GENERATION /////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+/*
+the fonts are generated on a pool of m_BatchThreadsCount threads (0 => count of cores)
+each font is independant : own FontGenerator, own HeaderGenerator, own output files
+the messages of each font are captured, then added in the font order after the join
+so the messages and the files are the same as a serial generation
+*/
+bool Generator::GenerateBatch(
+	ProjectFile* vProjectFile,
+	const std::function<bool(std::shared_ptr<FontInfos>)>& vGenerateFontFunc)
+{
+	bool res = false;
+
+	if (vProjectFile && vGenerateFontFunc)
+	{
+		std::vector<std::shared_ptr<FontInfos>> fonts;
+		for (const auto& font : vProjectFile->m_Fonts)
+		{
+			if (font.second)
+			{
+				fonts.push_back(font.second);
+			}
+		}
+
+		const size_t countFonts = fonts.size();
+		std::vector<uint8_t> results(countFonts, 0U); // not a std::vector<bool>, each thread write his own bytes
+		std::vector<Messaging::MessagesCapture> messages(countFonts);
+		std::atomic<size_t> nextFontIdx(0U);
+
+		auto worker = [&]()
+		{
+			size_t idx = nextFontIdx++;
+			while (idx < countFonts)
+			{
+				Messaging::Instance()->BeginThreadCapture(&messages[idx]);
+				results[idx] = vGenerateFontFunc(fonts[idx]) ? 1U : 0U;
+				Messaging::Instance()->EndThreadCapture();
+				idx = nextFontIdx++;
+			}
+		};
+
+		size_t countThreads = vProjectFile->m_BatchThreadsCount;
+		if (countThreads == 0U)
+			countThreads = (size_t)std::thread::hardware_concurrency();
+		countThreads = ct::clamp<size_t>(countThreads, 1U, ct::maxi<size_t>(countFonts, 1U));
+
+		// the current thread is one of the workers
+		std::vector<std::thread> threads;
+		for (size_t i = 1U; i < countThreads; i++)
+		{
+			threads.emplace_back(worker);
+		}
+		worker();
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+
+		for (size_t idx = 0U; idx < countFonts; idx++)
+		{
+			Messaging::Instance()->AddCapturedMessages(messages[idx]);
+			res |= (results[idx] != 0U);
+		}
+	}
+
+	return res;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////
 //// STATIC TEXTURE TO PICTURE FILE ///////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////
@@ -435,7 +510,8 @@ bool Generator::WriteGlyphCardToPicture(
 
 					if (success)
 					{
-						FileHelper::Instance()->OpenFile(vFilePathName);
+						if (!CommandLine::Instance()->IsHeadless())
+							FileHelper::Instance()->OpenFile(vFilePathName);
 						res = true;
 					}
 					else
@@ -510,9 +586,10 @@ bool Generator::GenerateCard_One(
 			std::map<std::string, std::pair<uint32_t, size_t>> glyphs;
 			if (vFontInfos->m_SelectedGlyphs.empty()) // no glyph selected so generate for whole font
 			{
-				for (auto& glyph : vFontInfos->m_GlyphCodePointToName)
+				const auto& glyphTable = vFontInfos->m_GlyphTable;
+				for (uint32_t slot = 0; slot < (uint32_t)glyphTable.size(); slot++)
 				{
-					glyphs[GetNewHeaderName(prefix, glyph.second)] = std::pair<uint32_t, size_t>(glyph.first, (size_t)vFontInfos.get());
+					glyphs[GetNewHeaderName(prefix, glyphTable.GetName(slot))] = std::pair<uint32_t, size_t>(glyphTable.GetCodePoint(slot), (size_t)vFontInfos.get());
 				}
 			}
 			else
@@ -611,7 +688,8 @@ bool Generator::GenerateFontFile_One(
 	const std::string& vFilePathName, 
 	ProjectFile* vProjectFile,
 	std::shared_ptr<FontInfos> vFontInfos,
-	const GenModeFlags& vFlags)
+	const GenModeFlags& vFlags,
+	std::vector<uint8_t>* vFontBuffer)
 {
 	bool res = false;
 
@@ -638,7 +716,7 @@ bool Generator::GenerateFontFile_One(
 		{
 			Messaging::Instance()->AddError(true, nullptr, nullptr,
 				"No glyphs are seleted for font file %s. aborting.\n",
-				vProjectFile->m_SelectedFont->m_FontFilePathName.c_str());
+				vFontInfos->m_FontFileName.c_str());
 			return false;
 		}
 
@@ -649,7 +727,7 @@ bool Generator::GenerateFontFile_One(
 			{
 				Messaging::Instance()->AddError(true, nullptr, nullptr,
 					"Could not open font file %s.\n",
-					vProjectFile->m_SelectedFont->m_FontFilePathName.c_str());
+					vFontInfos->m_FontFileName.c_str());
 				return false;
 			}
 		}
@@ -657,7 +735,7 @@ bool Generator::GenerateFontFile_One(
 		{
 			Messaging::Instance()->AddError(true, nullptr, nullptr,
 				"No glyphs header or codepoint found for font file %s. aborting.\n",
-				vProjectFile->m_SelectedFont->m_FontFilePathName.c_str());
+				vFontInfos->m_FontFileName.c_str());
 			return false;
 		}
 
@@ -684,13 +762,20 @@ bool Generator::GenerateFontFile_One(
 			ct::replaceString(name, "-", "_");
 			filePathName = ps.GetFPNE_WithNameExt(name, ".ttf");
 
-			if (fontGenerator.GenerateFontFile(filePathName, vFlags & GENERATOR_MODE_FONT_SETTINGS_USE_POST_TABLES))
+			bool generated = false;
+			if (vFontBuffer)
+				generated = fontGenerator.GenerateFontBuffer(vFontBuffer, vFlags & GENERATOR_MODE_FONT_SETTINGS_USE_POST_TABLES, filePathName);
+			else
+				generated = fontGenerator.GenerateFontFile(filePathName, vFlags & GENERATOR_MODE_FONT_SETTINGS_USE_POST_TABLES);
+
+			if (generated)
 			{
 				res = true;
 
 				if (vFlags & GENERATOR_MODE_HEADER)
 				{
-					m_HeaderGenerator.GenerateHeader_One(
+					HeaderGenerator headerGenerator; // local, this func can be called by many threads in batch mode
+					headerGenerator.GenerateHeader_One(
 						filePathName,
 						vProjectFile,
 						vFontInfos);
@@ -723,7 +808,8 @@ bool Generator::GenerateFontFile_One(
 bool Generator::GenerateFontFile_Merged(
 	const std::string& vFilePathName, 
 	ProjectFile* vProjectFile,
-	const GenModeFlags& vFlags)
+	const GenModeFlags& vFlags,
+	std::vector<uint8_t>* vFontBuffer)
 {
 	bool res = false;
 
@@ -838,7 +924,13 @@ bool Generator::GenerateFontFile_Merged(
 				ct::replaceString(name, "-", "_");
 				filePathName = ps.GetFPNE_WithNameExt(name, ".ttf");
 
-				if (fontGenerator.GenerateFontFile(vFilePathName, vFlags & GENERATOR_MODE_FONT_SETTINGS_USE_POST_TABLES))
+				bool generated = false;
+				if (vFontBuffer)
+					generated = fontGenerator.GenerateFontBuffer(vFontBuffer, vFlags & GENERATOR_MODE_FONT_SETTINGS_USE_POST_TABLES, filePathName);
+				else
+					generated = fontGenerator.GenerateFontFile(vFilePathName, vFlags & GENERATOR_MODE_FONT_SETTINGS_USE_POST_TABLES);
+
+				if (generated)
 				{
 					res = true;
 
@@ -889,7 +981,7 @@ bool Generator::GenerateFontFile_Merged(
 will generate cpp fille with/without header
 two modes :
 - no glyph selected => export whole font file to cpp (and header is asked)
-- some glyohs selectef => export glyph selection in a new temporary font file, then exported in cpp (and header if asked)
+- some glyohs selectef => export glyph selection in a new font buffer in memory, then exported in cpp (and header if asked)
 */
 bool Generator::GenerateSource_One(
 	const std::string& vFilePathName, 
@@ -906,27 +998,23 @@ bool Generator::GenerateSource_One(
 		{
 			std::string buffer;
 
-			bool generateTemporaryFontFile = false;
+			std::vector<uint8_t> fontBuffer;
+			bool fontDatasFound = false;
 			if (vFontInfos->m_SelectedGlyphs.empty()) // export whole font file to cpp (and header is asked)
 			{
 				filePathName = vProjectFile->GetAbsolutePath(vFontInfos->m_FontFilePathName);
+				fontDatasFound = Compress::ReadFileDatas(filePathName, &fontBuffer);
 				// todo: il faut gerer le cas ou on va exporter tout les fichier sans selction
 				// ici on ne fait que l'actif, c'est aps ce qu'on veut
 			}
-			else // export glyph selection in a new temporary font file, then exported in cpp (and header if asked)
+			else // export glyph selection in a new font file in memory, then exported in cpp (and header if asked)
 			{
-				// generate temporary font file first
-				generateTemporaryFontFile = true;
-				
-				std::string name = ps.name;
-				ct::replaceString(name, "-", "_");
-				filePathName = ps.GetFPNE_WithNameExt("temporary_" + name, ".ttf");
-
-				GenerateFontFile_One(filePathName, vProjectFile, vFontInfos,
-					(GenModeFlags)(vFlags & ~GENERATOR_MODE_HEADER_CARD)); // no header or card to generate
+				fontDatasFound = GenerateFontFile_One(vFilePathName, vProjectFile, vFontInfos,
+					(GenModeFlags)(vFlags & ~GENERATOR_MODE_HEADER_CARD), // no header or card to generate
+					&fontBuffer);
 			}
 
-			if (FileHelper::Instance()->IsFileExist(filePathName))
+			if (fontDatasFound)
 			{
 				std::string lang;
 				if (vProjectFile->IsGenMode(GENERATOR_MODE_LANG_C)) lang = "c";
@@ -936,17 +1024,30 @@ bool Generator::GenerateSource_One(
 				{
 					std::string bufferName;
 					size_t bufferSize = 0;
-					buffer = Compress::GetCompressedBase85BytesArray(
-						lang,
-						filePathName,
-						vFontInfos->m_FontPrefix,
-						&bufferName,
-						&bufferSize);
-
-					if (generateTemporaryFontFile)
+					size_t decompressedSize = 0;
+					const bool linkedDatas = vProjectFile->IsGenMode(GENERATOR_MODE_SRC_SETTINGS_LINKED_DATAS) && lang != "c#";
+					if (linkedDatas) // buffer is the header of the linked datas
+					{
+						buffer = GenerateLinkedDatas(
+							ps,
+							vProjectFile->GetCompressCodec(),
+							fontBuffer,
+							vFontInfos->m_FontPrefix,
+							&bufferName,
+							&bufferSize,
+							&decompressedSize);
+					}
+					else
 					{
-						// we have the result, if empty or not we need to destroy the temporary font file
-						FileHelper::Instance()->DestroyFile(filePathName);
+						buffer = Compress::GetCompressedBytesArray(
+							vProjectFile->GetCompressCodec(),
+							lang,
+							fontBuffer.data(),
+							fontBuffer.size(),
+							vFontInfos->m_FontPrefix,
+							&bufferName,
+							&bufferSize,
+							&decompressedSize);
 					}
 
 					// if ok, serialization
@@ -955,7 +1056,12 @@ bool Generator::GenerateSource_One(
 						PathStruct psSource = ps;
 
 						std::string sourceExt;
-						if (vProjectFile->IsGenMode(GENERATOR_MODE_LANG_C)) sourceExt = ".c";
+						if (linkedDatas)
+						{
+							psSource.name += "_Datas";
+							sourceExt = ".h";
+						}
+						else if (vProjectFile->IsGenMode(GENERATOR_MODE_LANG_C)) sourceExt = ".c";
 						else if (vProjectFile->IsGenMode(GENERATOR_MODE_LANG_CPP)) sourceExt = ".cpp";
 						else if (vProjectFile->IsGenMode(GENERATOR_MODE_LANG_CSHARP))
 						{
@@ -987,18 +1093,21 @@ bool Generator::GenerateSource_One(
 								ct::replaceString(buffer, vFontInfos->m_FontPrefix + "_compressed_data_base85", prefix);
 							}
 
-							m_HeaderGenerator.GenerateHeader_One(
+							HeaderGenerator headerGenerator; // local, this func can be called by many threads in batch mode
+							headerGenerator.GenerateHeader_One(
 								psHeader.GetFPNE_WithExt(headerExt),
 								vProjectFile,
 								vFontInfos,
 								bufferName,
-								bufferSize);
+								bufferSize,
+								vProjectFile->GetCompressCodec(),
+								decompressedSize);
 						}
 
 						if (vFlags & GENERATOR_MODE_CARD)
 						{
 							GenerateCard_One(
-								filePathName,
+								vFilePathName,
 								vFontInfos,
 								vProjectFile->m_CardGlyphHeightInPixel,
 								vProjectFile->m_CardCountRowsMax);
@@ -1020,7 +1129,8 @@ bool Generator::GenerateSource_One(
 
 						filePathName = psSource.GetFPNE_WithExt(sourceExt);
 						FileHelper::Instance()->SaveStringToFile(sourceFile, filePathName);
-						FileHelper::Instance()->OpenFile(filePathName);
+						if (!CommandLine::Instance()->IsHeadless())
+							FileHelper::Instance()->OpenFile(filePathName);
 
 						res = true;
 					}
@@ -1068,14 +1178,15 @@ bool Generator::GenerateSource_Merged(
 			std::string buffer;
 
 			ct::replaceString(ps.name, "-", "_");
-			filePathName = ps.GetFPNE_WithNameExt("temporary_" + ps.name, ".ttf");
+			filePathName = ps.GetFPNE_WithExt(".ttf");
 
-			GenerateFontFile_Merged(
+			// the merged font file is generated in memory only
+			std::vector<uint8_t> fontBuffer;
+			if (GenerateFontFile_Merged(
 				filePathName, 
 				vProjectFile,
-				(GenModeFlags)(vFlags & ~GENERATOR_MODE_HEADER_CARD)); // no header to generate
-
-			if (FileHelper::Instance()->IsFileExist(filePathName))
+				(GenModeFlags)(vFlags & ~GENERATOR_MODE_HEADER_CARD), // no header to generate
+				&fontBuffer))
 			{
 				std::string lang;
 				if (vProjectFile->IsGenMode(GENERATOR_MODE_LANG_C)) lang = "c";
@@ -1085,15 +1196,31 @@ bool Generator::GenerateSource_Merged(
 				{
 					std::string bufferName;
 					size_t bufferSize = 0;
-					buffer = Compress::GetCompressedBase85BytesArray(
-						lang,
-						filePathName,
-						vProjectFile->m_MergedFontPrefix,
-						&bufferName,
-						&bufferSize);
-
-					// we have the result, if empty or not we need to destroy the temporary font file
-					FileHelper::Instance()->DestroyFile(filePathName);
+					size_t decompressedSize = 0;
+					const bool linkedDatas = vProjectFile->IsGenMode(GENERATOR_MODE_SRC_SETTINGS_LINKED_DATAS) && lang != "c#";
+					if (linkedDatas) // buffer is the header of the linked datas
+					{
+						buffer = GenerateLinkedDatas(
+							ps,
+							vProjectFile->GetCompressCodec(),
+							fontBuffer,
+							vProjectFile->m_MergedFontPrefix,
+							&bufferName,
+							&bufferSize,
+							&decompressedSize);
+					}
+					else
+					{
+						buffer = Compress::GetCompressedBytesArray(
+							vProjectFile->GetCompressCodec(),
+							lang,
+							fontBuffer.data(),
+							fontBuffer.size(),
+							vProjectFile->m_MergedFontPrefix,
+							&bufferName,
+							&bufferSize,
+							&decompressedSize);
+					}
 
 					// if ok, serialization
 					if (!buffer.empty() && !bufferName.empty() && bufferSize > 0)
@@ -1101,7 +1228,12 @@ bool Generator::GenerateSource_Merged(
 						PathStruct psSource = ps;
 						
 						std::string sourceExt;
-						if (vProjectFile->IsGenMode(GENERATOR_MODE_LANG_C)) sourceExt = ".c";
+						if (linkedDatas)
+						{
+							psSource.name += "_Datas";
+							sourceExt = ".h";
+						}
+						else if (vProjectFile->IsGenMode(GENERATOR_MODE_LANG_C)) sourceExt = ".c";
 						else if (vProjectFile->IsGenMode(GENERATOR_MODE_LANG_CPP)) sourceExt = ".cpp";
 						else if (vProjectFile->IsGenMode(GENERATOR_MODE_LANG_CSHARP))
 						{
@@ -1137,7 +1269,9 @@ bool Generator::GenerateSource_Merged(
 								psHeader.GetFPNE_WithExt(headerExt),
 								vProjectFile,
 								bufferName,
-								bufferSize);
+								bufferSize,
+								vProjectFile->GetCompressCodec(),
+								decompressedSize);
 						}
 
 						if (vFlags & GENERATOR_MODE_CARD)
@@ -1157,14 +1291,16 @@ bool Generator::GenerateSource_Merged(
 							sourceFile += buffer;
 							sourceFile += "\t}\n}\n";
 						}
-						else if (vProjectFile->IsGenMode(GENERATOR_MODE_LANG_CPP))
+						else if (vProjectFile->IsGenMode(GENERATOR_MODE_LANG_C) ||
+								 vProjectFile->IsGenMode(GENERATOR_MODE_LANG_CPP))
 						{
 							sourceFile += buffer;
 						}
 
 						filePathName = psSource.GetFPNE_WithExt(sourceExt);
 						FileHelper::Instance()->SaveStringToFile(sourceFile, filePathName);
-						FileHelper::Instance()->OpenFile(filePathName);
+						if (!CommandLine::Instance()->IsHeadless())
+							FileHelper::Instance()->OpenFile(filePathName);
 						res = true;
 					}
 					else
@@ -1189,3 +1325,77 @@ bool Generator::GenerateSource_Merged(
 
 	return res;
 }
+
+///////////////////////////////////////////////////////////////////////////////////
+//// LINKED DATAS /////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+// write the font datas in <name>.bin, with <name>.S and <name>.obj for link it
+// return the header with the extern symbols, for the src file
+std::string Generator::GenerateLinkedDatas(
+	PathStruct vPathStruct,
+	CompressCodecEnum vCodec,
+	const std::vector<uint8_t>& vFontDatas,
+	const std::string& vPrefix,
+	std::string* vBufferName,
+	size_t* vBufferSize,
+	size_t* vDecompressedSize)
+{
+	std::string res;
+
+	std::vector<uint8_t> datas;
+	if (Compress::GetCompressedDatas(vCodec, vFontDatas.data(), vFontDatas.size(), &datas))
+	{
+		const std::string symbolName = ObjectFileGenerator::GetSymbolName(vPrefix);
+		const std::string binFileName = vPathStruct.name + ".bin";
+
+		if (ObjectFileGenerator::WriteBinaryFile(vPathStruct.GetFPNE_WithExt(".bin"), datas) &&
+			ObjectFileGenerator::WriteIncbinAsmFile(vPathStruct.GetFPNE_WithExt(".S"), binFileName, symbolName, datas.size()) &&
+			ObjectFileGenerator::WriteCoffObjectFile(vPathStruct.GetFPNE_WithExt(".obj"), datas, symbolName))
+		{
+			res = ObjectFileGenerator::GetExternHeader(vPathStruct.name, vPrefix, symbolName, datas.size(), vCodec);
+
+			if (vBufferName) *vBufferName = symbolName;
+			if (vBufferSize) *vBufferSize = datas.size();
+			if (vDecompressedSize) *vDecompressedSize = vFontDatas.size();
+		}
+		else
+		{
+			Messaging::Instance()->AddError(true, nullptr, nullptr,
+				"Cant write the linked datas of %s", vPathStruct.GetFPNE_WithExt(".bin").c_str());
+		}
+	}
+
+	return res;
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+//// FONT DATAS ///////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+// same datas as GenerateSource_One, the whole font file or the glyph selection in memory
+bool Generator::GetFontDatas_One(
+	ProjectFile* vProjectFile,
+	std::shared_ptr<FontInfos> vFontInfos,
+	std::vector<uint8_t>* vFontDatas)
+{
+	bool res = false;
+
+	if (vProjectFile && vFontInfos.use_count() && vFontDatas)
+	{
+		std::string filePathName = vProjectFile->GetAbsolutePath(vFontInfos->m_FontFilePathName);
+		if (vFontInfos->m_SelectedGlyphs.empty())
+		{
+			res = Compress::ReadFileDatas(filePathName, vFontDatas);
+		}
+		else
+		{
+			// the file path is only used for the name, nothing is written
+			res = GenerateFontFile_One(filePathName, vProjectFile, vFontInfos,
+				(GenModeFlags)(vProjectFile->GetGenMode() & ~GENERATOR_MODE_HEADER_CARD),
+				vFontDatas);
+		}
+	}
+
+	return res;
+}
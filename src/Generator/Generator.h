@@ -17,11 +17,15 @@
 
 #include <GLFW/glfw3.h>
 #include <ctools/cTools.h>
+#include <ctools/FileHelper.h>
 
 #include "HeaderGenerator.h"
 
 #include <stdint.h>
 #include <string>
+#include <vector>
+#include <memory>
+#include <functional>
 
 typedef int GenModeFlags;
 enum _GenModeFlags
@@ -42,6 +46,10 @@ enum _GenModeFlags
 	GENERATOR_MODE_LANG_LUA = (1 << 12),
 	GENERATOR_MODE_LANG_PYTHON = (1 << 13),
 	GENERATOR_MODE_LANG_RUST = (1 << 14),
+	GENERATOR_MODE_SRC_CODEC_NONE = (1 << 15),	// src embedded font as raw bytes
+	GENERATOR_MODE_SRC_CODEC_STB = (1 << 16),	// src embedded font with stb compress + base85
+	GENERATOR_MODE_SRC_CODEC_LZ4 = (1 << 17),	// src embedded font with lz4 + generated decoder
+	GENERATOR_MODE_SRC_SETTINGS_LINKED_DATAS = (1 << 18),	// src font datas linked (.bin + .S + .obj), not compiled (c/c++ only)
 
 	// Mix's
 
@@ -49,6 +57,7 @@ enum _GenModeFlags
 	GENERATOR_MODE_RADIO_LANG = GENERATOR_MODE_LANG_C | GENERATOR_MODE_LANG_CPP | GENERATOR_MODE_LANG_CSHARP | GENERATOR_MODE_LANG_LUA | GENERATOR_MODE_LANG_PYTHON | GENERATOR_MODE_LANG_RUST,
 	GENERATOR_MODE_RADIO_FONT_SRC = GENERATOR_MODE_FONT | GENERATOR_MODE_SRC,
 	GENERATOR_MODE_RADIO_CUR_BAT_MER = GENERATOR_MODE_CURRENT | GENERATOR_MODE_BATCH | GENERATOR_MODE_MERGED,
+	GENERATOR_MODE_RADIO_SRC_CODEC = GENERATOR_MODE_SRC_CODEC_NONE | GENERATOR_MODE_SRC_CODEC_STB | GENERATOR_MODE_SRC_CODEC_LZ4,
 	
 	// for group's
 	
@@ -105,6 +114,9 @@ public:
 		const std::string& vFileName = "");
 
 private:
+	bool GenerateBatch(ProjectFile* vProjectFile,
+		const std::function<bool(std::shared_ptr<FontInfos>)>& vGenerateFontFunc);
+
 	bool GenerateCard_One(const std::string& vFilePathName, std::shared_ptr<FontInfos> vFontInfos,
 		const uint32_t& vGlyphHeight, const uint32_t& vMaxRows);
 	bool GenerateCard_Merged(const std::string& vFilePathName, ProjectFile* vProjectFile,
@@ -115,15 +127,25 @@ private:
 	void GenerateHeader_Merged(const std::string& vFilePathName, ProjectFile* vProjectFile,
 		std::string vFontBufferName = "", size_t vFontBufferSize = 0);*/
 	
+	// if vFontBuffer is set, the font is generated in it, and no file is written
 	bool GenerateFontFile_One(const std::string& vFilePathName, ProjectFile* vProjectFile,
-		std::shared_ptr<FontInfos> vFontInfos, const GenModeFlags& vFlags);
+		std::shared_ptr<FontInfos> vFontInfos, const GenModeFlags& vFlags,
+		std::vector<uint8_t>* vFontBuffer = nullptr);
 	bool GenerateFontFile_Merged(const std::string& vFilePathName, ProjectFile* vProjectFile,
-		const GenModeFlags& vFlags);
+		const GenModeFlags& vFlags, std::vector<uint8_t>* vFontBuffer = nullptr);
 	
 	bool GenerateSource_One(const std::string& vFilePathName, ProjectFile* vProjectFile,
 		std::shared_ptr<FontInfos> vFontInfos, const GenModeFlags& vFlags);
 	bool GenerateSource_Merged(const std::string& vFilePathName, ProjectFile* vProjectFile,
 		const GenModeFlags& vFlags);
+	std::string GenerateLinkedDatas(PathStruct vPathStruct, CompressCodecEnum vCodec,
+		const std::vector<uint8_t>& vFontDatas, const std::string& vPrefix,
+		std::string* vBufferName, size_t* vBufferSize, size_t* vDecompressedSize);
+
+public:
+	// the font datas embedded by the source generation, for measure the codecs
+	bool GetFontDatas_One(ProjectFile* vProjectFile, std::shared_ptr<FontInfos> vFontInfos,
+		std::vector<uint8_t>* vFontDatas);
 
 public: // singleton
 	static Generator *Instance()
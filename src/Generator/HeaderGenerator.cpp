@@ -29,7 +29,9 @@
 #include <ctools/FileHelper.h>
 #include <ctools/Logger.h>
 #include <Generator/FontGenerator.h>
+#include <Generator/LZ4Codec.h>
 #include <Helper/Messaging.h>
+#include <Helper/CommandLine.h>
 #include <Project/FontInfos.h>
 #include <Project/ProjectFile.h>
 
@@ -84,7 +86,45 @@ static std::string GetFooter(std::string vLang, std::string vPrefix)
 	return header;
 }
 
-static std::string GetFontInfos(std::string vLang, std::string vPrefix, std::string vFontFileName, std::string vFontBufferName, size_t vFontBufferSize)
+// the call for load the embedded font in ImGui, according to the codec
+static std::string GetFontLoadingCall(std::string vLang, std::string vPrefix, CompressCodecEnum vCodec, bool vLinkedDatas)
+{
+	std::string header;
+
+	if (vLang == "cpp" ||
+		vLang == "c")
+	{
+		const char* p = vPrefix.c_str();
+		if (vCodec == COMPRESS_CODEC_NONE)
+		{
+			header += "// load with (no decode and no copy, the buffer is static, so the atlas must not free it) :\n";
+			header += "// ImFontConfig cfg; cfg.FontDataOwnedByAtlas = false;\n";
+			header += ct::toStr("// ImGui::GetIO().Fonts->AddFontFromMemoryTTF((void*)FONT_ICON_BUFFER_NAME_%s, FONT_ICON_BUFFER_SIZE_%s, font_size, &cfg);\n", p, p);
+		}
+		else if (vCodec == COMPRESS_CODEC_LZ4)
+		{
+			header += "// load with (the atlas will free the decompressed datas) :\n";
+			header += ct::toStr("// void* datas = IM_ALLOC(FONT_ICON_BUFFER_DECOMPRESSED_SIZE_%s);\n", p);
+			header += ct::toStr("// FONT_ICON_BUFFER_DECOMPRESS_%s(datas);\n", p);
+			header += ct::toStr("// ImGui::GetIO().Fonts->AddFontFromMemoryTTF(datas, FONT_ICON_BUFFER_DECOMPRESSED_SIZE_%s, font_size);\n", p);
+		}
+		else if (vLinkedDatas) // binary stb datas, no base85
+		{
+			header += "// load with :\n";
+			header += ct::toStr("// ImGui::GetIO().Fonts->AddFontFromMemoryCompressedTTF(FONT_ICON_BUFFER_NAME_%s, FONT_ICON_BUFFER_SIZE_%s, font_size);\n", p, p);
+		}
+		else
+		{
+			header += "// load with :\n";
+			header += ct::toStr("// ImGui::GetIO().Fonts->AddFontFromMemoryCompressedBase85TTF(FONT_ICON_BUFFER_NAME_%s, font_size);\n", p);
+		}
+	}
+
+	return header;
+}
+
+static std::string GetFontInfos(std::string vLang, std::string vPrefix, std::string vFontFileName, std::string vFontBufferName, size_t vFontBufferSize,
+	CompressCodecEnum vCodec, size_t vFontDecompressedSize, bool vLinkedDatas)
 {
 	std::string header;
 
@@ -95,10 +135,23 @@ static std::string GetFontInfos(std::string vLang, std::string vPrefix, std::str
 		{
 			header += ct::toStr("#define FONT_ICON_BUFFER_NAME_%s %s\n", vPrefix.c_str(), vFontBufferName.c_str());
 			header += ct::toStr("#define FONT_ICON_BUFFER_SIZE_%s 0x%s\n", vPrefix.c_str(), ct::toHexStr(vFontBufferSize).c_str());
+			if (vCodec == COMPRESS_CODEC_LZ4)
+			{
+				header += ct::toStr("#define FONT_ICON_BUFFER_DECOMPRESSED_SIZE_%s 0x%s\n", vPrefix.c_str(), ct::toHexStr(vFontDecompressedSize).c_str());
+				header += ct::toStr("#define FONT_ICON_BUFFER_DECOMPRESS_%s(dst) %s(%s, FONT_ICON_BUFFER_SIZE_%s, (unsigned char*)(dst), FONT_ICON_BUFFER_DECOMPRESSED_SIZE_%s)\n",
+					vPrefix.c_str(), LZ4Codec::GetDecoderName(vPrefix).c_str(), vFontBufferName.c_str(), vPrefix.c_str(), vPrefix.c_str());
+			}
+			header += GetFontLoadingCall(vLang, vPrefix, vCodec, vLinkedDatas);
 		}
 		else if (vLang == "c#")
 		{
 			//header += ct::toStr("\t\tpublic const int FONT_ICON_ARRAY_SIZE = 0x%s;\n", ct::toHexStr(vFontBufferSize).c_str());
+			if (vCodec == COMPRESS_CODEC_LZ4)
+			{
+				header += ct::toStr("\t\tpublic const int FONT_ICON_BUFFER_DECOMPRESSED_SIZE = 0x%s;\n", ct::toHexStr(vFontDecompressedSize).c_str());
+				header += ct::toStr("\t\t// decompress with : byte[] datas = %s_Bytes.%s(%s_Bytes.%s, FONT_ICON_BUFFER_DECOMPRESSED_SIZE);\n",
+					vPrefix.c_str(), LZ4Codec::GetDecoderName(vPrefix).c_str(), vPrefix.c_str(), vFontBufferName.c_str());
+			}
 		}
 	}
 	else
@@ -164,11 +217,12 @@ static std::string GetGlyphItem(std::string vLang, std::string vType, std::strin
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-std::string HeaderGenerator::GenerateHeaderFile(std::string vLang, std::string vPrefix, std::string vFontFileName, std::string vFontBufferName, size_t vFontBufferSize)
+std::string HeaderGenerator::GenerateHeaderFile(std::string vLang, std::string vPrefix, std::string vFontFileName, std::string vFontBufferName, size_t vFontBufferSize,
+	CompressCodecEnum vCodec, size_t vFontDecompressedSize)
 {
 	std::string headerFile;
 	headerFile += GetHeader(vLang, vPrefix);
-	headerFile += GetFontInfos(vLang, vPrefix, vFontFileName, vFontBufferName, vFontBufferSize);
+	headerFile += GetFontInfos(vLang, vPrefix, vFontFileName, vFontBufferName, vFontBufferSize, vCodec, vFontDecompressedSize, m_LinkedDatas);
 	headerFile += GetGlyphTableMinMax(vLang, vPrefix, m_FinalCodePointRange);
 	for (const auto& it : m_FinalGlyphNames)
 	{
@@ -214,7 +268,9 @@ void HeaderGenerator::GenerateHeader_One(
 	ProjectFile* vProjectFile,
 	std::shared_ptr<FontInfos> vFontInfos,
 	std::string vFontBufferName, // for header generation wehn using a cpp bytes array instead of a file
-	size_t vFontBufferSize) // for header generation wehn using a cpp bytes array instead of a file
+	size_t vFontBufferSize, // for header generation wehn using a cpp bytes array instead of a file
+	CompressCodecEnum vCodec, // codec of the cpp bytes array
+	size_t vFontDecompressedSize) // size of the font datas, when the codec need it
 {
 	if (!vFilePathName.empty() && vFontInfos.use_count())
 	{
@@ -224,8 +280,8 @@ void HeaderGenerator::GenerateHeader_One(
 		{
 			std::map<std::string, uint32_t> glyphNames;
 			if (vFontInfos->m_SelectedGlyphs.empty()) // no glyph selected so generate for whole font
-				for (auto& it : vFontInfos->m_GlyphCodePointToName)
-					glyphNames[it.second] = it.first;
+				for (uint32_t slot = 0; slot < (uint32_t)vFontInfos->m_GlyphTable.size(); slot++)
+					glyphNames[vFontInfos->m_GlyphTable.GetName(slot)] = vFontInfos->m_GlyphTable.GetCodePoint(slot);
 			else
 				for (auto& it : vFontInfos->m_SelectedGlyphs)
 					if (it.second)
@@ -233,6 +289,7 @@ void HeaderGenerator::GenerateHeader_One(
 
 			m_FinalGlyphNames.clear();
 			m_FinalCodePointRange = ct::uvec2(65535, 0);
+			m_LinkedDatas = vProjectFile->IsGenMode(GENERATOR_MODE_SRC_SETTINGS_LINKED_DATAS);
 			for (const auto& it : glyphNames)
 			{
 				m_FinalCodePointRange.x = ct::mini(m_FinalCodePointRange.x, it.second);
@@ -267,7 +324,8 @@ void HeaderGenerator::GenerateHeader_One(
 				std::string headerFile = GenerateHeaderFile(
 					lang, vFontInfos->m_FontPrefix,
 					vFontInfos->m_FontFileName,
-					vFontBufferName, vFontBufferSize);
+					vFontBufferName, vFontBufferSize,
+					vCodec, vFontDecompressedSize);
 				FileHelper::Instance()->SaveStringToFile(headerFile, filePathName);
 				/////////////////////
 			}
@@ -276,7 +334,8 @@ void HeaderGenerator::GenerateHeader_One(
 				Messaging::Instance()->AddError(true, nullptr, nullptr, "Language not set for : %s", vFilePathName.c_str());
 			}
 
-			FileHelper::Instance()->OpenFile(filePathName);
+			if (!CommandLine::Instance()->IsHeadless())
+				FileHelper::Instance()->OpenFile(filePathName);
 		}
 		else
 		{
@@ -289,7 +348,9 @@ void HeaderGenerator::GenerateHeader_Merged(
 	const std::string& vFilePathName,
 	ProjectFile* vProjectFile,
 	std::string vFontBufferName, // for header generation wehn using a cpp bytes array instead of a file
-	size_t vFontBufferSize) // for header generation wehn using a cpp bytes array instead of a file
+	size_t vFontBufferSize, // for header generation wehn using a cpp bytes array instead of a file
+	CompressCodecEnum vCodec, // codec of the cpp bytes array
+	size_t vFontDecompressedSize) // size of the font datas, when the codec need it
 {
 	if (vProjectFile &&
 		!vFilePathName.empty() &&
@@ -312,6 +373,7 @@ void HeaderGenerator::GenerateHeader_Merged(
 					
 			m_FinalGlyphNames.clear();
 			m_FinalCodePointRange = ct::uvec2(65535, 0);
+			m_LinkedDatas = vProjectFile->IsGenMode(GENERATOR_MODE_SRC_SETTINGS_LINKED_DATAS);
 			for (const auto& it : glyphNames)
 			{
 				m_FinalCodePointRange.x = ct::mini(m_FinalCodePointRange.x, it.second);
@@ -346,7 +408,8 @@ void HeaderGenerator::GenerateHeader_Merged(
 				std::string headerFile = GenerateHeaderFile(
 					lang, vProjectFile->m_MergedFontPrefix,
 					ps.name + "." + ps.ext,
-					vFontBufferName, vFontBufferSize);
+					vFontBufferName, vFontBufferSize,
+					vCodec, vFontDecompressedSize);
 				FileHelper::Instance()->SaveStringToFile(headerFile, filePathName);
 				/////////////////////
 			}
@@ -355,7 +418,8 @@ void HeaderGenerator::GenerateHeader_Merged(
 				Messaging::Instance()->AddError(true, nullptr, nullptr, "Language not set for : %s", vFilePathName.c_str());
 			}
 
-			FileHelper::Instance()->OpenFile(filePathName);
+			if (!CommandLine::Instance()->IsHeadless())
+				FileHelper::Instance()->OpenFile(filePathName);
 		}
 		else
 		{
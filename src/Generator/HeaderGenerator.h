@@ -18,6 +18,8 @@
 #include <GLFW/glfw3.h>
 #include <ctools/cTools.h>
 
+#include <Generator/Compress.h>
+
 #include <stdint.h>
 #include <string>
 #include <memory>
@@ -29,14 +31,18 @@ class HeaderGenerator
 private:
 	std::map<std::string, uint32_t> m_FinalGlyphNames;
 	ct::uvec2 m_FinalCodePointRange = ct::uvec2(65535, 0);
+	bool m_LinkedDatas = false; // the font datas are linked (binary), not compiled from a literal
 
 public:
 	void GenerateHeader_One(const std::string& vFilePathName, ProjectFile* vProjectFile,
-		std::shared_ptr<FontInfos> vFontInfos, std::string vFontBufferName = "", size_t vFontBufferSize = 0);
+		std::shared_ptr<FontInfos> vFontInfos, std::string vFontBufferName = "", size_t vFontBufferSize = 0,
+		CompressCodecEnum vCodec = COMPRESS_CODEC_STB, size_t vFontDecompressedSize = 0);
 	void GenerateHeader_Merged(const std::string& vFilePathName, ProjectFile* vProjectFile,
-		std::string vFontBufferName = "", size_t vFontBufferSize = 0);
+		std::string vFontBufferName = "", size_t vFontBufferSize = 0,
+		CompressCodecEnum vCodec = COMPRESS_CODEC_STB, size_t vFontDecompressedSize = 0);
 
 private:
-	std::string GenerateHeaderFile(std::string vLang, std::string vPrefix, std::string vFontFileName, std::string vFontBufferName, size_t vFontBufferSize);
+	std::string GenerateHeaderFile(std::string vLang, std::string vPrefix, std::string vFontFileName, std::string vFontBufferName, size_t vFontBufferSize,
+		CompressCodecEnum vCodec, size_t vFontDecompressedSize);
 };
 
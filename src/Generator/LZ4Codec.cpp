@@ -0,0 +1,291 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "LZ4Codec.h"
+
+#include <ctools/cTools.h>
+
+#include <cstring>
+
+// format constants, see lz4_Block_format.md
+#define LZ4_MIN_MATCH 4U
+#define LZ4_LAST_LITERALS 5U // the last 5 bytes are always literals
+#define LZ4_MF_LIMIT 12U // the last match must start at least 12 bytes before the end
+#define LZ4_MAX_OFFSET 65535U
+#define LZ4_HASH_BITS 16U
+
+static uint32_t LZ4_Read32(const uint8_t* vPtr)
+{
+	uint32_t v = 0;
+	memcpy(&v, vPtr, sizeof(v));
+	return v;
+}
+
+static uint32_t LZ4_Hash(uint32_t vSequence)
+{
+	return (vSequence * 2654435761U) >> (32U - LZ4_HASH_BITS);
+}
+
+// length over 15 (or over 15 + 4 for the match), stored as 255 + 255 + ... + rest
+static void LZ4_WriteLength(std::vector<uint8_t>* vOut, size_t vLength)
+{
+	while (vLength >= 255U)
+	{
+		vOut->push_back(255U);
+		vLength -= 255U;
+	}
+	vOut->push_back((uint8_t)vLength);
+}
+
+// one sequence : token, literals, and the match if vMatchLength > 0 (the last sequence have no match)
+static void LZ4_WriteSequence(std::vector<uint8_t>* vOut,
+	const uint8_t* vLiterals, size_t vLiteralsLength,
+	size_t vOffset, size_t vMatchLength)
+{
+	uint8_t token = (uint8_t)(ct::mini<size_t>(vLiteralsLength, 15U) << 4);
+	if (vMatchLength)
+		token |= (uint8_t)ct::mini<size_t>(vMatchLength - LZ4_MIN_MATCH, 15U);
+	vOut->push_back(token);
+
+	if (vLiteralsLength >= 15U)
+		LZ4_WriteLength(vOut, vLiteralsLength - 15U);
+	vOut->insert(vOut->end(), vLiterals, vLiterals + vLiteralsLength);
+
+	if (vMatchLength)
+	{
+		vOut->push_back((uint8_t)(vOffset & 0xFF));
+		vOut->push_back((uint8_t)((vOffset >> 8) & 0xFF));
+		if (vMatchLength - LZ4_MIN_MATCH >= 15U)
+			LZ4_WriteLength(vOut, vMatchLength - LZ4_MIN_MATCH - 15U);
+	}
+}
+
+bool LZ4Codec::Compress(const uint8_t* vDatas, const size_t& vDatasSize, std::vector<uint8_t>* vCompressedDatas)
+{
+	if (!vDatas || !vCompressedDatas)
+		return false;
+
+	vCompressedDatas->clear();
+	vCompressedDatas->reserve(vDatasSize + vDatasSize / 255U + 16U); // worst case
+
+	std::vector<int64_t> hashTable((size_t)1U << LZ4_HASH_BITS, -1);
+
+	size_t anchor = 0U;
+	size_t pos = 0U;
+	if (vDatasSize > LZ4_MF_LIMIT)
+	{
+		const size_t matchStartLimit = vDatasSize - LZ4_MF_LIMIT;
+		const size_t matchEndLimit = vDatasSize - LZ4_LAST_LITERALS;
+		while (pos <= matchStartLimit)
+		{
+			const uint32_t sequence = LZ4_Read32(vDatas + pos);
+			const uint32_t hash = LZ4_Hash(sequence);
+			const int64_t ref = hashTable[hash];
+			hashTable[hash] = (int64_t)pos;
+
+			if (ref >= 0 &&
+				pos - (size_t)ref <= LZ4_MAX_OFFSET &&
+				LZ4_Read32(vDatas + ref) == sequence)
+			{
+				size_t matchLength = LZ4_MIN_MATCH;
+				while (pos + matchLength < matchEndLimit &&
+					vDatas[(size_t)ref + matchLength] == vDatas[pos + matchLength])
+					matchLength++;
+
+				LZ4_WriteSequence(vCompressedDatas, vDatas + anchor, pos - anchor, pos - (size_t)ref, matchLength);
+
+				pos += matchLength;
+				anchor = pos;
+			}
+			else
+			{
+				pos++;
+			}
+		}
+	}
+
+	// last literals
+	LZ4_WriteSequence(vCompressedDatas, vDatas + anchor, vDatasSize - anchor, 0U, 0U);
+
+	return true;
+}
+
+bool LZ4Codec::Decompress(const uint8_t* vCompressedDatas, const size_t& vCompressedDatasSize, uint8_t* vDatas, const size_t& vDatasSize)
+{
+	if (!vCompressedDatas || !vDatas)
+		return false;
+
+	size_t ip = 0U;
+	size_t op = 0U;
+	while (ip < vCompressedDatasSize)
+	{
+		const uint8_t token = vCompressedDatas[ip++];
+
+		// literals
+		size_t length = token >> 4;
+		if (length == 15U)
+		{
+			uint8_t b = 0U;
+			do
+			{
+				if (ip >= vCompressedDatasSize) return false;
+				b = vCompressedDatas[ip++];
+				length += b;
+			} while (b == 255U);
+		}
+		if (length > vCompressedDatasSize - ip || length > vDatasSize - op)
+			return false;
+		memcpy(vDatas + op, vCompressedDatas + ip, length);
+		ip += length;
+		op += length;
+
+		if (ip >= vCompressedDatasSize)
+			break; // last sequence, no match
+
+		// match
+		if (vCompressedDatasSize - ip < 2U)
+			return false;
+		const size_t offset = (size_t)vCompressedDatas[ip] | ((size_t)vCompressedDatas[ip + 1U] << 8);
+		ip += 2U;
+		if (offset == 0U || offset > op)
+			return false;
+
+		length = token & 15U;
+		if (length == 15U)
+		{
+			uint8_t b = 0U;
+			do
+			{
+				if (ip >= vCompressedDatasSize) return false;
+				b = vCompressedDatas[ip++];
+				length += b;
+			} while (b == 255U);
+		}
+		length += LZ4_MIN_MATCH;
+		if (length > vDatasSize - op)
+			return false;
+
+		// the match can overlap the output, so byte per byte
+		const uint8_t* match = vDatas + op - offset;
+		for (size_t i = 0; i < length; i++)
+			vDatas[op + i] = match[i];
+		op += length;
+	}
+
+	return (op == vDatasSize);
+}
+
+// same algo as Decompress, for the generated files
+std::string LZ4Codec::GetDecoderSource(const std::string& vLang, const std::string& vFuncName)
+{
+	std::string res;
+
+	if (vLang == "c" ||
+		vLang == "cpp")
+	{
+		res = R"(// lz4 block decoder, return the count of decompressed bytes, or -1 if the datas are corrupted
+static inline int FUNC_NAME(const unsigned char* src, int srcSize, unsigned char* dst, int dstSize)
+{
+	const unsigned char* ip = src;
+	const unsigned char* ipEnd = src + srcSize;
+	unsigned char* op = dst;
+	unsigned char* opEnd = dst + dstSize;
+	while (ip < ipEnd)
+	{
+		const unsigned char* match;
+		unsigned int token = *ip++;
+		unsigned int len = token >> 4;
+		unsigned int offset;
+		unsigned char b;
+		if (len == 15)
+		{
+			do { if (ip >= ipEnd) return -1; b = *ip++; len += b; } while (b == 255);
+		}
+		if ((unsigned int)(ipEnd - ip) < len || (unsigned int)(opEnd - op) < len) return -1;
+		while (len--) *op++ = *ip++;
+		if (ip >= ipEnd) break;
+		if (ipEnd - ip < 2) return -1;
+		offset = (unsigned int)ip[0] | ((unsigned int)ip[1] << 8);
+		ip += 2;
+		if (offset == 0 || (unsigned int)(op - dst) < offset) return -1;
+		match = op - offset;
+		len = token & 15;
+		if (len == 15)
+		{
+			do { if (ip >= ipEnd) return -1; b = *ip++; len += b; } while (b == 255);
+		}
+		len += 4;
+		if ((unsigned int)(opEnd - op) < len) return -1;
+		while (len--) *op++ = *match++;
+	}
+	return (int)(op - dst);
+}
+
+)";
+	}
+	else if (vLang == "c#")
+	{
+		res = R"(		// lz4 block decoder, return the decompressed datas, or null if the datas are corrupted
+		public static byte[] FUNC_NAME(IReadOnlyList<byte> src, int dstSize)
+		{
+			byte[] dst = new byte[dstSize];
+			int ip = 0, op = 0;
+			while (ip < src.Count)
+			{
+				int token = src[ip++];
+				int len = token >> 4;
+				int b;
+				if (len == 15)
+				{
+					do { if (ip >= src.Count) return null; b = src[ip++]; len += b; } while (b == 255);
+				}
+				if (src.Count - ip < len || dstSize - op < len) return null;
+				while (len-- > 0) dst[op++] = src[ip++];
+				if (ip >= src.Count) break;
+				if (src.Count - ip < 2) return null;
+				int offset = src[ip] | (src[ip + 1] << 8);
+				ip += 2;
+				if (offset == 0 || offset > op) return null;
+				len = token & 15;
+				if (len == 15)
+				{
+					do { if (ip >= src.Count) return null; b = src[ip++]; len += b; } while (b == 255);
+				}
+				len += 4;
+				if (dstSize - op < len) return null;
+				for (int i = 0; i < len; i++, op++) dst[op] = dst[op - offset];
+			}
+			return (op == dstSize) ? dst : null;
+		}
+
+)";
+	}
+
+	ct::replaceString(res, "FUNC_NAME", vFuncName);
+
+	return res;
+}
+
+std::string LZ4Codec::GetDecoderName(const std::string& vPrefix)
+{
+	std::string funcName = vPrefix + "_lz4_decompress";
+	ct::replaceString(funcName, "-", "_");
+	ct::replaceString(funcName, " ", "_");
+	return funcName;
+}
@@ -0,0 +1,41 @@
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/*
+minimal codec for the lz4 block format :
+https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md
+the compressor is a greedy one with one hash table (no frame, no checksum)
+the blocks can be decoded by the official lib too (LZ4_decompress_safe)
+the point is the decoding, very fast and tiny, so easy to embed in the generated sources
+*/
+
+class LZ4Codec
+{
+public:
+	static bool Compress(const uint8_t* vDatas, const size_t& vDatasSize, std::vector<uint8_t>* vCompressedDatas);
+	// vDatasSize is the exact size of the decompressed datas
+	static bool Decompress(const uint8_t* vCompressedDatas, const size_t& vCompressedDatasSize, uint8_t* vDatas, const size_t& vDatasSize);
+	// source of the decoder function for the generated files (c, cpp, c#)
+	static std::string GetDecoderSource(const std::string& vLang, const std::string& vFuncName);
+	// name of the decoder function, prefixed for can include many generated fonts in the same file
+	static std::string GetDecoderName(const std::string& vPrefix);
+};
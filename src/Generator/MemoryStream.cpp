@@ -30,6 +30,11 @@ MemoryStream::MemoryStream(uint8_t *vDatas, size_t vSize)
 
 MemoryStream::~MemoryStream() = default;
 
+void MemoryStream::Reserve(size_t vCountBytes)
+{
+	m_Datas.reserve(m_Datas.size() + vCountBytes);
+}
+
 void MemoryStream::WriteByte(uint8_t b)
 {
 	m_Datas.push_back(b);
@@ -45,16 +50,12 @@ void MemoryStream::WriteBytes(std::vector<uint8_t> *buffer)
 
 void MemoryStream::WriteInt(int32_t i)
 {
-	WriteByte((uint8_t)((i >> 24) & 0xff));
-	WriteByte((uint8_t)((i >> 16) & 0xff));
-	WriteByte((uint8_t)((i >> 8) & 0xff));
-	WriteByte((uint8_t)(i & 0xff));
+	Write<int32_t>(i);
 }
 
 void MemoryStream::WriteUShort(int32_t us)
 {
-	WriteByte((uint8_t)((us >> 8) & 0xff));
-	WriteByte((uint8_t)(us & 0xff));
+	Write<uint16_t>((uint16_t)us);
 }
 
 void MemoryStream::WriteFWord(int32_t us)
@@ -64,7 +65,7 @@ void MemoryStream::WriteFWord(int32_t us)
 
 void MemoryStream::WriteShort(int32_t s)
 {
-	WriteUShort(s);
+	Write<int16_t>((int16_t)s);
 }
 
 void MemoryStream::WriteUInt24(int32_t ui)
@@ -76,10 +77,7 @@ void MemoryStream::WriteUInt24(int32_t ui)
 
 void MemoryStream::WriteULong(int64_t ul)
 {
-	WriteByte((uint8_t)((ul >> 24) & 0xff));
-	WriteByte((uint8_t)((ul >> 16) & 0xff));
-	WriteByte((uint8_t)((ul >> 8) & 0xff));
-	WriteByte((uint8_t)(ul & 0xff));
+	Write<uint32_t>((uint32_t)ul);
 }
 
 void MemoryStream::WriteLong(int64_t l)
@@ -102,8 +100,7 @@ void MemoryStream::WriteF2DOT14(MemoryStream::F2DOT14 f)
 
 void MemoryStream::WriteDateTime(longDateTime date)
 {
-	WriteULong((date >> 32) & 0xffffffff);
-	WriteULong(date & 0xffffffff);
+	Write<int64_t>(date);
 }
 
 uint8_t* MemoryStream::Get()
@@ -113,6 +110,8 @@ uint8_t* MemoryStream::Get()
 
 size_t MemoryStream::Size()
 {
+	if (m_View)
+		return m_ViewSize;
 	return m_Datas.size();
 }
 
@@ -130,6 +129,9 @@ void MemoryStream::Set(uint8_t *vDatas, size_t vSize)
 {
 	if (vDatas && vSize)
 	{
+		m_View = nullptr;
+		m_ViewSize = 0;
+
 		m_Datas.clear();
 		m_Datas.resize(vSize);
 
@@ -137,8 +139,22 @@ void MemoryStream::Set(uint8_t *vDatas, size_t vSize)
 	}
 }
 
+void MemoryStream::SetView(const uint8_t* vDatas, size_t vSize)
+{
+	m_Datas.clear();
+	m_View = vDatas;
+	m_ViewSize = vDatas ? vSize : 0;
+	m_ReadPos = 0;
+}
+
 uint8_t MemoryStream::ReadByte()
 {
+	if (m_View)
+	{
+		if (m_ReadPos < m_ViewSize)
+			return m_View[m_ReadPos++];
+		return 0;
+	}
 	if (m_ReadPos < m_Datas.size())
 		return m_Datas[m_ReadPos++];
 	return 0;
@@ -203,7 +219,13 @@ MemoryStream::longDateTime MemoryStream::ReadDateTime()
 
 std::string MemoryStream::ReadString(size_t vLen)
 {
-	std::string res = std::string((char*)(m_Datas.data() + m_ReadPos), vLen);
+	std::string res;
+	const size_t size = Size();
+	if (m_ReadPos < size)
+	{
+		const uint8_t* datas = m_View ? m_View : m_Datas.data();
+		res = std::string((const char*)(datas + m_ReadPos), (vLen < size - m_ReadPos) ? vLen : size - m_ReadPos);
+	}
 	m_ReadPos += vLen;
 	return res;
 }
\ No newline at end of file
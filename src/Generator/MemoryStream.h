@@ -19,6 +19,7 @@
 #include <vector>
 #include <string>
 #include <cmath>
+#include <type_traits>
 
 class MemoryStream
 {
@@ -46,6 +47,33 @@ public:
 	MemoryStream(uint8_t *vDatas, size_t vSize);
 	~MemoryStream();
 
+	void Reserve(size_t vCountBytes); // room for vCountBytes more bytes, before a big write
+
+	// big endian, one resize per call
+	template<typename T> void Write(T vValue)
+	{
+		const size_t pos = m_Datas.size();
+		m_Datas.resize(pos + sizeof(T));
+		WriteBigEndian(m_Datas.data() + pos, vValue);
+	}
+
+	// big endian, one resize for the whole array
+	template<typename T> void WriteArray(const T* vValues, size_t vCount)
+	{
+		if (vValues && vCount)
+		{
+			const size_t pos = m_Datas.size();
+			m_Datas.resize(pos + sizeof(T) * vCount);
+			uint8_t* dst = m_Datas.data() + pos;
+			for (size_t i = 0; i < vCount; i++)
+				WriteBigEndian(dst + i * sizeof(T), vValues[i]);
+		}
+	}
+	template<typename T> void WriteArray(const std::vector<T>& vValues)
+	{
+		WriteArray(vValues.data(), vValues.size());
+	}
+
 	void WriteByte(uint8_t b);
 	void WriteBytes(std::vector<uint8_t> *buffer);
 	void WriteShort(int32_t i);
@@ -61,6 +89,7 @@ public:
 
 	uint8_t* Get();
 	void Set(uint8_t *vDatas, size_t vSize);
+	void SetView(const uint8_t* vDatas, size_t vSize); // read only, no copy, the datas must stay alive
 	
 	size_t Size();
 
@@ -80,8 +109,23 @@ public:
 	longDateTime ReadDateTime();
 	std::string ReadString(size_t vLen);
 
+private:
+	template<typename T> static void WriteBigEndian(uint8_t* vDst, T vValue)
+	{
+		static_assert(std::is_integral<T>::value, "MemoryStream : only integral types can be written");
+		typedef typename std::make_unsigned<T>::type UT;
+		UT value = (UT)vValue;
+		for (size_t i = sizeof(T); i > 0; i--)
+		{
+			vDst[i - 1] = (uint8_t)(value & 0xFF);
+			value = (UT)(value >> 8);
+		}
+	}
+
 private:
 	std::vector<uint8_t> m_Datas;
+	const uint8_t* m_View = nullptr; // read from here if set (SetView), else from m_Datas
+	size_t m_ViewSize = 0;
 	size_t m_ReadPos = 0;
 };
 
@@ -0,0 +1,248 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ObjectFileGenerator.h"
+
+#include <ctools/cTools.h>
+#include <ctools/FileHelper.h>
+#include <Generator/LZ4Codec.h>
+
+#include <cstdio>
+
+///////////////////////////////////////////////////////////////////////////////////
+//// UTILS ////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+std::string ObjectFileGenerator::GetSymbolName(const std::string& vPrefix)
+{
+	std::string symbolName = vPrefix + "_font_data";
+	ct::replaceString(symbolName, "-", "_");
+	ct::replaceString(symbolName, " ", "_");
+	return symbolName;
+}
+
+bool ObjectFileGenerator::WriteBinaryFile(const std::string& vFilePathName, const std::vector<uint8_t>& vDatas)
+{
+	bool res = false;
+
+	if (vFilePathName.empty() || vDatas.empty())
+		return res;
+
+	FILE* f = nullptr;
+#if defined(MSVC)
+	fopen_s(&f, vFilePathName.c_str(), "wb");
+#else
+	f = fopen(vFilePathName.c_str(), "wb");
+#endif
+	if (f)
+	{
+		res = (fwrite(vDatas.data(), 1, vDatas.size(), f) == vDatas.size());
+		fclose(f);
+	}
+
+	return res;
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+//// INCBIN ///////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+// gnu as syntax, the .S is passed to the c preprocessor by gcc / clang
+bool ObjectFileGenerator::WriteIncbinAsmFile(
+	const std::string& vFilePathName,
+	const std::string& vBinFileName,
+	const std::string& vSymbolName,
+	const size_t& vDatasSize)
+{
+	auto ps = FileHelper::Instance()->ParsePathFileName(vFilePathName);
+	if (!ps.isOk)
+		return false;
+
+	std::string code;
+	code += "/* font datas linked with .incbin, Generated with https://github.com/aiekick/ImGuiFontStudio\n";
+	code += ct::toStr("   assemble with gcc or clang : gcc -c %s.%s -Wa,-I<directory of %s> */\n\n",
+		ps.name.c_str(), ps.ext.c_str(), vBinFileName.c_str());
+	code += "#if defined(__APPLE__) || (defined(_WIN32) && !defined(_WIN64))\n";
+	code += "#define FONT_SYMBOL(x) _##x\n";
+	code += "#else\n";
+	code += "#define FONT_SYMBOL(x) x\n";
+	code += "#endif\n\n";
+	code += "#if defined(__APPLE__)\n";
+	code += "\t.const_data\n";
+	code += "#elif defined(_WIN32)\n";
+	code += "\t.section .rdata,\"dr\"\n";
+	code += "#else\n";
+	code += "\t.section .rodata\n";
+	code += "#endif\n\n";
+	code += ct::toStr("\t.global FONT_SYMBOL(%s)\n", vSymbolName.c_str());
+	code += "\t.balign 16\n";
+	code += ct::toStr("FONT_SYMBOL(%s):\n", vSymbolName.c_str());
+	code += ct::toStr("\t.incbin \"%s\"\n\n", vBinFileName.c_str());
+	code += ct::toStr("\t.global FONT_SYMBOL(%s_size)\n", vSymbolName.c_str());
+	code += "\t.balign 4\n";
+	code += ct::toStr("FONT_SYMBOL(%s_size):\n", vSymbolName.c_str());
+	code += ct::toStr("\t.int %u\n\n", (uint32_t)vDatasSize);
+	code += "#if defined(__ELF__)\n";
+	code += "\t.section .note.GNU-stack,\"\",%progbits\n";
+	code += "#endif\n";
+
+	FileHelper::Instance()->SaveStringToFile(code, vFilePathName);
+
+	return FileHelper::Instance()->IsFileExist(vFilePathName);
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+//// COFF /////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+static void PushU16(std::vector<uint8_t>* vOut, uint16_t v)
+{
+	vOut->push_back((uint8_t)(v & 0xFF));
+	vOut->push_back((uint8_t)((v >> 8) & 0xFF));
+}
+
+static void PushU32(std::vector<uint8_t>* vOut, uint32_t v)
+{
+	PushU16(vOut, (uint16_t)(v & 0xFFFF));
+	PushU16(vOut, (uint16_t)((v >> 16) & 0xFFFF));
+}
+
+// symbol with the name in the string table
+static void PushCoffSymbol(std::vector<uint8_t>* vOut, uint32_t vNameOffset, uint32_t vValue)
+{
+	PushU32(vOut, 0U); // name in string table
+	PushU32(vOut, vNameOffset);
+	PushU32(vOut, vValue);
+	PushU16(vOut, 1U); // section number (1-based)
+	PushU16(vOut, 0U); // type
+	vOut->push_back(2U); // IMAGE_SYM_CLASS_EXTERNAL
+	vOut->push_back(0U); // aux symbols count
+}
+
+// one .rdata section with the datas, then the size as uint32
+// two external symbols : vSymbolName and vSymbolName_size
+// x64 only, the x86 symbols would need a leading underscore
+bool ObjectFileGenerator::WriteCoffObjectFile(
+	const std::string& vFilePathName,
+	const std::vector<uint8_t>& vDatas,
+	const std::string& vSymbolName)
+{
+	if (vDatas.empty() || vSymbolName.empty())
+		return false;
+
+	const uint32_t headerSize = 20U;
+	const uint32_t sectionHeaderSize = 40U;
+	const uint32_t datasSize = (uint32_t)vDatas.size();
+	const uint32_t paddedDatasSize = (datasSize + 3U) & ~3U;
+	const uint32_t rawDatasSize = paddedDatasSize + 4U; // + size
+	const uint32_t rawDatasOffset = headerSize + sectionHeaderSize;
+	const uint32_t symbolTableOffset = rawDatasOffset + rawDatasSize;
+
+	const std::string sizeSymbolName = vSymbolName + "_size";
+
+	std::vector<uint8_t> obj;
+	obj.reserve(symbolTableOffset + 2U * 18U + 4U + vSymbolName.size() * 2U + 8U);
+
+	// file header
+	PushU16(&obj, 0x8664); // IMAGE_FILE_MACHINE_AMD64
+	PushU16(&obj, 1U); // sections count
+	PushU32(&obj, 0U); // time stamp
+	PushU32(&obj, symbolTableOffset);
+	PushU32(&obj, 2U); // symbols count
+	PushU16(&obj, 0U); // optional header size
+	PushU16(&obj, 0U); // characteristics
+
+	// section header
+	const char sectionName[8] = { '.', 'r', 'd', 'a', 't', 'a', 0, 0 };
+	obj.insert(obj.end(), sectionName, sectionName + 8);
+	PushU32(&obj, 0U); // virtual size
+	PushU32(&obj, 0U); // virtual address
+	PushU32(&obj, rawDatasSize);
+	PushU32(&obj, rawDatasOffset);
+	PushU32(&obj, 0U); // relocations offset
+	PushU32(&obj, 0U); // line numbers offset
+	PushU16(&obj, 0U); // relocations count
+	PushU16(&obj, 0U); // line numbers count
+	PushU32(&obj,
+		0x00000040U | // IMAGE_SCN_CNT_INITIALIZED_DATA
+		0x00500000U | // IMAGE_SCN_ALIGN_16BYTES
+		0x40000000U); // IMAGE_SCN_MEM_READ
+
+	// raw datas
+	obj.insert(obj.end(), vDatas.begin(), vDatas.end());
+	obj.resize(rawDatasOffset + paddedDatasSize, 0U);
+	PushU32(&obj, datasSize);
+
+	// symbols, the string table offsets start after his own size (4 bytes)
+	const uint32_t nameOffset = 4U;
+	const uint32_t sizeNameOffset = nameOffset + (uint32_t)vSymbolName.size() + 1U;
+	PushCoffSymbol(&obj, nameOffset, 0U);
+	PushCoffSymbol(&obj, sizeNameOffset, paddedDatasSize);
+
+	// string table
+	PushU32(&obj, sizeNameOffset + (uint32_t)sizeSymbolName.size() + 1U);
+	obj.insert(obj.end(), vSymbolName.begin(), vSymbolName.end());
+	obj.push_back(0U);
+	obj.insert(obj.end(), sizeSymbolName.begin(), sizeSymbolName.end());
+	obj.push_back(0U);
+
+	return WriteBinaryFile(vFilePathName, obj);
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+//// HEADER ///////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+std::string ObjectFileGenerator::GetExternHeader(
+	const std::string& vName,
+	const std::string& vPrefix,
+	const std::string& vSymbolName,
+	const size_t& vDatasSize,
+	CompressCodecEnum vCodec)
+{
+	std::string upperSymbolName = vSymbolName;
+	for (auto& c : upperSymbolName)
+		c = (char)toupper((int32_t)c);
+	std::string guard = upperSymbolName + "_LINKED_H";
+
+	std::string header;
+	header += "//Header Generated with https://github.com/aiekick/ImGuiFontStudio\n";
+	header += ct::toStr("//the font datas are in %s.bin, they are not compiled but linked :\n", vName.c_str());
+	header += ct::toStr("// - gcc / clang : assemble %s.S (gcc -c %s.S -Wa,-I<directory of %s.bin>)\n", vName.c_str(), vName.c_str(), vName.c_str());
+	header += ct::toStr("// - msvc x64 : add %s.obj to the linker inputs\n\n", vName.c_str());
+	header += ct::toStr("#ifndef %s\n", guard.c_str());
+	header += ct::toStr("#define %s\n\n", guard.c_str());
+	header += "#ifdef __cplusplus\n";
+	header += "extern \"C\" {\n";
+	header += "#endif\n";
+	header += ct::toStr("extern const unsigned char %s[];\n", vSymbolName.c_str());
+	header += ct::toStr("extern const unsigned int %s_size;\n", vSymbolName.c_str());
+	header += "#ifdef __cplusplus\n";
+	header += "}\n";
+	header += "#endif\n\n";
+	header += ct::toStr("#define %s_SIZE 0x%s // same as %s_size, but known at compile time\n\n",
+		upperSymbolName.c_str(), ct::toHexStr(vDatasSize).c_str(), vSymbolName.c_str());
+	if (vCodec == COMPRESS_CODEC_LZ4)
+	{
+		header += LZ4Codec::GetDecoderSource("c", LZ4Codec::GetDecoderName(vPrefix));
+	}
+	header += ct::toStr("#endif // %s\n", guard.c_str());
+
+	return header;
+}
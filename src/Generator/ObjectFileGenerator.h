@@ -0,0 +1,45 @@
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <Generator/Compress.h>
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/*
+the font datas are linked instead of compiled from a big literal :
+- <name>.bin : the font datas (compressed according to the codec)
+- <name>.S : .incbin stub for gcc / clang (elf, mach-o, mingw)
+- <name>.obj : coff object for msvc x64
+- a small header with the extern symbols, the size, and the decoder if the codec need it
+*/
+
+class ObjectFileGenerator
+{
+public:
+	static std::string GetSymbolName(const std::string& vPrefix);
+
+	static bool WriteBinaryFile(const std::string& vFilePathName, const std::vector<uint8_t>& vDatas);
+	static bool WriteIncbinAsmFile(const std::string& vFilePathName, const std::string& vBinFileName,
+		const std::string& vSymbolName, const size_t& vDatasSize);
+	static bool WriteCoffObjectFile(const std::string& vFilePathName, const std::vector<uint8_t>& vDatas,
+		const std::string& vSymbolName);
+
+	static std::string GetExternHeader(const std::string& vName, const std::string& vPrefix, const std::string& vSymbolName,
+		const size_t& vDatasSize, CompressCodecEnum vCodec);
+};
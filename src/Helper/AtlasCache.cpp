@@ -0,0 +1,605 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AtlasCache.h"
+
+#include <ctools/cTools.h>
+#include <ctools/FileHelper.h>
+#include <Project/FontInfos.h>
+
+#include <imgui/imgui.h>
+#include <imgui/imgui_internal.h> // ImFontAtlasBuildSetupFont
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <utility>
+#include <vector>
+
+// to increase when the entry format change, the old entries will be ignored
+#define ATLAS_CACHE_VERSION 2U
+#define ATLAS_CACHE_MAGIC 0x41534649U // 'IFSA'
+
+///////////////////////////////////////////////////////////////////////////////////
+//// STATIC ///////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+// fnv-1a 64
+static uint64_t HashBytes(const uint8_t* vDatas, size_t vSize, uint64_t vHash = 14695981039346656037ULL)
+{
+	for (size_t i = 0; i < vSize; i++)
+	{
+		vHash ^= vDatas[i];
+		vHash *= 1099511628211ULL;
+	}
+	return vHash;
+}
+
+// all the params who change the atlas
+static std::string GetAtlasParams(FontInfos* vFontInfos)
+{
+	std::string res = ct::toStr("v%u_imgui%i_size%i_over%i_rast%i_flags%u_mul%.4f_pad%i",
+		ATLAS_CACHE_VERSION, IMGUI_VERSION_NUM,
+		vFontInfos->m_FontSize,
+		vFontInfos->m_Oversample,
+		(int)vFontInfos->rasterizerMode,
+		(vFontInfos->rasterizerMode == RasterizerEnum::RASTERIZER_FREETYPE) ? vFontInfos->freeTypeFlag : 0U,
+		vFontInfos->fontMultiply,
+		vFontInfos->fontPadding);
+
+	// only the rasterized pages are in the atlas
+	if (vFontInfos->m_PagedRasterization)
+	{
+		res += ct::toStr("_pages%016llx", (unsigned long long)HashBytes(
+			(const uint8_t*)vFontInfos->m_PagedRanges.data(), vFontInfos->m_PagedRanges.size() * sizeof(ImWchar)));
+	}
+
+	return res;
+}
+
+class CacheWriter
+{
+public:
+	std::vector<uint8_t> m_Datas;
+
+public:
+	template<typename T>
+	void Write(const T& vValue)
+	{
+		WriteBlock(&vValue, sizeof(T));
+	}
+	void WriteBlock(const void* vDatas, size_t vSize)
+	{
+		if (vSize)
+		{
+			const size_t pos = m_Datas.size();
+			m_Datas.resize(pos + vSize);
+			memcpy(m_Datas.data() + pos, vDatas, vSize);
+		}
+	}
+	void WriteString(const std::string& vStr)
+	{
+		Write((uint32_t)vStr.size());
+		WriteBlock(vStr.data(), vStr.size());
+	}
+	template<typename T>
+	void WriteArray(const std::vector<T>& vArray)
+	{
+		Write((uint32_t)vArray.size());
+		WriteBlock(vArray.data(), vArray.size() * sizeof(T));
+	}
+};
+
+class CacheReader
+{
+public:
+	const uint8_t* m_Datas = nullptr;
+	size_t m_Size = 0U;
+	size_t m_Pos = 0U;
+	bool m_Ok = true; // false after the first read out of the datas
+
+public:
+	CacheReader(const std::vector<uint8_t>& vDatas)
+	{
+		m_Datas = vDatas.data();
+		m_Size = vDatas.size();
+	}
+	template<typename T>
+	T Read()
+	{
+		T v = T();
+		ReadBlock(&v, sizeof(T));
+		return v;
+	}
+	void ReadBlock(void* vDatas, size_t vSize)
+	{
+		if (m_Ok && vSize <= m_Size - m_Pos)
+		{
+			if (vSize)
+				memcpy(vDatas, m_Datas + m_Pos, vSize);
+			m_Pos += vSize;
+		}
+		else
+		{
+			m_Ok = false;
+		}
+	}
+	std::string ReadString()
+	{
+		std::string res;
+		const uint32_t len = Read<uint32_t>();
+		if (m_Ok && len <= m_Size - m_Pos)
+		{
+			res.assign((const char*)m_Datas + m_Pos, len);
+			m_Pos += len;
+		}
+		else
+		{
+			m_Ok = false;
+		}
+		return res;
+	}
+	template<typename T>
+	void ReadArray(std::vector<T>* vArray)
+	{
+		const uint32_t count = Read<uint32_t>();
+		if (m_Ok && count <= (m_Size - m_Pos) / sizeof(T))
+		{
+			vArray->resize(count);
+			ReadBlock(vArray->data(), count * sizeof(T));
+		}
+		else
+		{
+			m_Ok = false;
+		}
+	}
+};
+
+static bool ReadBinaryFile(const std::string& vFilePathName, std::vector<uint8_t>* vDatas)
+{
+	bool res = false;
+
+	FILE* f = nullptr;
+#if defined(MSVC)
+	fopen_s(&f, vFilePathName.c_str(), "rb");
+#else
+	f = fopen(vFilePathName.c_str(), "rb");
+#endif
+	if (f)
+	{
+		fseek(f, 0, SEEK_END);
+		const long size = ftell(f);
+		fseek(f, 0, SEEK_SET);
+		if (size > 0)
+		{
+			vDatas->resize((size_t)size);
+			res = (fread(vDatas->data(), 1, vDatas->size(), f) == vDatas->size());
+		}
+		fclose(f);
+	}
+
+	return res;
+}
+
+static bool WriteBinaryFile(const std::string& vFilePathName, const std::vector<uint8_t>& vDatas)
+{
+	bool res = false;
+
+	FILE* f = nullptr;
+#if defined(MSVC)
+	fopen_s(&f, vFilePathName.c_str(), "wb");
+#else
+	f = fopen(vFilePathName.c_str(), "wb");
+#endif
+	if (f)
+	{
+		res = (fwrite(vDatas.data(), 1, vDatas.size(), f) == vDatas.size());
+		fclose(f);
+	}
+
+	return res;
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+//// CTOR / DTOR //////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+AtlasCache::AtlasCache() = default;
+AtlasCache::~AtlasCache() = default;
+
+///////////////////////////////////////////////////////////////////////////////////
+//// PUBLIC ///////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+std::string AtlasCache::GetKey(FontInfos* vFontInfos)
+{
+	std::string res;
+
+	if (m_Enabled && vFontInfos &&
+		vFontInfos->m_ImFontAtlas.ConfigData.Size == 1 &&
+		vFontInfos->m_ImFontAtlas.Fonts.Size == 1)
+	{
+		const ImFontConfig& cfg = vFontInfos->m_ImFontAtlas.ConfigData[0];
+		if (cfg.FontData && cfg.FontDataSize > 0)
+		{
+			const std::string params = GetAtlasParams(vFontInfos);
+			const uint64_t fontHash = HashBytes((const uint8_t*)cfg.FontData, (size_t)cfg.FontDataSize);
+			const uint64_t paramsHash = HashBytes((const uint8_t*)params.data(), params.size());
+
+			char buffer[40];
+			snprintf(buffer, 40, "%016llx%016llx", (unsigned long long)fontHash, (unsigned long long)paramsHash);
+			res = buffer;
+		}
+	}
+
+	return res;
+}
+
+bool AtlasCache::Load(const std::string& vKey, FontInfos* vFontInfos)
+{
+	if (!m_Enabled || vKey.empty() || !vFontInfos)
+		return false;
+
+	ImFontAtlas* atlas = &vFontInfos->m_ImFontAtlas;
+	ImFont* font = vFontInfos->GetImFont();
+	if (!font || atlas->ConfigData.Size != 1)
+		return false;
+
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	LoadIndex();
+
+	auto it = m_Entries.find(vKey);
+	if (it == m_Entries.end())
+		return false;
+
+	std::vector<uint8_t> datas;
+	if (!ReadBinaryFile(GetEntryFilePathName(vKey), &datas))
+	{
+		RemoveEntry(vKey);
+		SaveIndex();
+		return false;
+	}
+
+	CacheReader reader(datas);
+
+	// header, the params are checked in case of hash collision
+	if (reader.Read<uint32_t>() != ATLAS_CACHE_MAGIC ||
+		reader.Read<uint32_t>() != ATLAS_CACHE_VERSION ||
+		reader.ReadString() != GetAtlasParams(vFontInfos) ||
+		reader.Read<uint64_t>() != (uint64_t)atlas->ConfigData[0].FontDataSize ||
+		!reader.m_Ok)
+	{
+		RemoveEntry(vKey);
+		SaveIndex();
+		return false;
+	}
+
+	// atlas
+	const int32_t texWidth = reader.Read<int32_t>();
+	const int32_t texHeight = reader.Read<int32_t>();
+	const uint8_t isRGBA32 = reader.Read<uint8_t>();
+	const ImVec2 texUvScale = reader.Read<ImVec2>();
+	const ImVec2 texUvWhitePixel = reader.Read<ImVec2>();
+	const size_t pixelsSize = (size_t)ct::maxi(texWidth, 0) * (size_t)ct::maxi(texHeight, 0) * (isRGBA32 ? 4U : 1U);
+	std::vector<uint8_t> pixels;
+	if (reader.m_Ok && pixelsSize <= reader.m_Size - reader.m_Pos)
+	{
+		pixels.resize(pixelsSize);
+		reader.ReadBlock(pixels.data(), pixelsSize);
+	}
+	else
+	{
+		reader.m_Ok = false;
+	}
+
+	// font
+	const float ascent = reader.Read<float>();
+	const float descent = reader.Read<float>();
+	const ImWchar fallbackChar = reader.Read<ImWchar>();
+	const ImWchar ellipsisChar = reader.Read<ImWchar>();
+	const uint32_t countGlyphs = reader.Read<uint32_t>();
+	std::vector<ImFontGlyph> glyphs;
+	if (reader.m_Ok && countGlyphs <= (reader.m_Size - reader.m_Pos) / sizeof(ImFontGlyph))
+	{
+		glyphs.resize(countGlyphs);
+		reader.ReadBlock(glyphs.data(), countGlyphs * sizeof(ImFontGlyph));
+	}
+	else
+	{
+		reader.m_Ok = false;
+	}
+
+	// glyph table, the arrays as blocks
+	GlyphTable glyphTable;
+	reader.ReadArray(&glyphTable.m_CodePoints);
+	reader.ReadArray(&glyphTable.m_GlyphIndexs);
+	reader.ReadArray(&glyphTable.m_NameOffsets);
+	reader.ReadArray(&glyphTable.m_Flags);
+	reader.ReadArray(&glyphTable.m_GlyphNameOffsets);
+	reader.ReadArray(&glyphTable.m_GlyphIndexToSlot);
+	glyphTable.m_NamesPool = reader.ReadString();
+	if (reader.m_Ok)
+	{
+		// the names are read by offset, so a broken entry must not be used
+		const size_t countSlots = glyphTable.m_CodePoints.size();
+		reader.m_Ok =
+			glyphTable.m_GlyphIndexs.size() == countSlots &&
+			glyphTable.m_NameOffsets.size() == countSlots &&
+			glyphTable.m_Flags.size() == countSlots &&
+			(glyphTable.m_NamesPool.empty() || glyphTable.m_NamesPool.back() == '\0');
+		for (auto offset : glyphTable.m_NameOffsets)
+			reader.m_Ok &= (offset < glyphTable.m_NamesPool.size());
+		for (auto slot : glyphTable.m_GlyphIndexToSlot)
+			reader.m_Ok &= (slot == GlyphTable::INVALID_SLOT || slot < countSlots);
+		reader.m_Ok &= (countSlots == 0U || !glyphTable.m_NamesPool.empty());
+	}
+
+	if (!reader.m_Ok || pixels.empty())
+	{
+		RemoveEntry(vKey);
+		SaveIndex();
+		return false;
+	}
+
+	// restore the atlas like if it was built
+	atlas->ClearTexData();
+	atlas->TexWidth = texWidth;
+	atlas->TexHeight = texHeight;
+	atlas->TexUvScale = texUvScale;
+	atlas->TexUvWhitePixel = texUvWhitePixel;
+	if (isRGBA32)
+	{
+		atlas->TexPixelsRGBA32 = (unsigned int*)IM_ALLOC(pixelsSize);
+		memcpy(atlas->TexPixelsRGBA32, pixels.data(), pixelsSize);
+	}
+	else
+	{
+		atlas->TexPixelsAlpha8 = (unsigned char*)IM_ALLOC(pixelsSize);
+		memcpy(atlas->TexPixelsAlpha8, pixels.data(), pixelsSize);
+	}
+
+	ImFontAtlasBuildSetupFont(atlas, font, &atlas->ConfigData[0], ascent, descent);
+	font->Glyphs.resize((int)glyphs.size());
+	if (!glyphs.empty())
+		memcpy(font->Glyphs.Data, glyphs.data(), glyphs.size() * sizeof(ImFontGlyph));
+	font->FallbackChar = fallbackChar;
+	font->BuildLookupTable();
+	font->EllipsisChar = ellipsisChar;
+
+	vFontInfos->m_GlyphTable = std::move(glyphTable);
+
+	it->second.lastUse = ++m_UseCounter;
+	SaveIndex();
+
+	return true;
+}
+
+bool AtlasCache::Save(const std::string& vKey, FontInfos* vFontInfos)
+{
+	if (!m_Enabled || vKey.empty() || !vFontInfos)
+		return false;
+
+	ImFontAtlas* atlas = &vFontInfos->m_ImFontAtlas;
+	ImFont* font = vFontInfos->GetImFont();
+	if (!font || !atlas->IsBuilt() || atlas->ConfigData.Size != 1)
+		return false;
+
+	// the texture creation add the rgba32 pixels to the alpha8, so alpha8 first, 4x smaller
+	const bool isRGBA32 = (atlas->TexPixelsAlpha8 == nullptr);
+	const size_t pixelsSize = (size_t)atlas->TexWidth * (size_t)atlas->TexHeight * (isRGBA32 ? 4U : 1U);
+
+	CacheWriter writer;
+	writer.m_Datas.reserve(pixelsSize + (size_t)font->Glyphs.size_in_bytes() +
+		vFontInfos->m_GlyphTable.GetMemorySize() + 1024U);
+
+	// header
+	writer.Write((uint32_t)ATLAS_CACHE_MAGIC);
+	writer.Write((uint32_t)ATLAS_CACHE_VERSION);
+	writer.WriteString(GetAtlasParams(vFontInfos));
+	writer.Write((uint64_t)atlas->ConfigData[0].FontDataSize);
+
+	// atlas
+	writer.Write((int32_t)atlas->TexWidth);
+	writer.Write((int32_t)atlas->TexHeight);
+	writer.Write((uint8_t)(isRGBA32 ? 1U : 0U));
+	writer.Write(atlas->TexUvScale);
+	writer.Write(atlas->TexUvWhitePixel);
+	if (isRGBA32)
+		writer.WriteBlock(atlas->TexPixelsRGBA32, pixelsSize);
+	else
+		writer.WriteBlock(atlas->TexPixelsAlpha8, pixelsSize);
+
+	// font
+	writer.Write(font->Ascent);
+	writer.Write(font->Descent);
+	writer.Write(font->FallbackChar);
+	writer.Write(font->EllipsisChar);
+	writer.Write((uint32_t)font->Glyphs.size());
+	writer.WriteBlock(font->Glyphs.Data, (size_t)font->Glyphs.size_in_bytes());
+
+	// glyph table
+	const GlyphTable& glyphTable = vFontInfos->m_GlyphTable;
+	writer.WriteArray(glyphTable.m_CodePoints);
+	writer.WriteArray(glyphTable.m_GlyphIndexs);
+	writer.WriteArray(glyphTable.m_NameOffsets);
+	writer.WriteArray(glyphTable.m_Flags);
+	writer.WriteArray(glyphTable.m_GlyphNameOffsets);
+	writer.WriteArray(glyphTable.m_GlyphIndexToSlot);
+	writer.WriteString(glyphTable.m_NamesPool);
+
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	LoadIndex();
+
+	FileHelper::Instance()->CreateDirectoryIfNotExist(m_CacheDir);
+	if (!WriteBinaryFile(GetEntryFilePathName(vKey), writer.m_Datas))
+		return false;
+
+	auto& entry = m_Entries[vKey];
+	entry.size = (uint64_t)writer.m_Datas.size();
+	entry.lastUse = ++m_UseCounter;
+
+	EvictEntries(vKey);
+	SaveIndex();
+
+	return true;
+}
+
+void AtlasCache::Clear()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	LoadIndex();
+
+	while (!m_Entries.empty())
+		RemoveEntry(m_Entries.begin()->first);
+	m_UseCounter = 0U;
+
+	SaveIndex();
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+//// PRIVATE //////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+std::string AtlasCache::GetEntryFilePathName(const std::string& vKey)
+{
+	return m_CacheDir + "/" + vKey + ".atlas";
+}
+
+std::string AtlasCache::GetIndexFilePathName()
+{
+	return m_CacheDir + "/atlas.index";
+}
+
+// one line per entry : key size lastUse
+// the first line is the use counter
+void AtlasCache::LoadIndex()
+{
+	if (m_IndexLoaded)
+		return;
+
+	m_IndexLoaded = true;
+	m_Entries.clear();
+	m_UseCounter = 0U;
+
+	std::ifstream file(GetIndexFilePathName());
+	if (file.is_open())
+	{
+		file >> m_UseCounter;
+
+		std::string key;
+		EntryInfos infos;
+		while (file >> key >> infos.size >> infos.lastUse)
+		{
+			// entries removed by hand are forgotten
+			if (FileHelper::Instance()->IsFileExist(GetEntryFilePathName(key)))
+			{
+				m_Entries[key] = infos;
+				m_UseCounter = ct::maxi(m_UseCounter, infos.lastUse);
+			}
+		}
+	}
+}
+
+void AtlasCache::SaveIndex()
+{
+	std::string index = ct::toStr("%llu\n", (unsigned long long)m_UseCounter);
+	for (const auto& it : m_Entries)
+	{
+		index += ct::toStr("%s %llu %llu\n", it.first.c_str(),
+			(unsigned long long)it.second.size, (unsigned long long)it.second.lastUse);
+	}
+
+	FileHelper::Instance()->CreateDirectoryIfNotExist(m_CacheDir);
+	FileHelper::Instance()->SaveStringToFile(index, GetIndexFilePathName());
+}
+
+void AtlasCache::RemoveEntry(const std::string& vKey)
+{
+	std::remove(GetEntryFilePathName(vKey).c_str());
+	m_Entries.erase(vKey);
+}
+
+// remove the less recently used entries until the cache size is under the limit
+void AtlasCache::EvictEntries(const std::string& vKeyToKeep)
+{
+	const uint64_t maxSize = (uint64_t)m_MaxSizeInMB * 1024U * 1024U;
+
+	uint64_t cacheSize = 0U;
+	for (const auto& it : m_Entries)
+		cacheSize += it.second.size;
+
+	while (cacheSize > maxSize)
+	{
+		auto oldest = m_Entries.end();
+		for (auto it = m_Entries.begin(); it != m_Entries.end(); ++it)
+		{
+			if (it->first == vKeyToKeep) continue;
+			if (oldest == m_Entries.end() || it->second.lastUse < oldest->second.lastUse)
+				oldest = it;
+		}
+
+		if (oldest == m_Entries.end())
+			break; // only the last entry stay, even if bigger than the limit
+
+		cacheSize -= oldest->second.size;
+		RemoveEntry(oldest->first);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+//// CONFIGURATION ////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+std::string AtlasCache::getXml(const std::string& vOffset, const std::string& vUserDatas)
+{
+	UNUSED(vUserDatas);
+
+	std::string str;
+
+	str += vOffset + "<atlascacheenabled>" + (m_Enabled ? "true" : "false") + "</atlascacheenabled>\n";
+	str += vOffset + "<atlascachemaxsize>" + ct::toStr(m_MaxSizeInMB) + "</atlascachemaxsize>\n";
+
+	return str;
+}
+
+bool AtlasCache::setFromXml(tinyxml2::XMLElement* vElem, tinyxml2::XMLElement* vParent, const std::string& vUserDatas)
+{
+	UNUSED(vUserDatas);
+
+	// The value of this child identifies the name of this element
+	std::string strName;
+	std::string strValue;
+	std::string strParentName;
+
+	strName = vElem->Value();
+	if (vElem->GetText())
+		strValue = vElem->GetText();
+	if (vParent != nullptr)
+		strParentName = vParent->Value();
+
+	if (strName == "atlascacheenabled")
+		m_Enabled = ct::ivariant(strValue).GetB();
+	else if (strName == "atlascachemaxsize")
+		m_MaxSizeInMB = (uint32_t)ct::maxi(ct::ivariant(strValue).GetI(), 0);
+
+	return true;
+}
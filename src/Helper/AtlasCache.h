@@ -0,0 +1,85 @@
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <ctools/ConfigAbstract.h>
+#include <tinyxml2/tinyxml2.h>
+
+#include <string>
+#include <map>
+#include <mutex>
+#include <cstdint>
+
+/*
+on disk cache of the built font atlas, for not rasterize again the fonts at each project opening
+the key is a hash of the font file content and of all the params used by the atlas build
+(size, oversample, rasterizer, freetype flags, multiply, padding)
+an entry contain the atlas pixels, the ImFontGlyph table and the glyph names / index maps
+when the cache size exceed m_MaxSizeInMB, the less recently used entries are removed
+the cache is in the "cache" dir, like the config.xml and imgui.ini files
+*/
+
+class FontInfos;
+class AtlasCache : public conf::ConfigAbstract
+{
+public:
+	bool m_Enabled = true;
+	uint32_t m_MaxSizeInMB = 256U;
+
+private:
+	struct EntryInfos
+	{
+		uint64_t size = 0U; // file size in bytes
+		uint64_t lastUse = 0U; // use counter, the smaller is the older
+	};
+
+	std::string m_CacheDir = "cache";
+	std::map<std::string, EntryInfos> m_Entries; // key, infos
+	uint64_t m_UseCounter = 0U;
+	bool m_IndexLoaded = false;
+	std::mutex m_Mutex;
+
+public:
+	std::string GetKey(FontInfos* vFontInfos); // empty if the atlas can't be cached
+	bool Load(const std::string& vKey, FontInfos* vFontInfos); // restore the atlas and the glyph maps
+	bool Save(const std::string& vKey, FontInfos* vFontInfos);
+	void Clear(); // remove all the entries
+
+public:
+	std::string getXml(const std::string& vOffset, const std::string& vUserDatas = "") override;
+	bool setFromXml(tinyxml2::XMLElement* vElem, tinyxml2::XMLElement* vParent, const std::string& vUserDatas = "") override;
+
+private:
+	std::string GetEntryFilePathName(const std::string& vKey);
+	std::string GetIndexFilePathName();
+	void LoadIndex();
+	void SaveIndex();
+	void RemoveEntry(const std::string& vKey);
+	void EvictEntries(const std::string& vKeyToKeep);
+
+public: // singleton
+	static AtlasCache* Instance()
+	{
+		static AtlasCache* _instance = new AtlasCache();
+		return _instance;
+	}
+
+protected:
+	AtlasCache(); // Prevent construction
+	AtlasCache(const AtlasCache&) {}; // Prevent construction by copying
+	AtlasCache& operator =(const AtlasCache&) { return *this; }; // Prevent assignment
+	~AtlasCache(); // Prevent unwanted destruction
+};
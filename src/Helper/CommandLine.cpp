@@ -0,0 +1,168 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CommandLine.h"
+
+#include <ctools/cTools.h>
+#include <ctools/FileHelper.h>
+#include <Generator/Generator.h>
+#include <Helper/Messaging.h>
+#include <Panes/ParamsPane.h>
+#include <Project/FontInfos.h>
+#include <Project/ProjectFile.h>
+
+#include <stdio.h>
+#include <string.h>
+
+CommandLine::CommandLine() = default;
+CommandLine::~CommandLine() = default;
+
+///////////////////////////////////////////////////////////////////////////////////
+//// PUBLIC ///////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+bool CommandLine::Parse(int argc, char** argv)
+{
+	m_ProjectFilePathName.clear();
+	m_OutputPath.clear();
+	m_BatchThreadsCount = -1;
+	m_Generate = false;
+	m_Validate = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--project") == 0 && i + 1 < argc)
+		{
+			m_ProjectFilePathName = argv[++i];
+		}
+		else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+		{
+			m_OutputPath = argv[++i];
+		}
+		else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+		{
+			m_BatchThreadsCount = ct::maxi(ct::ivariant(std::string(argv[++i])).GetI(), 0);
+		}
+		else if (strcmp(argv[i], "--generate") == 0)
+		{
+			m_Generate = true;
+		}
+		else if (strcmp(argv[i], "--validate") == 0)
+		{
+			m_Validate = true;
+		}
+		else if (strcmp(argv[i], "--help") == 0)
+		{
+			PrintUsage(argv[0]);
+			return false;
+		}
+		else
+		{
+			fprintf(stderr, "Unknown or incomplete argument : %s\n", argv[i]);
+			PrintUsage(argv[0]);
+			return false;
+		}
+	}
+
+	if (m_Generate && m_ProjectFilePathName.empty())
+	{
+		fprintf(stderr, "--generate need a project file (--project x.ifs)\n");
+		PrintUsage(argv[0]);
+		return false;
+	}
+
+	return true;
+}
+
+bool CommandLine::IsHeadless() const
+{
+	return m_Generate;
+}
+
+bool CommandLine::IsValidationNeeded() const
+{
+	return m_Validate;
+}
+
+int CommandLine::RunHeadlessGeneration()
+{
+	bool res = false;
+
+	ProjectFile projectFile;
+	if (projectFile.LoadAs(m_ProjectFilePathName))
+	{
+		// same as MainFrame::LoadProject, but the fonts are loaded without atlas and texture
+		for (auto it : projectFile.m_Fonts)
+		{
+			if (it.second)
+			{
+				std::string absPath = projectFile.GetAbsolutePath(it.second->m_FontFilePathName);
+				ParamsPane::Instance()->OpenFont(&projectFile, absPath, false);
+			}
+		}
+		projectFile.UpdateCountSelectedGlyphs();
+
+		if (m_BatchThreadsCount >= 0)
+			projectFile.m_BatchThreadsCount = (uint32_t)m_BatchThreadsCount;
+
+		if (projectFile.IsGenMode(GENERATOR_MODE_HEADER) ||
+			projectFile.IsGenMode(GENERATOR_MODE_CARD) ||
+			projectFile.IsGenMode(GENERATOR_MODE_FONT) ||
+			projectFile.IsGenMode(GENERATOR_MODE_SRC))
+		{
+			std::string outputPath = m_OutputPath;
+			if (outputPath.empty())
+				outputPath = projectFile.m_LastGeneratedPath;
+			outputPath = FileHelper::Instance()->CorrectSlashTypeForFilePathName(outputPath);
+			FileHelper::Instance()->CreateDirectoryIfNotExist(outputPath);
+
+			res = Generator::Instance()->Generate(&projectFile, outputPath);
+		}
+		else
+		{
+			Messaging::Instance()->AddError(true, nullptr, nullptr,
+				"No generation mode selected in project %s", m_ProjectFilePathName.c_str());
+		}
+	}
+	else
+	{
+		Messaging::Instance()->AddError(true, nullptr, nullptr,
+			"Can't load project %s", m_ProjectFilePathName.c_str());
+	}
+
+	Messaging::Instance()->PrintToConsole();
+
+	if (res && !Messaging::Instance()->HaveErrors())
+		return 0;
+	return 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+//// PRIVATE //////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+void CommandLine::PrintUsage(const char* vAppName)
+{
+	printf("Usage : %s [--project x.ifs --generate [--out dir] [--threads n] [--validate]]\n", vAppName);
+	printf("\t--project x.ifs : project file to load\n");
+	printf("\t--generate : run the generation mode saved in the project, without window (headless)\n");
+	printf("\t--out dir : directory of the generated files (default : last generated path of the project)\n");
+	printf("\t--threads n : count of threads for the batch mode, 0 for the count of cores (default : value of the project)\n");
+	printf("\t--validate : validate the generated fonts (table checksums, structure), exit code 1 if one is not valid\n");
+}
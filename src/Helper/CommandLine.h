@@ -0,0 +1,61 @@
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <string>
+#include <cstdint>
+
+/*
+command line usage :
+	ImGuiFontStudio --project x.ifs --generate [--out dir] [--threads n] [--validate]
+		load the project x.ifs and his fonts, then run the generation mode saved in the project
+		no window and no opengl context are created in this mode (headless)
+		--out : the directory where the files are generated, the last generated path of the project else
+		--threads : count of threads for the batch mode (0 = count of cores), the project value else
+		--validate : the generated fonts are validated (table checksums, structure), exit code 1 if one is not valid
+*/
+
+class CommandLine
+{
+private:
+	std::string m_ProjectFilePathName;
+	std::string m_OutputPath;
+	int32_t m_BatchThreadsCount = -1; // -1 => the value of the project is used
+	bool m_Generate = false;
+	bool m_Validate = false;
+
+public:
+	bool Parse(int argc, char** argv); // return false if the arguments are wrong
+	bool IsHeadless() const; // no window, no opengl calls
+	bool IsValidationNeeded() const; // the generated fonts must be validated
+	int RunHeadlessGeneration(); // return the exit code of the app
+
+private:
+	static void PrintUsage(const char* vAppName);
+
+public: // singleton
+	static CommandLine* Instance()
+	{
+		static CommandLine* _instance = new CommandLine();
+		return _instance;
+	}
+
+protected:
+	CommandLine(); // Prevent construction
+	CommandLine(const CommandLine&) {}; // Prevent construction by copying
+	CommandLine& operator =(const CommandLine&) { return *this; }; // Prevent assignment
+	~CommandLine(); // Prevent unwanted destruction
+};
@@ -0,0 +1,300 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FontDataService.h"
+
+#include <ctools/FileHelper.h>
+
+#include <sfntly/font_factory.h>
+#include <sfntly/port/memory_input_stream.h>
+
+#include <cstdio>
+
+#ifdef WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+///////////////////////////////////////////////////////
+//// FONT FILE DATAS //////////////////////////////////
+///////////////////////////////////////////////////////
+
+FontFileDatas::FontFileDatas() = default;
+
+FontFileDatas::~FontFileDatas()
+{
+	if (m_MappedView)
+	{
+#ifdef WIN32
+		UnmapViewOfFile(m_MappedView);
+#else
+		munmap(m_MappedView, m_Size);
+#endif
+		m_MappedView = nullptr;
+	}
+}
+
+sfntly::Ptr<sfntly::Font> FontFileDatas::GetFont()
+{
+	std::lock_guard<std::mutex> lock(m_FontMutex);
+
+	if (!m_FontParsed)
+	{
+		m_FontParsed = true; // one try only, a bad file will stay bad
+
+		if (m_Datas && m_Size)
+		{
+			sfntly::Ptr<sfntly::FontFactory> font_factory;
+			font_factory.Attach(sfntly::FontFactory::GetInstance());
+
+			// sfntly read the stream in his own tables, the datas are not modified
+			sfntly::MemoryInputStream input_stream;
+			if (input_stream.Attach(m_Datas, m_Size))
+			{
+				sfntly::FontArray fonts;
+				font_factory->LoadFonts(&input_stream, &fonts);
+				if (!fonts.empty())
+					m_Font = fonts[0]; // the first font of a collection, like before
+			}
+		}
+	}
+
+	return m_Font;
+}
+
+bool FontFileDatas::Load(const std::string& vFilePathName)
+{
+	m_FilePathName = vFilePathName;
+
+	if (!Map(vFilePathName))
+	{
+		// no map (network drive, special fs..), the file is read
+		m_ReadDatas = FileHelper::Instance()->LoadFileToBytes(vFilePathName);
+		m_Datas = m_ReadDatas.data();
+		m_Size = m_ReadDatas.size();
+	}
+
+	return m_Datas && m_Size;
+}
+
+bool FontFileDatas::Map(const std::string& vFilePathName)
+{
+#ifdef WIN32
+	// FILE_SHARE_DELETE, for not lock the file more than needed
+	HANDLE file = CreateFileA(vFilePathName.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+		nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file); // the mapping keep the file opened
+	if (!mapping)
+		return false;
+
+	void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping); // the view keep the mapping
+	if (!view)
+		return false;
+
+	m_MappedView = view;
+	m_Size = (size_t)fileSize.QuadPart;
+#else
+	int fd = open(vFilePathName.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size <= 0)
+	{
+		close(fd);
+		return false;
+	}
+
+	void* view = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd); // the map keep the file
+	if (view == MAP_FAILED)
+		return false;
+
+	m_MappedView = view;
+	m_Size = (size_t)st.st_size;
+#endif
+
+	m_Datas = (const uint8_t*)m_MappedView;
+
+	return true;
+}
+
+///////////////////////////////////////////////////////
+//// SERVICE //////////////////////////////////////////
+///////////////////////////////////////////////////////
+
+FontDataService::FontDataService() = default;
+FontDataService::~FontDataService() = default;
+
+std::shared_ptr<FontFileDatas> FontDataService::GetFontFileDatas(const std::string& vFilePathName)
+{
+	std::shared_ptr<FontFileDatas> res;
+
+	if (vFilePathName.empty())
+		return res;
+
+	std::string filePathName = FileHelper::Instance()->CorrectSlashTypeForFilePathName(vFilePathName);
+
+	int64_t fileSize = 0, fileTime = 0;
+	if (!GetFileStamp(filePathName, &fileSize, &fileTime))
+		return res;
+
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		res = GetValidFile(filePathName, fileSize, fileTime);
+		if (res)
+			return res;
+	}
+
+	// the read is done without lock, for not block the loading of the other fonts
+	auto datas = std::make_shared<FontFileDatas>();
+	if (datas->Load(filePathName))
+	{
+		datas->m_FileSize = fileSize;
+		datas->m_FileTime = fileTime;
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		res = GetValidFile(filePathName, fileSize, fileTime); // maybe read by another thread in the meantime
+		if (!res)
+		{
+			RemoveExpiredFiles();
+			m_Files[filePathName] = datas;
+			res = datas;
+		}
+	}
+
+	return res;
+}
+
+sfntly::Ptr<sfntly::Font> FontDataService::GetFont(const std::string& vFilePathName)
+{
+	auto datas = GetFontFileDatas(vFilePathName);
+	if (datas)
+		return datas->GetFont();
+	return sfntly::Ptr<sfntly::Font>();
+}
+
+bool FontDataService::ReplaceFontFile(const std::string& vTmpFilePathName, const std::string& vFilePathName)
+{
+	bool res = false;
+
+	if (vTmpFilePathName.empty() || vFilePathName.empty())
+		return res;
+
+#ifdef WIN32
+	res = (MoveFileExA(vTmpFilePathName.c_str(), vFilePathName.c_str(), MOVEFILE_REPLACE_EXISTING) != 0);
+	if (!res)
+	{
+		// a mapped file can't be replaced, but can be renamed (mapped with FILE_SHARE_DELETE)
+		// so it is moved away, and deleted when his last view will be unmapped
+		const std::string oldFilePathName = vFilePathName + ".old";
+		if (MoveFileExA(vFilePathName.c_str(), oldFilePathName.c_str(), MOVEFILE_REPLACE_EXISTING))
+		{
+			res = (MoveFileExA(vTmpFilePathName.c_str(), vFilePathName.c_str(), 0) != 0);
+			if (res)
+				DeleteFileA(oldFilePathName.c_str());
+			else
+				MoveFileExA(oldFilePathName.c_str(), vFilePathName.c_str(), 0); // restore
+		}
+	}
+#else
+	// the old file stay alive for the maps until munmap
+	res = (rename(vTmpFilePathName.c_str(), vFilePathName.c_str()) == 0);
+#endif
+
+	if (res)
+	{
+		// not wait the stamp check, the size and the time can be the same
+		std::string filePathName = FileHelper::Instance()->CorrectSlashTypeForFilePathName(vFilePathName);
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Files.erase(filePathName);
+	}
+
+	return res;
+}
+
+bool FontDataService::GetFileStamp(const std::string& vFilePathName, int64_t* vFileSize, int64_t* vFileTime)
+{
+	if (!vFileSize || !vFileTime)
+		return false;
+
+#ifdef WIN32
+	WIN32_FILE_ATTRIBUTE_DATA attribs;
+	if (!GetFileAttributesExA(vFilePathName.c_str(), GetFileExInfoStandard, &attribs))
+		return false;
+	*vFileSize = ((int64_t)attribs.nFileSizeHigh << 32) | (int64_t)attribs.nFileSizeLow;
+	*vFileTime = ((int64_t)attribs.ftLastWriteTime.dwHighDateTime << 32) | (int64_t)attribs.ftLastWriteTime.dwLowDateTime;
+#else
+	struct stat st;
+	if (stat(vFilePathName.c_str(), &st) != 0)
+		return false;
+	*vFileSize = (int64_t)st.st_size;
+	*vFileTime = (int64_t)st.st_mtime;
+#endif
+
+	return true;
+}
+
+// m_Mutex must be locked
+// a changed file is not returned, the current users keep the old datas
+std::shared_ptr<FontFileDatas> FontDataService::GetValidFile(const std::string& vFilePathName, int64_t vFileSize, int64_t vFileTime)
+{
+	auto it = m_Files.find(vFilePathName);
+	if (it != m_Files.end())
+	{
+		auto datas = it->second.lock();
+		if (datas && datas->m_FileSize == vFileSize && datas->m_FileTime == vFileTime)
+			return datas;
+	}
+	return nullptr;
+}
+
+// m_Mutex must be locked
+void FontDataService::RemoveExpiredFiles()
+{
+	for (auto it = m_Files.begin(); it != m_Files.end();)
+	{
+		if (it->second.expired())
+			it = m_Files.erase(it);
+		else
+			++it;
+	}
+}
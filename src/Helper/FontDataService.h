@@ -0,0 +1,107 @@
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+
+#include <sfntly/font.h>
+#include <sfntly/port/refcount.h>
+
+/*
+the font files shared by all the app, each file is read only once
+the file is mapped in memory (mmap / MapViewOfFile), or read if the map fail
+the same bytes are used by the atlas (FontDataOwnedByAtlas = false), the font structure pane and sfntly
+the sfntly font is parsed once per file, at the first need (glyph pane, generation)
+the service keep only weak refs, the datas are released when the last user is gone (the FontInfos in general)
+a file is read again if his size or his modif time was changed
+a mapped file must not be rewritten in place (SIGBUS on linux, sharing violation on windows),
+so the generated fonts are written in a temp file, then renamed over the old one by ReplaceFontFile
+*/
+
+class FontFileDatas
+{
+	friend class FontDataService;
+
+private:
+	std::string m_FilePathName;
+	const uint8_t* m_Datas = nullptr; // read only
+	size_t m_Size = 0U;
+	int64_t m_FileSize = 0; // for detect a change of the file
+	int64_t m_FileTime = 0;
+	void* m_MappedView = nullptr; // nullptr if read in m_ReadDatas
+	std::vector<uint8_t> m_ReadDatas; // if the map have failed
+
+	sfntly::Ptr<sfntly::Font> m_Font;
+	bool m_FontParsed = false;
+	std::mutex m_FontMutex;
+
+public:
+	FontFileDatas();
+	~FontFileDatas(); // unmap the file
+	FontFileDatas(const FontFileDatas&) = delete;
+	FontFileDatas& operator =(const FontFileDatas&) = delete;
+
+	const uint8_t* GetDatas() const { return m_Datas; }
+	size_t GetSize() const { return m_Size; }
+	const std::string& GetFilePathName() const { return m_FilePathName; }
+	sfntly::Ptr<sfntly::Font> GetFont(); // parsed at the first call, can be called by many threads
+
+private:
+	bool Load(const std::string& vFilePathName);
+	bool Map(const std::string& vFilePathName);
+};
+
+class FontDataService
+{
+private:
+	std::map<std::string, std::weak_ptr<FontFileDatas>> m_Files; // file path name, datas
+	std::mutex m_Mutex;
+
+public:
+	// the datas of the file, shared if already loaded, nullptr if the file can't be read
+	// can be called by the FontLoader threads
+	std::shared_ptr<FontFileDatas> GetFontFileDatas(const std::string& vFilePathName);
+	// the parsed sfntly font of the file, nullptr if the file can't be read or parsed
+	// sfntly have his own copy of the tables, but the parsing is shared only while the datas are used (FontInfos)
+	sfntly::Ptr<sfntly::Font> GetFont(const std::string& vFilePathName);
+	// rename vTmpFilePathName over vFilePathName, even if vFilePathName is mapped
+	// the current users keep the old datas, the next GetFontFileDatas read the new file
+	bool ReplaceFontFile(const std::string& vTmpFilePathName, const std::string& vFilePathName);
+
+private:
+	static bool GetFileStamp(const std::string& vFilePathName, int64_t* vFileSize, int64_t* vFileTime);
+	std::shared_ptr<FontFileDatas> GetValidFile(const std::string& vFilePathName, int64_t vFileSize, int64_t vFileTime);
+	void RemoveExpiredFiles();
+
+public: // singleton
+	static FontDataService* Instance()
+	{
+		static FontDataService* _instance = new FontDataService();
+		return _instance;
+	}
+
+protected:
+	FontDataService(); // Prevent construction
+	FontDataService(const FontDataService&) {}; // Prevent construction by copying
+	FontDataService& operator =(const FontDataService&) { return *this; }; // Prevent assignment
+	~FontDataService(); // Prevent unwanted destruction
+};
@@ -0,0 +1,287 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FontLoader.h"
+
+#include <ctools/cTools.h>
+#include <ctools/FileHelper.h>
+#include <Gui/ImGuiWidgets.h>
+#include <ImguiImpl/freetype/imgui_freetype.h>
+#include <Panes/ParamsPane.h>
+#include <Project/FontInfos.h>
+#include <Project/ProjectFile.h>
+
+#include <imgui/imgui.h>
+
+#include <chrono>
+#include <cstdlib>
+
+static const char* FontLoadingStageString[FONT_LOADING_STAGE_Count] =
+{
+	"Queued",
+	"Reading",
+	"Rasterizing",
+	"Glyph Names",
+	"Texture Upload"
+};
+
+// the default imgui allocators count the allocations in the imgui context, not thread safe
+// these ones are used by all the app since the first loading, the atlas build is done in the threads
+static void* ThreadSafeMemAlloc(size_t vSize, void* vUserDatas)
+{
+	(void)vUserDatas;
+	return malloc(vSize);
+}
+
+static void ThreadSafeMemFree(void* vPtr, void* vUserDatas)
+{
+	(void)vUserDatas;
+	free(vPtr);
+}
+
+FontLoader::FontLoader() = default;
+FontLoader::~FontLoader() = default;
+
+///////////////////////////////////////////////////////////////////////////////////
+//// LOADING //////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+bool FontLoader::LoadFont(ProjectFile* vProjectFile, const std::string& vFontFilePathName, bool vProjectChange)
+{
+	if (!vProjectFile || !vProjectFile->IsLoaded())
+		return false;
+
+	auto ps = FileHelper::Instance()->ParsePathFileName(vFontFilePathName);
+	if (!ps.isOk)
+		return false;
+
+	std::string fontName = ps.name + "." + ps.ext;
+
+	// already loading
+	for (const auto& job : m_Jobs)
+	{
+		if (job->fontName == fontName)
+			return false;
+	}
+
+	if (vProjectFile->m_Fonts.find(fontName) == vProjectFile->m_Fonts.end())
+	{
+		// create font 
+		vProjectFile->m_Fonts[fontName] = FontInfos::Create();
+	}
+
+	auto font = vProjectFile->m_Fonts[fontName];
+	if (!font)
+		return false;
+
+	// not found => stay in the project, for the file path resolve
+	std::string fontFilePathName = font->GetFontFilePathNameToLoad(vProjectFile, vFontFilePathName);
+	if (fontFilePathName.empty())
+		return false;
+
+	// hidden from the panes until the end of the loading
+	vProjectFile->m_Fonts.erase(fontName);
+	if (vProjectFile->m_SelectedFont == font)
+		vProjectFile->m_SelectedFont = nullptr;
+	font->m_IsLoading = true;
+
+	auto job = std::make_shared<FontLoadingJob>();
+	job->fontInfos = font;
+	job->fontName = fontName;
+	job->fontFilePathName = fontFilePathName;
+	job->projectChange = vProjectChange;
+	m_Jobs.push_back(job);
+
+	StartThreads();
+
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Queue.push_back(job);
+	}
+	m_QueueCondition.notify_one();
+
+	return true;
+}
+
+bool FontLoader::FinishLoadedFonts(ProjectFile* vProjectFile)
+{
+	bool res = false;
+
+	for (auto it = m_Jobs.begin(); it != m_Jobs.end();)
+	{
+		if ((*it)->done)
+		{
+			auto job = *it;
+			it = m_Jobs.erase(it);
+			res |= FinishFont(vProjectFile, job);
+		}
+		else
+		{
+			++it;
+		}
+	}
+
+	if (res)
+		vProjectFile->UpdateCountSelectedGlyphs();
+
+	return res;
+}
+
+void FontLoader::WaitAndFinishAll(ProjectFile* vProjectFile)
+{
+	while (IsLoading())
+	{
+		if (!FinishLoadedFonts(vProjectFile))
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+}
+
+bool FontLoader::IsLoading() const
+{
+	return !m_Jobs.empty();
+}
+
+void FontLoader::Cancel()
+{
+	// the running jobs keep their FontInfos alive until their end
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	m_Queue.clear();
+	m_Jobs.clear();
+}
+
+bool FontLoader::FinishFont(ProjectFile* vProjectFile, std::shared_ptr<FontLoadingJob> vJob)
+{
+	bool res = false;
+
+	if (vProjectFile && vJob && vJob->fontInfos)
+	{
+		Messaging::Instance()->AddCapturedMessages(vJob->messages);
+
+		auto font = vJob->fontInfos;
+		font->m_IsLoading = false;
+
+		const bool projectChanged = vProjectFile->IsThereAnyNotSavedChanged();
+
+		// back in the project, even if the loading failed, like the sync loading
+		vProjectFile->m_Fonts[vJob->fontName] = font;
+
+		if (font->FinishLoading(vProjectFile, vJob->fontFilePathName, vJob->success))
+		{
+			if (vProjectFile->m_FontToMergeIn.empty() ||
+				vProjectFile->m_FontToMergeIn == font->m_FontFileName)
+			{
+				ParamsPane::Instance()->SelectFont(vProjectFile, font);
+			}
+
+			res = true;
+		}
+
+		if (!vJob->projectChange)
+			vProjectFile->SetProjectChange(projectChanged);
+	}
+
+	return res;
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+//// THREADS //////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+void FontLoader::StartThreads()
+{
+	if (m_Threads.empty())
+	{
+		m_Quit = false;
+		// malloc / free like the default imgui allocators, so the blocks allocated before stay compatible
+		ImGui::SetAllocatorFunctions(ThreadSafeMemAlloc, ThreadSafeMemFree, nullptr);
+		const size_t countThreads = ct::maxi<size_t>((size_t)std::thread::hardware_concurrency(), 1U);
+		for (size_t i = 0U; i < countThreads; i++)
+		{
+			m_Threads.emplace_back(&FontLoader::ThreadLoop, this);
+		}
+	}
+}
+
+// the imgui allocators are called from these threads (atlas build), see ThreadSafeMemAlloc
+void FontLoader::ThreadLoop()
+{
+	// the loading threads are already one per core, so each one rasterize its atlas alone
+	// (else each atlas build start a thread per core, so cores * cores threads)
+	ImGuiFreeType::SetRasterizerThreadsCount(1);
+
+	while (true)
+	{
+		std::shared_ptr<FontLoadingJob> job;
+
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_QueueCondition.wait(lock, [this]() { return m_Quit || !m_Queue.empty(); });
+			if (m_Quit)
+				break;
+			job = m_Queue.front();
+			m_Queue.pop_front();
+		}
+
+		Messaging::Instance()->BeginThreadCapture(&job->messages);
+		job->success = job->fontInfos->LoadFontDatas(job->fontFilePathName, &job->stage);
+		Messaging::Instance()->EndThreadCapture();
+
+		job->done = true; // after success and messages, read by the main thread
+	}
+}
+
+void FontLoader::Unit()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Quit = true;
+		m_Queue.clear();
+	}
+	m_QueueCondition.notify_all();
+
+	for (auto& thread : m_Threads)
+	{
+		if (thread.joinable())
+			thread.join();
+	}
+	m_Threads.clear();
+	m_Jobs.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+//// DRAW /////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+void FontLoader::DrawProgress()
+{
+	if (m_Jobs.empty())
+		return;
+
+	ImGui::FramedGroupSeparator();
+
+	ImGui::FramedGroupText("Loading Fonts (%u)", (uint32_t)m_Jobs.size());
+
+	for (const auto& job : m_Jobs)
+	{
+		const int stage = ct::clamp<int>(job->stage, 0, FONT_LOADING_STAGE_Count - 1);
+		const float progress = (float)stage / (float)(FONT_LOADING_STAGE_Count - 1);
+		const std::string label = job->fontName + " : " + FontLoadingStageString[stage];
+		ImGui::ProgressBar(progress, ImVec2(-1.0f, 0.0f), label.c_str());
+	}
+}
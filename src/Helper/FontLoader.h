@@ -0,0 +1,89 @@
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <Helper/Messaging.h>
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+/*
+async loading of the fonts (open dialog, drop, project opening)
+the file reading, the atlas build and the glyph names are done by a pool of threads, many fonts at the same time
+the font is removed from ProjectFile::m_Fonts during his loading, so the panes never see it
+each frame, FinishLoadedFonts put back the loaded fonts in the project, and upload their textures (main thread, opengl)
+the messages of a font are captured by his thread and added when the font is finished
+the sync loading (FontInfos::LoadFont) is still used by the headless mode and the font params changes
+*/
+
+class ProjectFile;
+class FontInfos;
+class FontLoader
+{
+private:
+	struct FontLoadingJob
+	{
+		std::shared_ptr<FontInfos> fontInfos;
+		std::string fontName; // key in ProjectFile::m_Fonts
+		std::string fontFilePathName; // absolute
+		bool projectChange = true; // false for the project opening, the loading is not a change
+		std::atomic<int> stage; // FontLoadingStageEnum, written by the thread
+		std::atomic<bool> done;
+		bool success = false; // valid when done
+		Messaging::MessagesCapture messages; // valid when done
+		FontLoadingJob() : stage(0), done(false) {}
+	};
+
+	std::vector<std::shared_ptr<FontLoadingJob>> m_Jobs; // all the loadings, in the request order (main thread only)
+	std::deque<std::shared_ptr<FontLoadingJob>> m_Queue; // not started loadings (protected by m_Mutex)
+	std::vector<std::thread> m_Threads;
+	std::mutex m_Mutex;
+	std::condition_variable m_QueueCondition;
+	bool m_Quit = false;
+
+public:
+	bool LoadFont(ProjectFile* vProjectFile, const std::string& vFontFilePathName, bool vProjectChange = true);
+	bool FinishLoadedFonts(ProjectFile* vProjectFile); // each frame, return true if at least one font was finished
+	void WaitAndFinishAll(ProjectFile* vProjectFile); // blocking, for the project save and the generation
+	bool IsLoading() const;
+	void Cancel(); // project closed, the running loadings are dropped
+	void DrawProgress();
+	void Unit(); // join the threads
+
+private:
+	void StartThreads();
+	void ThreadLoop();
+	bool FinishFont(ProjectFile* vProjectFile, std::shared_ptr<FontLoadingJob> vJob);
+
+public: // singleton
+	static FontLoader* Instance()
+	{
+		static FontLoader* _instance = new FontLoader();
+		return _instance;
+	}
+
+protected:
+	FontLoader(); // Prevent construction
+	FontLoader(const FontLoader&) {}; // Prevent construction by copying
+	FontLoader& operator =(const FontLoader&) { return *this; }; // Prevent assignment
+	~FontLoader(); // Prevent unwanted destruction
+};
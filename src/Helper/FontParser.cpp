@@ -19,24 +19,74 @@
 
  
 #include "FontParser.h"
+#include <Helper/FontDataService.h>
+#include <Helper/Messaging.h>
 #include <ctools/FileHelper.h>
 #include <imgui/imgui.h>
 #include <ctools/cTools.h>
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <functional>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FONT_CHECKSUM_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define FONT_CHECKSUM_NEON
+#endif
+
 using namespace FontAnalyser;
 
+// only the visible lines of the array are drawn
+template<typename T, typename F>
+static void DisplayArrayLines(const std::vector<T>& vArray, F vDrawLine)
+{
+	ImGuiListClipper clipper;
+	clipper.Begin((int)vArray.size(), ImGui::GetTextLineHeightWithSpacing());
+	while (clipper.Step())
+	{
+		for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+		{
+			if (i < 0) continue;
+
+			vDrawLine((size_t)i, vArray[i]);
+		}
+	}
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
 void TableDisplay::AddItem(std::string vItem, std::string vSize, std::string vInfos)
 {
-	std::vector<std::string> arr;
-	arr.push_back(vItem);
-	arr.push_back(vSize);
-	arr.push_back(vInfos);
-	array.push_back(arr);
+	RowBlock block;
+	block.firstRow = m_CountRows;
+	block.countRows = 1U;
+	block.item = std::move(vItem);
+	block.size = std::move(vSize);
+	block.infos = std::move(vInfos);
+	m_RowBlocks.push_back(std::move(block));
+	m_CountRows++;
+}
+
+void TableDisplay::AddItems(size_t vCountRows, RowFormatter vFormatter)
+{
+	if (vCountRows && vFormatter)
+	{
+		RowBlock block;
+		block.firstRow = m_CountRows;
+		block.countRows = vCountRows;
+		block.formatter = vFormatter;
+		m_RowBlocks.push_back(std::move(block));
+		m_CountRows += vCountRows;
+	}
 }
+
 void TableDisplay::DisplayTable(const char* vTableLabel, size_t vMaxCount)
 {
 	ImGuiTableFlags flags = ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders;
@@ -55,25 +105,43 @@ void TableDisplay::DisplayTable(const char* vTableLabel, size_t vMaxCount)
 		ImGui::TableSetupColumn("Infos", ImGuiTableColumnFlags_WidthStretch, -1, 1);
 		ImGui::TableHeadersRow(); // draw headers
 
-		m_Clipper.Begin((int)array.size(), ImGui::GetTextLineHeightWithSpacing());
+		TableRow row;
+		m_Clipper.Begin((int)m_CountRows, ImGui::GetTextLineHeightWithSpacing());
 		while (m_Clipper.Step())
 		{
-			for (int i = m_Clipper.DisplayStart; i < m_Clipper.DisplayEnd; i++)
-			{
-				if (i < 0) continue;
+			if (m_Clipper.DisplayStart < 0) continue;
 
-				auto line = array[i];
+			// the visible rows are consecutive, so the block is searched once per step
+			auto blockIt = std::upper_bound(m_RowBlocks.begin(), m_RowBlocks.end(), (size_t)m_Clipper.DisplayStart,
+				[](size_t vRow, const RowBlock& vBlock) { return vRow < vBlock.firstRow; });
+			if (blockIt == m_RowBlocks.begin()) continue;
+			--blockIt;
 
-				ImGui::TableNextRow();
-				int idx = 0;
-				for (auto column : line)
+			for (size_t i = (size_t)m_Clipper.DisplayStart; i < (size_t)m_Clipper.DisplayEnd; i++)
+			{
+				while (blockIt != m_RowBlocks.end() && i >= blockIt->firstRow + blockIt->countRows)
+					++blockIt;
+				if (blockIt == m_RowBlocks.end())
+					break;
+
+				const char* item = blockIt->item.c_str();
+				const char* size = blockIt->size.c_str();
+				const char* infos = blockIt->infos.c_str();
+				if (blockIt->formatter)
 				{
-					if (idx > 2) break; //3 columns max
-					if (ImGui::TableSetColumnIndex(idx++))
-					{
-						ImGui::Text("%s", column.c_str());
-					}
+					row.item = "";
+					row.size = "";
+					row.infos[0] = '\0';
+					blockIt->formatter(this, i - blockIt->firstRow, &row);
+					item = row.item;
+					size = row.size;
+					infos = row.infos;
 				}
+
+				ImGui::TableNextRow();
+				if (ImGui::TableSetColumnIndex(0)) ImGui::TextUnformatted(item);
+				if (ImGui::TableSetColumnIndex(1)) ImGui::TextUnformatted(size);
+				if (ImGui::TableSetColumnIndex(2)) ImGui::TextUnformatted(infos);
 			}
 		}
 
@@ -81,6 +149,98 @@ void TableDisplay::DisplayTable(const char* vTableLabel, size_t vMaxCount)
 	}
 }
 
+void TableDisplay::AddError(const std::string& vError)
+{
+	m_Errors.push_back(vError);
+}
+
+void TableDisplay::AddErrors(const TableDisplay& vSubTable)
+{
+	m_Errors.insert(m_Errors.end(), vSubTable.m_Errors.begin(), vSubTable.m_Errors.end());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void LazyTableDisplay::SetLocation(MemoryStream* vMem, size_t vOffset, size_t vLength)
+{
+	m_Mem = vMem;
+	m_Offset = vOffset;
+	m_Length = vLength;
+	m_Decoded = false;
+}
+
+void LazyTableDisplay::Decode()
+{
+	Decode(m_Mem);
+}
+
+void LazyTableDisplay::Decode(MemoryStream* vMem)
+{
+	if (!m_Decoded && m_Mem && vMem)
+	{
+		m_Decoded = true; // before the parse, a table can decode his dependencies
+		parse(vMem, m_Offset, m_Length);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+static uint32_t ReadBigEndianUInt32(const uint8_t* vDatas)
+{
+	return ((uint32_t)vDatas[0] << 24) | ((uint32_t)vDatas[1] << 16) | ((uint32_t)vDatas[2] << 8) | (uint32_t)vDatas[3];
+}
+
+uint32_t FontAnalyser::ComputeChecksum(const uint8_t* vDatas, size_t vSize)
+{
+	uint32_t sum = 0U;
+
+	if (!vDatas)
+		return sum;
+
+	size_t i = 0U;
+
+#if defined(FONT_CHECKSUM_SSE2)
+	// sse2 have no byte shuffle, the bytes are swapped by 16 bits, then the 16 bits by 32 bits
+	__m128i acc = _mm_setzero_si128();
+	for (; i + 16U <= vSize; i += 16U)
+	{
+		__m128i v = _mm_loadu_si128((const __m128i*)(vDatas + i));
+		v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+		v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0xB1), 0xB1);
+		acc = _mm_add_epi32(acc, v); // modulo 2^32 per lane, like the spec sum
+	}
+	uint32_t lanes[4];
+	_mm_storeu_si128((__m128i*)lanes, acc);
+	sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#elif defined(FONT_CHECKSUM_NEON)
+	uint32x4_t acc = vdupq_n_u32(0U);
+	for (; i + 16U <= vSize; i += 16U)
+	{
+		acc = vaddq_u32(acc, vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(vDatas + i))));
+	}
+	sum = vgetq_lane_u32(acc, 0) + vgetq_lane_u32(acc, 1) + vgetq_lane_u32(acc, 2) + vgetq_lane_u32(acc, 3);
+#endif
+
+	for (; i + 4U <= vSize; i += 4U)
+	{
+		sum += ReadBigEndianUInt32(vDatas + i);
+	}
+
+	if (i < vSize) // last word, padded with zeros
+	{
+		uint8_t last[4] = {};
+		for (size_t j = 0U; i + j < vSize; j++)
+			last[j] = vDatas[i + j];
+		sum += ReadBigEndianUInt32(last);
+	}
+
+	return sum;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -241,22 +401,41 @@ void FontAnalyser::nameTableV0Struct::parse(MemoryStream* vMem, size_t vOffset,
 		count = (uint16_t)vMem->ReadUShort();
 		storageOffset = (uint16_t)vMem->ReadUShort();
 
-		nameRecords.resize(count);
-		for (size_t i = 0; i < count; i++)
+		// the records, in the table only
+		size_t countRecords = count;
+		if (4U + NameRecord().GetSizeof() * countRecords > vLength)
+		{
+			countRecords = (vLength > 4U) ? (vLength - 4U) / NameRecord().GetSizeof() : 0U;
+			AddError(ct::toStr("%u name records, %u in the table", (uint32_t)count, (uint32_t)countRecords));
+		}
+
+		nameRecords.resize(countRecords);
+		for (size_t i = 0; i < countRecords; i++)
 		{
 			NameRecord nr;
 			nr.parse(vMem, vOffset + 4U + nr.GetSizeof() * i, nr.GetSizeof());
 			nameRecords[i] = nr;
 		}
 
+		size_t countBadStrings = 0U;
 		for (auto& nr : nameRecords)
 		{
 			if (nr.length)
 			{
+				// storageOffset et stringOffset sont depuis le debut de la table, il y a le champ version avant vOffset
+				if ((size_t)storageOffset + nr.stringOffset + nr.length > vLength + 2U)
+				{
+					countBadStrings++;
+					continue;
+				}
 				vMem->SetPos(vOffset - 2U + storageOffset + nr.stringOffset); // -2U car storageOffset est depuis le debut de la table, et il a le champ version qui dans nametable
 				nr.name = vMem->ReadString(nr.length);
 			}
 		}
+		if (countBadStrings)
+		{
+			AddError(ct::toStr("%u name strings out of the table", (uint32_t)countBadStrings));
+		}
 
 		AddItem("count", "(2 bytes)", ct::toStr("%u", count));
 		AddItem("storageOffset", "(2 bytes)", ct::toStr("%u", storageOffset));
@@ -327,6 +506,8 @@ int FontAnalyser::nameTableStruct::draw(int vWidgetId)
 
 	if (ImGui::TreeNode("name Table :"))
 	{
+		Decode();
+
 		DisplayTable("name Table");
 
 		if (version == 0)
@@ -354,15 +535,25 @@ void FontAnalyser::nameTableStruct::parse(MemoryStream* vMem, size_t vOffset, si
 	{
 		vMem->SetPos(vOffset);
 
+		if (vLength < 6U)
+		{
+			AddError(ct::toStr("length %u, less than the header", (uint32_t)vLength));
+			return;
+		}
+
 		version = (uint16_t)vMem->ReadUShort(); // 2U
 
 		if (version == 0)
 		{
 			nameTableV0.parse(vMem, vOffset + 2U, vLength - 2U);
+			AddErrors(nameTableV0);
 		}
 		else
 		{
+			if (version > 1)
+				AddError(ct::toStr("unknown version %u", (uint32_t)version));
 			nameTableV1.parse(vMem, vOffset + 2U, vLength - 2U);
+			AddErrors(nameTableV1);
 		}
 
 		AddItem("version", "(2 bytes)", ct::toStr("%u", version));
@@ -379,6 +570,8 @@ int FontAnalyser::maxpTableStruct::draw(int vWidgetId)
 
 	if (ImGui::TreeNode("maxp Table :"))
 	{
+		Decode();
+
 		DisplayTable("maxp Table");
 
 		ImGui::TreePop();
@@ -441,6 +634,8 @@ int FontAnalyser::locaTableStruct::draw(int vWidgetId)
 
 	if (ImGui::TreeNode("loca Table :"))
 	{
+		Decode();
+
 		DisplayTable("loca Table", 20);
 
 		ImGui::TreePop();
@@ -453,41 +648,45 @@ int FontAnalyser::locaTableStruct::draw(int vWidgetId)
 	return vWidgetId;
 }
 
-void FontAnalyser::locaTableStruct::parse(MemoryStream* vMem, size_t vOffset, size_t /*vLength*/)
+// numGlyphs + 1 offsets, the last one is the end of the last glyf
+// but not more than the table can contain
+void FontAnalyser::locaTableStruct::parse(MemoryStream* vMem, size_t vOffset, size_t vLength)
 {
 	if (vMem && head && maxp)
 	{
+		// needed for the format and the count, before the SetPos
+		head->Decode();
+		maxp->Decode();
+
 		vMem->SetPos(vOffset);
 
+		const size_t countOffsets = (size_t)maxp->numGlyphs + 1U;
 		if (head->indexToLocFormat == 0) // short format
 		{
-			for (int i = 0; i < maxp->numGlyphs; i++)
+			const size_t count = ct::mini<size_t>(countOffsets, vLength / 2U);
+			offsets.reserve(count);
+			for (size_t i = 0; i < count; i++)
 			{
 				offsets.push_back(((uint32_t)vMem->ReadUShort()) * 2);
 			}
 		}
 		else if (head->indexToLocFormat == 1) // long format
 		{
-			for (int i = 0; i < maxp->numGlyphs; i++)
+			const size_t count = ct::mini<size_t>(countOffsets, vLength / 4U);
+			offsets.reserve(count);
+			for (size_t i = 0; i < count; i++)
 			{
 				offsets.push_back((uint32_t)vMem->ReadULong());
 			}
 		}
 
-		if (head->indexToLocFormat == 0) // short format
-		{
-			for (auto& it : offsets)
-			{
-				AddItem("offsets", "(2 bytes)", ct::toStr("%hu", it));
-			}
-		}
-		else if (head->indexToLocFormat == 1) // long format
+		AddItems(offsets.size(), [](const TableDisplay* vTable, size_t vIdx, TableRow* vRow)
 		{
-			for (auto& it : offsets)
-			{
-				AddItem("offsets", "(4 bytes)", ct::toStr("%u", it));
-			}
-		}
+			auto loca = static_cast<const locaTableStruct*>(vTable);
+			vRow->item = "offsets";
+			vRow->size = (loca->head->indexToLocFormat == 0) ? "(2 bytes)" : "(4 bytes)";
+			snprintf(vRow->infos, sizeof(vRow->infos), "%u", loca->offsets[vIdx]);
+		});
 	}
 }
 
@@ -575,6 +774,8 @@ int FontAnalyser::colrTableStruct::draw(int vWidgetId)
 
 	if (ImGui::TreeNode("COLR Table :"))
 	{
+		Decode();
+
 		DisplayTable("COLR Table");
 
 		if (ImGui::TreeNode("Glyph Records :", "Glyph Records : %u", numBaseGlyphRecords))
@@ -629,10 +830,14 @@ int FontAnalyser::colrTableStruct::draw(int vWidgetId)
 
 void FontAnalyser::colrTableStruct::parse(MemoryStream* vMem, size_t vOffset, size_t vLength)
 {
-	UNUSED(vLength);
-
 	if (vMem)
 	{
+		if (vLength < 14U)
+		{
+			AddError(ct::toStr("length %u, less than the header", (uint32_t)vLength));
+			return;
+		}
+
 		vMem->SetPos(vOffset);
 
 		version = (uint16_t)vMem->ReadUShort();
@@ -647,6 +852,18 @@ void FontAnalyser::colrTableStruct::parse(MemoryStream* vMem, size_t vOffset, si
 		AddItem("layerRecordsOffset", "(4 bytes)", ct::toStr("%hu", layerRecordsOffset));
 		AddItem("numLayerRecords", "(2 bytes)", ct::toStr("%hu", numLayerRecords));
 
+		// the records, in the table only
+		if ((size_t)baseGlyphRecordsOffset + 6U * numBaseGlyphRecords > vLength)
+		{
+			AddError(ct::toStr("%u base glyph records out of the table", (uint32_t)numBaseGlyphRecords));
+			numBaseGlyphRecords = 0;
+		}
+		if ((size_t)layerRecordsOffset + 4U * numLayerRecords > vLength)
+		{
+			AddError(ct::toStr("%u layer records out of the table", (uint32_t)numLayerRecords));
+			numLayerRecords = 0;
+		}
+
 		for (int i = 0; i < numBaseGlyphRecords; i++)
 		{
 			baseGlyphRecordStruct base;
@@ -660,6 +877,17 @@ void FontAnalyser::colrTableStruct::parse(MemoryStream* vMem, size_t vOffset, si
 			layer.parse(vMem, vOffset + layerRecordsOffset + layer.GetSizeof() * i, layer.GetSizeof());
 			layerRecords.push_back(layer);
 		}
+
+		size_t countBadBases = 0U;
+		for (const auto& base : baseGlyphRecords)
+		{
+			if ((size_t)base.firstLayerIndex + base.numLayers > numLayerRecords)
+				countBadBases++;
+		}
+		if (countBadBases)
+		{
+			AddError(ct::toStr("%u base glyph records with layers out of the layer records", (uint32_t)countBadBases));
+		}
 	}
 }
 
@@ -756,10 +984,14 @@ int cpalTableV0Struct::draw(int vWidgetId)
 
 void cpalTableV0Struct::parse(MemoryStream* vMem, size_t vOffset, size_t vLength)
 {
-	UNUSED(vLength);
-
 	if (vMem)
 	{
+		if (vLength < 10U)
+		{
+			AddError(ct::toStr("length %u, less than the header", (uint32_t)vLength + 2U));
+			return;
+		}
+
 		vMem->SetPos(vOffset);
 
 		numPaletteEntries = (uint16_t)vMem->ReadUShort();
@@ -772,6 +1004,18 @@ void cpalTableV0Struct::parse(MemoryStream* vMem, size_t vOffset, size_t vLength
 		AddItem("numColorRecords", "(4 bytes)", ct::toStr("%hu", numColorRecords));
 		AddItem("colorRecordsArrayOffset", "(4 bytes)", ct::toStr("%hu", colorRecordsArrayOffset));
 		
+		// the offsets are from the table start, -2U car il y a version avant vOffset
+		if (10U + 2U * (size_t)numPalettes > vLength)
+		{
+			AddError(ct::toStr("%u palettes out of the table", (uint32_t)numPalettes));
+			numPalettes = 0;
+		}
+		if ((size_t)colorRecordsArrayOffset + 4U * numColorRecords > vLength + 2U)
+		{
+			AddError(ct::toStr("%u color records out of the table", (uint32_t)numColorRecords));
+			numPalettes = 0;
+		}
+
 		colorRecordIndices.resize(numPalettes);
 		palettes.resize(numPalettes);
 		
@@ -780,8 +1024,15 @@ void cpalTableV0Struct::parse(MemoryStream* vMem, size_t vOffset, size_t vLength
 			colorRecordIndices[paletteIndex] = (uint16_t)vMem->ReadUShort();
 		}
 
+		size_t countBadPalettes = 0U;
 		for (int paletteIndex = 0; paletteIndex < numPalettes; paletteIndex++)
 		{
+			if ((size_t)colorRecordIndices[paletteIndex] + numPaletteEntries > numColorRecords)
+			{
+				countBadPalettes++;
+				continue;
+			}
+
 			for (int paletteEntryIndex = 0; paletteEntryIndex < numPaletteEntries; paletteEntryIndex++)
 			{
 				colorRecordStruct col;
@@ -792,6 +1043,10 @@ void cpalTableV0Struct::parse(MemoryStream* vMem, size_t vOffset, size_t vLength
 				palettes[paletteIndex].colorRecords.push_back(col);
 			}
 		}
+		if (countBadPalettes)
+		{
+			AddError(ct::toStr("%u palettes with entries out of the color records", (uint32_t)countBadPalettes));
+		}
 	}
 }
 
@@ -817,10 +1072,14 @@ int cpalTableV1Struct::draw(int vWidgetId)
 
 void cpalTableV1Struct::parse(MemoryStream* vMem, size_t vOffset, size_t vLength)
 {
-	UNUSED(vLength);
-
 	if (vMem)
 	{
+		if (vLength < 10U)
+		{
+			AddError(ct::toStr("length %u, less than the header", (uint32_t)vLength + 2U));
+			return;
+		}
+
 		vMem->SetPos(vOffset);
 
 		numPaletteEntries = (uint16_t)vMem->ReadUShort();
@@ -841,6 +1100,22 @@ void cpalTableV1Struct::parse(MemoryStream* vMem, size_t vOffset, size_t vLength
 		paletteLabelsArrayOffset = (uint32_t)vMem->ReadULong();
 		paletteEntryLabelsArrayOffset = (uint32_t)vMem->ReadULong();
 
+		// the offsets are from the table start, there is version before vOffset
+		if (22U + 2U * (size_t)numPalettes > vLength)
+		{
+			AddError(ct::toStr("%u palettes out of the table", (uint32_t)numPalettes));
+		}
+		if ((size_t)colorRecordsArrayOffset + 4U * numColorRecords > vLength + 2U)
+		{
+			AddError(ct::toStr("%u color records out of the table", (uint32_t)numColorRecords));
+		}
+		if (paletteTypesArrayOffset >= vLength + 2U ||
+			paletteLabelsArrayOffset >= vLength + 2U ||
+			paletteEntryLabelsArrayOffset >= vLength + 2U)
+		{
+			AddError("palette types or labels out of the table");
+		}
+
 		AddItem("numPaletteEntries", "(2 bytes)", ct::toStr("%hu", numPaletteEntries));
 		AddItem("numPalettes", "(2 bytes)", ct::toStr("%hu", numPalettes));
 		AddItem("numColorRecords", "(2 bytes)", ct::toStr("%hu", numColorRecords));
@@ -859,6 +1134,8 @@ int cpalTableStruct::draw(int vWidgetId)
 
 	if (ImGui::TreeNode("CPAL Table :"))
 	{
+		Decode();
+
 		DisplayTable("CPAL Table");
 
 		if (version == 0U)
@@ -890,13 +1167,23 @@ void cpalTableStruct::parse(MemoryStream* vMem, size_t vOffset, size_t vLength)
 		
 		AddItem("version", "(2 bytes)", ct::toStr("%hu", version));
 		
-		if (version == 0U)
+		if (vLength < 2U)
+		{
+			AddError(ct::toStr("length %u, less than the header", (uint32_t)vLength));
+		}
+		else if (version == 0U)
 		{
 			tableV0Struct.parse(vMem, vOffset + 2U, vLength - 2U);
+			AddErrors(tableV0Struct);
 		}
 		else if (version == 1U)
 		{
 			tableV1Struct.parse(vMem, vOffset + 2U, vLength - 2U);
+			AddErrors(tableV1Struct);
+		}
+		else
+		{
+			AddError(ct::toStr("unknown version %u", (uint32_t)version));
 		}
 	}
 }
@@ -919,52 +1206,70 @@ int FontAnalyser::compositeGlyphTableStruct::draw(int vWidgetId)
 	return vWidgetId;
 }
 
+// all the components are read, until the flag MORE_COMPONENTS is not set
 void FontAnalyser::compositeGlyphTableStruct::parse(MemoryStream* vMem, size_t vOffset, size_t vLength, int16_t vCountContours)
 {
-	UNUSED(vLength);
 	UNUSED(vCountContours);
 
 	if (vMem)
 	{
 		vMem->SetPos(vOffset);
 
-		flags = (uint16_t)vMem->ReadUShort();
-		glyphIndex = (uint16_t)vMem->ReadUShort();
+		filled = true;
 
-		if (flags & ARG_1_AND_2_ARE_WORDS)
+		const size_t endPos = vOffset + vLength;
+		do
 		{
-			argument1_16 = (uint16_t)vMem->ReadUShort();
-			argument2_16 = (uint16_t)vMem->ReadUShort();
-		}
-		else
-		{
-			argument1_8 = (uint16_t)vMem->ReadByte();
-			argument2_8 = (uint16_t)vMem->ReadByte();
-		}
-		if (flags & WE_HAVE_A_SCALE)
-		{
-			scale = vMem->ReadF2DOT14();
-		}
-		else if (flags & WE_HAVE_AN_X_AND_Y_SCALE)
+			if (vMem->GetPos() + 4U > endPos)
+			{
+				AddError(ct::toStr("component %u out of the glyf", (uint32_t)glyphIndexs.size()));
+				return;
+			}
+
+			flags = (uint16_t)vMem->ReadUShort();
+			glyphIndex = (uint16_t)vMem->ReadUShort();
+			glyphIndexs.push_back(glyphIndex);
+
+			if (flags & ARG_1_AND_2_ARE_WORDS)
+			{
+				argument1_16 = (uint16_t)vMem->ReadUShort();
+				argument2_16 = (uint16_t)vMem->ReadUShort();
+			}
+			else
+			{
+				argument1_8 = (uint16_t)vMem->ReadByte();
+				argument2_8 = (uint16_t)vMem->ReadByte();
+			}
+
+			if (flags & WE_HAVE_A_SCALE)
+			{
+				scale = vMem->ReadF2DOT14();
+			}
+			else if (flags & WE_HAVE_AN_X_AND_Y_SCALE)
+			{
+				xscale = vMem->ReadF2DOT14();
+				yscale = vMem->ReadF2DOT14();
+			}
+			else if (flags & WE_HAVE_A_TWO_BY_TWO)
+			{
+				xscale = vMem->ReadF2DOT14();
+				scale01 = vMem->ReadF2DOT14();
+				scale10 = vMem->ReadF2DOT14();
+				yscale = vMem->ReadF2DOT14();
+			}
+		} while (flags & MORE_COMPONENTS);
+
+		if (flags & WE_HAVE_INSTRUCTIONS)
 		{
-			xscale = vMem->ReadF2DOT14();
-			yscale = vMem->ReadF2DOT14();
+			const uint16_t numInstr = (uint16_t)vMem->ReadUShort();
+			vMem->SetPos(vMem->GetPos() + numInstr);
 		}
-		else if (flags & WE_HAVE_A_TWO_BY_TWO)
+
+		if (vMem->GetPos() > endPos)
 		{
-			xscale = vMem->ReadF2DOT14();
-			scale01 = vMem->ReadF2DOT14();
-			scale10 = vMem->ReadF2DOT14();
-			yscale = vMem->ReadF2DOT14();
+			AddError(ct::toStr("%u components, %u bytes out of the glyf",
+				(uint32_t)glyphIndexs.size(), (uint32_t)(vMem->GetPos() - endPos)));
 		}
-		/*while (flags & MORE_COMPONENTS)
-		{
-			if (flags & WE_HAVE_INSTRUCTIONS)
-			{
-				uint16 numInstr
-				uint8 instr[numInstr]
-			}
-		}*/
 	}
 }
 
@@ -980,10 +1285,10 @@ int FontAnalyser::simpleGlyphTableStruct::draw(int vWidgetId)
 		{
 			if (ImGui::TreeNode("endPtsOfContours :"))
 			{
-				for (auto& it : endPtsOfContours)
+				DisplayArrayLines(endPtsOfContours, [](size_t, uint16_t vValue)
 				{
-					ImGui::Text("End pt            (1 byte) : %hu", it);
-				}
+					ImGui::Text("End pt            (1 byte) : %hu", vValue);
+				});
 
 				ImGui::TreePop();
 			}
@@ -992,10 +1297,10 @@ int FontAnalyser::simpleGlyphTableStruct::draw(int vWidgetId)
 			{
 				if (ImGui::TreeNode("instructions :"))
 				{
-					for (auto& it : endPtsOfContours)
+					DisplayArrayLines(instructions, [](size_t, uint8_t vValue)
 					{
-						ImGui::Text("Instruction       (1 byte) : %hu", it);
-					}
+						ImGui::Text("Instruction       (1 byte) : %hu", (uint16_t)vValue);
+					});
 
 					ImGui::TreePop();
 				}
@@ -1012,41 +1317,37 @@ int FontAnalyser::simpleGlyphTableStruct::draw(int vWidgetId)
   (byte & 0x04 ? '1' : '0'), \
   (byte & 0x02 ? '1' : '0'), \
   (byte & 0x01 ? '1' : '0') 
-				for (auto& it : flags)
+				DisplayArrayLines(flags, [](size_t, uint8_t vValue)
 				{
-					ImGui::Text("flag              (1 byte) :" BYTE_TO_BINARY_PATTERN, BYTE_TO_BINARY(it));
-				}
+					ImGui::Text("flag              (1 byte) :" BYTE_TO_BINARY_PATTERN, BYTE_TO_BINARY(vValue));
+				});
 #undef BYTE_TO_BINARY
 #undef BYTE_TO_BINARY_PATTERN
 				ImGui::TreePop();
 			}
 			if (ImGui::TreeNode("xCoordinates :"))
 			{
-				int shortX = (1 << 1);
-				int idx = 0;
-				for (auto& it : xCoordinates)
+				const int shortX = (1 << 1);
+				DisplayArrayLines(xCoordinates, [this, shortX](size_t vIdx, int16_t vValue)
 				{
-					if (flags[idx] & shortX)
-						ImGui::Text("xCoordinates      (1 byte) : %hi", it);
+					if (flags[vIdx] & shortX)
+						ImGui::Text("xCoordinates      (1 byte) : %hi", vValue);
 					else
-						ImGui::Text("xCoordinates      (2 byte) : %hi", it);
-					idx++;
-				}
+						ImGui::Text("xCoordinates      (2 byte) : %hi", vValue);
+				});
 
 				ImGui::TreePop();
 			}
 			if (ImGui::TreeNode("yCoordinates :"))
 			{
-				int shortY = (1 << 2);
-				int idx = 0;
-				for (auto& it : yCoordinates)
+				const int shortY = (1 << 2);
+				DisplayArrayLines(yCoordinates, [this, shortY](size_t vIdx, int16_t vValue)
 				{
-					if (flags[idx] & shortY)
-						ImGui::Text("yCoordinates      (1 byte) : %hi", it);
+					if (flags[vIdx] & shortY)
+						ImGui::Text("yCoordinates      (1 byte) : %hi", vValue);
 					else
-						ImGui::Text("yCoordinates      (2 byte) : %hi", it);
-					idx++;
-				}
+						ImGui::Text("yCoordinates      (2 byte) : %hi", vValue);
+				});
 
 				ImGui::TreePop();
 			}
@@ -1060,20 +1361,37 @@ int FontAnalyser::simpleGlyphTableStruct::draw(int vWidgetId)
 	return vWidgetId;
 }
 
-void FontAnalyser::simpleGlyphTableStruct::parse(MemoryStream *vMem, size_t /*vOffset*/, size_t /*vLength*/, int16_t vCountContours)
+// vOffset is the current pos, after the glyf header
+void FontAnalyser::simpleGlyphTableStruct::parse(MemoryStream *vMem, size_t vOffset, size_t vLength, int16_t vCountContours)
 {
 	if (vMem)
 	{
 		if (vCountContours)
 		{
+			const size_t endPos = vOffset + vLength;
+			if (2U * (size_t)vCountContours + 2U > vLength)
+			{
+				AddError(ct::toStr("%i contours out of the glyf", (int)vCountContours));
+				return;
+			}
+
 			filled = true;
 			
 			for (int i = 0; i < vCountContours; i++)
 			{
 				endPtsOfContours.push_back((uint16_t)vMem->ReadShort());
+				if (i && endPtsOfContours[i] <= endPtsOfContours[i - 1])
+				{
+					AddError(ct::toStr("contour %i end before the previous one", i));
+				}
 			}
 
 			instructionLength = (uint16_t)vMem->ReadUShort();
+			if (vMem->GetPos() + instructionLength > endPos)
+			{
+				AddError(ct::toStr("%u bytes of instructions out of the glyf", (uint32_t)instructionLength));
+				return;
+			}
 			
 			for (int i = 0; i < instructionLength; i++)
 			{
@@ -1082,7 +1400,7 @@ void FontAnalyser::simpleGlyphTableStruct::parse(MemoryStream *vMem, size_t /*vO
 			
 			if (!endPtsOfContours.empty())
 			{
-				int countPoints = endPtsOfContours[endPtsOfContours.size() - 1];
+				int countPoints = endPtsOfContours[endPtsOfContours.size() - 1] + 1; // last point index + 1
 				if (countPoints > 0)
 				{
 					uint32_t flag_repeat = 0;
@@ -1101,44 +1419,53 @@ void FontAnalyser::simpleGlyphTableStruct::parse(MemoryStream *vMem, size_t /*vO
 						{
 							flag_repeat--;
 						}
+
 						flags.push_back((uint8_t)flag);
 					}
+
+					// the deltas, all the x then all the y
+					// short : 1 byte, positive if the same bit is set, else 2 bytes, or 0 if the same bit is set
 					int shortX = (1 << 1);
 					int shortY = (1 << 2);
+					int sameX = (1 << 4);
+					int sameY = (1 << 5);
 					for (auto & it : flags)
 					{
 						if (it & shortX)
-							xCoordinates.push_back((int16_t)vMem->ReadByte());
+							xCoordinates.push_back((it & sameX) ? (int16_t)vMem->ReadByte() : (int16_t)-vMem->ReadByte());
+						else if (it & sameX)
+							xCoordinates.push_back(0);
 						else
 							xCoordinates.push_back((int16_t)vMem->ReadShort());
-
+					}
+					for (auto & it : flags)
+					{
 						if (it & shortY)
-							yCoordinates.push_back((int16_t)vMem->ReadByte());
+							yCoordinates.push_back((it & sameY) ? (int16_t)vMem->ReadByte() : (int16_t)-vMem->ReadByte());
+						else if (it & sameY)
+							yCoordinates.push_back(0);
 						else
 							yCoordinates.push_back((int16_t)vMem->ReadShort());
 					}
 				}
 			}
+
+			if (vMem->GetPos() > endPos)
+			{
+				AddError(ct::toStr("outline %u bytes out of the glyf", (uint32_t)(vMem->GetPos() - endPos)));
+			}
 		}
 	}
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// the node of the glyf is drawn by the glyf table
 int FontAnalyser::glyfStruct::draw(int vWidgetId)
 {
-	ImGui::PushID(++vWidgetId);
-
-	if (ImGui::TreeNode("glyf :"))
-	{
-		DisplayTable("glyf");
-
-		vWidgetId = simpleGlyph.draw(vWidgetId);
-
-		ImGui::TreePop();
-	}
+	DisplayTable("glyf");
 
-	ImGui::PopID();
+	vWidgetId = simpleGlyph.draw(vWidgetId);
 
 	return vWidgetId;
 }
@@ -1147,6 +1474,14 @@ void FontAnalyser::glyfStruct::parse(MemoryStream *vMem, size_t vOffset, size_t
 {
 	if (vMem)
 	{
+		if (vLength < 10U) // no outline (space, etc..)
+		{
+			if (vLength)
+				AddError(ct::toStr("length %u, less than the header", (uint32_t)vLength));
+			AddItem("numberOfContours", "(0 bytes)", "empty glyf");
+			return;
+		}
+
 		vMem->SetPos(vOffset);
 
 		numberOfContours = (uint16_t)vMem->ReadUShort();
@@ -1157,11 +1492,13 @@ void FontAnalyser::glyfStruct::parse(MemoryStream *vMem, size_t vOffset, size_t
 
 		if (numberOfContours >= 0)
 		{
-			simpleGlyph.parse(vMem, vMem->GetPos(), vLength - vMem->GetPos(), numberOfContours);
+			simpleGlyph.parse(vMem, vMem->GetPos(), vLength - 10U, numberOfContours);
+			AddErrors(simpleGlyph);
 		}
 		else // compound
 		{
-			compositeGlyph.parse(vMem, vMem->GetPos(), vLength - vMem->GetPos(), numberOfContours);
+			compositeGlyph.parse(vMem, vMem->GetPos(), vLength - 10U, numberOfContours);
+			AddErrors(compositeGlyph);
 		}
 
 		AddItem("numberOfContours", "(2 bytes)", ct::toStr("%hu", numberOfContours));
@@ -1180,17 +1517,33 @@ int FontAnalyser::glyfTableStruct::draw(int vWidgetId)
 
 	if (ImGui::TreeNode("glyf Table :"))
 	{
-		if (!glyfs.empty())
+		Decode();
+
+		if (!glyfLocations.empty())
 		{
 			ImGuiListClipper clipper;
-			clipper.Begin((int)glyfs.size(), ImGui::GetTextLineHeightWithSpacing());
+			clipper.Begin((int)glyfLocations.size(), ImGui::GetTextLineHeightWithSpacing());
 			while (clipper.Step())
 			{
 				for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
 				{
 					if (i < 0) continue;
 
-					vWidgetId = glyfs[i].draw(vWidgetId);
+					ImGui::PushID(++vWidgetId);
+
+					// the glyf is decoded only when opened
+					if (ImGui::TreeNode("glyf", "glyf %i :", i))
+					{
+						auto glyfPtr = GetGlyf((uint32_t)i);
+						if (glyfPtr)
+						{
+							vWidgetId = glyfPtr->draw(vWidgetId);
+						}
+
+						ImGui::TreePop();
+					}
+
+					ImGui::PopID();
 				}
 			}
 		}
@@ -1205,25 +1558,65 @@ int FontAnalyser::glyfTableStruct::draw(int vWidgetId)
 	return vWidgetId;
 }
 
-void FontAnalyser::glyfTableStruct::parse(MemoryStream *vMem, size_t vOffset, size_t /*vLength*/)
+// only the locations of the glyfs, from the loca table
+// the length of a glyf is the difference of two consecutive offsets, the padding is not in it
+void FontAnalyser::glyfTableStruct::parse(MemoryStream *vMem, size_t /*vOffset*/, size_t /*vLength*/)
 {
 	if (vMem && loca)
 	{
-		int offset = 0;
-		int length = 0;
-		for (auto & it : loca->offsets)
-		{
-			offset = it;
-			
-			glyfStruct glyf;
-			glyf.parse(vMem, vOffset + offset, length);
-			glyfs.push_back(glyf);
+		loca->Decode();
 
-			length = offset;
+		glyfLocations.clear();
+		if (loca->offsets.size() > 1U)
+		{
+			glyfLocations.reserve(loca->offsets.size() - 1U);
+			for (size_t i = 0; i + 1U < loca->offsets.size(); i++)
+			{
+				const uint32_t offset = loca->offsets[i];
+				const uint32_t end = loca->offsets[i + 1U];
+				glyfLocations.emplace_back(offset, (end > offset) ? end - offset : 0U);
+			}
 		}
 	}
 }
 
+FontAnalyser::glyfStruct* FontAnalyser::glyfTableStruct::GetGlyf(uint32_t vGlyphIndex)
+{
+	if (vGlyphIndex >= glyfLocations.size() || !m_Mem)
+		return nullptr;
+
+	const int frame = ImGui::GetFrameCount();
+
+	auto it = decodedGlyfs.find(vGlyphIndex);
+	if (it != decodedGlyfs.end())
+	{
+		// most recent
+		decodedOrder.splice(decodedOrder.begin(), decodedOrder, it->second.orderIt);
+		it->second.lastFrame = frame;
+		return &it->second.glyf;
+	}
+
+	// the older glyfs are removed, except if displayed in this frame
+	while (decodedGlyfs.size() >= MAX_DECODED_GLYFS)
+	{
+		auto oldIt = decodedGlyfs.find(decodedOrder.back());
+		if (oldIt == decodedGlyfs.end() || oldIt->second.lastFrame == frame)
+			break;
+		decodedGlyfs.erase(oldIt);
+		decodedOrder.pop_back();
+	}
+
+	decodedOrder.push_front(vGlyphIndex);
+	auto& decoded = decodedGlyfs[vGlyphIndex];
+	decoded.orderIt = decodedOrder.begin();
+	decoded.lastFrame = frame;
+
+	const auto& location = glyfLocations[vGlyphIndex];
+	decoded.glyf.parse(m_Mem, m_Offset + location.first, location.second);
+
+	return &decoded.glyf;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -1240,10 +1633,10 @@ int FontAnalyser::cmapSubTableF4Struct::draw(int vWidgetId)
 
 			if (ImGui::TreeNode("endCode :"))
 			{
-				for (auto& it : endCode)
+				DisplayArrayLines(endCode, [](size_t, uint16_t vValue)
 				{
-					ImGui::Text("                   (2 bytes) : %hu", it);
-				}
+					ImGui::Text("                   (2 bytes) : %hu", vValue);
+				});
 
 				ImGui::TreePop();
 			}
@@ -1252,40 +1645,40 @@ int FontAnalyser::cmapSubTableF4Struct::draw(int vWidgetId)
 
 			if (ImGui::TreeNode("startCode :"))
 			{
-				for (auto& it : startCode)
+				DisplayArrayLines(startCode, [](size_t, uint16_t vValue)
 				{
-					ImGui::Text("                   (2 bytes) : %hu", it);
-				}
+					ImGui::Text("                   (2 bytes) : %hu", vValue);
+				});
 
 				ImGui::TreePop();
 			}
 
 			if (ImGui::TreeNode("idDelta :"))
 			{
-				for (auto& it : idDelta)
+				DisplayArrayLines(idDelta, [](size_t, int16_t vValue)
 				{
-					ImGui::Text("                   (2 bytes) : %hi", it);
-				}
+					ImGui::Text("                   (2 bytes) : %hi", vValue);
+				});
 
 				ImGui::TreePop();
 			}
 
 			if (ImGui::TreeNode("idRangeOffset :"))
 			{
-				for (auto& it : idRangeOffset)
+				DisplayArrayLines(idRangeOffset, [](size_t, uint16_t vValue)
 				{
-					ImGui::Text("                   (2 bytes) : %hu", it);
-				}
+					ImGui::Text("                   (2 bytes) : %hu", vValue);
+				});
 
 				ImGui::TreePop();
 			}
 
 			if (ImGui::TreeNode("glyphIdArray :"))
 			{
-				for (auto& it : glyphIdArray)
+				DisplayArrayLines(glyphIdArray, [](size_t, uint16_t vValue)
 				{
-					ImGui::Text("                   (2 bytes) : %hu", it);
-				}
+					ImGui::Text("                   (2 bytes) : %hu", vValue);
+				});
 
 				ImGui::TreePop();
 			}
@@ -1299,7 +1692,8 @@ int FontAnalyser::cmapSubTableF4Struct::draw(int vWidgetId)
 	return vWidgetId;
 }
 
-void FontAnalyser::cmapSubTableF4Struct::parse(MemoryStream *vMem, size_t /*vOffset*/, size_t /*vLength*/)
+// vLength is the length of the sub table, the format and the length are already read
+void FontAnalyser::cmapSubTableF4Struct::parse(MemoryStream *vMem, size_t /*vOffset*/, size_t vLength)
 {
 	if (vMem)
 	{
@@ -1317,6 +1711,17 @@ void FontAnalyser::cmapSubTableF4Struct::parse(MemoryStream *vMem, size_t /*vOff
 		AddItem("segCountX2", "(2 bytes)", ct::toStr("%hu", segCountX2));
 		AddItem("entrySelector", "(2 bytes)", ct::toStr("%hu", entrySelector));
 		AddItem("rangeShift", "(2 bytes)", ct::toStr("%hu", rangeShift));
+
+		if (!segCountX2 || (segCountX2 & 1))
+		{
+			AddError(ct::toStr("format 4 : bad segCountX2 %u", (uint32_t)segCountX2));
+			return;
+		}
+		if (16U + 4U * (size_t)segCountX2 > vLength)
+		{
+			AddError(ct::toStr("format 4 : %u segments out of the sub table", (uint32_t)segCountX2 / 2U));
+			return;
+		}
 		
 		int segCount = segCountX2 / 2;
 		for (int i = 0; i < segCount; i++)
@@ -1338,7 +1743,21 @@ void FontAnalyser::cmapSubTableF4Struct::parse(MemoryStream *vMem, size_t /*vOff
 			idRangeOffset.push_back((uint16_t)vMem->ReadUShort());
 		}
 
-		
+		// segments sorted, not overlapping, the last one end at 0xFFFF
+		size_t countBadSegments = 0U;
+		for (int i = 0; i < segCount; i++)
+		{
+			if (startCode[i] > endCode[i] || (i && startCode[i] <= endCode[i - 1]))
+				countBadSegments++;
+		}
+		if (countBadSegments)
+		{
+			AddError(ct::toStr("format 4 : %u segments not sorted or overlapping", (uint32_t)countBadSegments));
+		}
+		if (endCode.back() != 0xFFFF)
+		{
+			AddError("format 4 : the last segment not end at 0xFFFF");
+		}
 	}
 }
 
@@ -1375,10 +1794,17 @@ int FontAnalyser::cmapSubTableF0Struct::draw(int vWidgetId)
 	return vWidgetId;
 }
 
-void FontAnalyser::cmapSubTableF0Struct::parse(MemoryStream *vMem, size_t /*vOffset*/, size_t /*vLength*/)
+// vLength is the length of the sub table, the format and the length are already read
+void FontAnalyser::cmapSubTableF0Struct::parse(MemoryStream *vMem, size_t /*vOffset*/, size_t vLength)
 {
 	if (vMem)
 	{
+		if (vLength != 262U)
+		{
+			AddError(ct::toStr("format 0 : length %u, 262 expected", (uint32_t)vLength));
+			return;
+		}
+
 		filled = true;
 		language = (uint16_t)vMem->ReadUShort();
 
@@ -1416,37 +1842,72 @@ int FontAnalyser::cmapEncodingRecordStruct::draw(int vWidgetId)
 	return vWidgetId;
 }
 
-void FontAnalyser::cmapEncodingRecordStruct::parse(MemoryStream *vMem, size_t /*vOffset*/, size_t /*vLength*/)
+// the record is read at the current pos, the sub table at vOffset + offset
+// vOffset and vLength are the ones of the cmap table, the pos is after the record at the end
+void FontAnalyser::cmapEncodingRecordStruct::parse(MemoryStream *vMem, size_t vOffset, size_t vLength)
 {
 	if (vMem)
 	{
 		platformID = (uint16_t)vMem->ReadUShort();
 		encodingID = (uint16_t)vMem->ReadUShort();
-		offset = (uint16_t)vMem->ReadULong();
+		offset = (uint32_t)vMem->ReadULong();
 
 		AddItem("platformID", "(2 bytes)", ct::toStr("%hu", platformID));
 		AddItem("platformSpecificID", "(2 bytes)", ct::toStr("%hu", encodingID));
 		AddItem("offset", "(4 bytes)", ct::toStr("%u", offset));
 
+		const size_t nextRecordPos = vMem->GetPos();
+
+		if ((size_t)offset + 4U > vLength)
+		{
+			AddError(ct::toStr("sub table %hu/%hu : offset %u out of the table", platformID, encodingID, offset));
+			return;
+		}
+
+		vMem->SetPos(vOffset + offset);
+
 		uint16_t format = (uint16_t)vMem->ReadUShort();
 		uint16_t length = (uint16_t)vMem->ReadUShort();
 
-		if (format == 0)
+		if (format == 0 || format == 4)
 		{
-			subTableF0.format = format;
-			subTableF0.length = length;
-			subTableF0.parse(vMem, vMem->GetPos(), length);
+			if ((size_t)offset + length > vLength)
+			{
+				AddError(ct::toStr("sub table %hu/%hu : format %hu, length %hu out of the table", platformID, encodingID, format, length));
+			}
+			else if (format == 0)
+			{
+				subTableF0.format = format;
+				subTableF0.length = length;
+				subTableF0.parse(vMem, vMem->GetPos(), length);
+				AddErrors(subTableF0);
+			}
+			else
+			{
+				subTableF4.format = format;
+				subTableF4.length = length;
+				subTableF4.parse(vMem, vMem->GetPos(), length);
+				AddErrors(subTableF4);
+			}
 		}
-		else if (format == 4)
+		else if (format == 12)
 		{
-			subTableF4.format = format;
-			subTableF4.length = length;
-			subTableF4.parse(vMem, vMem->GetPos(), length);
+			// length is 32 bits here, only the bounds are checked
+			const uint32_t length32 = (uint32_t)vMem->ReadULong();
+			vMem->ReadULong(); // language
+			const uint32_t numGroups = (uint32_t)vMem->ReadULong();
+			if ((size_t)offset + length32 > vLength || 16U + 12U * (size_t)numGroups > length32)
+			{
+				AddError(ct::toStr("sub table %hu/%hu : format 12, %u groups out of the table", platformID, encodingID, numGroups));
+			}
+			AddItem("format", "(2 bytes)", "12, not decoded for the moment");
 		}
 		else
 		{
-			ImGui::Text("Not added for the moment");
+			AddItem("format", "(2 bytes)", ct::toStr("%hu, not decoded for the moment", format));
 		}
+
+		vMem->SetPos(nextRecordPos);
 	}
 }
 
@@ -1460,6 +1921,8 @@ int FontAnalyser::cmapTableStruct::draw(int vWidgetId)
 
 	if (ImGui::TreeNode("cmap Table :"))
 	{
+		Decode();
+
 		DisplayTable("cmap Table");
 
 		for (auto & it : encodingRecords)
@@ -1477,7 +1940,7 @@ int FontAnalyser::cmapTableStruct::draw(int vWidgetId)
 	return vWidgetId;
 }
 
-void FontAnalyser::cmapTableStruct::parse(MemoryStream *vMem, size_t vOffset, size_t /*vLength*/)
+void FontAnalyser::cmapTableStruct::parse(MemoryStream *vMem, size_t vOffset, size_t vLength)
 {
 	if (vMem)
 	{
@@ -1489,10 +1952,17 @@ void FontAnalyser::cmapTableStruct::parse(MemoryStream *vMem, size_t vOffset, si
 		AddItem("version", "(2 bytes)", ct::toStr("%hu", version));
 		AddItem("numEncodingRecords", "(2 bytes)", ct::toStr("%hu", numEncodingRecords));
 
+		if (4U + 8U * (size_t)numEncodingRecords > vLength)
+		{
+			AddError(ct::toStr("%u encoding records out of the table", (uint32_t)numEncodingRecords));
+			return;
+		}
+
 		for (int i = 0; i < numEncodingRecords; i++)
 		{
 			cmapEncodingRecordStruct enc;
-			enc.parse(vMem, 0, 0);
+			enc.parse(vMem, vOffset, vLength);
+			AddErrors(enc);
 			encodingRecords.push_back(enc);
 		}
 	}
@@ -1508,6 +1978,8 @@ int FontAnalyser::headTableStruct::draw(int vWidgetId)
 
 	if (ImGui::TreeNode("head Table :"))
 	{
+		Decode();
+
 		DisplayTable("head Table");
 
 		ImGui::TreePop();
@@ -1606,14 +2078,18 @@ int FontAnalyser::postTableF2Struct::draw(int vWidgetId)
 
 			if (ImGui::TreeNode("glyphNameIndexs (2 bytes array of numberOfGlyphs)"))
 			{
-				for (auto& it : glyphNameIndex)
-					ImGui::Text("glyph id        (2 bytes) : %hu", it);
+				DisplayArrayLines(glyphNameIndex, [](size_t, uint16_t vValue)
+				{
+					ImGui::Text("glyph id        (2 bytes) : %hu", vValue);
+				});
 				ImGui::TreePop();
 			}
 			if (ImGui::TreeNode("names :"))
 			{
-				for (auto& it : names)
-					ImGui::Text("%s", it.c_str());
+				DisplayArrayLines(names, [](size_t, const std::string& vValue)
+				{
+					ImGui::TextUnformatted(vValue.c_str());
+				});
 				ImGui::TreePop();
 			}
 			ImGui::TreePop();
@@ -1631,6 +2107,14 @@ void FontAnalyser::postTableF2Struct::parse(MemoryStream *vMem, size_t vOffset,
 		
 		AddItem("numberOfGlyphs", "(2 bytes)", ct::toStr("%hu", numberOfGlyphs));
 
+		size_t endPos = vOffset + vLength;
+
+		if (vMem->GetPos() + 2U * numberOfGlyphs > endPos)
+		{
+			AddError(ct::toStr("%u glyph name indexs out of the table", (uint32_t)numberOfGlyphs));
+			numberOfGlyphs = 0;
+		}
+
 		if (numberOfGlyphs)
 		{
 			for (int i = 0; i < numberOfGlyphs; i++)
@@ -1638,16 +2122,20 @@ void FontAnalyser::postTableF2Struct::parse(MemoryStream *vMem, size_t vOffset,
 				glyphNameIndex.push_back((uint16_t)vMem->ReadUShort());
 			}
 
-			size_t endPos = vOffset + vLength;
-
 			std::vector<std::string> pendingNames;
 			while (vMem->GetPos() < endPos)
 			{
 				uint8_t len = vMem->ReadByte();
+				if (vMem->GetPos() + len > endPos)
+				{
+					AddError(ct::toStr("glyph name %u out of the table", (uint32_t)pendingNames.size()));
+					break;
+				}
 				std::string str = vMem->ReadString(len);
 				pendingNames.push_back(str);
 			}
 
+			size_t countBadIndexs = 0U;
 			for (int i = 0; i < numberOfGlyphs; i++)
 			{
 				uint16_t mapIdx = glyphNameIndex[i];
@@ -1656,6 +2144,8 @@ void FontAnalyser::postTableF2Struct::parse(MemoryStream *vMem, size_t vOffset,
 					uint16_t idx = mapIdx - 258;
 					if (idx < pendingNames.size())
 						names.push_back(pendingNames[idx]);
+					else
+						countBadIndexs++;
 				}
 				else
 				{
@@ -1663,6 +2153,11 @@ void FontAnalyser::postTableF2Struct::parse(MemoryStream *vMem, size_t vOffset,
 				}
 			}
 
+			if (countBadIndexs)
+			{
+				AddError(ct::toStr("%u glyph name indexs without name", (uint32_t)countBadIndexs));
+			}
+
 			filled = true;
 		}
 	}
@@ -1678,6 +2173,8 @@ int FontAnalyser::postTableStruct::draw(int vWidgetId)
 
 	if (ImGui::TreeNode("post Table :"))
 	{
+		Decode();
+
 		DisplayTable("post Table");
 
 		vWidgetId = tableF2.draw(vWidgetId);
@@ -1708,8 +2205,19 @@ void FontAnalyser::postTableStruct::parse(MemoryStream *vMem, size_t vOffset, si
 		minMemType1 = (uint32_t)vMem->ReadULong();
 		maxMemType1 = (uint32_t)vMem->ReadULong();
 
-		if (format.high == 2)
+		if (vLength < 32U)
+		{
+			AddError(ct::toStr("length %u, less than the header", (uint32_t)vLength));
+		}
+		else if (format.high == 2)
+		{
 			tableF2.parse(vMem, vOffset, vLength);
+			AddErrors(tableF2);
+		}
+		else if (format.high < 1 || format.high > 3)
+		{
+			AddError(ct::toStr("unknown format %hi.%hi", format.high, format.low));
+		}
 
 		AddItem("format", "(4 bytes)", ct::toStr("%hi.%hi", format.high, format.low));
 		AddItem("italicAngle", "(4 bytes)", ct::toStr("%hi.%hi", italicAngle.high, italicAngle.low));
@@ -1763,45 +2271,51 @@ int FontAnalyser::FontAnalyzedStruct::draw(int vWidgetId)
 }
 
 
-void FontAnalyser::FontAnalyzedStruct::parse(MemoryStream *vMem)
+// the tables are decoded when theirs tree nodes are opened (LazyTableDisplay)
+// no copy of the datas, they are viewed by mem
+void FontAnalyser::FontAnalyzedStruct::parse(const uint8_t* vDatas, size_t vSize)
 {
-	if (vMem)
+	if (vDatas && vSize)
 	{
+		fontDatas = vDatas;
+		fontSize = vSize;
+		mem.SetView(vDatas, vSize);
+
 #define IF_TABLE(_tag_) if (tables.find(_tag_) != tables.end())
-#define PARSE_TABLE(_tag_, _class_) _class_.parse(vMem, tables[_tag_].offset, tables[_tag_].length)
+#define PREPARE_TABLE(_tag_, _class_) _class_.SetLocation(&mem, tables[_tag_].offset, tables[_tag_].length)
 
-		header.parse(vMem);
+		header.parse(&mem);
 
 		for (int i = 0; i < header.numTables; i++)
 		{
 			TableStruct tbl;
-			tbl.parse(vMem);
+			tbl.parse(&mem);
 			tables[std::string((char*)tbl.tag)] = tbl;
 		}
 
-		IF_TABLE("head") PARSE_TABLE("head", head);
-		IF_TABLE("name") PARSE_TABLE("name", name);
-		IF_TABLE("maxp") PARSE_TABLE("maxp", maxp);
-		IF_TABLE("cmap") PARSE_TABLE("cmap", cmap);
-		IF_TABLE("post") PARSE_TABLE("post", post);
+		IF_TABLE("head") PREPARE_TABLE("head", head);
+		IF_TABLE("name") PREPARE_TABLE("name", name);
+		IF_TABLE("maxp") PREPARE_TABLE("maxp", maxp);
+		IF_TABLE("cmap") PREPARE_TABLE("cmap", cmap);
+		IF_TABLE("post") PREPARE_TABLE("post", post);
 		IF_TABLE("loca")
 		{
 			IF_TABLE("head") IF_TABLE("maxp")
 			{
 				loca.head = &head;
 				loca.maxp = &maxp;
-				PARSE_TABLE("loca", loca);
+				PREPARE_TABLE("loca", loca);
 			}
-			IF_TABLE("head")
+			IF_TABLE("glyf")
 			{
 				glyf.loca = &loca;
-				PARSE_TABLE("glyf", glyf);
+				PREPARE_TABLE("glyf", glyf);
 			}
 		}
-		IF_TABLE("COLR") PARSE_TABLE("COLR", colr);
-		IF_TABLE("CPAL") PARSE_TABLE("CPAL", cpal);
+		IF_TABLE("COLR") PREPARE_TABLE("COLR", colr);
+		IF_TABLE("CPAL") PREPARE_TABLE("CPAL", cpal);
 
-#undef PARSE_TABLE
+#undef PREPARE_TABLE
 #undef IF_TABLE
 	}
 
@@ -1809,6 +2323,246 @@ void FontAnalyser::FontAnalyzedStruct::parse(MemoryStream *vMem)
 	parsed = true;
 }
 
+// vJob is called for each index of [0, vCountJobs[, on vCountThreads threads (0 => count of cores)
+// each thread have his own stream on the same datas, the current thread is one of the workers
+static void RunOnThreads(const uint8_t* vDatas, size_t vSize, size_t vCountJobs, size_t vCountThreads,
+	const std::function<void(size_t vIdx, MemoryStream* vMem, size_t vThreadIdx)>& vJob)
+{
+	std::atomic<size_t> nextIdx(0U);
+	auto worker = [&](size_t vThreadIdx)
+	{
+		MemoryStream threadMem;
+		threadMem.SetView(vDatas, vSize);
+
+		size_t idx = nextIdx++;
+		while (idx < vCountJobs)
+		{
+			vJob(idx, &threadMem, vThreadIdx);
+			idx = nextIdx++;
+		}
+	};
+
+	size_t countThreads = vCountThreads;
+	if (countThreads == 0U)
+		countThreads = (size_t)std::thread::hardware_concurrency();
+	countThreads = ct::clamp<size_t>(countThreads, 1U, ct::maxi<size_t>(vCountJobs, 1U));
+
+	std::vector<std::thread> threads;
+	for (size_t i = 1U; i < countThreads; i++)
+	{
+		threads.emplace_back(worker, i);
+	}
+	worker(0U);
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+}
+
+void FontAnalyser::FontAnalyzedStruct::validate(FontValidation* vValidation, size_t vCountThreads)
+{
+	if (!vValidation)
+		return;
+
+	*vValidation = FontValidation();
+	vValidation->done = true;
+
+	if (!parsed || !fontDatas || !fontSize)
+	{
+		vValidation->errors.push_back("no font datas");
+		return;
+	}
+
+	/////////////////////////////
+	// checksums
+
+	auto checksumStart = std::chrono::steady_clock::now();
+
+	if (12U + 16U * (size_t)header.numTables > fontSize)
+	{
+		vValidation->errors.push_back(ct::toStr("the table directory (%u tables) is out of the file", header.numTables));
+	}
+
+	for (auto& it : tables)
+	{
+		TableValidation tableValidation;
+		tableValidation.tag = it.first;
+		tableValidation.storedCheckSum = it.second.checkSum;
+
+		const size_t offset = it.second.offset;
+		const size_t length = it.second.length;
+		if (offset > fontSize || length > fontSize - offset)
+		{
+			tableValidation.inFile = false;
+			vValidation->errors.push_back(ct::toStr("table %s is out of the file (offset %u, length %u, file size %u)",
+				it.first.c_str(), it.second.offset, it.second.length, (uint32_t)fontSize));
+		}
+		else
+		{
+			tableValidation.computedCheckSum = ComputeChecksum(fontDatas + offset, length);
+
+			if (it.first == "head" && length >= 12U)
+			{
+				// the head checksum is computed with checkSumAdjustment as 0
+				vValidation->headFound = true;
+				vValidation->storedAdjustment = ReadBigEndianUInt32(fontDatas + offset + 8U);
+				tableValidation.computedCheckSum -= vValidation->storedAdjustment;
+
+				if (tableValidation.computedCheckSum != tableValidation.storedCheckSum)
+				{
+					vValidation->warnings.push_back(ct::toStr("table head : checksum 0x%08X, computed 0x%08X",
+						tableValidation.storedCheckSum, tableValidation.computedCheckSum));
+				}
+			}
+			else if (tableValidation.computedCheckSum != tableValidation.storedCheckSum)
+			{
+				vValidation->errors.push_back(ct::toStr("table %s : checksum 0x%08X, computed 0x%08X",
+					it.first.c_str(), tableValidation.storedCheckSum, tableValidation.computedCheckSum));
+			}
+		}
+
+		vValidation->tables.push_back(tableValidation);
+	}
+
+	if (vValidation->headFound)
+	{
+		// sum of the whole font with checkSumAdjustment as 0
+		const uint32_t fontSum = ComputeChecksum(fontDatas, fontSize) - vValidation->storedAdjustment;
+		vValidation->computedAdjustment = 0xB1B0AFBAU - fontSum;
+		if (vValidation->computedAdjustment != vValidation->storedAdjustment)
+		{
+			vValidation->warnings.push_back(ct::toStr("head.checkSumAdjustment : 0x%08X, computed 0x%08X",
+				vValidation->storedAdjustment, vValidation->computedAdjustment));
+		}
+	}
+	else
+	{
+		vValidation->errors.push_back("no head table");
+	}
+
+	vValidation->checksumTimeInMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - checksumStart).count();
+
+	/////////////////////////////
+	// decode
+
+	auto decodeStart = std::chrono::steady_clock::now();
+
+	// the dependencies first, loca need head and maxp, glyf need loca
+	head.Decode();
+	maxp.Decode();
+	loca.Decode();
+
+	// no dependencies between these tables
+	std::vector<LazyTableDisplay*> independentTables;
+	LazyTableDisplay* candidates[] = { &name, &cmap, &post, &colr, &cpal, &glyf };
+	for (auto table : candidates)
+	{
+		if (table->IsLocated())
+			independentTables.push_back(table);
+	}
+
+	RunOnThreads(fontDatas, fontSize, independentTables.size(), vCountThreads,
+		[&independentTables](size_t vIdx, MemoryStream* vMem, size_t /*vThreadIdx*/)
+	{
+		independentTables[vIdx]->Decode(vMem);
+	});
+
+	// the parse of each table report his bounds and structure errors
+	const std::pair<const char*, const LazyTableDisplay*> decodedTables[] = {
+		{ "head", &head }, { "maxp", &maxp }, { "loca", &loca }, { "name", &name }, { "cmap", &cmap },
+		{ "post", &post }, { "COLR", &colr }, { "CPAL", &cpal }, { "glyf", &glyf } };
+	for (const auto& it : decodedTables)
+	{
+		for (const auto& error : it.second->GetErrors())
+		{
+			vValidation->errors.push_back(ct::toStr("%s : %s", it.first, error.c_str()));
+		}
+	}
+
+	// every glyf is decoded, with his own glyfStruct on the thread of the decode (not the lru of the display)
+	if (glyf.IsLocated() && !glyf.glyfLocations.empty())
+	{
+		const auto& locations = glyf.glyfLocations;
+		const size_t glyfOffset = tables["glyf"].offset;
+		const size_t glyfLength = tables["glyf"].length;
+
+		size_t countThreads = vCountThreads ? vCountThreads : (size_t)std::thread::hardware_concurrency();
+		countThreads = ct::clamp<size_t>(countThreads, 1U, locations.size());
+		std::vector<std::vector<std::pair<uint32_t, std::string>>> threadErrors(countThreads); // glyph index, error
+
+		RunOnThreads(fontDatas, fontSize, locations.size(), countThreads,
+			[&locations, &threadErrors, glyfOffset, glyfLength](size_t vIdx, MemoryStream* vMem, size_t vThreadIdx)
+		{
+			auto& errors = threadErrors[vThreadIdx];
+			const auto& location = locations[vIdx];
+			if ((size_t)location.first + location.second > glyfLength)
+			{
+				errors.emplace_back((uint32_t)vIdx, "out of the glyf table");
+				return;
+			}
+
+			glyfStruct glyfDecoded;
+			glyfDecoded.parse(vMem, glyfOffset + location.first, location.second);
+			for (const auto& error : glyfDecoded.GetErrors())
+			{
+				errors.emplace_back((uint32_t)vIdx, error);
+			}
+			for (auto component : glyfDecoded.compositeGlyph.glyphIndexs)
+			{
+				if (component >= locations.size())
+				{
+					errors.emplace_back((uint32_t)vIdx, ct::toStr("component glyph %u not in the font", (uint32_t)component));
+				}
+			}
+		});
+
+		std::vector<std::pair<uint32_t, std::string>> glyfErrors;
+		for (auto& errors : threadErrors)
+		{
+			glyfErrors.insert(glyfErrors.end(), errors.begin(), errors.end());
+		}
+		std::sort(glyfErrors.begin(), glyfErrors.end(),
+			[](const std::pair<uint32_t, std::string>& a, const std::pair<uint32_t, std::string>& b) { return a.first < b.first; });
+
+		// the firsts only, a corrupted glyf table give an error per glyf
+		const size_t maxGlyfErrors = 10U;
+		for (size_t i = 0; i < glyfErrors.size() && i < maxGlyfErrors; i++)
+		{
+			vValidation->errors.push_back(ct::toStr("glyf %u : %s", glyfErrors[i].first, glyfErrors[i].second.c_str()));
+		}
+		if (glyfErrors.size() > maxGlyfErrors)
+		{
+			vValidation->errors.push_back(ct::toStr("glyf : %u errors more", (uint32_t)(glyfErrors.size() - maxGlyfErrors)));
+		}
+	}
+
+	// the glyfs must be in the glyf table, in the order of the glyph ids
+	if (glyf.IsLocated() && tables.find("glyf") != tables.end())
+	{
+		const uint32_t glyfLength = tables["glyf"].length;
+		size_t countBadOffsets = 0U;
+		uint32_t lastOffset = 0U;
+		for (auto offset : loca.offsets)
+		{
+			if (offset < lastOffset || offset > glyfLength)
+				countBadOffsets++;
+			lastOffset = offset;
+		}
+		if (countBadOffsets)
+		{
+			vValidation->errors.push_back(ct::toStr("loca : %u glyf offsets are decreasing or out of the glyf table",
+				(uint32_t)countBadOffsets));
+		}
+		if (maxp.IsLocated() && loca.offsets.size() != (size_t)maxp.numGlyphs + 1U)
+		{
+			vValidation->errors.push_back(ct::toStr("loca : %u offsets found, %u expected (numGlyphs + 1)",
+				(uint32_t)loca.offsets.size(), (uint32_t)maxp.numGlyphs + 1U));
+		}
+	}
+
+	vValidation->decodeTimeInMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - decodeStart).count();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -1825,18 +2579,103 @@ FontParser::~FontParser()
 
 void FontParser::ParseFont(const std::string& vFilePathName)
 {
-	auto arrBytes = FileHelper::Instance()->LoadFileToBytes(vFilePathName);
-	if (!arrBytes.empty())
+	// the shared bytes of the file, not read again if the font is loaded
+	auto fontFileDatas = FontDataService::Instance()->GetFontFileDatas(vFilePathName);
+	if (fontFileDatas)
 	{
-		MemoryStream mem;
-		mem.Set(arrBytes.data(), arrBytes.size());
-		
 		m_FontAnalyzed = {}; // re init
-		m_FontAnalyzed.parse(&mem);
+		m_Validation = {};
+		m_FontFileDatas = fontFileDatas; // kept alive, viewed by m_FontAnalyzed
+		m_FontAnalyzed.parse(m_FontFileDatas->GetDatas(), m_FontFileDatas->GetSize());
 	}
 }
 
+void FontParser::ValidateFont(const std::string& vFilePathName)
+{
+	auto fontFileDatas = FontDataService::Instance()->GetFontFileDatas(vFilePathName);
+	if (fontFileDatas != m_FontFileDatas || !m_FontAnalyzed.parsed)
+	{
+		ParseFont(vFilePathName);
+	}
+
+	m_FontAnalyzed.validate(&m_Validation);
+}
+
 int FontParser::draw(int vWidgetId)
 {
 	return m_FontAnalyzed.draw(vWidgetId);
-}
\ No newline at end of file
+}
+
+void FontParser::drawValidation()
+{
+	if (m_Validation.done)
+	{
+		if (m_Validation.IsValid())
+		{
+			ImGui::TextColored(ImVec4(0.2f, 0.9f, 0.2f, 1.0f), "Font valid");
+		}
+		else
+		{
+			ImGui::TextColored(ImVec4(0.9f, 0.2f, 0.2f, 1.0f), "Font not valid : %u errors", (uint32_t)m_Validation.errors.size());
+		}
+		ImGui::Text("checksums : %.3f ms / decode : %.3f ms", m_Validation.checksumTimeInMs, m_Validation.decodeTimeInMs);
+
+		for (auto& it : m_Validation.errors)
+		{
+			ImGui::TextColored(ImVec4(0.9f, 0.2f, 0.2f, 1.0f), "%s", it.c_str());
+		}
+		for (auto& it : m_Validation.warnings)
+		{
+			ImGui::TextColored(ImVec4(0.9f, 0.7f, 0.2f, 1.0f), "%s", it.c_str());
+		}
+
+		ImGuiTableFlags flags = ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders;
+		if (ImGui::BeginTable("Validation", 4, flags))
+		{
+			ImGui::TableSetupColumn("Table", ImGuiTableColumnFlags_WidthFixed, -1, 0);
+			ImGui::TableSetupColumn("CheckSum", ImGuiTableColumnFlags_WidthFixed, -1, 1);
+			ImGui::TableSetupColumn("Computed", ImGuiTableColumnFlags_WidthFixed, -1, 2);
+			ImGui::TableSetupColumn("Status", ImGuiTableColumnFlags_WidthStretch, -1, 3);
+			ImGui::TableHeadersRow();
+
+			for (auto& it : m_Validation.tables)
+			{
+				ImGui::TableNextRow();
+				if (ImGui::TableSetColumnIndex(0)) ImGui::Text("%s", it.tag.c_str());
+				if (ImGui::TableSetColumnIndex(1)) ImGui::Text("0x%08X", it.storedCheckSum);
+				if (ImGui::TableSetColumnIndex(2)) ImGui::Text("0x%08X", it.computedCheckSum);
+				if (ImGui::TableSetColumnIndex(3))
+				{
+					if (!it.inFile) ImGui::Text("out of the file");
+					else if (it.storedCheckSum == it.computedCheckSum) ImGui::Text("ok");
+					else ImGui::Text("mismatch");
+				}
+			}
+
+			ImGui::EndTable();
+		}
+
+		ImGui::Separator();
+	}
+}
+
+// one thread, the generator is already multi threaded in batch mode
+bool FontParser::ValidateFontDatas(const uint8_t* vDatas, size_t vSize, const std::string& vFontName)
+{
+	FontAnalyser::FontAnalyzedStruct fontAnalyzed;
+	fontAnalyzed.parse(vDatas, vSize);
+
+	FontAnalyser::FontValidation validation;
+	fontAnalyzed.validate(&validation, 1U);
+
+	for (auto& it : validation.errors)
+	{
+		Messaging::Instance()->AddError(true, nullptr, nullptr, "%s not valid : %s", vFontName.c_str(), it.c_str());
+	}
+	for (auto& it : validation.warnings)
+	{
+		Messaging::Instance()->AddWarning(true, nullptr, nullptr, "%s : %s", vFontName.c_str(), it.c_str());
+	}
+
+	return validation.IsValid();
+}
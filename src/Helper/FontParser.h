@@ -22,6 +22,9 @@
 #include <vector>
 #include <map>
 #include <set>
+#include <list>
+#include <unordered_map>
+#include <memory>
 #include <utility> // std::pair
 
  //////////////////////////////////////////////////////////////////////////////////
@@ -29,15 +32,66 @@
 
 namespace FontAnalyser
 {
+	// the rows are formatted only when visible, from the parsed datas
+	// the fields are single rows, the arrays are blocks of rows with a formatter
 	class TableDisplay
 	{
+	public:
+		struct TableRow
+		{
+			const char* item = "";
+			const char* size = "";
+			char infos[256] = "";
+		};
+		// no capture, the table is given at the display, so the tables can be copied
+		typedef void(*RowFormatter)(const TableDisplay* vTable, size_t vIdx, TableRow* vRow);
+
 	private:
-		std::vector<std::vector<std::string>> array;
+		struct RowBlock
+		{
+			size_t firstRow = 0U;
+			size_t countRows = 0U;
+			RowFormatter formatter = nullptr; // if nullptr, item, size and infos are used
+			std::string item;
+			std::string size;
+			std::string infos;
+		};
+
+		std::vector<RowBlock> m_RowBlocks;
+		size_t m_CountRows = 0U;
 		ImGuiListClipper m_Clipper;
 
+	protected:
+		std::vector<std::string> m_Errors; // bounds and structure errors found by the parse
+
 	public:
-		void AddItem(std::string vItem, std::string vSize, std::string vInfos);
+		void AddItem(std::string vItem, std::string vSize, std::string vInfos); // one row
+		void AddItems(size_t vCountRows, RowFormatter vFormatter); // rows of an array, vIdx is the index in the array
 		void DisplayTable(const char* vTableLabel, size_t vMaxCount = 0);
+		void AddError(const std::string& vError);
+		void AddErrors(const TableDisplay& vSubTable); // the errors of a sub struct parsed by this one
+		const std::vector<std::string>& GetErrors() const { return m_Errors; }
+	};
+
+	//////////////////////////////////////
+
+	// table decoded only when his tree node is opened the first time
+	// only the location in the font is known before
+	class LazyTableDisplay : public TableDisplay
+	{
+	protected:
+		MemoryStream* m_Mem = nullptr;
+		size_t m_Offset = 0U;
+		size_t m_Length = 0U;
+		bool m_Decoded = false;
+
+	public:
+		virtual ~LazyTableDisplay() = default;
+		void SetLocation(MemoryStream* vMem, size_t vOffset, size_t vLength); // no decode
+		bool IsLocated() const { return m_Mem != nullptr; } // the table is in the font
+		void Decode(); // parse at the first call only
+		void Decode(MemoryStream* vMem); // same, with another stream on the same datas (one per thread)
+		virtual void parse(MemoryStream* vMem, size_t vOffset, size_t vLength) = 0;
 	};
 
 	//////////////////////////////////////
@@ -133,7 +187,7 @@ namespace FontAnalyser
 		void parse(MemoryStream* vMem, size_t vOffset, size_t vLength);
 	};
 
-	class nameTableStruct : public TableDisplay
+	class nameTableStruct : public LazyTableDisplay
 	{
 	public:
 		uint16_t version = 0;
@@ -143,12 +197,12 @@ namespace FontAnalyser
 
 	public:
 		int draw(int vWidgetId);
-		void parse(MemoryStream* vMem, size_t vOffset, size_t vLength);
+		void parse(MemoryStream* vMem, size_t vOffset, size_t vLength) override;
 	};
 
 	//////////////////////////////////////
 
-	class maxpTableStruct : public TableDisplay
+	class maxpTableStruct : public LazyTableDisplay
 	{
 	public:
 		MemoryStream::Fixed version;
@@ -169,7 +223,7 @@ namespace FontAnalyser
 
 	public:
 		int draw(int vWidgetId);
-		void parse(MemoryStream *vMem, size_t vOffset, size_t vLength);
+		void parse(MemoryStream *vMem, size_t vOffset, size_t vLength) override;
 	};
 
 	//////////////////////////////////////
@@ -189,7 +243,7 @@ namespace FontAnalyser
 		void parse(MemoryStream *vMem, size_t vOffset, size_t vLength);
 	};
 
-	class postTableStruct : public TableDisplay
+	class postTableStruct : public LazyTableDisplay
 	{
 	public:
 		MemoryStream::Fixed format;
@@ -205,12 +259,12 @@ namespace FontAnalyser
 
 	public:
 		int draw(int vWidgetId);
-		void parse(MemoryStream *vMem, size_t vOffset, size_t vLength);
+		void parse(MemoryStream *vMem, size_t vOffset, size_t vLength) override;
 	};
 
 	//////////////////////////////////////
 
-	class headTableStruct : public TableDisplay
+	class headTableStruct : public LazyTableDisplay
 	{
 	public:
 		MemoryStream::Fixed version;
@@ -233,7 +287,7 @@ namespace FontAnalyser
 
 	public:
 		int draw(int vWidgetId);
-		void parse(MemoryStream *vMem, size_t vOffset, size_t vLength);
+		void parse(MemoryStream *vMem, size_t vOffset, size_t vLength) override;
 	};
 
 	//////////////////////////////////////
@@ -293,7 +347,7 @@ namespace FontAnalyser
 		void parse(MemoryStream *vMem, size_t vOffset, size_t vLength);
 	};
 
-	class cmapTableStruct : public TableDisplay
+	class cmapTableStruct : public LazyTableDisplay
 	{
 	public:
 		uint16_t version = 0;
@@ -302,12 +356,12 @@ namespace FontAnalyser
 
 	public:
 		int draw(int vWidgetId);
-		void parse(MemoryStream *vMem, size_t vOffset, size_t vLength);
+		void parse(MemoryStream *vMem, size_t vOffset, size_t vLength) override;
 	};
 
 	//////////////////////////////////////
 
-	class locaTableStruct : public TableDisplay
+	class locaTableStruct : public LazyTableDisplay
 	{
 	public:
 		headTableStruct *head = 0;
@@ -318,7 +372,7 @@ namespace FontAnalyser
 		
 	public:
 		int draw(int vWidgetId);
-		void parse(MemoryStream *vMem, size_t vOffset, size_t vLength);
+		void parse(MemoryStream *vMem, size_t vOffset, size_t vLength) override;
 	};
 
 	//////////////////////////////////////
@@ -356,7 +410,7 @@ namespace FontAnalyser
 		void parse(MemoryStream* vMem, size_t vOffset, size_t vLength);
 	};
 
-	class colrTableStruct : public TableDisplay
+	class colrTableStruct : public LazyTableDisplay
 	{
 	public:
 		uint16_t version;
@@ -376,7 +430,7 @@ namespace FontAnalyser
 
 	public:
 		int draw(int vWidgetId);
-		void parse(MemoryStream* vMem, size_t vOffset, size_t vLength);
+		void parse(MemoryStream* vMem, size_t vOffset, size_t vLength) override;
 	};
 
 	//////////////////////////////////////
@@ -448,7 +502,7 @@ namespace FontAnalyser
 		void parse(MemoryStream* vMem, size_t vOffset, size_t vLength);
 	};
 
-	class cpalTableStruct : public TableDisplay
+	class cpalTableStruct : public LazyTableDisplay
 	{
 	public:
 		uint16_t version; // 0 => CPAL 0 / 1 => CPAL 1
@@ -457,7 +511,7 @@ namespace FontAnalyser
 
 	public:
 		int draw(int vWidgetId);
-		void parse(MemoryStream* vMem, size_t vOffset, size_t vLength);
+		void parse(MemoryStream* vMem, size_t vOffset, size_t vLength) override;
 	};
 
 	//////////////////////////////////////
@@ -501,6 +555,8 @@ namespace FontAnalyser
 		MemoryStream::F2DOT14 scale01;
 		MemoryStream::F2DOT14 scale10;
 
+		std::vector<uint16_t> glyphIndexs; // of all the components, the fields above are the ones of the last component
+
 	public:
 		int draw(int vWidgetId);
 		void parse(MemoryStream* vMem, size_t vOffset, size_t vLength, int16_t vCountContours);
@@ -537,28 +593,76 @@ namespace FontAnalyser
 
 	public:
 		int draw(int vWidgetId);
-		void parse(MemoryStream *vMem, size_t vOffset, size_t vLength);
+		void parse(MemoryStream *vMem, size_t vOffset, size_t vLength); // errors in GetErrors(), with the sub glyph ones
 	};
 
-	class glyfTableStruct : public TableDisplay
+	class glyfTableStruct : public LazyTableDisplay
 	{
+	public:
+		static const size_t MAX_DECODED_GLYFS = 256U; // lru, the older glyfs are decoded again if reopened
+
+	private:
+		struct DecodedGlyf
+		{
+			glyfStruct glyf;
+			std::list<uint32_t>::iterator orderIt; // in decodedOrder
+			int lastFrame = 0; // no eviction of a glyf displayed in the current frame
+		};
+
 	public:
 		locaTableStruct *loca = 0;
 
 	public:
-		std::vector<glyfStruct> glyfs;
+		std::vector<std::pair<uint32_t, uint32_t>> glyfLocations; // offset from the table start, length
+		
+	private:
+		std::unordered_map<uint32_t, DecodedGlyf> decodedGlyfs; // glyph index, glyf
+		std::list<uint32_t> decodedOrder; // glyph indexs, most recently displayed first
 
 	public:
 		int draw(int vWidgetId);
-		void parse(MemoryStream *vMem, size_t vOffset, size_t vLength);
+		void parse(MemoryStream *vMem, size_t vOffset, size_t vLength) override;
+
+	private:
+		glyfStruct* GetGlyf(uint32_t vGlyphIndex); // decoded if needed
 	};
 
 	//////////////////////////////////////
 
+	// big endian sum of the uint32 of the datas, the last one padded with zeros (table checksum of the spec)
+	// 4 words per step with sse2 or neon
+	uint32_t ComputeChecksum(const uint8_t* vDatas, size_t vSize);
+
+	struct TableValidation
+	{
+		std::string tag;
+		uint32_t storedCheckSum = 0U;
+		uint32_t computedCheckSum = 0U; // for head, computed with checkSumAdjustment as 0
+		bool inFile = true; // false if the table is out of the file
+	};
+
+	struct FontValidation
+	{
+		bool done = false;
+		std::vector<TableValidation> tables;
+		bool headFound = false;
+		uint32_t storedAdjustment = 0U; // head.checkSumAdjustment
+		uint32_t computedAdjustment = 0U;
+		std::vector<std::string> errors; // bad structure, checksum mismatch of a table
+		std::vector<std::string> warnings; // head checksum and adjustment, often not updated by the font tools
+		double checksumTimeInMs = 0.0;
+		double decodeTimeInMs = 0.0;
+
+		bool IsValid() const { return done && errors.empty(); }
+	};
+
 	class FontAnalyzedStruct
 	{
 	public:
 		bool parsed = false;
+		const uint8_t* fontDatas = nullptr; // not owned
+		size_t fontSize = 0U;
+		MemoryStream mem; // view on fontDatas, needed for decode the tables when opened
 		HeaderStruct header;
 		std::map<std::string, TableStruct> tables;
 		maxpTableStruct maxp;
@@ -573,23 +677,34 @@ namespace FontAnalyser
 
 	public:
 		int draw(int vWidgetId);
-		void parse(MemoryStream *vMem);
+		void parse(const uint8_t* vDatas, size_t vSize); // only the header and the table directory, vDatas must stay alive
+		// check the checksums of the tables and of the font, then decode the tables and every glyf on vCountThreads threads
+		// the bounds and structure errors found by the parse of the tables are errors of the validation
+		void validate(FontValidation* vValidation, size_t vCountThreads = 0U); // 0 => count of cores
 	};
 }
 
 //////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////
 
+class FontFileDatas;
 class FontParser
 {
 private:
+	std::shared_ptr<FontFileDatas> m_FontFileDatas; // viewed by m_FontAnalyzed
 	FontAnalyser::FontAnalyzedStruct m_FontAnalyzed;
+	FontAnalyser::FontValidation m_Validation;
 
 public:
 	FontParser();
 	~FontParser();
 
 	void ParseFont(const std::string& vFilePathName);
+	void ValidateFont(const std::string& vFilePathName); // parse if not the parsed font, and validate
 	int draw(int vWidgetId);
+	void drawValidation();
+
+	// for the generated fonts, the errors and warnings are added to Messaging
+	static bool ValidateFontDatas(const uint8_t* vDatas, size_t vSize, const std::string& vFontName);
 };
 
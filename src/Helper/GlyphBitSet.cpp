@@ -0,0 +1,237 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "GlyphBitSet.h"
+
+const uint32_t GlyphBitSet::BMP_SIZE;
+const uint32_t GlyphBitSet::PAGE_SIZE;
+const uint32_t GlyphBitSet::MAX_CODEPOINT;
+
+uint32_t GlyphBitSet::PopCount(uint64_t vWord)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return (uint32_t)__builtin_popcountll(vWord);
+#else
+	vWord = vWord - ((vWord >> 1) & 0x5555555555555555ULL);
+	vWord = (vWord & 0x3333333333333333ULL) + ((vWord >> 2) & 0x3333333333333333ULL);
+	vWord = (vWord + (vWord >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+	return (uint32_t)((vWord * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+uint32_t GlyphBitSet::CountTrailingZeros(uint64_t vWord)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return (uint32_t)__builtin_ctzll(vWord);
+#else
+	return PopCount((vWord & (0ULL - vWord)) - 1ULL); // bits under the lowest set bit
+#endif
+}
+
+uint64_t* GlyphBitSet::GetWord(uint32_t vCodePoint, bool vCreate)
+{
+	if (vCodePoint < BMP_SIZE)
+	{
+		if (m_Bmp.empty())
+		{
+			if (!vCreate)
+				return nullptr;
+			m_Bmp.resize(BMP_SIZE / 64U, 0U);
+		}
+		return &m_Bmp[vCodePoint / 64U];
+	}
+
+	if (vCodePoint > MAX_CODEPOINT)
+		return nullptr;
+
+	const uint32_t page = vCodePoint / PAGE_SIZE;
+	auto it = m_Pages.find(page);
+	if (it == m_Pages.end())
+	{
+		if (!vCreate)
+			return nullptr;
+		it = m_Pages.emplace(page, std::vector<uint64_t>(PAGE_SIZE / 64U, 0U)).first;
+	}
+	return &it->second[(vCodePoint % PAGE_SIZE) / 64U];
+}
+
+const uint64_t* GlyphBitSet::GetWord(uint32_t vCodePoint) const
+{
+	if (vCodePoint < BMP_SIZE)
+	{
+		if (m_Bmp.empty())
+			return nullptr;
+		return &m_Bmp[vCodePoint / 64U];
+	}
+
+	auto it = m_Pages.find(vCodePoint / PAGE_SIZE);
+	if (it == m_Pages.end())
+		return nullptr;
+	return &it->second[(vCodePoint % PAGE_SIZE) / 64U];
+}
+
+bool GlyphBitSet::Test(uint32_t vCodePoint) const
+{
+	const uint64_t* word = GetWord(vCodePoint);
+	return word && ((*word >> (vCodePoint % 64U)) & 1U);
+}
+
+void GlyphBitSet::Set(uint32_t vCodePoint)
+{
+	uint64_t* word = GetWord(vCodePoint, true);
+	if (word)
+		*word |= (1ULL << (vCodePoint % 64U));
+}
+
+void GlyphBitSet::Reset(uint32_t vCodePoint)
+{
+	uint64_t* word = GetWord(vCodePoint, false);
+	if (word)
+		*word &= ~(1ULL << (vCodePoint % 64U));
+}
+
+void GlyphBitSet::SetRange(uint32_t vFirst, uint32_t vLast, bool vValue)
+{
+	if (vValue)
+		ForEachWordOfRange(vFirst, vLast, true, [](uint64_t& vWord, uint64_t vMask) { vWord |= vMask; });
+	else
+		ForEachWordOfRange(vFirst, vLast, false, [](uint64_t& vWord, uint64_t vMask) { vWord &= ~vMask; });
+}
+
+void GlyphBitSet::InvertRange(uint32_t vFirst, uint32_t vLast)
+{
+	ForEachWordOfRange(vFirst, vLast, true, [](uint64_t& vWord, uint64_t vMask) { vWord ^= vMask; });
+}
+
+void GlyphBitSet::Add(const GlyphBitSet& vBitSet)
+{
+	if (!vBitSet.m_Bmp.empty())
+	{
+		if (m_Bmp.empty())
+			m_Bmp.resize(BMP_SIZE / 64U, 0U);
+		for (size_t i = 0; i < m_Bmp.size(); i++)
+			m_Bmp[i] |= vBitSet.m_Bmp[i];
+	}
+
+	for (const auto& it : vBitSet.m_Pages)
+	{
+		auto& page = m_Pages[it.first];
+		if (page.empty())
+			page.resize(PAGE_SIZE / 64U, 0U);
+		for (size_t i = 0; i < page.size(); i++)
+			page[i] |= it.second[i];
+	}
+}
+
+void GlyphBitSet::Remove(const GlyphBitSet& vBitSet)
+{
+	if (!m_Bmp.empty() && !vBitSet.m_Bmp.empty())
+	{
+		for (size_t i = 0; i < m_Bmp.size(); i++)
+			m_Bmp[i] &= ~vBitSet.m_Bmp[i];
+	}
+
+	for (const auto& it : vBitSet.m_Pages)
+	{
+		auto page = m_Pages.find(it.first);
+		if (page != m_Pages.end())
+		{
+			for (size_t i = 0; i < page->second.size(); i++)
+				page->second[i] &= ~it.second[i];
+		}
+	}
+}
+
+void GlyphBitSet::Clear()
+{
+	m_Bmp.clear();
+	m_Pages.clear();
+}
+
+bool GlyphBitSet::empty() const
+{
+	for (auto word : m_Bmp)
+		if (word)
+			return false;
+	for (const auto& it : m_Pages)
+		for (auto word : it.second)
+			if (word)
+				return false;
+	return true;
+}
+
+size_t GlyphBitSet::Count() const
+{
+	size_t res = 0U;
+	for (auto word : m_Bmp)
+		res += PopCount(word);
+	for (const auto& it : m_Pages)
+		for (auto word : it.second)
+			res += PopCount(word);
+	return res;
+}
+
+bool GlyphBitSet::GetFirst(uint32_t* vCodePoint) const
+{
+	for (size_t i = 0; i < m_Bmp.size(); i++)
+	{
+		if (m_Bmp[i])
+		{
+			*vCodePoint = (uint32_t)(i * 64U) + CountTrailingZeros(m_Bmp[i]);
+			return true;
+		}
+	}
+	for (const auto& it : m_Pages)
+	{
+		for (size_t i = 0; i < it.second.size(); i++)
+		{
+			if (it.second[i])
+			{
+				*vCodePoint = it.first * PAGE_SIZE + (uint32_t)(i * 64U) + CountTrailingZeros(it.second[i]);
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+bool GlyphBitSet::GetLast(uint32_t* vCodePoint) const
+{
+	auto lastOfWords = [vCodePoint](const std::vector<uint64_t>& vWords, uint32_t vFirstCodePoint)
+	{
+		for (size_t i = vWords.size(); i > 0U; i--)
+		{
+			uint64_t word = vWords[i - 1U];
+			if (word)
+			{
+				uint32_t bit = 63U;
+				while (!((word >> bit) & 1U))
+					bit--;
+				*vCodePoint = vFirstCodePoint + (uint32_t)((i - 1U) * 64U) + bit;
+				return true;
+			}
+		}
+		return false;
+	};
+
+	for (auto it = m_Pages.rbegin(); it != m_Pages.rend(); ++it)
+		if (lastOfWords(it->second, it->first * PAGE_SIZE))
+			return true;
+	return lastOfWords(m_Bmp, 0U);
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <vector>
+#include <map>
+#include <cstdint>
+#include <cstddef>
+
+/*
+set of codepoints, one bit per codepoint
+the bmp is 1024 words of 64 bits (8 KB), allocated at the first Set
+the supplementary planes are in sparse pages of 4096 codepoints (512 bytes), allocated when needed
+the range operations work on whole words, except the partial words of the range limits
+*/
+
+class GlyphBitSet
+{
+public:
+	static const uint32_t BMP_SIZE = 0x10000U;
+	static const uint32_t PAGE_SIZE = 4096U; // codepoints per page of the supplementary planes
+	static const uint32_t MAX_CODEPOINT = 0x10FFFFU;
+
+private:
+	std::vector<uint64_t> m_Bmp; // empty or BMP_SIZE / 64 words
+	std::map<uint32_t, std::vector<uint64_t>> m_Pages; // codepoint / PAGE_SIZE, PAGE_SIZE / 64 words
+
+public:
+	bool Test(uint32_t vCodePoint) const;
+	void Set(uint32_t vCodePoint);
+	void Reset(uint32_t vCodePoint);
+
+	void SetRange(uint32_t vFirst, uint32_t vLast, bool vValue); // vFirst to vLast included
+	void InvertRange(uint32_t vFirst, uint32_t vLast);
+	void Add(const GlyphBitSet& vBitSet); // or
+	void Remove(const GlyphBitSet& vBitSet); // and not
+
+	void Clear();
+	bool empty() const;
+	size_t Count() const;
+	bool GetFirst(uint32_t* vCodePoint) const; // false if empty
+	bool GetLast(uint32_t* vCodePoint) const;
+
+	// call vFunc(codepoint) for each codepoint in the set, in the codepoint order
+	template<typename T>
+	void ForEach(T vFunc) const
+	{
+		ForEachWords(m_Bmp, 0U, vFunc);
+		for (const auto& it : m_Pages)
+			ForEachWords(it.second, it.first * PAGE_SIZE, vFunc);
+	}
+
+public: // bits utils
+	static uint32_t PopCount(uint64_t vWord);
+	static uint32_t CountTrailingZeros(uint64_t vWord); // vWord must not be 0
+
+private:
+	uint64_t* GetWord(uint32_t vCodePoint, bool vCreate);
+	const uint64_t* GetWord(uint32_t vCodePoint) const;
+
+	// call vOp(word, mask) for each word of the range, the mask is the bits of the range in the word
+	template<typename T>
+	void ForEachWordOfRange(uint32_t vFirst, uint32_t vLast, bool vCreate, T vOp)
+	{
+		if (vFirst > vLast)
+			return;
+		if (vLast > MAX_CODEPOINT)
+			vLast = MAX_CODEPOINT;
+
+		uint32_t codePoint = vFirst;
+		while (codePoint <= vLast)
+		{
+			const uint32_t wordStart = codePoint & ~63U;
+			const uint32_t wordEnd = wordStart + 63U;
+			const uint32_t lo = codePoint - wordStart;
+			const uint32_t hi = ((vLast < wordEnd) ? vLast : wordEnd) - wordStart;
+			const uint64_t mask = ((hi == 63U) ? ~0ULL : ((1ULL << (hi + 1U)) - 1ULL)) & ~((1ULL << lo) - 1ULL);
+
+			uint64_t* word = GetWord(codePoint, vCreate);
+			if (word)
+				vOp(*word, mask);
+
+			if (wordEnd >= vLast)
+				break;
+			codePoint = wordEnd + 1U;
+		}
+	}
+
+	template<typename T>
+	static void ForEachWords(const std::vector<uint64_t>& vWords, uint32_t vFirstCodePoint, T vFunc)
+	{
+		for (size_t i = 0; i < vWords.size(); i++)
+		{
+			uint64_t word = vWords[i];
+			while (word)
+			{
+				vFunc(vFirstCodePoint + (uint32_t)(i * 64U) + CountTrailingZeros(word));
+				word &= word - 1U; // clear the lowest bit
+			}
+		}
+	}
+};
@@ -30,7 +30,9 @@ Messaging::~Messaging() = default;
 ///// PRIVATE /////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////////////
 
-static char Messaging_Message_Buffer[2048] = "\0";
+// thread_local for allow messages from the generation threads
+static thread_local char Messaging_Message_Buffer[2048] = "\0";
+static thread_local Messaging::MessagesCapture* Messaging_Thread_Capture = nullptr;
 
 void Messaging::AddMessage(MessageTypeEnum vType, bool vSelect, MessageData vDatas, const MessageFunc& vFunction, const char* fmt, va_list args)
 {
@@ -41,12 +43,25 @@ void Messaging::AddMessage(MessageTypeEnum vType, bool vSelect, MessageData vDat
 
 void Messaging::AddMessage(const std::string& vMsg, MessageTypeEnum vType, bool vSelect, MessageData vDatas, const MessageFunc& vFunction)
 {
+	if (Messaging_Thread_Capture)
+	{
+		Messaging_Thread_Capture->emplace_back(vMsg, vType, vDatas, vFunction);
+		return;
+	}
+
 	if (vSelect)
 	{
 		currentMsgIdx = (int32_t)m_Messages.size();
 	}
 
 	m_Messages.emplace_back(vMsg, vType, vDatas, vFunction);
+
+	if (vType == MessageTypeEnum::MESSAGE_TYPE_INFOS)
+		m_MessageExistFlags = (MessageExistFlags)(m_MessageExistFlags | MESSAGE_EXIST_INFOS);
+	else if (vType == MessageTypeEnum::MESSAGE_TYPE_WARNING)
+		m_MessageExistFlags = (MessageExistFlags)(m_MessageExistFlags | MESSAGE_EXIST_WARNING);
+	else if (vType == MessageTypeEnum::MESSAGE_TYPE_ERROR)
+		m_MessageExistFlags = (MessageExistFlags)(m_MessageExistFlags | MESSAGE_EXIST_ERROR);
 }
 
 bool Messaging::DrawMessage(const size_t& vMsgIdx)
@@ -170,7 +185,6 @@ void Messaging::AddInfos(bool vSelect, MessageData vDatas, const MessageFunc& vF
 	va_start(args, fmt);
 	AddMessage(MessageTypeEnum::MESSAGE_TYPE_INFOS, vSelect, vDatas, vFunction, fmt, args);
 	va_end(args);
-	m_MessageExistFlags = (MessageExistFlags)(m_MessageExistFlags | MESSAGE_EXIST_INFOS);
 }
 
 void Messaging::AddWarning(bool vSelect, MessageData vDatas, const MessageFunc& vFunction, const char* fmt, ...)
@@ -179,7 +193,6 @@ void Messaging::AddWarning(bool vSelect, MessageData vDatas, const MessageFunc&
 	va_start(args, fmt);
 	AddMessage(MessageTypeEnum::MESSAGE_TYPE_WARNING, vSelect, vDatas, vFunction, fmt, args);
 	va_end(args);
-	m_MessageExistFlags = (MessageExistFlags)(m_MessageExistFlags | MESSAGE_EXIST_WARNING);
 }
 
 void Messaging::AddError(bool vSelect, MessageData vDatas, const MessageFunc& vFunction, const char* fmt, ...)
@@ -188,7 +201,6 @@ void Messaging::AddError(bool vSelect, MessageData vDatas, const MessageFunc& vF
 	va_start(args, fmt);
 	AddMessage(MessageTypeEnum::MESSAGE_TYPE_ERROR, vSelect, vDatas, vFunction, fmt, args);
 	va_end(args);
-	m_MessageExistFlags = (MessageExistFlags)(m_MessageExistFlags | MESSAGE_EXIST_ERROR);
 }
 
 void Messaging::ClearErrors()
@@ -252,4 +264,40 @@ void Messaging::Clear()
 {
 	m_Messages.clear();
 	m_MessageExistFlags = MESSAGE_EXIST_NONE;
-}
\ No newline at end of file
+}
+bool Messaging::HaveErrors() const
+{
+	return (m_MessageExistFlags & MESSAGE_EXIST_ERROR) != 0;
+}
+
+void Messaging::PrintToConsole()
+{
+	for (const auto& msg : m_Messages)
+	{
+		const auto& type = std::get<1>(msg);
+		if (type == MessageTypeEnum::MESSAGE_TYPE_INFOS)
+			fprintf(stdout, "Infos : %s\n", std::get<0>(msg).c_str());
+		else if (type == MessageTypeEnum::MESSAGE_TYPE_WARNING)
+			fprintf(stderr, "Warning : %s\n", std::get<0>(msg).c_str());
+		else if (type == MessageTypeEnum::MESSAGE_TYPE_ERROR)
+			fprintf(stderr, "Error : %s\n", std::get<0>(msg).c_str());
+	}
+}
+
+void Messaging::BeginThreadCapture(MessagesCapture* vCapture)
+{
+	Messaging_Thread_Capture = vCapture;
+}
+
+void Messaging::EndThreadCapture()
+{
+	Messaging_Thread_Capture = nullptr;
+}
+
+void Messaging::AddCapturedMessages(const MessagesCapture& vCapture)
+{
+	for (const auto& msg : vCapture)
+	{
+		AddMessage(std::get<0>(msg), std::get<1>(msg), true, std::get<2>(msg), std::get<3>(msg));
+	}
+}
@@ -95,6 +95,14 @@ public:
 	void ClearWarnings();
 	void ClearInfos();
 	void Clear();
+	bool HaveErrors() const;
+	void PrintToConsole(); // for the headless mode, infos in stdout, warnings and errors in stderr
+
+public: // capture of the messages added by the current thread, flushed later in a deterministic order (parallel generation)
+	typedef std::vector<Messagekey> MessagesCapture;
+	void BeginThreadCapture(MessagesCapture* vCapture);
+	void EndThreadCapture();
+	void AddCapturedMessages(const MessagesCapture& vCapture);
 
 public: // singleton
 	static Messaging *Instance()
@@ -26,18 +26,180 @@
 #include <Panes/FinalFontPane.h>
 #include <Panes/GeneratorPane.h>
 #include <Project/ProjectFile.h>
+#include <Project/ProjectJournal.h>
 #include <Res/CustomFont.h>
 
 #define IMGUI_DEFINE_MATH_OPERATORS
 #include <imgui/imgui_internal.h>
 
 #include <cinttypes> // printf zu
+#include <algorithm>
+#include <cstring>
 
 static bool clickedFromLastFrame = false;
 
 SelectionHelper::SelectionHelper() = default;
 SelectionHelper::~SelectionHelper() = default;
 
+///////////////////////////////////////////////////////////////////////////////////////////
+//// FONT GLYPH SELECTION /////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////////////
+
+bool FontGlyphSelection::Test(uint32_t vCodePoint, const std::shared_ptr<FontInfos>& vFontInfos) const
+{
+	for (const auto& it : m_Fonts)
+	{
+		if (it.font == vFontInfos)
+			return it.bits.Test(vCodePoint);
+	}
+	return false;
+}
+
+void FontGlyphSelection::Set(uint32_t vCodePoint, const std::shared_ptr<FontInfos>& vFontInfos)
+{
+	auto bits = GetBits(vFontInfos, true);
+	if (bits)
+		bits->Set(vCodePoint);
+}
+
+void FontGlyphSelection::Reset(uint32_t vCodePoint, const std::shared_ptr<FontInfos>& vFontInfos)
+{
+	auto bits = GetBits(vFontInfos, false);
+	if (bits)
+		bits->Reset(vCodePoint);
+}
+
+GlyphBitSet* FontGlyphSelection::GetBits(const std::shared_ptr<FontInfos>& vFontInfos, bool vCreate)
+{
+	if (!vFontInfos)
+		return nullptr;
+
+	m_NeedOrderedUpdate = true;
+
+	for (auto& it : m_Fonts)
+	{
+		if (it.font == vFontInfos)
+			return &it.bits;
+	}
+
+	if (!vCreate)
+		return nullptr;
+
+	m_Fonts.emplace_back();
+	m_Fonts.back().font = vFontInfos;
+	return &m_Fonts.back().bits;
+}
+
+void FontGlyphSelection::Add(const FontGlyphSelection& vSelection)
+{
+	for (const auto& it : vSelection.m_Fonts)
+	{
+		auto bits = GetBits(it.font, true);
+		if (bits)
+			bits->Add(it.bits);
+	}
+}
+
+void FontGlyphSelection::Remove(const FontGlyphSelection& vSelection)
+{
+	for (const auto& it : vSelection.m_Fonts)
+	{
+		auto bits = GetBits(it.font, false);
+		if (bits)
+			bits->Remove(it.bits);
+	}
+}
+
+void FontGlyphSelection::Clear()
+{
+	m_Fonts.clear();
+	m_Ordered.clear();
+	m_NeedOrderedUpdate = false;
+}
+
+bool FontGlyphSelection::empty() const
+{
+	for (const auto& it : m_Fonts)
+	{
+		if (!it.bits.empty())
+			return false;
+	}
+	return true;
+}
+
+size_t FontGlyphSelection::size() const
+{
+	size_t res = 0U;
+	for (const auto& it : m_Fonts)
+		res += it.bits.Count();
+	return res;
+}
+
+bool FontGlyphSelection::GetLimits(uint32_t* vFirst, uint32_t* vLast) const
+{
+	bool found = false;
+
+	for (const auto& it : m_Fonts)
+	{
+		uint32_t first = 0U, last = 0U;
+		if (it.bits.GetFirst(&first) && it.bits.GetLast(&last))
+		{
+			if (!found || first < *vFirst) *vFirst = first;
+			if (!found || last > *vLast) *vLast = last;
+			found = true;
+		}
+	}
+
+	return found;
+}
+
+const std::vector<FontInfosCodePoint>& FontGlyphSelection::GetOrdered()
+{
+	if (m_NeedOrderedUpdate)
+	{
+		m_Ordered.clear();
+		for (const auto& it : m_Fonts)
+		{
+			const auto& font = it.font;
+			it.bits.ForEach([this, &font](uint32_t vCodePoint)
+			{
+				m_Ordered.emplace_back(vCodePoint, font);
+			});
+		}
+		std::sort(m_Ordered.begin(), m_Ordered.end()); // codepoint then font, like the old std::set
+		m_NeedOrderedUpdate = false;
+	}
+
+	return m_Ordered;
+}
+
+// call vOp(first, last) for each range of consecutive codepoints in the selected glyphs of the font
+template<typename T>
+static void ForEachSelectedGlyphsRange(const std::shared_ptr<FontInfos>& vFontInfos, T vOp)
+{
+	bool inRange = false;
+	uint32_t first = 0U, last = 0U;
+	for (const auto& glyph : vFontInfos->m_SelectedGlyphs)
+	{
+		if (!glyph.second)
+			continue;
+
+		if (inRange && glyph.first == last + 1U)
+		{
+			last = glyph.first;
+		}
+		else
+		{
+			if (inRange)
+				vOp(first, last);
+			first = last = glyph.first;
+			inRange = true;
+		}
+	}
+	if (inRange)
+		vOp(first, last);
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -51,7 +213,7 @@ TemporarySelectionStruct* SelectionHelper::getSelStruct(SelectionContainerEnum v
 }
 
 bool SelectionHelper::IsGlyphSelected(
-	std::shared_ptr<FontInfos> vFontInfos,
+	const std::shared_ptr<FontInfos>& vFontInfos,
 	SelectionContainerEnum vSelectionContainerEnum,
 	uint32_t vCodePoint)
 {
@@ -65,8 +227,7 @@ bool SelectionHelper::IsGlyphSelected(
 	}
 	else if (vSelectionContainerEnum == SelectionContainerEnum::SELECTION_CONTAINER_FINAL)
 	{
-		res = (m_SelectionForOperation.find(FontInfosCodePoint(vCodePoint, vFontInfos)) !=
-			m_SelectionForOperation.end()); // trouv?
+		res = m_SelectionForOperation.Test(vCodePoint, vFontInfos);
 	}
 
 	return res;
@@ -83,8 +244,7 @@ bool SelectionHelper::CanWeApplySelection(SelectionContainerEnum vSelectionConta
 	bool res = false;
 
 	auto s = getSelStruct(vSelectionContainerEnum);
-	size_t n = s->tmpSel.size() + s->tmpUnSel.size();
-	if (n > 0)
+	if (!s->tmpSel.empty() || !s->tmpUnSel.empty())
 	{
 		if (ImGui::IsWindowHovered() && s->startSelWindow)
 		{
@@ -307,6 +467,27 @@ void SelectionHelper::DrawSelectionMenu(ProjectFile * vProjectFile, SelectionCon
 			}
 		}
 
+		if (ImGui::MenuItem("Invert Selection", ""))
+		{
+			if (vSelectionContainerEnum == SelectionContainerEnum::SELECTION_CONTAINER_SOURCE)
+			{
+				InvertAllGlyphs(
+					vProjectFile, vProjectFile->m_SelectedFont,
+					vSelectionContainerEnum);
+			}
+			else if (vSelectionContainerEnum == SelectionContainerEnum::SELECTION_CONTAINER_FINAL)
+			{
+				for (auto font : vProjectFile->m_Fonts)
+				{
+					InvertAllGlyphs(
+						vProjectFile, font.second,
+						vSelectionContainerEnum);
+				}
+
+				FinalizeSelectionForOperations();
+			}
+		}
+
 		ImGui::EndMenu();
 	}
 }
@@ -331,7 +512,7 @@ void SelectionHelper::Load(ProjectFile* vProjectFile)
 				auto font = vProjectFile->GetFontWithFontName(ficdp_toload.second);
 				if (font)
 				{
-					m_SelectionForOperation.emplace(ficdp_toload.first, font);
+					m_SelectionForOperation.Set(ficdp_toload.first, font);
 				}
 			}
 
@@ -340,9 +521,9 @@ void SelectionHelper::Load(ProjectFile* vProjectFile)
 	}
 }
 
-std::set<FontInfosCodePoint>* SelectionHelper::GetSelection()
+const std::vector<FontInfosCodePoint>& SelectionHelper::GetSelection()
 {
-	return &m_SelectionForOperation;
+	return m_SelectionForOperation.GetOrdered();
 }
 
 void SelectionHelper::SelectWithToolOrApply(
@@ -384,7 +565,7 @@ void SelectionHelper::SelectWithToolOrApplyOnGlyph(
 }
 
 bool SelectionHelper::IsGlyphIntersectedAndSelected(
-	std::shared_ptr<FontInfos> vFontInfos, ImVec2 vCellSize, uint32_t vCodePoint, bool* vSelected,
+	const std::shared_ptr<FontInfos>& vFontInfos, ImVec2 vCellSize, uint32_t vCodePoint, bool* vSelected,
 	SelectionContainerEnum vSelectionContainerEnum)
 {
 	bool intersected = false;
@@ -439,7 +620,7 @@ bool SelectionHelper::IsGlyphIntersectedAndSelected(
 ///////////////////////////////////////////////////////////////////////////////////////////
 
 void SelectionHelper::GlyphSelectionIfIntersected(
-	std::shared_ptr<FontInfos> vFontInfos, ImVec2
+	const std::shared_ptr<FontInfos>& vFontInfos, ImVec2
 #ifdef _DEBUG 
 	vCaseSize
 #endif
@@ -538,7 +719,7 @@ void SelectionHelper::SelectByLine(ProjectFile * vProjectFile,
 
 // return true if intersected by line
 bool SelectionHelper::DrawGlyphSelectionByLine(
-	std::shared_ptr<FontInfos> vFontInfos,
+	const std::shared_ptr<FontInfos>& vFontInfos,
 	ImVec2 vCaseSize,
 	uint32_t vCodePoint,
 	bool* vSelected,
@@ -586,7 +767,7 @@ void SelectionHelper::SelectByZone(
 }
 
 bool SelectionHelper::DrawGlyphSelectionByZone(
-	std::shared_ptr<FontInfos> vFontInfos,
+	const std::shared_ptr<FontInfos>& vFontInfos,
 	ImVec2 vCaseSize,
 	uint32_t vCodePoint,
 	bool* vSelected,
@@ -646,64 +827,48 @@ void SelectionHelper::ApplySelection(ProjectFile * vProjectFile,
 				auto selStruct = getSelStruct(vSelectionContainerEnum);
 
 				// to Select
-				auto itSel = selStruct->tmpSel.begin();
-				while (itSel != selStruct->tmpSel.end())
+				selStruct->tmpSel.ForEachFont([this, vProjectFile, vSelectionContainerEnum](
+					const std::shared_ptr<FontInfos>& vFontInfos, GlyphBitSet& vBits)
 				{
-					const auto codePoint = *itSel; // attention, it is a copy
-
-					bool toErase = false;
-					if (codePoint.second)
+					if (vFontInfos->m_ImFontAtlas.IsBuilt())
 					{
-						if (codePoint.second->m_ImFontAtlas.IsBuilt())
+						ImFont* font = vFontInfos->GetImFont();
+						if (font)
 						{
-							ImFont* font = codePoint.second->GetImFont();
-							if (font)
+							vBits.ForEach([&](uint32_t vCodePoint)
 							{
-								auto ptr = font->FindGlyph((ImWchar)codePoint.first);
+								auto ptr = font->FindGlyph((ImWchar)vCodePoint);
 								if (ptr)
 								{
-									SelectGlyph(vProjectFile, codePoint.second, *ptr, false, vSelectionContainerEnum);
-									toErase = true;
+									SelectGlyph(vProjectFile, vFontInfos, *ptr, false, vSelectionContainerEnum);
+									vBits.Reset(vCodePoint); // applied
 								}
-							}
+							});
 						}
 					}
-
-					if (toErase)
-						itSel = selStruct->tmpSel.erase(itSel);
-					else
-						itSel++;
-				}
+				});
 
 				// to UnSelect
-				auto itUnSel = selStruct->tmpUnSel.begin();
-				while (itUnSel != selStruct->tmpUnSel.end())
+				selStruct->tmpUnSel.ForEachFont([this, vProjectFile, vSelectionContainerEnum](
+					const std::shared_ptr<FontInfos>& vFontInfos, GlyphBitSet& vBits)
 				{
-					const auto codePoint = *itUnSel; // attention, it is a copy
-
-					bool toErase = false;
-					if (codePoint.second)
+					if (vFontInfos->m_ImFontAtlas.IsBuilt())
 					{
-						if (codePoint.second->m_ImFontAtlas.IsBuilt())
+						ImFont* font = vFontInfos->GetImFont();
+						if (font)
 						{
-							ImFont* font = codePoint.second->GetImFont();
-							if (font)
+							vBits.ForEach([&](uint32_t vCodePoint)
 							{
-								auto ptr = font->FindGlyph((ImWchar)codePoint.first);
+								auto ptr = font->FindGlyph((ImWchar)vCodePoint);
 								if (ptr)
 								{
-									UnSelectGlyph(vProjectFile, codePoint.second, *ptr, false, vSelectionContainerEnum);
-									toErase = true;
+									UnSelectGlyph(vProjectFile, vFontInfos, *ptr, false, vSelectionContainerEnum);
+									vBits.Reset(vCodePoint); // applied
 								}
-							}
+							});
 						}
 					}
-
-					if (toErase)
-						itUnSel = selStruct->tmpUnSel.erase(itUnSel);
-					else
-						itUnSel++;
-				}
+				});
 
 				// update maps
 				PrepareSelection(vProjectFile, vSelectionContainerEnum);
@@ -712,23 +877,10 @@ void SelectionHelper::ApplySelection(ProjectFile * vProjectFile,
 			{
 				auto selStruct = getSelStruct(vSelectionContainerEnum);
 
-				// to Select
-				auto itSel = selStruct->tmpSel.begin();
-				while (itSel != selStruct->tmpSel.end())
-				{
-					const auto codePoint = *itSel; // attention, it is a copy
-					SelectGlyph(vProjectFile, codePoint.second, codePoint.first, false, vSelectionContainerEnum);
-					itSel = selStruct->tmpSel.erase(itSel);
-				}
-
-				// to UnSelect
-				auto itUnSel = selStruct->tmpUnSel.begin();
-				while (itUnSel != selStruct->tmpUnSel.end())
-				{
-					const auto codePoint = *itUnSel; // attention, it is a copy
-					UnSelectGlyph(vProjectFile, codePoint.second, codePoint.first, false, vSelectionContainerEnum);
-					itUnSel = selStruct->tmpUnSel.erase(itUnSel);
-				}
+				// word wide, for all the fonts
+				m_SelectionForOperation.Add(selStruct->tmpSel);
+				m_SelectionForOperation.Remove(selStruct->tmpUnSel);
+				selStruct->Clear();
 
 				FinalizeSelectionForOperations();
 			}
@@ -755,9 +907,20 @@ void SelectionHelper::SelectAllGlyphs(ProjectFile * vProjectFile, std::shared_pt
 
 					if (font)
 					{
-						for (const auto& glyph : font->Glyphs)
+						if (vFontInfos->m_PagedRasterization)
+						{
+							// all the glyphs of the font, not only the ones of the rasterized pages
+							for (uint32_t slot = 0; slot < (uint32_t)vFontInfos->m_GlyphTable.size(); slot++)
+							{
+								SelectGlyph(vProjectFile, vFontInfos, vFontInfos->GetGlyph(vFontInfos->m_GlyphTable.GetCodePoint(slot)), false, vSelectionContainerEnum);
+							}
+						}
+						else
 						{
-							SelectGlyph(vProjectFile, vFontInfos, glyph, false, vSelectionContainerEnum);
+							for (const auto& glyph : font->Glyphs)
+							{
+								SelectGlyph(vProjectFile, vFontInfos, glyph, false, vSelectionContainerEnum);
+							}
 						}
 
 						// update maps
@@ -768,13 +931,11 @@ void SelectionHelper::SelectAllGlyphs(ProjectFile * vProjectFile, std::shared_pt
 			}
 			else if (vSelectionContainerEnum == SelectionContainerEnum::SELECTION_CONTAINER_FINAL)
 			{
-				for (const auto& glyph : vFontInfos->m_SelectedGlyphs)
+				auto bits = m_SelectionForOperation.GetBits(vFontInfos, true);
+				ForEachSelectedGlyphsRange(vFontInfos, [bits](uint32_t vFirst, uint32_t vLast)
 				{
-					if (glyph.second)
-					{
-						SelectGlyph(vProjectFile, vFontInfos, glyph.second->glyph.Codepoint, false, vSelectionContainerEnum);
-					}
-				}
+					bits->SetRange(vFirst, vLast, true);
+				});
 
 				FinalizeSelectionForOperations();
 			}
@@ -797,9 +958,20 @@ void SelectionHelper::UnSelectAllGlyphs(ProjectFile * vProjectFile, std::shared_
 
 					if (font)
 					{
-						for (const auto& glyph : font->Glyphs)
+						if (vFontInfos->m_PagedRasterization)
 						{
-							UnSelectGlyph(vProjectFile, vFontInfos, glyph, false, vSelectionContainerEnum);
+							// all the glyphs of the font, not only the ones of the rasterized pages
+							for (uint32_t slot = 0; slot < (uint32_t)vFontInfos->m_GlyphTable.size(); slot++)
+							{
+								UnSelectGlyph(vProjectFile, vFontInfos, vFontInfos->GetGlyph(vFontInfos->m_GlyphTable.GetCodePoint(slot)), false, vSelectionContainerEnum);
+							}
+						}
+						else
+						{
+							for (const auto& glyph : font->Glyphs)
+							{
+								UnSelectGlyph(vProjectFile, vFontInfos, glyph, false, vSelectionContainerEnum);
+							}
 						}
 
 						// update maps
@@ -810,13 +982,73 @@ void SelectionHelper::UnSelectAllGlyphs(ProjectFile * vProjectFile, std::shared_
 			}
 			else if (vSelectionContainerEnum == SelectionContainerEnum::SELECTION_CONTAINER_FINAL)
 			{
-				for (const auto& glyph : vFontInfos->m_SelectedGlyphs)
+				auto bits = m_SelectionForOperation.GetBits(vFontInfos, false);
+				if (bits)
 				{
-					if (glyph.second)
+					ForEachSelectedGlyphsRange(vFontInfos, [bits](uint32_t vFirst, uint32_t vLast)
 					{
-						UnSelectGlyph(vProjectFile, vFontInfos, glyph.second->glyph.Codepoint, false, vSelectionContainerEnum);
+						bits->SetRange(vFirst, vLast, false);
+					});
+				}
+
+				FinalizeSelectionForOperations();
+			}
+		}
+	}
+}
+
+void SelectionHelper::InvertAllGlyphs(ProjectFile * vProjectFile, std::shared_ptr<FontInfos> vFontInfos,
+	SelectionContainerEnum vSelectionContainerEnum)
+{
+	if (vProjectFile && vProjectFile->IsLoaded())
+	{
+		if (vFontInfos.use_count())
+		{
+			if (vSelectionContainerEnum == SelectionContainerEnum::SELECTION_CONTAINER_SOURCE)
+			{
+				if (!vFontInfos->m_ImFontAtlas.Fonts.empty())
+				{
+					ImFont* font = vFontInfos->GetImFont();
+
+					if (font)
+					{
+						auto invertGlyph = [this, vProjectFile, &vFontInfos, vSelectionContainerEnum](const ImFontGlyph& vGlyph)
+						{
+							if (IsGlyphSelected(vFontInfos, vSelectionContainerEnum, vGlyph.Codepoint))
+								UnSelectGlyph(vProjectFile, vFontInfos, vGlyph.Codepoint, false, vSelectionContainerEnum);
+							else
+								SelectGlyph(vProjectFile, vFontInfos, vGlyph, false, vSelectionContainerEnum);
+						};
+
+						if (vFontInfos->m_PagedRasterization)
+						{
+							// all the glyphs of the font, not only the ones of the rasterized pages
+							for (uint32_t slot = 0; slot < (uint32_t)vFontInfos->m_GlyphTable.size(); slot++)
+							{
+								invertGlyph(vFontInfos->GetGlyph(vFontInfos->m_GlyphTable.GetCodePoint(slot)));
+							}
+						}
+						else
+						{
+							for (const auto& glyph : font->Glyphs)
+							{
+								invertGlyph(glyph);
+							}
+						}
+
+						// update maps
+						vProjectFile->UpdateCountSelectedGlyphs();
+						PrepareSelection(vProjectFile, vSelectionContainerEnum);
 					}
 				}
+			}
+			else if (vSelectionContainerEnum == SelectionContainerEnum::SELECTION_CONTAINER_FINAL)
+			{
+				auto bits = m_SelectionForOperation.GetBits(vFontInfos, true);
+				ForEachSelectedGlyphsRange(vFontInfos, [bits](uint32_t vFirst, uint32_t vLast)
+				{
+					bits->InvertRange(vFirst, vLast);
+				});
 
 				FinalizeSelectionForOperations();
 			}
@@ -833,10 +1065,13 @@ void SelectionHelper::SelectGlyph(ProjectFile * vProjectFile, std::shared_ptr<Fo
 		{
 			if (vSelectionContainerEnum == SelectionContainerEnum::SELECTION_CONTAINER_SOURCE)
 			{
-				if (vFontInfos->m_SelectedGlyphs.find(vGlyph.Codepoint) == vFontInfos->m_SelectedGlyphs.end()) // not found
+				auto it = vFontInfos->m_SelectedGlyphs.lower_bound(vGlyph.Codepoint);
+				if (it == vFontInfos->m_SelectedGlyphs.end() || it->first != vGlyph.Codepoint) // not found
 				{
 					std::string res = vFontInfos->GetGlyphName(vGlyph.Codepoint);
-					vFontInfos->m_SelectedGlyphs[vGlyph.Codepoint] = GlyphInfos::Create(vFontInfos, vGlyph, res, res);
+					it = vFontInfos->m_SelectedGlyphs.emplace_hint(it, vGlyph.Codepoint, GlyphInfos::Create(vFontInfos, vGlyph, res, res));
+					vFontInfos->m_GlyphOrderedIndex.AddGlyph(it->second);
+					ProjectJournal::Instance()->AddSelect(vFontInfos, vGlyph.Codepoint, res);
 					vProjectFile->SetProjectChange();
 
 					if (vUpdateMaps)
@@ -877,13 +1112,9 @@ void SelectionHelper::SelectGlyph(ProjectFile * vProjectFile, std::shared_ptr<Fo
 			}
 			else if (vSelectionContainerEnum == SelectionContainerEnum::SELECTION_CONTAINER_FINAL)
 			{
-				auto c = FontInfosCodePoint(vCodePoint, vFontInfos);
-				if (m_SelectionForOperation.find(c) == m_SelectionForOperation.end()) // not found
-				{
-					m_SelectionForOperation.emplace(c);
-				}
+				m_SelectionForOperation.Set(vCodePoint, vFontInfos);
 
-				FinalizeSelectionForOperations();
+				// FinalizeSelectionForOperations is called by the callers, once
 			}
 		}
 	}
@@ -914,7 +1145,8 @@ void SelectionHelper::UnSelectGlyph(ProjectFile * vProjectFile, std::shared_ptr<
 			{
 				if (vFontInfos->m_SelectedGlyphs.find(vCodePoint) != vFontInfos->m_SelectedGlyphs.end()) // found
 				{
-					vFontInfos->m_SelectedGlyphs.erase(vCodePoint);
+					vFontInfos->RemoveSelectedGlyph(vCodePoint);
+					ProjectJournal::Instance()->AddUnSelect(vFontInfos, vCodePoint);
 					vProjectFile->SetProjectChange();
 
 					if (vUpdateMaps)
@@ -926,13 +1158,9 @@ void SelectionHelper::UnSelectGlyph(ProjectFile * vProjectFile, std::shared_ptr<
 			}
 			else if (vSelectionContainerEnum == SelectionContainerEnum::SELECTION_CONTAINER_FINAL)
 			{
-				auto c = FontInfosCodePoint(vCodePoint, vFontInfos);
-				if (m_SelectionForOperation.find(c) != m_SelectionForOperation.end()) // found
-				{
-					m_SelectionForOperation.erase(c);
-				}
+				m_SelectionForOperation.Reset(vCodePoint, vFontInfos);
 
-				FinalizeSelectionForOperations();
+				// FinalizeSelectionForOperations is called by the callers, once
 			}
 		}
 	}
@@ -940,7 +1168,7 @@ void SelectionHelper::UnSelectGlyph(ProjectFile * vProjectFile, std::shared_ptr<
 
 void SelectionHelper::RemoveSelectionFromFinal(ProjectFile * vProjectFile)
 {
-	for (auto& codePoint : m_SelectionForOperation)
+	for (const auto& codePoint : m_SelectionForOperation.GetOrdered())
 	{
 		UnSelectGlyph(vProjectFile, codePoint, false, SelectionContainerEnum::SELECTION_CONTAINER_SOURCE);
 	}
@@ -952,25 +1180,25 @@ void SelectionHelper::RemoveSelectionFromFinal(ProjectFile * vProjectFile)
 
 void SelectionHelper::ReRange_Offset_After_Start(ProjectFile * vProjectFile, uint32_t vOffsetCodePoint)
 {
-	std::set<uint32_t> codePoints;
+	GlyphBitSet codePoints;
 	for (auto font : vProjectFile->m_Fonts)
 	{
-		for (auto& selection : font.second->m_SelectedGlyphs)
+		ForEachSelectedGlyphsRange(font.second, [&codePoints](uint32_t vFirst, uint32_t vLast)
 		{
-			codePoints.emplace(selection.first);
-		}
+			codePoints.SetRange(vFirst, vLast, true);
+		});
 	}
 
 	uint32_t pos = vOffsetCodePoint;
-	for (auto& codePoint : m_SelectionForOperation)
+	for (const auto& codePoint : m_SelectionForOperation.GetOrdered())
 	{
-		auto fontInfos = codePoint.second;
+		const auto& fontInfos = codePoint.second;
 		if (fontInfos)
 		{
-			while (codePoints.find(pos) != codePoints.end())
+			while (codePoints.Test(pos))
 				pos++;
 
-			if (codePoints.find(pos) == codePoints.end()) // not found
+			if (!codePoints.Test(pos)) // not found
 			{
 				if (fontInfos->m_SelectedGlyphs.find(codePoint.first) != fontInfos->m_SelectedGlyphs.end()) // found
 				{
@@ -978,7 +1206,7 @@ void SelectionHelper::ReRange_Offset_After_Start(ProjectFile * vProjectFile, uin
 					{
 						if (fontInfos->m_SelectedGlyphs[codePoint.first])
 						{
-							fontInfos->m_SelectedGlyphs[codePoint.first]->newCodePoint = pos;
+							fontInfos->m_SelectedGlyphs[codePoint.first]->SetNewCodePoint(pos);
 							pos++;
 							vProjectFile->SetProjectChange();
 						}
@@ -997,25 +1225,25 @@ void SelectionHelper::ReRange_Offset_After_Start(ProjectFile * vProjectFile, uin
 
 void SelectionHelper::ReRange_Offset_Before_End(ProjectFile * vProjectFile, uint32_t vOffsetCodePoint)
 {
-	std::set<uint32_t> codePoints;
+	GlyphBitSet codePoints;
 	for (auto font : vProjectFile->m_Fonts)
 	{
-		for (auto& selection : font.second->m_SelectedGlyphs)
+		ForEachSelectedGlyphsRange(font.second, [&codePoints](uint32_t vFirst, uint32_t vLast)
 		{
-			codePoints.emplace(selection.first);
-		}
+			codePoints.SetRange(vFirst, vLast, true);
+		});
 	}
 
 	uint32_t pos = vOffsetCodePoint;
-	for (auto& codePoint : m_SelectionForOperation)
+	for (const auto& codePoint : m_SelectionForOperation.GetOrdered())
 	{
-		auto fontInfos = codePoint.second;
+		const auto& fontInfos = codePoint.second;
 		if (fontInfos)
 		{
-			while (codePoints.find(pos) != codePoints.end())
+			while (codePoints.Test(pos))
 				pos--;
 
-			if (codePoints.find(pos) == codePoints.end()) // not found
+			if (!codePoints.Test(pos)) // not found
 			{
 				if (fontInfos->m_SelectedGlyphs.find(codePoint.first) != fontInfos->m_SelectedGlyphs.end()) // found
 				{
@@ -1023,7 +1251,7 @@ void SelectionHelper::ReRange_Offset_Before_End(ProjectFile * vProjectFile, uint
 					{
 						if (fontInfos->m_SelectedGlyphs[codePoint.first])
 						{
-							fontInfos->m_SelectedGlyphs[codePoint.first]->newCodePoint = pos;
+							fontInfos->m_SelectedGlyphs[codePoint.first]->SetNewCodePoint(pos);
 							pos--;
 							vProjectFile->SetProjectChange();
 						}
@@ -1393,95 +1621,16 @@ void SelectionHelper::AnalyseSourceSelection(ProjectFile * vProjectFile)
 		//Messaging::Instance()->ClearErrors();
 
 		// search for codepoint and names in double => an generate an error
-		std::set<std::string> namesGlobal; vProjectFile->m_NameFoundInDouble = false;
-		std::set<uint32_t> codePointsGlobal; vProjectFile->m_CodePointFoundInDouble = false;
-		std::set<std::string> namesLocal;
-		std::set<uint32_t> codePointsLocal;
+		// the indexs are updated at each glyph change, so only the fonts links are updated here
+		vProjectFile->UpdateGlyphOrderedIndexLinks();
+		vProjectFile->m_NameFoundInDouble = vProjectFile->m_GlyphOrderedIndex.IsNameInDouble();
+		vProjectFile->m_CodePointFoundInDouble = vProjectFile->m_GlyphOrderedIndex.IsCodePointInDouble();
 		for (const auto& font : vProjectFile->m_Fonts)
 		{
 			if (!font.second->m_NeedFilePathResolve) // if font have issue not take it into account
 			{
-				font.second->m_NameInDoubleFound = false;
-				font.second->m_CodePointInDoubleFound = false;
-				namesLocal.clear();
-				codePointsLocal.clear();
-
-				for (auto& selection : font.second->m_SelectedGlyphs)
-				{
-					// local in current font
-					if (!font.second->m_CodePointInDoubleFound)
-					{
-						if (selection.second)
-						{
-							if (codePointsLocal.find(selection.second->newCodePoint) == codePointsLocal.end()) // not found 
-							{
-								codePointsLocal.emplace(selection.second->newCodePoint);
-							}
-							else
-							{
-								// double detected => cast an error
-								font.second->m_CodePointInDoubleFound = true;
-							}
-						}
-					}
-
-					// local in current font
-					if (!font.second->m_NameInDoubleFound)
-					{
-						if (selection.second)
-						{
-							if (namesLocal.find(selection.second->newHeaderName) == namesLocal.end()) // not found 
-							{
-								namesLocal.emplace(selection.second->newHeaderName);
-							}
-							else
-							{
-								// double detected => cast an error
-								font.second->m_NameInDoubleFound = true;
-							}
-						}
-					}
-
-					// global for all fonts
-					if (!vProjectFile->m_CodePointFoundInDouble)
-					{
-						if (selection.second)
-						{
-							if (codePointsGlobal.find(selection.second->newCodePoint) == codePointsGlobal.end()) // not found 
-							{
-								codePointsGlobal.emplace(selection.second->newCodePoint);
-							}
-							else
-							{
-								// double detected => cast an error
-								vProjectFile->m_CodePointFoundInDouble = true;
-							}
-						}
-					}
-
-					// global for all fonts
-					if (!vProjectFile->m_NameFoundInDouble)
-					{
-						if (selection.second)
-						{
-							if (namesGlobal.find(selection.second->newHeaderName) == namesGlobal.end()) // not found 
-							{
-								namesGlobal.emplace(selection.second->newHeaderName);
-							}
-							else
-							{
-								// double detected => cast an error
-								vProjectFile->m_NameFoundInDouble = true;
-							}
-						}
-					}
-
-					if (vProjectFile->m_CodePointFoundInDouble &&
-						vProjectFile->m_NameFoundInDouble &&
-						font.second->m_CodePointInDoubleFound &&
-						font.second->m_NameInDoubleFound)
-						break;
-				}
+				font.second->m_NameInDoubleFound = font.second->m_GlyphOrderedIndex.IsNameInDouble();
+				font.second->m_CodePointInDoubleFound = font.second->m_GlyphOrderedIndex.IsCodePointInDouble();
 			}
 		}
 
@@ -1546,11 +1695,7 @@ void SelectionHelper::FinalizeSelectionForOperations()
 {
 	// Prepare re range min/max
 	uint32_t inf = 65535, sup = 0;
-	for (auto& it : m_SelectionForOperation)
-	{
-		inf = ct::mini<uint32_t>(inf, it.first);
-		sup = ct::maxi<uint32_t>(sup, it.first);
-	}
+	m_SelectionForOperation.GetLimits(&inf, &sup);
 	m_ReRangeStruct.startCodePoint.codePoint = inf;
 	m_ReRangeStruct.endCodePoint.codePoint = sup;
 }
@@ -1565,18 +1710,54 @@ std::string SelectionHelper::getXml(const std::string& vOffset, const std::strin
 
 	std::string res;
 
-	res += vOffset + "<finalselection>\n";
-	for (auto fi : m_SelectionForOperation)
+	XmlStreamWriter writer(&res);
+	WriteXml(writer, vOffset);
+
+	return res;
+}
+
+// the following codepoints of a font are saved in one selectionrun element :
+// <selectionrun orgId="first codepoint" count="n" font="font name"/>
+void SelectionHelper::WriteXml(XmlStreamWriter& vWriter, const std::string& vOffset)
+{
+	vWriter.Add(vOffset).Add("<finalselection>\n");
+	m_SelectionForOperation.ForEachFont([&vWriter, &vOffset](const std::shared_ptr<FontInfos>& vFontInfos, GlyphBitSet& vBits)
 	{
-		if (fi.second)
+		if (!vFontInfos)
+			return;
+
+		uint32_t firstCodePoint = 0U, countCodePoints = 0U;
+		auto writeRun = [&]()
 		{
-			res += vOffset + "\t<selection orgId=\"" +
-				ct::toStr(fi.first) + "\" font=\"" + fi.second->m_FontFileName + "\"/>\n";
-		}
-	}
-	res += vOffset + "</finalselection>\n";
+			if (countCodePoints == 1U)
+			{
+				vWriter.Add(vOffset).Add("\t<selection orgId=\"").AddUInt(firstCodePoint)
+					.Add("\" font=\"").Add(vFontInfos->m_FontFileName).Add("\"/>\n");
+			}
+			else if (countCodePoints > 1U)
+			{
+				vWriter.Add(vOffset).Add("\t<selectionrun orgId=\"").AddUInt(firstCodePoint)
+					.Add("\" count=\"").AddUInt(countCodePoints)
+					.Add("\" font=\"").Add(vFontInfos->m_FontFileName).Add("\"/>\n");
+			}
+		};
 
-	return res;
+		vBits.ForEach([&](uint32_t vCodePoint)
+		{
+			if (countCodePoints && vCodePoint == firstCodePoint + countCodePoints)
+			{
+				countCodePoints++;
+			}
+			else
+			{
+				writeRun();
+				firstCodePoint = vCodePoint;
+				countCodePoints = 1U;
+			}
+		});
+		writeRun();
+	});
+	vWriter.Add(vOffset).Add("</finalselection>\n");
 }
 
 bool SelectionHelper::setFromXml(tinyxml2::XMLElement* vElem, tinyxml2::XMLElement* vParent, const std::string& vUserDatas)
@@ -1596,31 +1777,30 @@ bool SelectionHelper::setFromXml(tinyxml2::XMLElement* vElem, tinyxml2::XMLEleme
 
 	if (strName == "finalselection")
 	{
+		// flat loop, a project can have tens of thousands of selected glyphs
 		for (tinyxml2::XMLElement* child = vElem->FirstChildElement(); child != nullptr; child = child->NextSiblingElement())
 		{
-			RecursParsingConfig(child->ToElement(), vElem);
-		}
-	}
+			const char* name = child->Name();
+			const char* font = child->Attribute("font");
+			if (!font)
+				continue;
 
-	if (strParentName == "finalselection")
-	{
-		if (strName == "selection")
-		{
-			FontInfosCodePoint_ToLoad fi;
-
-			for (const tinyxml2::XMLAttribute* attr = vElem->FirstAttribute(); attr != nullptr; attr = attr->Next())
+			if (strcmp(name, "selection") == 0)
 			{
-				std::string attName = attr->Name();
-				std::string attValue = attr->Value();
-
-				if (attName == "orgId")
-					fi.first = ct::fvariant(attValue).GetI();
-				else if (attName == "font")
-					fi.second = attValue;
+				m_SelectionForOperation_ToLoad.emplace(child->UnsignedAttribute("orgId"), font);
+			}
+			else if (strcmp(name, "selectionrun") == 0)
+			{
+				const std::string fontName = font;
+				const uint32_t firstCodePoint = child->UnsignedAttribute("orgId");
+				const uint32_t countCodePoints = ct::mini(child->UnsignedAttribute("count"), 0x110000U - ct::mini(firstCodePoint, 0x110000U));
+				auto hint = m_SelectionForOperation_ToLoad.end();
+				for (uint32_t i = 0U; i < countCodePoints; ++i)
+					hint = std::next(m_SelectionForOperation_ToLoad.emplace_hint(hint, firstCodePoint + i, fontName));
 			}
-
-			m_SelectionForOperation_ToLoad.emplace(fi);
 		}
+
+		return false; // childs already loaded, no recursion
 	}
 
 	return true;
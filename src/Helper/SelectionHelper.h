@@ -17,8 +17,11 @@
 
 #include <ctools/cTools.h>
 #include <ctools/ConfigAbstract.h>
+#include <Helper/GlyphBitSet.h>
+#include <Helper/XmlStreamWriter.h>
 #include <string>
 #include <set>
+#include <vector>
 #include <memory>
 
 enum GlyphSelectionTypeFlags
@@ -60,47 +63,80 @@ struct ReRangeStruct
 class FontInfos;
 struct ImGuiWindow;
 typedef std::pair<uint32_t, std::shared_ptr<FontInfos>> FontInfosCodePoint;
+
+// codepoints of several fonts, one bitset per font
+// the queries take the font by ref, so no shared_ptr copy
+class FontGlyphSelection
+{
+private:
+	struct FontBits
+	{
+		std::shared_ptr<FontInfos> font;
+		GlyphBitSet bits;
+	};
+	std::vector<FontBits> m_Fonts; // few fonts, linear search
+	std::vector<FontInfosCodePoint> m_Ordered; // by codepoint then font, rebuilt when needed
+	bool m_NeedOrderedUpdate = false;
+
+public:
+	bool Test(uint32_t vCodePoint, const std::shared_ptr<FontInfos>& vFontInfos) const;
+	void Set(uint32_t vCodePoint, const std::shared_ptr<FontInfos>& vFontInfos);
+	void Reset(uint32_t vCodePoint, const std::shared_ptr<FontInfos>& vFontInfos);
+	GlyphBitSet* GetBits(const std::shared_ptr<FontInfos>& vFontInfos, bool vCreate); // the bits can be modified
+	void Add(const FontGlyphSelection& vSelection);
+	void Remove(const FontGlyphSelection& vSelection);
+	void Clear();
+	bool empty() const;
+	size_t size() const;
+	bool GetLimits(uint32_t* vFirst, uint32_t* vLast) const; // codepoint limits of all the fonts
+	const std::vector<FontInfosCodePoint>& GetOrdered();
+
+	// call vFunc(font, bits) for each font, the bits can be modified
+	template<typename T>
+	void ForEachFont(T vFunc)
+	{
+		m_NeedOrderedUpdate = true;
+		for (auto& it : m_Fonts)
+			vFunc(it.font, it.bits);
+	}
+};
+
 struct TemporarySelectionStruct
 {
 	// for avoid selection apply if seletion ended outside of start window
 	ImGuiWindow *startSelWindow = 0;
 
-	std::set<FontInfosCodePoint> tmpSel;
-	std::set<FontInfosCodePoint> tmpUnSel;
+	FontGlyphSelection tmpSel;
+	FontGlyphSelection tmpUnSel;
 
-	bool isSelected(uint32_t c, std::shared_ptr<FontInfos> f)
+	bool isSelected(uint32_t c, const std::shared_ptr<FontInfos>& f) const
 	{
-		auto p = FontInfosCodePoint(c, f);
-		return (tmpSel.find(p) != tmpSel.end()); // found
+		return tmpSel.Test(c, f);
 	}
 	
-	bool isUnSelected(uint32_t c, std::shared_ptr<FontInfos> f)
+	bool isUnSelected(uint32_t c, const std::shared_ptr<FontInfos>& f) const
 	{
-		auto p = FontInfosCodePoint(c, f);
-		return (tmpUnSel.find(p) != tmpUnSel.end()); // found
+		return tmpUnSel.Test(c, f);
 	}
-	void Select(uint32_t c, std::shared_ptr<FontInfos> f)
+	void Select(uint32_t c, const std::shared_ptr<FontInfos>& f)
 	{
-		auto p = FontInfosCodePoint(c, f);
-		tmpSel.emplace(p);
-		tmpUnSel.erase(p);
+		tmpSel.Set(c, f);
+		tmpUnSel.Reset(c, f);
 	}
-	void UnSelect(uint32_t c, std::shared_ptr<FontInfos> f)
+	void UnSelect(uint32_t c, const std::shared_ptr<FontInfos>& f)
 	{
-		auto p = FontInfosCodePoint(c, f);
-		tmpSel.erase(p);
-		tmpUnSel.emplace(p);
+		tmpSel.Reset(c, f);
+		tmpUnSel.Set(c, f);
 	}
-	void Clear(uint32_t c, std::shared_ptr<FontInfos> f)
+	void Clear(uint32_t c, const std::shared_ptr<FontInfos>& f)
 	{
-		auto p = FontInfosCodePoint(c, f);
-		tmpSel.erase(p);
-		tmpUnSel.erase(p);
+		tmpSel.Reset(c, f);
+		tmpUnSel.Reset(c, f);
 	}
 	void Clear()
 	{
-		tmpSel.clear();
-		tmpUnSel.clear();
+		tmpSel.Clear();
+		tmpUnSel.Clear();
 	}
 };
 
@@ -115,7 +151,7 @@ private: // Vars
 	// pos x,y, radius z, default radius // if not active x,y == 0,0
 	ct::fvec4 m_Zone = ct::fvec4(0.0f, 0.0f, 0.5f, 0.5f);
 	// selection for operations in final pane
-	std::set<FontInfosCodePoint> m_SelectionForOperation;
+	FontGlyphSelection m_SelectionForOperation;
 	// first glyph state when clicked
 	// if not selected will apply unseletion
 	// if selected will apply selection
@@ -133,7 +169,7 @@ public:
 private:
 	TemporarySelectionStruct* getSelStruct(SelectionContainerEnum vSelectionContainerEnum);
 	bool IsGlyphSelected(
-		std::shared_ptr<FontInfos> vFontInfos,
+		const std::shared_ptr<FontInfos>& vFontInfos,
 		SelectionContainerEnum vSelectionContainerEnum,
 		uint32_t vCodePoint);
 	void StartSelection(SelectionContainerEnum vSelectionContainerEnum);
@@ -151,7 +187,7 @@ public:
 	void Load(ProjectFile* vProjectFile);
 
 public:
-	std::set<FontInfosCodePoint>* GetSelection();
+	const std::vector<FontInfosCodePoint>& GetSelection(); // ordered by codepoint
 public:
 	void SelectWithToolOrApply(
 		ProjectFile *vProjectFile, 
@@ -165,7 +201,7 @@ public:
 		bool vUpdateMaps,
 		SelectionContainerEnum vSelectionContainerEnum);
 	bool IsGlyphIntersectedAndSelected(
-		std::shared_ptr<FontInfos> vFontInfos,
+		const std::shared_ptr<FontInfos>& vFontInfos,
 		ImVec2 vCellSize, 
 		uint32_t vCodePoint,
 		bool *vSelected,
@@ -186,6 +222,8 @@ private:
 	
 	void UnSelectAllGlyphs(ProjectFile *vProjectFile, std::shared_ptr<FontInfos> vFontInfos,
 		SelectionContainerEnum vSelectionContainerEnum);
+	void InvertAllGlyphs(ProjectFile *vProjectFile, std::shared_ptr<FontInfos> vFontInfos,
+		SelectionContainerEnum vSelectionContainerEnum);
 	void UnSelectGlyph(ProjectFile *vProjectFile, std::shared_ptr<FontInfos> vFontInfos, ImFontGlyph vGlyph, bool vUpdateMaps,
 		SelectionContainerEnum vSelectionContainerEnum);
 	void UnSelectGlyph(ProjectFile *vProjectFile, FontInfosCodePoint vFontInfosCodePoint, bool vUpdateMaps,
@@ -207,7 +245,7 @@ private: // ReRange
 
 private: // selections mode common
 	void GlyphSelectionIfIntersected(
-		std::shared_ptr<FontInfos> vFontInfos,
+		const std::shared_ptr<FontInfos>& vFontInfos,
 		ImVec2 vCaseSize, uint32_t vCodePoint,
 		bool *vSelected,
 		SelectionContainerEnum vSelectionContainerEnum);
@@ -218,7 +256,7 @@ private: // selection by line
 	void SelectByLine(ProjectFile *vProjectFile, 
 		SelectionContainerEnum vSelectionContainerEnum);
 	bool DrawGlyphSelectionByLine(
-		std::shared_ptr<FontInfos> vFontInfos,
+		const std::shared_ptr<FontInfos>& vFontInfos,
 		ImVec2 vCaseSize, uint32_t vCodePoint,
 		bool *vSelected,
 		SelectionContainerEnum vSelectionContainerEnum);
@@ -227,7 +265,7 @@ private: // selection by zone
 	void SelectByZone(ProjectFile *vProjectFile, 
 		SelectionContainerEnum vSelectionContainerEnum);
 	bool DrawGlyphSelectionByZone(
-		std::shared_ptr<FontInfos> vFontInfos,
+		const std::shared_ptr<FontInfos>& vFontInfos,
 		ImVec2 vCaseSize, uint32_t vCodePoint,
 		bool *vSelected,
 		SelectionContainerEnum vSelectionContainerEnum);
@@ -256,6 +294,7 @@ private: // selection by range
 
 public:
 	std::string getXml(const std::string& vOffset, const std::string& vUserDatas = "");
+	void WriteXml(XmlStreamWriter& vWriter, const std::string& vOffset); // used by getXml and the project save
 	bool setFromXml(tinyxml2::XMLElement* vElem, tinyxml2::XMLElement* vParent, const std::string& vUserDatas = "");
 
 public: // singleton
@@ -0,0 +1,136 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "XmlStreamWriter.h"
+
+#include <cstring>
+
+XmlStreamWriter::XmlStreamWriter() = default;
+
+XmlStreamWriter::XmlStreamWriter(std::string* vString)
+{
+	m_String = vString;
+}
+
+XmlStreamWriter::~XmlStreamWriter()
+{
+	Close();
+}
+
+bool XmlStreamWriter::Open(const std::string& vFilePathName)
+{
+	Close();
+
+	m_WriteError = false;
+	m_BufferPos = 0U;
+
+#ifdef MSVC
+	if (fopen_s(&m_File, vFilePathName.c_str(), "wb") != 0)
+		m_File = nullptr;
+#else
+	m_File = fopen(vFilePathName.c_str(), "wb");
+#endif
+
+	if (m_File)
+		m_Buffer.resize(BUFFER_SIZE);
+
+	return m_File != nullptr;
+}
+
+bool XmlStreamWriter::Close()
+{
+	if (m_File)
+	{
+		Flush();
+		if (fclose(m_File) != 0)
+			m_WriteError = true;
+		m_File = nullptr;
+		return !m_WriteError;
+	}
+
+	return m_String != nullptr;
+}
+
+XmlStreamWriter& XmlStreamWriter::Add(const char* vStr)
+{
+	if (vStr)
+		Add(vStr, strlen(vStr));
+	return *this;
+}
+
+XmlStreamWriter& XmlStreamWriter::Add(const char* vStr, size_t vLen)
+{
+	if (m_String)
+	{
+		m_String->append(vStr, vLen);
+	}
+	else if (m_File)
+	{
+		if (m_BufferPos + vLen > m_Buffer.size())
+		{
+			Flush();
+			if (vLen > m_Buffer.size()) // too big for the buffer, direct write
+			{
+				if (fwrite(vStr, 1, vLen, m_File) != vLen)
+					m_WriteError = true;
+				return *this;
+			}
+		}
+		memcpy(m_Buffer.data() + m_BufferPos, vStr, vLen);
+		m_BufferPos += vLen;
+	}
+	return *this;
+}
+
+XmlStreamWriter& XmlStreamWriter::Add(const std::string& vStr)
+{
+	return Add(vStr.c_str(), vStr.size());
+}
+
+XmlStreamWriter& XmlStreamWriter::Add(char vChar)
+{
+	return Add(&vChar, 1U);
+}
+
+XmlStreamWriter& XmlStreamWriter::AddUInt(uint32_t vValue)
+{
+	char buf[16];
+	char* p = buf + sizeof(buf);
+	do
+	{
+		*--p = (char)('0' + vValue % 10U);
+		vValue /= 10U;
+	} while (vValue);
+	return Add(p, (size_t)(buf + sizeof(buf) - p));
+}
+
+XmlStreamWriter& XmlStreamWriter::AddBool(bool vValue)
+{
+	return vValue ? Add("true", 4U) : Add("false", 5U);
+}
+
+void XmlStreamWriter::Flush()
+{
+	if (m_File && m_BufferPos)
+	{
+		if (fwrite(m_Buffer.data(), 1, m_BufferPos, m_File) != m_BufferPos)
+			m_WriteError = true;
+		m_BufferPos = 0U;
+	}
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+
+/*
+xml writer for the big project files
+write directly in a file through a big buffer, or append to a string for the old getXml
+no temporary string per element, the values are written as is (no escaping, like the getXml's)
+*/
+
+class XmlStreamWriter
+{
+private:
+	static const size_t BUFFER_SIZE = 1U << 16U;
+
+private:
+	FILE* m_File = nullptr;
+	std::string* m_String = nullptr; // target if not a file
+	std::vector<char> m_Buffer;
+	size_t m_BufferPos = 0U;
+	bool m_WriteError = false;
+
+public:
+	XmlStreamWriter(); // for a file, need Open
+	explicit XmlStreamWriter(std::string* vString); // append to vString
+	~XmlStreamWriter(); // close the file if opened
+	XmlStreamWriter(const XmlStreamWriter&) = delete;
+	XmlStreamWriter& operator =(const XmlStreamWriter&) = delete;
+
+	bool Open(const std::string& vFilePathName);
+	bool Close(); // flush and close, false if a write have failed
+
+	XmlStreamWriter& Add(const char* vStr);
+	XmlStreamWriter& Add(const char* vStr, size_t vLen);
+	XmlStreamWriter& Add(const std::string& vStr);
+	XmlStreamWriter& Add(char vChar);
+	XmlStreamWriter& AddUInt(uint32_t vValue);
+	XmlStreamWriter& AddBool(bool vValue); // true / false
+
+private:
+	void Flush();
+};
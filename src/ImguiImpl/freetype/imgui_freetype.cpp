@@ -16,6 +16,7 @@
 // - v0.63: (2020/06/04) fix for rare case where FT_Get_Char_Index() succeed but FT_Load_Glyph() fails.
 // - v0.64: (2021/01/18) add FT_Error in loading function call flag for a way for get freetype error message when bad font file
 // - v0.65: (2021/01/20) add copy/past function form ImDraw and specific for COLOR support in freetype from PR : https://github.com/ocornut/imgui/pull/336, for avoid modification of ImDraw
+// - v0.66: (2021/02/10) render the glyphs on worker threads, each with its own FT_Face on the shared font data. Packing and blit are unchanged, so the atlas is the same as the serial path. see SetRasterizerThreadsCount()
 
 // Gamma Correct Blending:
 //  FreeType assumes blending in linear space rather than gamma space.
@@ -29,6 +30,9 @@
 #define IMGUI_DEFINE_MATH_OPERATORS
 #include "imgui_internal.h"     // ImMin,ImMax,ImFontAtlasBuild*,
 #include <stdint.h>
+#include <thread>
+#include <atomic>
+#include <vector>
 #include <ft2build.h>
 #include FT_FREETYPE_H          // <freetype/freetype.h>
 #include FT_MODULE_H            // <freetype/ftmodapi.h>
@@ -367,6 +371,79 @@ struct ImFontBuildDstDataFT
     ImBitVector         GlyphsSet;          // This is used to resolve collision when multiple sources are merged into a same destination font.
 };
 
+// A contiguous range of glyphs of one source font, rendered by one worker thread.
+// Each job write only the Info/BitmapData/Rects of its own glyphs and use its own bitmap buffers, so there is no sharing between jobs.
+struct ImFontBuildRasterJobFT
+{
+    int                 SrcIndex;
+    int                 GlyphStart;
+    int                 GlyphEnd;
+    bool                Done;               // false if the job failed to create its FT_Face, the glyphs are then rendered by the main thread
+    std::vector<std::vector<unsigned char> > BitmapBuffers; // Not IM_ALLOC(), the imgui allocators are not thread safe
+    int                 BitmapBufferUsedBytes;
+};
+
+static const int FT_BITMAP_BUFFERS_CHUNK_SIZE = 256 * 1024;
+static const int FT_MIN_GLYPHS_PER_JOB = 128;
+static thread_local unsigned int GImFreeTypeThreadsCount = 0; // 0 => count of cores, per calling thread
+
+static unsigned int* ImFontBuildAllocBitmapFT(ImFontBuildRasterJobFT* job, int size_in_bytes)
+{
+    if (job->BitmapBuffers.empty() || job->BitmapBufferUsedBytes + size_in_bytes > (int)job->BitmapBuffers.back().size())
+    {
+        job->BitmapBuffers.push_back(std::vector<unsigned char>((size_t)ImMax(FT_BITMAP_BUFFERS_CHUNK_SIZE, size_in_bytes)));
+        job->BitmapBufferUsedBytes = 0;
+    }
+    unsigned int* ptr = (unsigned int*)(job->BitmapBuffers.back().data() + job->BitmapBufferUsedBytes);
+    job->BitmapBufferUsedBytes += size_in_bytes;
+    return ptr;
+}
+
+// Render a range of glyphs into temporary bitmaps, and fill their rect sizes for the packing
+static void ImFontBuildRasterizeGlyphsFT(FreeTypeFont& font, ImFontBuildSrcDataFT& src_tmp, ImFontBuildRasterJobFT* job, unsigned char* multiply_table, int padding)
+{
+    for (int glyph_i = job->GlyphStart; glyph_i < job->GlyphEnd; glyph_i++)
+    {
+        ImFontBuildSrcGlyphFT& src_glyph = src_tmp.GlyphsList[glyph_i];
+
+        const FT_Glyph_Metrics* metrics = font.LoadGlyph(src_glyph.Codepoint);
+        if (metrics == NULL)
+            continue;
+
+        // Render glyph into a bitmap (currently held by FreeType)
+        const FT_Bitmap* ft_bitmap = font.RenderGlyphAndGetInfo(&src_glyph.Info);
+        IM_ASSERT(ft_bitmap);
+
+        // Blit rasterized pixels to our temporary buffer and keep a pointer to it.
+        const int bitmap_size_in_bytes = src_glyph.Info.Width * src_glyph.Info.Height * 4;
+        src_glyph.BitmapData = ImFontBuildAllocBitmapFT(job, bitmap_size_in_bytes);
+        font.BlitGlyph(ft_bitmap, src_glyph.BitmapData, src_glyph.Info.Width, multiply_table);
+
+        src_tmp.Rects[glyph_i].w = (stbrp_coord)(src_glyph.Info.Width + padding);
+        src_tmp.Rects[glyph_i].h = (stbrp_coord)(src_glyph.Info.Height + padding);
+    }
+}
+
+// Worker side : one FT_Library / FT_Face per job, on the font data shared with the main face (FT_New_Memory_Face doesn't copy it)
+// FT_Init_FreeType use the FreeType system allocator, who is thread safe
+static void ImFontBuildRunJobFT(ImFontAtlas* atlas, ImVector<ImFontBuildSrcDataFT>& src_tmp_array, ImFontBuildRasterJobFT* job, unsigned int extra_flags, unsigned char* multiply_table)
+{
+    FT_Library ft_library = NULL;
+    if (FT_Init_FreeType(&ft_library) != 0)
+        return;
+
+    FreeTypeFont font;
+    memset(&font, 0, sizeof(font));
+    if (font.InitFont(ft_library, atlas->ConfigData[job->SrcIndex], extra_flags, NULL))
+    {
+        ImFontBuildRasterizeGlyphsFT(font, src_tmp_array[job->SrcIndex], job, multiply_table, atlas->TexGlyphPadding);
+        job->Done = true;
+    }
+    font.CloseFont();
+
+    FT_Done_FreeType(ft_library);
+}
+
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////
 // EXTRACTED FROM IMDRAW AND MODIFIED FOR FREETYPE COLR SUPPORT
@@ -673,64 +750,87 @@ bool ImFontAtlasBuildWithFreeType(FT_Library ft_library, ImFontAtlas* atlas, uns
     // We could not find a way to retrieve accurate glyph size without rendering them.
     // (e.g. slot->metrics->width not always matching bitmap->width, especially considering the Oblique transform)
     // We allocate in chunks of 256 KB to not waste too much extra memory ahead. Hopefully users of FreeType won't find the temporary allocations.
-    const int BITMAP_BUFFERS_CHUNK_SIZE = 256 * 1024;
-    int buf_bitmap_current_used_bytes = 0;
-    ImVector<unsigned char*> buf_bitmap_buffers;
-    buf_bitmap_buffers.push_back((unsigned char*)IM_ALLOC(BITMAP_BUFFERS_CHUNK_SIZE));
+    // The buffers are owned by the jobs, see ImFontBuildRasterJobFT
 
-    // 4. Gather glyphs sizes so we can pack them in our virtual canvas.
-    // 8. Render/rasterize font characters into the texture
-    int total_surface = 0;
+    // Compute multiply tables if requested
+    ImVector<unsigned char> multiply_tables;
+    multiply_tables.resize(src_tmp_array.Size * 256);
+    for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+    {
+        ImFontConfig& cfg = atlas->ConfigData[src_i];
+        if (cfg.RasterizerMultiply != 1.0f)
+            ImFontAtlasBuildMultiplyCalcLookupTable(&multiply_tables[src_i * 256], cfg.RasterizerMultiply);
+    }
+
+    // Split the glyphs of each source font in jobs of contiguous ranges
+    unsigned int threads_count = GImFreeTypeThreadsCount ? GImFreeTypeThreadsCount : std::thread::hardware_concurrency();
+    threads_count = ImMax(threads_count, 1u);
+    std::vector<ImFontBuildRasterJobFT> jobs;
     int buf_rects_out_n = 0;
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
     {
         ImFontBuildSrcDataFT& src_tmp = src_tmp_array[src_i];
-        ImFontConfig& cfg = atlas->ConfigData[src_i];
         if (src_tmp.GlyphsCount == 0)
             continue;
 
         src_tmp.Rects = &buf_rects[buf_rects_out_n];
         buf_rects_out_n += src_tmp.GlyphsCount;
 
-        // Compute multiply table if requested
-        const bool multiply_enabled = (cfg.RasterizerMultiply != 1.0f);
-        unsigned char multiply_table[256];
-        if (multiply_enabled)
-            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
-
-        // Gather the sizes of all rectangles we will need to pack
-        const int padding = atlas->TexGlyphPadding;
-        for (int glyph_i = 0; glyph_i < src_tmp.GlyphsList.Size; glyph_i++)
+        const int jobs_count = ImClamp(src_tmp.GlyphsList.Size / FT_MIN_GLYPHS_PER_JOB, 1, (int)threads_count);
+        const int glyphs_per_job = (src_tmp.GlyphsList.Size + jobs_count - 1) / jobs_count;
+        for (int glyph_start = 0; glyph_start < src_tmp.GlyphsList.Size; glyph_start += glyphs_per_job)
         {
-            ImFontBuildSrcGlyphFT& src_glyph = src_tmp.GlyphsList[glyph_i];
-
-            const FT_Glyph_Metrics* metrics = src_tmp.Font.LoadGlyph(src_glyph.Codepoint);
-            if (metrics == NULL)
-                continue;
-
-            // Render glyph into a bitmap (currently held by FreeType)
-            const FT_Bitmap* ft_bitmap = src_tmp.Font.RenderGlyphAndGetInfo(&src_glyph.Info);
-            IM_ASSERT(ft_bitmap);
+            ImFontBuildRasterJobFT job;
+            job.SrcIndex = src_i;
+            job.GlyphStart = glyph_start;
+            job.GlyphEnd = ImMin(glyph_start + glyphs_per_job, src_tmp.GlyphsList.Size);
+            job.Done = false;
+            job.BitmapBufferUsedBytes = 0;
+            jobs.push_back(job);
+        }
+    }
 
-            // Allocate new temporary chunk if needed
-            const int bitmap_size_in_bytes = src_glyph.Info.Width * src_glyph.Info.Height * 4;
-            if (buf_bitmap_current_used_bytes + bitmap_size_in_bytes > BITMAP_BUFFERS_CHUNK_SIZE)
+    // 4. Gather glyphs sizes so we can pack them in our virtual canvas.
+    // 8. Render/rasterize font characters into the texture
+    if (threads_count > 1 && jobs.size() > 1)
+    {
+        std::atomic<int> next_job(0);
+        std::vector<std::thread> workers;
+        const unsigned int workers_count = ImMin(threads_count, (unsigned int)jobs.size());
+        for (unsigned int worker_i = 0; worker_i < workers_count; worker_i++)
+        {
+            workers.push_back(std::thread([&]()
             {
-                buf_bitmap_current_used_bytes = 0;
-                buf_bitmap_buffers.push_back((unsigned char*)IM_ALLOC(BITMAP_BUFFERS_CHUNK_SIZE));
-            }
-
-            // Blit rasterized pixels to our temporary buffer and keep a pointer to it.
-            src_glyph.BitmapData = (unsigned int*)(buf_bitmap_buffers.back() + buf_bitmap_current_used_bytes);
-            buf_bitmap_current_used_bytes += bitmap_size_in_bytes;
-            src_tmp.Font.BlitGlyph(ft_bitmap, src_glyph.BitmapData, src_glyph.Info.Width, multiply_enabled ? multiply_table : NULL);
-
-            src_tmp.Rects[glyph_i].w = (stbrp_coord)(src_glyph.Info.Width + padding);
-            src_tmp.Rects[glyph_i].h = (stbrp_coord)(src_glyph.Info.Height + padding);
-            total_surface += src_tmp.Rects[glyph_i].w * src_tmp.Rects[glyph_i].h;
+                for (int job_i = next_job++; job_i < (int)jobs.size(); job_i = next_job++)
+                {
+                    ImFontBuildRasterJobFT& job = jobs[job_i];
+                    ImFontConfig& cfg = atlas->ConfigData[job.SrcIndex];
+                    ImFontBuildRunJobFT(atlas, src_tmp_array, &job, extra_flags,
+                        (cfg.RasterizerMultiply != 1.0f) ? &multiply_tables[job.SrcIndex * 256] : NULL);
+                }
+            }));
         }
+        for (auto& worker : workers)
+            worker.join();
     }
 
+    // Serial path, and the jobs who have failed, with the main face of the source font
+    for (auto& job : jobs)
+    {
+        if (job.Done)
+            continue;
+        ImFontBuildSrcDataFT& src_tmp = src_tmp_array[job.SrcIndex];
+        ImFontConfig& cfg = atlas->ConfigData[job.SrcIndex];
+        ImFontBuildRasterizeGlyphsFT(src_tmp.Font, src_tmp, &job,
+            (cfg.RasterizerMultiply != 1.0f) ? &multiply_tables[job.SrcIndex * 256] : NULL, atlas->TexGlyphPadding);
+        job.Done = true;
+    }
+
+    // Sum in the glyph order, like the serial path
+    int total_surface = 0;
+    for (int rect_i = 0; rect_i < buf_rects_out_n; rect_i++)
+        total_surface += buf_rects[rect_i].w * buf_rects[rect_i].h;
+
     // We need a width for the skyline algorithm, any width!
     // The exact width doesn't really matter much, but some API/GPU have texture size limitations and increasing width can decrease height.
     // User can override TexDesiredWidth and TexGlyphPadding if they wish, otherwise we use a simple heuristic to select the width based on expected surface.
@@ -854,8 +954,7 @@ bool ImFontAtlasBuildWithFreeType(FT_Library ft_library, ImFontAtlas* atlas, uns
     }
 
     // Cleanup
-    for (int buf_i = 0; buf_i < buf_bitmap_buffers.Size; buf_i++)
-        IM_FREE(buf_bitmap_buffers[buf_i]);
+    jobs.clear(); // the temporary bitmaps
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
         src_tmp_array[src_i].~ImFontBuildSrcDataFT();
 
@@ -941,6 +1040,11 @@ bool ImGuiFreeType::BuildFontAtlas(ImFontAtlas* atlas, unsigned int extra_flags,
     return ret;
 }
 
+void ImGuiFreeType::SetRasterizerThreadsCount(unsigned int threads_count)
+{
+    GImFreeTypeThreadsCount = threads_count;
+}
+
 void ImGuiFreeType::SetAllocatorFunctions(void* (*alloc_func)(size_t sz, void* user_data), void (*free_func)(void* ptr, void* user_data), void* user_data)
 {
     GImFreeTypeAllocFunc = alloc_func;
@@ -39,6 +39,11 @@ namespace ImGuiFreeType
 
     IMGUI_API bool BuildFontAtlas(ImFontAtlas* atlas, unsigned int extra_flags = 0, FT_Error* vFreetypeError = 0);
 
+    // Count of threads used for render the glyphs in BuildFontAtlas(). 0 (default) => count of cores, 1 => serial.
+    // The atlas is the same whatever the count of threads.
+    // The count is per calling thread, so threads who already build atlases in parallel can set 1 for themselves.
+    IMGUI_API void SetRasterizerThreadsCount(unsigned int threads_count);
+
     // By default ImGuiFreeType will use IM_ALLOC()/IM_FREE().
     // However, as FreeType does lots of allocations we provide a way for the user to redirect it to a separate memory heap if desired:
     IMGUI_API void SetAllocatorFunctions(void* (*alloc_func)(size_t sz, void* user_data), void (*free_func)(void* ptr, void* user_data), void* user_data = NULL);
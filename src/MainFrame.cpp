@@ -41,8 +41,11 @@
 #include <Panes/ParamsPane.h>
 #include <Project/FontInfos.h>
 #include <Project/ProjectFile.h>
+#include <Project/ProjectJournal.h>
 #include <Res/CustomFont.h>
 #include <Helper/AssetManager.h>
+#include <Helper/AtlasCache.h>
+#include <Helper/FontLoader.h>
 
 #define IMGUI_DEFINE_MATH_OPERATORS
 #include <imgui/imgui_internal.h>
@@ -85,6 +88,8 @@ void MainFrame::Init()
 
 void MainFrame::Unit()
 {
+	FontLoader::Instance()->Unit();
+	ProjectJournal::Instance()->Discard(&m_ProjectFile); // normal close, the unsaved edits was saved or dropped by the user
 	SaveConfigFile("config.xml");
 }
 
@@ -98,14 +103,19 @@ void MainFrame::LoadProject(const std::string& vFilePathName)
 {
 	if (m_ProjectFile.LoadAs(vFilePathName))
 	{
+		const bool restoredEdits = m_ProjectFile.IsThereAnyNotSavedChanged(); // by the journal
 		SetAppTitle(vFilePathName);
+		std::vector<std::string> absPaths; // the loader remove the fonts from m_Fonts during the loading
 		for (auto it : m_ProjectFile.m_Fonts)
 		{
-			std::string absPath = m_ProjectFile.GetAbsolutePath(it.second->m_FontFilePathName);
-			ParamsPane::Instance()->OpenFont(&m_ProjectFile, absPath, false);
+			absPaths.push_back(m_ProjectFile.GetAbsolutePath(it.second->m_FontFilePathName));
+		}
+		for (const auto& absPath : absPaths)
+		{
+			FontLoader::Instance()->LoadFont(&m_ProjectFile, absPath, false);
 		}
 		m_ProjectFile.UpdateCountSelectedGlyphs();
-		m_ProjectFile.SetProjectChange(false);
+		m_ProjectFile.SetProjectChange(restoredEdits);
 	}
 }
 
@@ -142,6 +152,9 @@ void MainFrame::Display(ImVec2 vPos, ImVec2 vSize)
 	m_DisplayPos = vPos;
 	m_DisplaySize = vSize;
 
+	FontLoader::Instance()->FinishLoadedFonts(&m_ProjectFile); // texture upload of the fonts loaded since the last frame
+	ProjectJournal::Instance()->FlushIfNeeded(); // the glyph edits of the last seconds
+
 	DrawDockPane(m_DisplayPos, m_DisplaySize);
 
 	widgetId = LayoutManager::Instance()->DisplayPanes(&m_ProjectFile, widgetId);
@@ -895,6 +908,7 @@ std::string MainFrame::getXml(const std::string& vOffset, const std::string& vUs
 
 	str += ImGuiThemeHelper::Instance()->getXml(vOffset);
 	str += LayoutManager::Instance()->getXml(vOffset, "app");
+	str += AtlasCache::Instance()->getXml(vOffset);
 	str += vOffset + "<bookmarks>" + ImGuiFileDialog::Instance()->SerializeBookmarks() + "</bookmarks>\n";
 	str += vOffset + "<showaboutdialog>" + (m_ShowAboutDialog ? "true" : "false") + "</showaboutdialog>\n";
 	str += vOffset + "<showimgui>" + (m_ShowImGui ? "true" : "false") + "</showimgui>\n";
@@ -922,6 +936,7 @@ bool MainFrame::setFromXml(tinyxml2::XMLElement* vElem, tinyxml2::XMLElement* vP
 
 	ImGuiThemeHelper::Instance()->setFromXml(vElem, vParent);
 	LayoutManager::Instance()->setFromXml(vElem, vParent, "app");
+	AtlasCache::Instance()->setFromXml(vElem, vParent);
 
 	if (strName == "bookmarks")
 		ImGuiFileDialog::Instance()->DeserializeBookmarks(strValue);
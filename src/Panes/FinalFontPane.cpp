@@ -105,42 +105,27 @@ void FinalFontPane::DrawFinalFontPane(ProjectFile *vProjectFile)
 								&m_FinalFontPaneModeFlags, 
 								FinalFontPaneModeFlags::FINAL_FONT_PANE_BY_FONT_NO_ORDER, true);
 
-							if (ImGui::MenuItem<FinalFontPaneModeFlags>("by Font, ordered by CodePoint", "",
+							ImGui::MenuItem<FinalFontPaneModeFlags>("by Font, ordered by CodePoint", "",
 								&m_FinalFontPaneModeFlags , 
-								FinalFontPaneModeFlags::FINAL_FONT_PANE_BY_FONT_ORDERED_BY_CODEPOINT, true))
-							{
-								PrepareSelectionByFontOrderedByCodePoint(vProjectFile);
-							}
+								FinalFontPaneModeFlags::FINAL_FONT_PANE_BY_FONT_ORDERED_BY_CODEPOINT, true);
 
-							if (ImGui::MenuItem<FinalFontPaneModeFlags>("by Font, ordered by Name", "",
+							ImGui::MenuItem<FinalFontPaneModeFlags>("by Font, ordered by Name", "",
 								&m_FinalFontPaneModeFlags , 
-								FinalFontPaneModeFlags::FINAL_FONT_PANE_BY_FONT_ORDERED_BY_NAMES, true))
-							{
-								PrepareSelectionByFontOrderedByGlyphNames(vProjectFile);
-							}
+								FinalFontPaneModeFlags::FINAL_FONT_PANE_BY_FONT_ORDERED_BY_NAMES, true);
 
 							ImGui::Spacing();
 
-							if (ImGui::MenuItem<FinalFontPaneModeFlags>("Merged, no order", "",
+							ImGui::MenuItem<FinalFontPaneModeFlags>("Merged, no order", "",
 								&m_FinalFontPaneModeFlags , 
-								FinalFontPaneModeFlags::FINAL_FONT_PANE_MERGED_NO_ORDER, true))
-							{
-								PrepareSelectionMergedNoOrder(vProjectFile);
-							}
+								FinalFontPaneModeFlags::FINAL_FONT_PANE_MERGED_NO_ORDER, true);
 
-							if (ImGui::MenuItem<FinalFontPaneModeFlags>("Merged, ordered by CodePoint", "",
+							ImGui::MenuItem<FinalFontPaneModeFlags>("Merged, ordered by CodePoint", "",
 								&m_FinalFontPaneModeFlags , 
-								FinalFontPaneModeFlags::FINAL_FONT_PANE_MERGED_ORDERED_BY_CODEPOINT, true))
-							{
-								PrepareSelectionMergedOrderedByCodePoint(vProjectFile);
-							}
+								FinalFontPaneModeFlags::FINAL_FONT_PANE_MERGED_ORDERED_BY_CODEPOINT, true);
 
-							if (ImGui::MenuItem<FinalFontPaneModeFlags>("Merged, ordered by Name", "",
+							ImGui::MenuItem<FinalFontPaneModeFlags>("Merged, ordered by Name", "",
 								&m_FinalFontPaneModeFlags , 
-								FinalFontPaneModeFlags::FINAL_FONT_PANE_MERGED_ORDERED_BY_NAMES, true))
-							{
-								PrepareSelectionMergedOrderedByGlyphNames(vProjectFile);
-							}
+								FinalFontPaneModeFlags::FINAL_FONT_PANE_MERGED_ORDERED_BY_NAMES, true);
 
 							ImGui::EndMenu();
 						}
@@ -173,6 +158,9 @@ void FinalFontPane::DrawFinalFontPane(ProjectFile *vProjectFile)
 						ImGui::EndMenuBar();
 					}
 
+					// only check the links of the fonts, for the loaded or removed ones
+					PrepareSelection(vProjectFile);
+
 					if (m_FinalFontPaneModeFlags & FinalFontPaneModeFlags::FINAL_FONT_PANE_BY_FONT_NO_ORDER)
 					{
 						DrawSelectionsByFontNoOrder(vProjectFile, vProjectFile->m_FinalPane_ShowGlyphTooltip);
@@ -226,19 +214,13 @@ void FinalFontPane::DrawSelectedFontPane(ProjectFile *vProjectFile)
 					{
 						if (ImGui::BeginMenu("Sorting"))
 						{
-							if (ImGui::MenuItem<SelectedFontPaneModeFlags>("by CodePoint", "",
+							ImGui::MenuItem<SelectedFontPaneModeFlags>("by CodePoint", "",
 								&m_SelectedFontPaneModeFlags,
-								SelectedFontPaneModeFlags::SELECTED_FONT_PANE_ORDERED_BY_CODEPOINT, true))
-							{
-								PrepareSelectionByFontOrderedByCodePoint(vProjectFile);
-							}
+								SelectedFontPaneModeFlags::SELECTED_FONT_PANE_ORDERED_BY_CODEPOINT, true);
 
-							if (ImGui::MenuItem<SelectedFontPaneModeFlags>("by Name", "",
+							ImGui::MenuItem<SelectedFontPaneModeFlags>("by Name", "",
 								&m_SelectedFontPaneModeFlags,
-								SelectedFontPaneModeFlags::SELECTED_FONT_PANE_ORDERED_BY_NAMES, true))
-							{
-								PrepareSelectionByFontOrderedByGlyphNames(vProjectFile);
-							}
+								SelectedFontPaneModeFlags::SELECTED_FONT_PANE_ORDERED_BY_NAMES, true);
 
 							ImGui::EndMenu();
 						}
@@ -299,40 +281,13 @@ bool FinalFontPane::IsSelectedFontPaneMode(SelectedFontPaneModeFlags vSelectedFo
 	return (m_SelectedFontPaneModeFlags & vSelectedFontPaneModeFlags) == vSelectedFontPaneModeFlags; // check
 }
 
+// the per font indexs are updated at each selection / rename / re range (see GlyphOrderedIndex)
+// so here we only link the fonts of the project to the merged index of the project, and unlink the removed ones
 void FinalFontPane::PrepareSelection(ProjectFile *vProjectFile)
 {
-	if (IsSelectedFontPaneMode(SelectedFontPaneModeFlags::SELECTED_FONT_PANE_ORDERED_BY_CODEPOINT))
-	{
-		PrepareSelectionByFontOrderedByCodePoint(vProjectFile);
-	}
-	else if (IsSelectedFontPaneMode(SelectedFontPaneModeFlags::SELECTED_FONT_PANE_ORDERED_BY_NAMES))
-	{
-		PrepareSelectionByFontOrderedByGlyphNames(vProjectFile);
-	}
-
-	if (IsFinalFontPaneMode(FinalFontPaneModeFlags::FINAL_FONT_PANE_BY_FONT_NO_ORDER))
-	{
-		// nothing to prepare because this is the default view => pointed on FontInfos->m_SelectedGlyphs
-	}
-	else if (IsFinalFontPaneMode(FinalFontPaneModeFlags::FINAL_FONT_PANE_BY_FONT_ORDERED_BY_CODEPOINT))
-	{
-		PrepareSelectionByFontOrderedByCodePoint(vProjectFile);
-	}
-	else if (IsFinalFontPaneMode(FinalFontPaneModeFlags::FINAL_FONT_PANE_BY_FONT_ORDERED_BY_NAMES))
-	{
-		PrepareSelectionByFontOrderedByGlyphNames(vProjectFile);
-	}
-	else if (IsFinalFontPaneMode(FinalFontPaneModeFlags::FINAL_FONT_PANE_MERGED_NO_ORDER))
-	{
-		PrepareSelectionMergedNoOrder(vProjectFile);
-	}
-	else if (IsFinalFontPaneMode(FinalFontPaneModeFlags::FINAL_FONT_PANE_MERGED_ORDERED_BY_CODEPOINT))
-	{
-		PrepareSelectionMergedOrderedByCodePoint(vProjectFile);
-	}
-	else if (IsFinalFontPaneMode(FinalFontPaneModeFlags::FINAL_FONT_PANE_MERGED_ORDERED_BY_NAMES))
+	if (vProjectFile)
 	{
-		PrepareSelectionMergedOrderedByGlyphNames(vProjectFile);
+		vProjectFile->UpdateGlyphOrderedIndexLinks();
 	}
 }
 
@@ -343,7 +298,6 @@ void FinalFontPane::PrepareSelection(ProjectFile *vProjectFile)
 bool FinalFontPane::DrawGlyph(ProjectFile *vProjectFile, 
 	std::shared_ptr<FontInfos> vFontInfos, const ImVec2& vSize,
 	std::shared_ptr<GlyphInfos> vGlyph, bool vShowRect,
-	bool *vNameupdated, bool *vCodePointUpdated, 
 	bool vForceEditMode)
 {
 	int res = false;
@@ -409,9 +363,7 @@ bool FinalFontPane::DrawGlyph(ProjectFile *vProjectFile,
 				float x = ImGui::GetCursorScreenPos().x;
 				if (ImGui::Button(ICON_IGFS_OK "##okname"))
 				{
-					if (vNameupdated)
-						*vNameupdated = true;
-					vGlyph->newHeaderName = vGlyph->editHeaderName;
+					vGlyph->SetNewHeaderName(vGlyph->editHeaderName);
 					SelectionHelper::Instance()->AnalyseSourceSelection(vProjectFile);
 					vProjectFile->SetProjectChange();
 					vGlyph->m_editingName = false;
@@ -442,9 +394,7 @@ bool FinalFontPane::DrawGlyph(ProjectFile *vProjectFile,
 				ImGui::PushItemWidth(ImGui::GetFrameHeight());
 				if (ImGui::Button("R##resetname"))
 				{
-					if (vNameupdated)
-						*vNameupdated = true;
-					vGlyph->newHeaderName = vGlyph->oldHeaderName;
+					vGlyph->SetNewHeaderName(vGlyph->oldHeaderName);
 					SelectionHelper::Instance()->AnalyseSourceSelection(vProjectFile);
 					vProjectFile->SetProjectChange();
 				}
@@ -468,9 +418,7 @@ bool FinalFontPane::DrawGlyph(ProjectFile *vProjectFile,
 					btn = ImGui::Button(ICON_IGFS_OK "##okcodepoint");
 				if (btn)
 				{
-					if (vCodePointUpdated)
-						*vCodePointUpdated = true;
-					vGlyph->newCodePoint = (uint32_t)vGlyph->editCodePoint;// range 0 => 2^16;
+					vGlyph->SetNewCodePoint((uint32_t)vGlyph->editCodePoint);// range 0 => 2^16;
 					SelectionHelper::Instance()->AnalyseSourceSelection(vProjectFile);
 					vProjectFile->SetProjectChange();
 					vGlyph->m_editingCodePoint = false;
@@ -511,9 +459,7 @@ bool FinalFontPane::DrawGlyph(ProjectFile *vProjectFile,
 				ImGui::PushItemWidth(ImGui::GetFrameHeight());
 				if (ImGui::Button("R##resetcodepoint"))
 				{
-					if (vCodePointUpdated)
-						*vCodePointUpdated = true;
-					vGlyph->newCodePoint = vGlyph->glyph.Codepoint;
+					vGlyph->SetNewCodePoint(vGlyph->glyph.Codepoint);
 					SelectionHelper::Instance()->AnalyseSourceSelection(vProjectFile);
 					vProjectFile->SetProjectChange();
 				}
@@ -560,131 +506,133 @@ static inline void DrawGlyphInfosToolTip(std::shared_ptr<FontInfos> vFontInfos,
 	}
 }
 
-// this func can be called by FinalFontPane et SelectedFontPane
-// but these two panes have a specific flag for show the tooltip
-// so we need to pass this flag in parameter
-void FinalFontPane::DrawSelectionsByFontNoOrder_OneFontOnly(
+static inline bool IsFontReadyForDisplay(const std::shared_ptr<FontInfos>& vFontInfos)
+{
+	return vFontInfos.use_count() &&
+		!vFontInfos->m_IsLoading &&
+		vFontInfos->m_ImFontAtlas.IsBuilt() &&
+		vFontInfos->m_ImFontAtlas.TexID;
+}
+
+// virtual grid like SourceFontPane::DrawFontAtlas_Virtual : only the visible rows are submitted to imgui
+// vGetGlyph give the glyph of an index, vFontInfos is empty for the merged views (the font of each glyph is used)
+// the row height is measured on the first row by the clipper, since it change in edition mode
+void FinalFontPane::DrawGlyphsGrid(
 	ProjectFile *vProjectFile,
 	std::shared_ptr<FontInfos> vFontInfos,
-	bool vWithFramedGroup,
+	uint32_t vCountGlyphs,
+	const std::function<const GlyphOrderedIndex::FlatGlyph&(uint32_t)>& vGetGlyph,
+	uint32_t vGlyphCountX, const ImVec2& vGlyphSize,
 	bool vForceEditMode,
-	bool vForceEditModeOneColumn,
-	bool vShowTooltipInfos)
+	bool vShowTooltipInfos,
+	bool vRangeBySourceCodePoint)
 {
-	if (vProjectFile && vFontInfos.use_count())
-	{
-		if (vFontInfos->m_SelectedGlyphs.empty())
-			return;
-
-		if (vFontInfos->m_ImFontAtlas.IsBuilt())
-		{
-			if (vFontInfos->m_ImFontAtlas.TexID)
-			{
-				if (vFontInfos->m_SelectedGlyphs.begin()->second)
-				{
-					uint32_t startCodePoint = vFontInfos->m_SelectedGlyphs.begin()->second->glyph.Codepoint;
-
-					char buffer[1024] = "\0";
-					snprintf(buffer, 1023, "Font %s / Start CodePoint %u / Count %u",
-						vFontInfos->m_FontFileName.c_str(), startCodePoint,
-						(uint32_t)vFontInfos->m_SelectedGlyphs.size());
-					bool frm = true;
-					if (vWithFramedGroup)
-						frm = ImGui::BeginFramedGroup(buffer);
-					if (frm)
-					{
-						ImVec2 cell_size, glyph_size;
-						uint32_t glyphCountX = GlyphDisplayHelper::CalcGlyphsCountAndSize(vProjectFile, &cell_size, &glyph_size, m_GlyphEdition, vForceEditMode, vForceEditModeOneColumn);
-						if (glyphCountX)
-						{
-							uint32_t idx = 0;
-							uint32_t lastGlyphCodePoint = 0;
-							ImVec4 glyphRangeColoring = ImGui::GetStyleColorVec4(ImGuiCol_Button);
-							bool showRangeColoring = vProjectFile->IsRangeColoringShown();
-
-							bool nameUpdated = false;
-							bool codepointUpdated = false;
-
-							for (auto& it : vFontInfos->m_SelectedGlyphs)
-							{
-								uint32_t x = idx % glyphCountX;
-
-								uint32_t codePoint = it.first;
-								auto glyphInfo = it.second;
-
-								if (x) ImGui::SameLine();
+	if (!vProjectFile || !vCountGlyphs || !vGlyphCountX)
+		return;
 
-								if (showRangeColoring)
-								{
-									if (codePoint != lastGlyphCodePoint + 1)
-									{
-										glyphRangeColoring = vProjectFile->GetColorFromInteger(codePoint);
-									}
+	const bool showRangeColoring = vProjectFile->IsRangeColoringShown();
+	const int rowCount = (int)((vCountGlyphs + vGlyphCountX - 1U) / vGlyphCountX);
 
-									ImGui::PushStyleColor(ImGuiCol_Button, glyphRangeColoring);
-									ImVec4 bh = glyphRangeColoring; bh.w = 0.75f;
-									ImGui::PushStyleColor(ImGuiCol_ButtonHovered, bh);
-									ImVec4 ba = glyphRangeColoring; ba.w = 1.0f;
-									ImGui::PushStyleColor(ImGuiCol_ButtonActive, ba);
-								}
+	ImGuiListClipper clipper;
+	clipper.Begin(rowCount);
+	while (clipper.Step())
+	{
+		for (int j = clipper.DisplayStart; j < clipper.DisplayEnd; j++)
+		{
+			if (j < 0) continue;
 
-								DrawGlyph(vProjectFile, vFontInfos,
-									glyph_size, glyphInfo, false,
-									&nameUpdated, &codepointUpdated, vForceEditMode);
+			for (uint32_t i = 0; i < vGlyphCountX; i++)
+			{
+				const uint32_t glyphIdx = i + (uint32_t)j * vGlyphCountX;
+				if (glyphIdx >= vCountGlyphs)
+					break;
 
-								if (showRangeColoring)
-								{
-									ImGui::PopStyleColor(3);
-								}
+				const auto& flat = vGetGlyph(glyphIdx);
+				auto glyphInfo = flat.glyph; // copy, an edition can change the lists
+				if (!glyphInfo)
+					continue;
 
-								if (vShowTooltipInfos)
-								{
-									DrawGlyphInfosToolTip(vFontInfos, glyphInfo);
-								}
+				if (i) ImGui::SameLine();
 
-								lastGlyphCodePoint = codePoint;
+				auto fontInfos = vFontInfos.use_count() ? vFontInfos : glyphInfo->GetFontInfos().lock();
+				if (!IsFontReadyForDisplay(fontInfos))
+				{
+					// keep the grid aligned during the loading of this font
+					ImGui::Dummy(vGlyphSize + ImGui::GetStyle().FramePadding * 2.0f);
+					continue;
+				}
 
-								idx++;
-							}
+				if (showRangeColoring)
+				{
+					const ImVec4 glyphRangeColoring = vProjectFile->GetColorFromInteger(
+						vRangeBySourceCodePoint ? flat.rangeStartSourceCodePoint : flat.rangeStartCodePoint);
+					ImGui::PushStyleColor(ImGuiCol_Button, glyphRangeColoring);
+					ImVec4 bh = glyphRangeColoring; bh.w = 0.75f;
+					ImGui::PushStyleColor(ImGuiCol_ButtonHovered, bh);
+					ImVec4 ba = glyphRangeColoring; ba.w = 1.0f;
+					ImGui::PushStyleColor(ImGuiCol_ButtonActive, ba);
+				}
 
-							// update for other views
-							if (nameUpdated)
-							{
-								PrepareSelectionByFontOrderedByGlyphNames(vProjectFile);
-								PrepareSelectionMergedOrderedByGlyphNames(vProjectFile);
-							}
+				DrawGlyph(vProjectFile, fontInfos,
+					vGlyphSize, glyphInfo, flat.inDouble,
+					vForceEditMode);
 
-							// update for other views
-							if (codepointUpdated)
-							{
-								PrepareSelectionByFontOrderedByCodePoint(vProjectFile);
-								PrepareSelectionMergedOrderedByCodePoint(vProjectFile);
-							}
-						}
+				if (showRangeColoring)
+				{
+					ImGui::PopStyleColor(3);
+				}
 
-						if (vWithFramedGroup)
-							ImGui::EndFramedGroup();
-					}
+				if (vShowTooltipInfos)
+				{
+					DrawGlyphInfosToolTip(fontInfos, glyphInfo);
 				}
 			}
 		}
 	}
+	clipper.End();
 }
 
-void FinalFontPane::PrepareSelectionByFontOrderedByCodePoint(ProjectFile *vProjectFile)
+// this func can be called by FinalFontPane et SelectedFontPane
+// but these two panes have a specific flag for show the tooltip
+// so we need to pass this flag in parameter
+void FinalFontPane::DrawSelectionsByFontNoOrder_OneFontOnly(
+	ProjectFile *vProjectFile,
+	std::shared_ptr<FontInfos> vFontInfos,
+	bool vWithFramedGroup,
+	bool vForceEditMode,
+	bool vForceEditModeOneColumn,
+	bool vShowTooltipInfos)
 {
-	if (vProjectFile)
+	if (vProjectFile && vFontInfos.use_count())
 	{
-		for (auto itFont : vProjectFile->m_Fonts)
-		{
-			itFont.second->m_GlyphsOrderedByCodePoints.clear();
+		const auto& glyphs = vFontInfos->m_GlyphOrderedIndex.GetFlatGlyphsBySourceCodePoint();
+		if (glyphs.empty())
+			return;
 
-			for (auto& itGlyph : itFont.second->m_SelectedGlyphs)
+		if (vFontInfos->m_ImFontAtlas.IsBuilt())
+		{
+			if (vFontInfos->m_ImFontAtlas.TexID)
 			{
-				if (itGlyph.second)
+				uint32_t startCodePoint = glyphs[0].glyph->glyph.Codepoint;
+
+				char buffer[1024] = "\0";
+				snprintf(buffer, 1023, "Font %s / Start CodePoint %u / Count %u",
+					vFontInfos->m_FontFileName.c_str(), startCodePoint,
+					(uint32_t)glyphs.size());
+				bool frm = true;
+				if (vWithFramedGroup)
+					frm = ImGui::BeginFramedGroup(buffer);
+				if (frm)
 				{
-					itGlyph.second->SetFontInfos(itFont.second);
-					itFont.second->m_GlyphsOrderedByCodePoints[itGlyph.second->newCodePoint].push_back(itGlyph.second);
+					ImVec2 cell_size, glyph_size;
+					uint32_t glyphCountX = GlyphDisplayHelper::CalcGlyphsCountAndSize(vProjectFile, &cell_size, &glyph_size, m_GlyphEdition, vForceEditMode, vForceEditModeOneColumn);
+					DrawGlyphsGrid(vProjectFile, vFontInfos, (uint32_t)glyphs.size(),
+						[&glyphs](uint32_t vIdx) -> const GlyphOrderedIndex::FlatGlyph& { return glyphs[vIdx]; },
+						glyphCountX, glyph_size, vForceEditMode, vShowTooltipInfos,
+						true); // the font view in the source order is colored by source range
+
+					if (vWithFramedGroup)
+						ImGui::EndFramedGroup();
 				}
 			}
 		}
@@ -721,134 +669,36 @@ void FinalFontPane::DrawSelectionsByFontOrderedByCodePoint_OneFontOnly(
 {
 	if (vProjectFile && vFontInfos.use_count())
 	{
-		if (vFontInfos->m_GlyphsOrderedByCodePoints.empty())
+		const auto& glyphs = vFontInfos->m_GlyphOrderedIndex.GetFlatGlyphsByCodePoints();
+		if (glyphs.empty())
 			return;
 
 		if (vFontInfos->m_ImFontAtlas.IsBuilt())
 		{
 			if (vFontInfos->m_ImFontAtlas.TexID)
 			{
-				if (vFontInfos->m_GlyphsOrderedByCodePoints.empty())
+				uint32_t startCodePoint = glyphs[0].glyph->newCodePoint;
+
+				char buffer[1024] = "\0";
+				snprintf(buffer, 1023, "Font %s / Start CodePoint %u / Count %u",
+					vFontInfos->m_FontFileName.c_str(), startCodePoint,
+					(uint32_t)vFontInfos->m_GlyphOrderedIndex.GetGlyphsOrderedByCodePoints().size());
+				bool frm = true;
+				if (vWithFramedGroup)
+					frm = ImGui::BeginFramedGroup(buffer);
+				if (frm)
 				{
-					PrepareSelectionByFontOrderedByCodePoint(vProjectFile);
-				}
-				else
-				{
-                    uint32_t startCodePoint = vFontInfos->m_GlyphsOrderedByCodePoints.begin()->second[0]->newCodePoint;
+					// si plus d'un glyph pour un codepoint, alors deux glyph partagent le meme codepoint
+					// et il va falloir le montrer (inDouble)
+					// un rerange sera necesaire
+					ImVec2 cell_size, glyph_size;
+					uint32_t glyphCountX = GlyphDisplayHelper::CalcGlyphsCountAndSize(vProjectFile, &cell_size, &glyph_size, m_GlyphEdition, vForceEditMode, vForceEditModeOneColumn);
+					DrawGlyphsGrid(vProjectFile, vFontInfos, (uint32_t)glyphs.size(),
+						[&glyphs](uint32_t vIdx) -> const GlyphOrderedIndex::FlatGlyph& { return glyphs[vIdx]; },
+						glyphCountX, glyph_size, vForceEditMode, vShowTooltipInfos);
 
-					char buffer[1024] = "\0";
-					snprintf(buffer, 1023, "Font %s / Start CodePoint %u / Count %u",
-						vFontInfos->m_FontFileName.c_str(), startCodePoint,
-						(uint32_t)vFontInfos->m_GlyphsOrderedByCodePoints.size());
-					bool frm = true;
 					if (vWithFramedGroup)
-						frm = ImGui::BeginFramedGroup(buffer);
-					if (frm)
-					{
-						ImVec2 cell_size, glyph_size;
-						uint32_t glyphCountX = GlyphDisplayHelper::CalcGlyphsCountAndSize(vProjectFile, &cell_size, &glyph_size, m_GlyphEdition, vForceEditMode, vForceEditModeOneColumn);
-						if (glyphCountX)
-						{
-                            uint32_t idx = 0;
-                            uint32_t lastGlyphCodePoint = 0;
-							ImVec4 glyphRangeColoring = ImGui::GetStyleColorVec4(ImGuiCol_Button);
-							bool showRangeColoring = vProjectFile->IsRangeColoringShown();
-
-							bool nameUpdated = false;
-							bool codepointUpdated = false;
-
-							for (auto &itGlyph : vFontInfos->m_GlyphsOrderedByCodePoints)
-							{
-								uint32_t codePoint = itGlyph.first;
-								auto glyphVector = itGlyph.second;
-
-								// si plus d'un glyph ici, alors deux glyph partagent le meme codepoint
-								// et il va falloir le montrer
-								// un rerange sera necesaire
-								for (auto & glyphInfo : glyphVector)
-								{
-                                    uint32_t x = idx++ % glyphCountX;
-
-									if (x) ImGui::SameLine();
-
-									if (showRangeColoring)
-									{
-										if (glyphInfo->newCodePoint != lastGlyphCodePoint + 1)
-										{
-											glyphRangeColoring = vProjectFile->GetColorFromInteger(glyphInfo->newCodePoint);
-										}
-
-										ImGui::PushStyleColor(ImGuiCol_Button, glyphRangeColoring);
-										ImVec4 bh = glyphRangeColoring; bh.w = 0.75f;
-										ImGui::PushStyleColor(ImGuiCol_ButtonHovered, bh);
-										ImVec4 ba = glyphRangeColoring; ba.w = 1.0f;
-										ImGui::PushStyleColor(ImGuiCol_ButtonActive, ba);
-									}
-
-									DrawGlyph(vProjectFile, vFontInfos,
-										glyph_size, glyphInfo, glyphVector.size() > 1,
-										&nameUpdated, &codepointUpdated, vForceEditMode);
-
-									if (showRangeColoring)
-									{
-										ImGui::PopStyleColor(3);
-									}
-
-									if (vShowTooltipInfos)
-									{
-										DrawGlyphInfosToolTip(vFontInfos, glyphInfo);
-
-										/*if (ImGui::IsItemHovered())
-										{
-											ImGui::SetTooltip("new name : %s\nnew codepoint : %i\nold name : %s\nold codepoint : %i\nfont : %s",
-												glyphInfo->newHeaderName.c_str(),
-												(int)glyphInfo->newCodePoint,
-												glyphInfo->oldHeaderName.c_str(),
-												(int)glyphInfo->glyph.Codepoint,
-												vFontInfos->m_FontFileName.c_str());
-										}*/
-									}
-
-									lastGlyphCodePoint = codePoint;
-								}
-							}
-
-							if (nameUpdated)
-							{
-								PrepareSelectionByFontOrderedByGlyphNames(vProjectFile);
-								PrepareSelectionMergedOrderedByGlyphNames(vProjectFile);
-							}
-
-							if (codepointUpdated)
-							{
-								PrepareSelectionByFontOrderedByCodePoint(vProjectFile);
-								PrepareSelectionMergedOrderedByCodePoint(vProjectFile);
-							}
-						}
-
-						if (vWithFramedGroup)
-							ImGui::EndFramedGroup();
-					}
-				}
-			}
-		}
-	}
-}
-
-void FinalFontPane::PrepareSelectionByFontOrderedByGlyphNames(ProjectFile *vProjectFile)
-{
-	if (vProjectFile)
-	{
-		for (auto itFont : vProjectFile->m_Fonts)
-		{
-			itFont.second->m_GlyphsOrderedByGlyphName.clear();
-
-			for (auto& itGlyph : itFont.second->m_SelectedGlyphs)
-			{
-				if (itGlyph.second)
-				{
-					itGlyph.second->SetFontInfos(itFont.second);
-					itFont.second->m_GlyphsOrderedByGlyphName[itGlyph.second->newHeaderName].push_back(itGlyph.second);
+						ImGui::EndFramedGroup();
 				}
 			}
 		}
@@ -885,487 +735,124 @@ void FinalFontPane::DrawSelectionsByFontOrderedByGlyphNames_OneFontOnly(
 {
 	if (vProjectFile && vFontInfos.use_count())
 	{
-		if (vFontInfos->m_GlyphCodePointToName.empty())
+		const auto& glyphs = vFontInfos->m_GlyphOrderedIndex.GetFlatGlyphsByGlyphName();
+		if (glyphs.empty())
 			return;
 
 		if (vFontInfos->m_ImFontAtlas.IsBuilt())
 		{
 			if (vFontInfos->m_ImFontAtlas.TexID)
 			{
-				if (vFontInfos->m_GlyphsOrderedByGlyphName.empty())
-				{
-					PrepareSelectionByFontOrderedByGlyphNames(vProjectFile);
-				}
-				else
+				const std::string& name = glyphs[0].glyph->newHeaderName;
+
+				char buffer[1024] = "\0";
+				snprintf(buffer, 1023, "Font %s / Start Name %s / Count Names %u",
+					vFontInfos->m_FontFileName.c_str(), name.c_str(),
+					(uint32_t)vFontInfos->m_GlyphOrderedIndex.GetGlyphsOrderedByGlyphName().size());
+				bool frm = true;
+				if (vWithFramedGroup)
+					frm = ImGui::BeginFramedGroup(buffer);
+				if (frm)
 				{
-					std::string name = vFontInfos->m_GlyphsOrderedByGlyphName.begin()->second[0]->newHeaderName;
+					// si plus d'un glyph pour un nom, alors deux glyph partagent le meme nom
+					// et il va falloir le montrer (inDouble)
+					ImVec2 cell_size2, glyph_size;
+					uint32_t glyphCountX = GlyphDisplayHelper::CalcGlyphsCountAndSize(vProjectFile, &cell_size2, &glyph_size, m_GlyphEdition, vForceEditMode, vForceEditModeOneColumn);
+					DrawGlyphsGrid(vProjectFile, vFontInfos, (uint32_t)glyphs.size(),
+						[&glyphs](uint32_t vIdx) -> const GlyphOrderedIndex::FlatGlyph& { return glyphs[vIdx]; },
+						glyphCountX, glyph_size, vForceEditMode, vShowTooltipInfos);
 
-					char buffer[1024] = "\0";
-					snprintf(buffer, 1023, "Font %s / Start Name %s / Count Names %u",
-						vFontInfos->m_FontFileName.c_str(), name.c_str(),
-						(uint32_t)vFontInfos->m_GlyphsOrderedByGlyphName.size());
-					bool frm = true;
 					if (vWithFramedGroup)
-						frm = ImGui::BeginFramedGroup(buffer);
-					if (frm)
-					{
-						ImVec2 cell_size2, glyph_size;
-						uint32_t glyphCountX = GlyphDisplayHelper::CalcGlyphsCountAndSize(vProjectFile, &cell_size2, &glyph_size, m_GlyphEdition, vForceEditMode, vForceEditModeOneColumn);
-						if (glyphCountX)
-						{
-							int idx = 0;
-                            uint32_t lastGlyphCodePoint = 0;
-							ImVec4 glyphRangeColoring = ImGui::GetStyleColorVec4(ImGuiCol_Button);
-							bool showRangeColoring = vProjectFile->IsRangeColoringShown();
-
-							bool nameUpdated = false;
-							bool codepointUpdated = false;
-
-							for (auto &itGlyph : vFontInfos->m_GlyphsOrderedByGlyphName)
-							{
-								auto glyphVector = itGlyph.second;
-
-								// si plus d'un glyph ici, alors deux glyph partagent le meme codepoint
-								// et il va falloir le montrer
-								// un rerange sera necesaire
-								for (auto & glyphInfo : glyphVector)
-								{
-                                    uint32_t x = idx++ % glyphCountX;
-
-									if (x) ImGui::SameLine();
-
-									if (showRangeColoring)
-									{
-										if (glyphInfo->newCodePoint != lastGlyphCodePoint + 1)
-										{
-											glyphRangeColoring = vProjectFile->GetColorFromInteger(glyphInfo->newCodePoint);
-										}
-
-										ImGui::PushStyleColor(ImGuiCol_Button, glyphRangeColoring);
-										ImVec4 bh = glyphRangeColoring; bh.w = 0.75f;
-										ImGui::PushStyleColor(ImGuiCol_ButtonHovered, bh);
-										ImVec4 ba = glyphRangeColoring; ba.w = 1.0f;
-										ImGui::PushStyleColor(ImGuiCol_ButtonActive, ba);
-									}
-
-									DrawGlyph(vProjectFile, vFontInfos,
-										glyph_size, glyphInfo, glyphVector.size() > 1,
-										&nameUpdated, &codepointUpdated, vForceEditMode);
-
-									if (showRangeColoring)
-									{
-										ImGui::PopStyleColor(3);
-									}
-
-									if (vShowTooltipInfos)
-									{
-										DrawGlyphInfosToolTip(vFontInfos, glyphInfo);
-										
-										/*if (ImGui::IsItemHovered())
-										{
-											ImGui::SetTooltip("new name : %s\nnew codepoint : %i\nold name : %s\nold codepoint : %i\nfont : %s",
-												glyphInfo->newHeaderName.c_str(),
-												(int)glyphInfo->newCodePoint,
-												glyphInfo->oldHeaderName.c_str(),
-												(int)glyphInfo->glyph.Codepoint,
-												vFontInfos->m_FontFileName.c_str());
-										}*/
-									}
-
-									lastGlyphCodePoint = glyphInfo->newCodePoint;
-								}
-							}
-
-							if (nameUpdated)
-							{
-								PrepareSelectionByFontOrderedByGlyphNames(vProjectFile);
-								PrepareSelectionMergedOrderedByGlyphNames(vProjectFile);
-							}
-
-							if (codepointUpdated)
-							{
-								PrepareSelectionByFontOrderedByCodePoint(vProjectFile);
-								PrepareSelectionMergedOrderedByCodePoint(vProjectFile);
-							}
-						}
-
-						if (vWithFramedGroup)
-							ImGui::EndFramedGroup();
-					}
+						ImGui::EndFramedGroup();
 				}
 			}
 		}
 	}
 }
 
-void FinalFontPane::PrepareSelectionMergedNoOrder(ProjectFile *vProjectFile)
+void FinalFontPane::DrawSelectionMergedNoOrder(ProjectFile *vProjectFile)
 {
-	m_GlyphsMergedNoOrder.clear();
-
 	if (vProjectFile)
 	{
-		for (auto itFont : vProjectFile->m_Fonts)
+		if (!vProjectFile->m_GlyphOrderedIndex.GetCountGlyphs())
+			return;
+
+		// the lists of the fonts one after the other, the font of an index is found in few steps (count of fonts)
+		std::vector<const GlyphOrderedIndex::FlatGlyphVector*> fontsGlyphs;
+		uint32_t countGlyphs = 0U;
+		for (const auto& itFont : vProjectFile->m_Fonts)
 		{
-			for (auto& itGlyph : itFont.second->m_SelectedGlyphs)
+			if (itFont.second)
 			{
-				if (itGlyph.second)
+				const auto& glyphs = itFont.second->m_GlyphOrderedIndex.GetFlatGlyphsBySourceCodePoint();
+				if (!glyphs.empty())
 				{
-					itGlyph.second->SetFontInfos(itFont.second);
-					m_GlyphsMergedNoOrder.push_back(itGlyph.second);
+					fontsGlyphs.push_back(&glyphs);
+					countGlyphs += (uint32_t)glyphs.size();
 				}
 			}
 		}
-	}
-}
-
-void FinalFontPane::DrawSelectionMergedNoOrder(ProjectFile *vProjectFile)
-{
-	if (m_GlyphsMergedNoOrder.empty())
-		return;
 
-	if (vProjectFile)
-	{
         ImVec2 cell_size, glyph_size;
 		uint32_t glyphCountX = GlyphDisplayHelper::CalcGlyphsCountAndSize(vProjectFile, &cell_size, &glyph_size, m_GlyphEdition);
-		if (glyphCountX)
-		{
-			uint32_t idx = 0;
-			uint32_t lastGlyphCodePoint = 0;
-			ImVec4 glyphRangeColoring = ImGui::GetStyleColorVec4(ImGuiCol_Button);
-			bool showRangeColoring = vProjectFile->IsRangeColoringShown();
-
-			bool nameUpdated = false;
-			bool codepointUpdated = false;
-
-			for (auto& glyphInfo : m_GlyphsMergedNoOrder)
+		DrawGlyphsGrid(vProjectFile, nullptr, countGlyphs,
+			[&fontsGlyphs](uint32_t vIdx) -> const GlyphOrderedIndex::FlatGlyph&
 			{
-				auto fontInfos = glyphInfo->GetFontInfos();
-				if (!fontInfos.expired() && glyphCountX)
+				size_t fontIdx = 0U;
+				while (vIdx >= fontsGlyphs[fontIdx]->size()) // vIdx < countGlyphs, so always found
 				{
-					auto fontInfosPtr = fontInfos.lock();
-					if (fontInfosPtr.use_count())
-					{
-						if (fontInfosPtr->m_ImFontAtlas.IsBuilt())
-						{
-							if (fontInfosPtr->m_ImFontAtlas.TexID)
-							{
-								uint32_t x = idx++ % glyphCountX;
-
-								if (x) ImGui::SameLine();
-
-								if (showRangeColoring)
-								{
-									if (glyphInfo->newCodePoint != lastGlyphCodePoint + 1)
-									{
-										glyphRangeColoring = vProjectFile->GetColorFromInteger(glyphInfo->newCodePoint);
-									}
-
-									ImGui::PushStyleColor(ImGuiCol_Button, glyphRangeColoring);
-									ImVec4 bh = glyphRangeColoring; bh.w = 0.75f;
-									ImGui::PushStyleColor(ImGuiCol_ButtonHovered, bh);
-									ImVec4 ba = glyphRangeColoring; ba.w = 1.0f;
-									ImGui::PushStyleColor(ImGuiCol_ButtonActive, ba);
-								}
-
-								DrawGlyph(vProjectFile, fontInfosPtr,
-									glyph_size, glyphInfo, false,
-									&nameUpdated, &codepointUpdated);
-
-								if (showRangeColoring)
-								{
-									ImGui::PopStyleColor(3);
-								}
-
-								if (vProjectFile->m_FinalPane_ShowGlyphTooltip)
-								{
-									DrawGlyphInfosToolTip(fontInfosPtr, glyphInfo);
-
-									/*if (ImGui::IsItemHovered())
-									{
-										ImGui::SetTooltip("new name : %s\nnew codepoint : %i\nold name : %s\nold codepoint : %i\nfont : %s",
-											glyphInfo->newHeaderName.c_str(),
-											(int)glyphInfo->newCodePoint,
-											glyphInfo->oldHeaderName.c_str(),
-											(int)glyphInfo->glyph.Codepoint,
-											vFontInfos->m_FontFileName.c_str());
-									}*/
-								}
-
-								lastGlyphCodePoint = glyphInfo->newCodePoint;
-							}
-						}
-					}
+					vIdx -= (uint32_t)fontsGlyphs[fontIdx]->size();
+					++fontIdx;
 				}
-			}
-
-			SelectionHelper::Instance()->SelectWithToolOrApply(
-				vProjectFile, SelectionContainerEnum::SELECTION_CONTAINER_FINAL);
-
-			if (nameUpdated)
-			{
-				PrepareSelectionByFontOrderedByGlyphNames(vProjectFile);
-				PrepareSelectionMergedOrderedByGlyphNames(vProjectFile);
-			}
-
-			if (codepointUpdated)
-			{
-				PrepareSelectionByFontOrderedByCodePoint(vProjectFile);
-				PrepareSelectionMergedOrderedByCodePoint(vProjectFile);
-			}
-		}
-	}
-}
-
-void FinalFontPane::PrepareSelectionMergedOrderedByCodePoint(ProjectFile *vProjectFile)
-{
-	m_GlyphsMergedOrderedByCodePoints.clear();
+				return (*fontsGlyphs[fontIdx])[vIdx];
+			},
+			glyphCountX, glyph_size, false, vProjectFile->m_FinalPane_ShowGlyphTooltip);
 
-	if (vProjectFile)
-	{
-		for (auto itFont : vProjectFile->m_Fonts)
-		{
-			for (auto& itGlyph : itFont.second->m_SelectedGlyphs)
-			{
-				if (itGlyph.second)
-				{
-					itGlyph.second->SetFontInfos(itFont.second);
-					m_GlyphsMergedOrderedByCodePoints[itGlyph.second->newCodePoint].push_back(itGlyph.second);
-				}
-			}
-		}
+		SelectionHelper::Instance()->SelectWithToolOrApply(
+			vProjectFile, SelectionContainerEnum::SELECTION_CONTAINER_FINAL);
 	}
 }
 
 void FinalFontPane::DrawSelectionMergedOrderedByCodePoint(ProjectFile *vProjectFile)
 {
-	if (m_GlyphsMergedOrderedByCodePoints.empty())
-		return;
-
 	if (vProjectFile)
 	{
+		const auto& glyphs = vProjectFile->m_GlyphOrderedIndex.GetFlatGlyphsByCodePoints();
+		if (glyphs.empty())
+			return;
+
+		// si plus d'un glyph pour un codepoint, alors deux glyph partagent le meme codepoint
+		// et il va falloir le montrer (inDouble)
+		// un rerange sera necesaire
 		ImVec2 cell_size, glyph_size;
 		uint32_t glyphCountX = GlyphDisplayHelper::CalcGlyphsCountAndSize(vProjectFile, &cell_size, &glyph_size, m_GlyphEdition);
-		if (glyphCountX)
-		{
-			uint32_t idx = 0;
-			uint32_t lastGlyphCodePoint = 0;
-			ImVec4 glyphRangeColoring = ImGui::GetStyleColorVec4(ImGuiCol_Button);
-			bool showRangeColoring = vProjectFile->IsRangeColoringShown();
-
-			bool nameUpdated = false;
-			bool codepointUpdated = false;
-
-			for (auto& itGlyph : m_GlyphsMergedOrderedByCodePoints)
-			{
-				uint32_t codePoint = itGlyph.first;
-				auto glyphVector = itGlyph.second;
-
-				// si plus d'un glyph ici, alors deux glyph partagent le meme codepoint
-				// et il va falloir le montrer
-				// un rerange sera necesaire
-				for (auto& glyphInfo : glyphVector)
-				{
-					auto fontInfos = glyphInfo->GetFontInfos();
-					if (!fontInfos.expired() && glyphCountX)
-					{
-						auto fontInfosPtr = fontInfos.lock();
-						if (fontInfosPtr.use_count())
-						{
-							if (fontInfosPtr->m_ImFontAtlas.IsBuilt())
-							{
-								if (fontInfosPtr->m_ImFontAtlas.TexID)
-								{
-									uint32_t x = idx++ % glyphCountX;
-
-									if (x) ImGui::SameLine();
-
-									if (showRangeColoring)
-									{
-										if (glyphInfo->newCodePoint != lastGlyphCodePoint + 1)
-										{
-											glyphRangeColoring = vProjectFile->GetColorFromInteger(glyphInfo->newCodePoint);
-										}
-
-										ImGui::PushStyleColor(ImGuiCol_Button, glyphRangeColoring);
-										ImVec4 bh = glyphRangeColoring; bh.w = 0.75f;
-										ImGui::PushStyleColor(ImGuiCol_ButtonHovered, bh);
-										ImVec4 ba = glyphRangeColoring; ba.w = 1.0f;
-										ImGui::PushStyleColor(ImGuiCol_ButtonActive, ba);
-									}
-
-									DrawGlyph(vProjectFile, fontInfosPtr,
-										glyph_size, glyphInfo, glyphVector.size() > 1,
-										&nameUpdated, &codepointUpdated);
-
-									if (showRangeColoring)
-									{
-										ImGui::PopStyleColor(3);
-									}
-
-									if (vProjectFile->m_FinalPane_ShowGlyphTooltip)
-									{
-										DrawGlyphInfosToolTip(fontInfosPtr, glyphInfo);
-
-										/*if (ImGui::IsItemHovered())
-										{
-											ImGui::SetTooltip("new name : %s\nnew codepoint : %i\nold name : %s\nold codepoint : %i\nfont : %s",
-												glyphInfo->newHeaderName.c_str(),
-												(int)glyphInfo->newCodePoint,
-												glyphInfo->oldHeaderName.c_str(),
-												(int)glyphInfo->glyph.Codepoint,
-												vFontInfos->m_FontFileName.c_str());
-										}*/
-									}
-
-									lastGlyphCodePoint = codePoint;
-								}
-							}
-						}
-					}
-				}
-			}
-
-			SelectionHelper::Instance()->SelectWithToolOrApply(
-				vProjectFile, SelectionContainerEnum::SELECTION_CONTAINER_FINAL);
+		DrawGlyphsGrid(vProjectFile, nullptr, (uint32_t)glyphs.size(),
+			[&glyphs](uint32_t vIdx) -> const GlyphOrderedIndex::FlatGlyph& { return glyphs[vIdx]; },
+			glyphCountX, glyph_size, false, vProjectFile->m_FinalPane_ShowGlyphTooltip);
 
-			if (nameUpdated)
-			{
-				PrepareSelectionByFontOrderedByGlyphNames(vProjectFile);
-				PrepareSelectionMergedOrderedByGlyphNames(vProjectFile);
-			}
-
-			if (codepointUpdated)
-			{
-				PrepareSelectionByFontOrderedByCodePoint(vProjectFile);
-				PrepareSelectionMergedOrderedByCodePoint(vProjectFile);
-			}
-		}
-	}
-}
-
-void FinalFontPane::PrepareSelectionMergedOrderedByGlyphNames(ProjectFile *vProjectFile)
-{
-	m_GlyphsMergedOrderedByGlyphName.clear();
-
-	if (vProjectFile)
-	{
-		for (auto itFont : vProjectFile->m_Fonts)
-		{
-			for (auto& itGlyph : itFont.second->m_SelectedGlyphs)
-			{
-				if (itGlyph.second)
-				{
-					itGlyph.second->SetFontInfos(itFont.second);
-					m_GlyphsMergedOrderedByGlyphName[itGlyph.second->newHeaderName].push_back(itGlyph.second);
-				}
-			}
-		}
+		SelectionHelper::Instance()->SelectWithToolOrApply(
+			vProjectFile, SelectionContainerEnum::SELECTION_CONTAINER_FINAL);
 	}
 }
 
 void FinalFontPane::DrawSelectionMergedOrderedByGlyphNames(ProjectFile *vProjectFile)
 {
-	if (m_GlyphsMergedOrderedByGlyphName.empty())
-		return;
-
 	if (vProjectFile)
 	{
+		const auto& glyphs = vProjectFile->m_GlyphOrderedIndex.GetFlatGlyphsByGlyphName();
+		if (glyphs.empty())
+			return;
+
+		// si plus d'un glyph pour un nom, alors deux glyph partagent le meme nom
+		// et il va falloir le montrer (inDouble)
         ImVec2 cell_size, glyph_size;
 		uint32_t glyphCountX = GlyphDisplayHelper::CalcGlyphsCountAndSize(vProjectFile, &cell_size, &glyph_size, m_GlyphEdition);
-		if (glyphCountX)
-		{
-			uint32_t idx = 0;
-			uint32_t lastGlyphCodePoint = 0;
-			ImVec4 glyphRangeColoring = ImGui::GetStyleColorVec4(ImGuiCol_Button);
-			bool showRangeColoring = vProjectFile->IsRangeColoringShown();
-
-			bool nameUpdated = false;
-			bool codepointUpdated = false;
-
-			for (auto& itGlyph : m_GlyphsMergedOrderedByGlyphName)
-			{
-				auto glyphVector = itGlyph.second;
-
-				// si plus d'un glyph ici, alors deux glyph partagent le meme codepoint
-				// et il va falloir le montrer
-				// un rerange sera necesaire
-				for (auto& glyphInfo : glyphVector)
-				{
-					auto fontInfos = glyphInfo->GetFontInfos();
-					if (!fontInfos.expired() && glyphCountX)
-					{
-						auto fontInfosPtr = fontInfos.lock();
-						if (fontInfosPtr.use_count())
-						{
-							if (fontInfosPtr->m_ImFontAtlas.IsBuilt())
-							{
-								if (fontInfosPtr->m_ImFontAtlas.TexID)
-								{
-									uint32_t x = idx++ % glyphCountX;
-
-									if (x) ImGui::SameLine();
-
-									if (showRangeColoring)
-									{
-										if (glyphInfo->newCodePoint != lastGlyphCodePoint + 1)
-										{
-											glyphRangeColoring = vProjectFile->GetColorFromInteger(glyphInfo->newCodePoint);
-										}
-
-										ImGui::PushStyleColor(ImGuiCol_Button, glyphRangeColoring);
-										ImVec4 bh = glyphRangeColoring; bh.w = 0.75f;
-										ImGui::PushStyleColor(ImGuiCol_ButtonHovered, bh);
-										ImVec4 ba = glyphRangeColoring; ba.w = 1.0f;
-										ImGui::PushStyleColor(ImGuiCol_ButtonActive, ba);
-									}
-
-									DrawGlyph(vProjectFile, fontInfosPtr,
-										glyph_size, glyphInfo, glyphVector.size() > 1,
-										&nameUpdated, &codepointUpdated);
-
-									if (showRangeColoring)
-									{
-										ImGui::PopStyleColor(3);
-									}
-
-									if (vProjectFile->m_FinalPane_ShowGlyphTooltip)
-									{
-										DrawGlyphInfosToolTip(fontInfosPtr, glyphInfo);
-
-										/*if (ImGui::IsItemHovered())
-										{
-											ImGui::SetTooltip("new name : %s\nnew codepoint : %i\nold name : %s\nold codepoint : %i\nfont : %s",
-												glyphInfo->newHeaderName.c_str(),
-												(int)glyphInfo->newCodePoint,
-												glyphInfo->oldHeaderName.c_str(),
-												(int)glyphInfo->glyph.Codepoint,
-												vFontInfos->m_FontFileName.c_str());
-										}*/
-									}
-
-									lastGlyphCodePoint = glyphInfo->newCodePoint;
-								}
-							}
-						}
-					}
-				}
-			}
-
-			SelectionHelper::Instance()->SelectWithToolOrApply(
-				vProjectFile, SelectionContainerEnum::SELECTION_CONTAINER_FINAL);
+		DrawGlyphsGrid(vProjectFile, nullptr, (uint32_t)glyphs.size(),
+			[&glyphs](uint32_t vIdx) -> const GlyphOrderedIndex::FlatGlyph& { return glyphs[vIdx]; },
+			glyphCountX, glyph_size, false, vProjectFile->m_FinalPane_ShowGlyphTooltip);
 
-			if (nameUpdated)
-			{
-				PrepareSelectionByFontOrderedByGlyphNames(vProjectFile);
-				PrepareSelectionMergedOrderedByGlyphNames(vProjectFile);
-			}
-
-			if (codepointUpdated)
-			{
-				PrepareSelectionByFontOrderedByCodePoint(vProjectFile);
-				PrepareSelectionMergedOrderedByCodePoint(vProjectFile);
-			}
-		}
+		SelectionHelper::Instance()->SelectWithToolOrApply(
+			vProjectFile, SelectionContainerEnum::SELECTION_CONTAINER_FINAL);
 	}
 }
 
@@ -18,9 +18,11 @@
 #include <Panes/Abstract/AbstractPane.h>
 #include <ctools/ConfigAbstract.h>
 #include <Gui/ImGuiWidgets.h>
+#include <Project/GlyphOrderedIndex.h>
 
 #include <imgui/imgui.h>
 #include <map>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -53,11 +55,6 @@ private: // per pane settings to save
 	//int m_Selected_GlyphSize_Policy_Count = 20;
 	//float m_Selected_GlyphSize_Policy_Width = 40.0f;
 
-private:
-	std::vector<std::shared_ptr<GlyphInfos>> m_GlyphsMergedNoOrder;
-	std::map<uint32_t, std::vector<std::shared_ptr<GlyphInfos>>> m_GlyphsMergedOrderedByCodePoints;
-	std::map<std::string, std::vector<std::shared_ptr<GlyphInfos>>> m_GlyphsMergedOrderedByGlyphName;
-
 private:
 	FinalFontPaneModeFlags m_FinalFontPaneModeFlags = 
 		FinalFontPaneModeFlags::FINAL_FONT_PANE_BY_FONT_NO_ORDER;
@@ -87,8 +84,13 @@ private:
 	bool DrawGlyph(ProjectFile *vProjectFile, 
 		std::shared_ptr<FontInfos> vFontInfos, const ImVec2& vSize,
 		std::shared_ptr<GlyphInfos> vGlyph, bool vShowRect,
-		bool *vNameupdated, bool *vCodePointUpdated,
 		bool vForceEditMode = false);
+	void DrawGlyphsGrid(ProjectFile *vProjectFile,
+		std::shared_ptr<FontInfos> vFontInfos, uint32_t vCountGlyphs,
+		const std::function<const GlyphOrderedIndex::FlatGlyph&(uint32_t)>& vGetGlyph,
+		uint32_t vGlyphCountX, const ImVec2& vGlyphSize,
+		bool vForceEditMode, bool vShowTooltipInfos,
+		bool vRangeBySourceCodePoint = false);
 	
 	void DrawSelectionsByFontNoOrder(ProjectFile *vProjectFile,
 		bool vShowTooltipInfos = false);
@@ -99,7 +101,6 @@ private:
 		bool vForceEditModeOneColumn = false,
 		bool vShowTooltipInfos = false);
 
-	static void PrepareSelectionByFontOrderedByCodePoint(ProjectFile *vProjectFile);
 	void DrawSelectionsByFontOrderedByCodePoint(ProjectFile *vProjectFile,
 		bool vShowTooltipInfos = false);
 	void DrawSelectionsByFontOrderedByCodePoint_OneFontOnly(
@@ -109,7 +110,6 @@ private:
 		bool vForceEditModeOneColumn = false,
 		bool vShowTooltipInfos = false);
 
-	static void PrepareSelectionByFontOrderedByGlyphNames(ProjectFile *vProjectFile);
 	void DrawSelectionsByFontOrderedByGlyphNames(ProjectFile *vProjectFile,
 		bool vShowTooltipInfos = false);
 	void DrawSelectionsByFontOrderedByGlyphNames_OneFontOnly(
@@ -119,13 +119,10 @@ private:
 		bool vForceEditModeOneColumn = false,
 		bool vShowTooltipInfos = false);
 
-	void PrepareSelectionMergedNoOrder(ProjectFile *vProjectFile);
 	void DrawSelectionMergedNoOrder(ProjectFile *vProjectFile);
 
-	void PrepareSelectionMergedOrderedByCodePoint(ProjectFile *vProjectFile);
 	void DrawSelectionMergedOrderedByCodePoint(ProjectFile *vProjectFile);
 
-	void PrepareSelectionMergedOrderedByGlyphNames(ProjectFile *vProjectFile);
 	void DrawSelectionMergedOrderedByGlyphNames(ProjectFile *vProjectFile);
 
 public: // configuration
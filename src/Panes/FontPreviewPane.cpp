@@ -141,11 +141,11 @@ void FontPreviewPane::DrawFontPreviewPane(ProjectFile *vProjectFile)
 					auto font = ImGui::GetFont();
 					if (font)
 					{
-						auto sel = SelectionHelper::Instance()->GetSelection();
+						const auto& sel = SelectionHelper::Instance()->GetSelection();
 						size_t idx = 0;
-						for (auto glyph : *sel)
+						for (const auto& glyph : sel)
 						{
-							if (glyph.second)
+							if (glyph.second && !glyph.second->m_IsLoading) // the atlas is built by the FontLoader
 							{
 								uint32_t x = idx % glyphCountX;
 
@@ -244,7 +244,7 @@ void FontPreviewPane::DrawMixerWidget(ProjectFile* vProjectFile)
 	if (!vProjectFile->m_FontTestInfos.m_TestFont.expired())
 	{
 		auto fontPtr = vProjectFile->m_FontTestInfos.m_TestFont.lock();
-		if (fontPtr.use_count())
+		if (fontPtr.use_count() && !fontPtr->m_IsLoading) // the atlas is built by the FontLoader
 		{
 			font = fontPtr->GetImFont();
 		}
@@ -284,7 +284,7 @@ void FontPreviewPane::DrawMixerWidget(ProjectFile* vProjectFile)
 					if (vProjectFile->m_FontTestInfos.m_GlyphToInsert.find(idx) != vProjectFile->m_FontTestInfos.m_GlyphToInsert.end())
 					{
 						auto glyphInsert = &vProjectFile->m_FontTestInfos.m_GlyphToInsert[idx];
-						if (glyphInsert->second.use_count() &&
+						if (glyphInsert->second.use_count() && !glyphInsert->second->m_IsLoading &&
 							glyphInsert->second->m_SelectedGlyphs.find(glyphInsert->first) != glyphInsert->second->m_SelectedGlyphs.end())
 						{
 							const auto glyphInfos = glyphInsert->second->m_SelectedGlyphs[glyphInsert->first];
@@ -362,7 +362,7 @@ void FontPreviewPane::DrawMixedFontResult(ProjectFile* vProjectFile)
 	if (!vProjectFile->m_FontTestInfos.m_TestFont.expired())
 	{
 		auto fontPtr = vProjectFile->m_FontTestInfos.m_TestFont.lock();
-		if (fontPtr.use_count())
+		if (fontPtr.use_count() && !fontPtr->m_IsLoading) // the atlas is built by the FontLoader
 		{
 			font = fontPtr->GetImFont();
 		}
@@ -416,7 +416,7 @@ void FontPreviewPane::DrawMixedFontResult(ProjectFile* vProjectFile)
 				{
 					// on dessin le glyph
 					auto glyphInfos = &vProjectFile->m_FontTestInfos.m_GlyphToInsert[idx];
-					if (glyphInfos->second)
+					if (glyphInfos->second && !glyphInfos->second->m_IsLoading) // the atlas is built by the FontLoader
 					{
 						if (glyphInfos->second->m_SelectedGlyphs.find(glyphInfos->first) != glyphInfos->second->m_SelectedGlyphs.end())
 						{
@@ -92,14 +92,18 @@ void FontStructurePane::DrawFontStructurePane(ProjectFile *vProjectFile)
             {
                 if (ImGui::Button("Analyse Font"))
                 {
-					std::string fontFilePathName = FileHelper::Instance()->CorrectSlashTypeForFilePathName(vProjectFile->m_SelectedFont->m_FontFilePathName);
+					std::string fontFilePathName = GetSelectedFontFilePathName(vProjectFile);
+					if (!fontFilePathName.empty())
+						m_FontParser.ParseFont(fontFilePathName);
+                }
 
-					if (!FileHelper::Instance()->IsAbsolutePath(fontFilePathName))
-					{
-						fontFilePathName = vProjectFile->GetAbsolutePath(fontFilePathName);
-					}
+                ImGui::SameLine();
 
-					m_FontParser.ParseFont(fontFilePathName);
+                if (ImGui::Button("Validate Font"))
+                {
+					std::string fontFilePathName = GetSelectedFontFilePathName(vProjectFile);
+					if (!fontFilePathName.empty())
+						m_FontParser.ValidateFont(fontFilePathName);
                 }
 
                 DisplayAnalyze();
@@ -116,5 +120,23 @@ void FontStructurePane::DrawFontStructurePane(ProjectFile *vProjectFile)
 
 void FontStructurePane::DisplayAnalyze()
 {
+    m_FontParser.drawValidation();
     paneWidgetId = m_FontParser.draw(paneWidgetId);
 }
+
+std::string FontStructurePane::GetSelectedFontFilePathName(ProjectFile* vProjectFile)
+{
+	std::string res;
+
+	if (vProjectFile && vProjectFile->m_SelectedFont)
+	{
+		res = FileHelper::Instance()->CorrectSlashTypeForFilePathName(vProjectFile->m_SelectedFont->m_FontFilePathName);
+
+		if (!FileHelper::Instance()->IsAbsolutePath(res))
+		{
+			res = vProjectFile->GetAbsolutePath(res);
+		}
+	}
+
+	return res;
+}
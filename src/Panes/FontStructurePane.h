@@ -39,6 +39,7 @@ public:
 private:
 	void DrawFontStructurePane(ProjectFile *vProjectFile);
 	void DisplayAnalyze();
+	std::string GetSelectedFontFilePathName(ProjectFile* vProjectFile);
 
 public: // singleton
 	static FontStructurePane *Instance()
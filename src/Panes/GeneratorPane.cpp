@@ -312,6 +312,36 @@ void GeneratorPane::DrawFontsGenerator(ProjectFile *vProjectFile)
 #endif
 			}
 
+			if (vProjectFile->IsGenMode(GENERATOR_MODE_SRC))
+			{
+				ImGui::FramedGroupText("Src Compression");
+				mrw = maxWidth / 3.0f - ImGui::GetStyle().FramePadding.x;
+				change |= ImGui::RadioButtonLabeled_BitWize<GenModeFlags>(
+					"None", "Font as a raw bytes array (aligned)\nbiggest size, but no decode and no copy at startup\nloaded with AddFontFromMemoryTTF and FontDataOwnedByAtlas = false",
+					&vProjectFile->m_GenModeFlags, GENERATOR_MODE_SRC_CODEC_NONE, mrw,
+					true, true, GENERATOR_MODE_RADIO_SRC_CODEC);
+				ImGui::SameLine();
+				change |= ImGui::RadioButtonLabeled_BitWize<GenModeFlags>(
+					"Stb", "Font compressed with stb_compress and encoded in base85\nloaded with AddFontFromMemoryCompressedBase85TTF",
+					&vProjectFile->m_GenModeFlags, GENERATOR_MODE_SRC_CODEC_STB, mrw,
+					true, true, GENERATOR_MODE_RADIO_SRC_CODEC);
+				ImGui::SameLine();
+				change |= ImGui::RadioButtonLabeled_BitWize<GenModeFlags>(
+					"LZ4", "Font compressed with lz4\nthe decoder is generated in the source file",
+					&vProjectFile->m_GenModeFlags, GENERATOR_MODE_SRC_CODEC_LZ4, mrw,
+					true, true, GENERATOR_MODE_RADIO_SRC_CODEC);
+
+				if (!vProjectFile->IsGenMode(GENERATOR_MODE_LANG_CSHARP))
+				{
+					change |= ImGui::RadioButtonLabeled_BitWize<GenModeFlags>(
+						"Linked Datas", "the font datas are written in a .bin file, linked with a .S (gcc/clang) or a .obj (msvc x64)\nthe compiler never parse a big literal\nthe src file is a small header with the extern symbols",
+						&vProjectFile->m_GenModeFlags, GENERATOR_MODE_SRC_SETTINGS_LINKED_DATAS,
+						maxWidth - ImGui::GetStyle().FramePadding.x);
+				}
+
+				DrawSourceCodecs(vProjectFile, maxWidth);
+			}
+
 			if (vProjectFile->IsGenMode(GENERATOR_MODE_MERGED))
 			{
 				ImGui::FramedGroupText("Merged Mode");
@@ -321,6 +351,14 @@ void GeneratorPane::DrawFontsGenerator(ProjectFile *vProjectFile)
 					maxWidth - ImGui::GetStyle().FramePadding.x);
 			}
 
+			if (vProjectFile->IsGenMode(GENERATOR_MODE_BATCH))
+			{
+				ImGui::FramedGroupText("Batch Mode");
+				change |= ImGui::SliderUIntDefaultCompact(maxWidth - ImGui::GetStyle().FramePadding.x,
+					"Threads (0 = cores)", &vProjectFile->m_BatchThreadsCount, 0U, 64U,
+					defaultProjectFile.m_BatchThreadsCount);
+			}
+
 			if (vProjectFile->IsGenMode(GENERATOR_MODE_FONT))
 			{
 				ImGui::FramedGroupText("Font");
@@ -397,6 +435,49 @@ void GeneratorPane::DrawFontsGenerator(ProjectFile *vProjectFile)
 	}
 }
 
+// size and decoding time of each codec, for the selected font
+// the measure is done on demand, its too long for each frame
+void GeneratorPane::DrawSourceCodecs(ProjectFile *vProjectFile, float vMaxWidth)
+{
+	if (vProjectFile && vProjectFile->m_SelectedFont)
+	{
+		if (ImGui::Button("Measure Codecs", ImVec2(vMaxWidth - ImGui::GetStyle().FramePadding.x, 0.0f)))
+		{
+			m_CodecStatsFontName.clear();
+			for (auto& stats : m_CodecStats)
+				stats = CompressCodecStats();
+
+			std::vector<uint8_t> fontDatas;
+			if (Generator::Instance()->GetFontDatas_One(vProjectFile, vProjectFile->m_SelectedFont, &fontDatas))
+			{
+				m_CodecStatsFontName = vProjectFile->m_SelectedFont->m_FontFileName;
+				for (int i = 0; i < (int)COMPRESS_CODEC_Count; i++)
+				{
+					Compress::MeasureCodec((CompressCodecEnum)i, fontDatas.data(), fontDatas.size(), &m_CodecStats[i]);
+				}
+			}
+		}
+
+		if (!m_CodecStatsFontName.empty())
+		{
+			ImGui::Text("Font : %s (%u bytes)", m_CodecStatsFontName.c_str(), (uint32_t)m_CodecStats[COMPRESS_CODEC_NONE].datasSize);
+			for (int i = 0; i < (int)COMPRESS_CODEC_Count; i++)
+			{
+				const auto& stats = m_CodecStats[i];
+				if (stats.valid)
+				{
+					ImGui::Text("%s : %u bytes, decode %.3f ms", Compress::GetCodecName((CompressCodecEnum)i),
+						(uint32_t)stats.compressedSize, stats.decodeTimeInMs);
+				}
+				else
+				{
+					ImGui::TextColored(ImGuiThemeHelper::Instance()->badColor, "%s : measure failed", Compress::GetCodecName((CompressCodecEnum)i));
+				}
+			}
+		}
+	}
+}
+
 /*
 Always on feature must be selected : Header or Card or Font or CPP
 Card can be alone
@@ -18,6 +18,7 @@
 #include <Panes/Abstract/AbstractPane.h>
 
 #include <ImGuiFileDialog/ImGuiFileDialog.h>
+#include <Generator/Compress.h>
 
 #include <stdint.h>
 #include <string>
@@ -42,6 +43,10 @@ class GeneratorPane : public AbstractPane
 private: // STATUS FLAGS
 	GeneratorStatusFlags m_GeneratorStatusFlags = GENERATOR_STATUS_DEFAULT;
 
+private: // codecs measures, for the selected font
+	CompressCodecStats m_CodecStats[COMPRESS_CODEC_Count];
+	std::string m_CodecStatsFontName;
+
 public:
 	void Init() override;
 	void Unit() override;
@@ -56,6 +61,7 @@ public:
 private:
 	void DrawGeneratorPane(ProjectFile *vProjectFile);
 	void DrawFontsGenerator(ProjectFile *vProjectFile);
+	void DrawSourceCodecs(ProjectFile *vProjectFile, float vMaxWidth);
 	void GeneratorFileDialogPane(const char *vFilter, IGFDUserDatas vUserDatas, bool* vCantContinue);
 
 	bool CheckGenerationConditions(ProjectFile *vProjectFile);
@@ -36,6 +36,8 @@
 #include <sfntly/font_factory.h>
 
 #include <Helper/Messaging.h>
+#include <Helper/FontDataService.h>
+#include <Project/ProjectJournal.h>
 
 GlyphPane::GlyphPane() = default;
 GlyphPane::~GlyphPane() = default;
@@ -176,9 +178,8 @@ bool GlyphPane::LoadGlyph(ProjectFile *vProjectFile, std::shared_ptr<FontInfos>
 
 			if (FileHelper::Instance()->IsFileExist(fontPathName))
 			{
-				FontGenerator m_FontHelper;
-
-				m_fontInstance.m_Font.Attach(m_FontHelper.LoadFontFile(fontPathName.c_str()));
+				// the font file is not read at each click, the parsed font is shared
+				m_fontInstance.m_Font = FontDataService::Instance()->GetFont(fontPathName);
 				if (m_fontInstance.m_Font)
 				{
 					sfntly::Ptr<sfntly::CMapTable> cmap_table = down_cast<sfntly::CMapTable*>(m_fontInstance.m_Font->GetTable(sfntly::Tag::cmap));
@@ -271,7 +272,7 @@ bool GlyphPane::DrawSimpleGlyph(ProjectFile* vProjectFile)
 				if (!fontInfos.expired())
 				{
 					auto fontInfosPtr = fontInfos.lock();
-					if (fontInfosPtr.use_count())
+					if (fontInfosPtr.use_count() && !fontInfosPtr->m_IsLoading) // the bbox and metrics are rewritten by the FontLoader
 					{
 						int cmax = (int)g->coords.size();
 						ct::ivec4 rc = g->rc;
@@ -315,6 +316,7 @@ bool GlyphPane::DrawSimpleGlyph(ProjectFile* vProjectFile)
 							// will come back with svg or/and glyph edition
 							g->m_Translation = glyphInfosPtr->m_Translation; // wip
 							g->m_Scale = glyphInfosPtr->m_Scale;// for the moment scale is overwrite by merged system
+							ProjectJournal::Instance()->AddTransform(fontInfosPtr, *glyphInfosPtr);
 							vProjectFile->SetProjectChange();
 						}
 
@@ -23,6 +23,7 @@
 
 #include <MainFrame.h>
 #include <Helper/SelectionHelper.h>
+#include <Helper/FontLoader.h>
 #include <Panes/FinalFontPane.h>
 #include <Panes/Manager/LayoutManager.h>
 #include <Project/FontInfos.h>
@@ -239,6 +240,8 @@ void ParamsPane::DrawParamsPane(ProjectFile *vProjectFile)
 						}
 					}
 
+					FontLoader::Instance()->DrawProgress();
+
 					ImGui::EndFramedGroup(true);
 				}
 
@@ -465,18 +468,15 @@ bool ParamsPane::Display_ConfirmToCloseFont_Dialog()
 //// FONT ////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 
+// async, the fonts are added to the project when loaded (see FontLoader)
 void ParamsPane::OpenFonts(ProjectFile *vProjectFile, const std::map<std::string, std::string>& vFontFilePathNames)
 {
 	if (vProjectFile && vProjectFile->IsLoaded())
 	{
-		bool res = false;
 		for (auto & it : vFontFilePathNames)
 		{
-			res |= OpenFont(vProjectFile, it.second, false);
+			FontLoader::Instance()->LoadFont(vProjectFile, it.second);
 		}
-
-		if (res) // si au moins est bon
-			vProjectFile->UpdateCountSelectedGlyphs();
 	}
 }
 
@@ -183,28 +183,59 @@ void SourceFontPane::DrawFilterBar(ProjectFile *vProjectFile, std::shared_ptr<Fo
 		ImGui::Text("(?)");
 		if (ImGui::IsItemHovered())
 			ImGui::SetTooltip("will search for any filter separated\n\tby a coma ',' or a space ' '");
+		bool filterChanged = false;
 		if (ImGui::MenuItem(ICON_IGFS_DESTROY "##clearFilter"))
 		{
 			ct::ResetBuffer(vFontInfos->m_SearchBuffer);
-			vFontInfos->m_Filters.clear();
-			vProjectFile->SetProjectChange();
-			vFontInfos->UpdateFiltering();
+			filterChanged = true;
 		}
 		ImGui::PushItemWidth(400);
-		bool filterChanged = ImGui::InputText("##Filter", vFontInfos->m_SearchBuffer, 1023);
+		filterChanged |= ImGui::InputText("##Filter", vFontInfos->m_SearchBuffer, 1023);
 		ImGui::PopItemWidth();
+		if (ImGui::MenuItem("All Fonts", "", &vProjectFile->m_SourcePane_FilterAllFonts))
+		{
+			filterChanged = vProjectFile->m_SourcePane_FilterAllFonts;
+			vProjectFile->SetProjectChange();
+		}
+		if (ImGui::IsItemHovered())
+			ImGui::SetTooltip("apply the filters to all the fonts");
 		ImGui::PopID();
 		if (filterChanged)
 		{
-			vFontInfos->m_Filters.clear();
+			std::set<std::string> filters;
 			std::string s = vFontInfos->m_SearchBuffer;
 			auto arr = ct::splitStringToVector(s, ", ");
 			for (const auto &it : arr)
 			{
-				vFontInfos->m_Filters.insert(it);
+				filters.insert(it);
 			}
+
+			// each font have his name index, so the filtering of all the fonts is fast enough for be done while typing
+			auto applyFilters = [&filters, &vFontInfos](std::shared_ptr<FontInfos> vFont)
+			{
+				if (vFont != vFontInfos)
+				{
+					ct::ResetBuffer(vFont->m_SearchBuffer);
+					ct::AppendToBuffer(vFont->m_SearchBuffer, 1023, vFontInfos->m_SearchBuffer);
+				}
+				vFont->m_Filters = filters;
+				vFont->UpdateFiltering();
+			};
+
+			if (vProjectFile->m_SourcePane_FilterAllFonts)
+			{
+				for (const auto& it : vProjectFile->m_Fonts)
+				{
+					if (it.second.use_count())
+						applyFilters(it.second);
+				}
+			}
+			else
+			{
+				applyFilters(vFontInfos);
+			}
+
 			vProjectFile->SetProjectChange();
-			vFontInfos->UpdateFiltering();
 		}
 	}
 }
@@ -328,11 +359,14 @@ void SourceFontPane::DrawFontAtlas_Virtual(ProjectFile *vProjectFile, std::share
 		{
 			vProjectFile->m_Preview_Glyph_CountX = ct::maxi(vProjectFile->m_Preview_Glyph_CountX, 1);
 
+			// the pages requested by the last frame, before any use of the texture in this frame
+			vFontInfos->RasterizePendingPages();
+
 			if (vFontInfos->m_ImFontAtlas.IsBuilt())
 			{
 				if (vFontInfos->m_ImFontAtlas.TexID)
 				{
-					if (!vFontInfos->m_FilteredGlyphs.empty())
+					if (!vFontInfos->m_FilteredSlots.empty())
 					{
 						ImVec2 hostTextureSize = ImVec2(
 							(float)vFontInfos->m_ImFontAtlas.TexWidth,
@@ -345,7 +379,7 @@ void SourceFontPane::DrawFontAtlas_Virtual(ProjectFile *vProjectFile, std::share
 							ImVec4 glyphRangeColoring = ImGui::GetStyleColorVec4(ImGuiCol_Button);
 							bool showRangeColoring = vProjectFile->IsRangeColoringShown();
 							
-							uint32_t countGlyphs = (uint32_t)vFontInfos->m_FilteredGlyphs.size();
+							uint32_t countGlyphs = (uint32_t)vFontInfos->m_FilteredSlots.size();
 							int rowCount = (int)ct::ceil((double)countGlyphs / (double)glyphCountX);
 							
 							m_VirtualClipper.Begin(rowCount, cell_size.y);
@@ -360,10 +394,14 @@ void SourceFontPane::DrawFontAtlas_Virtual(ProjectFile *vProjectFile, std::share
 										uint32_t glyphIdx = i + j * glyphCountX;
 										if (glyphIdx < countGlyphs)
 										{
-											auto glyph = *(vFontInfos->m_FilteredGlyphs.begin() + glyphIdx);
+											const uint32_t glyphSlot = vFontInfos->m_FilteredSlots[glyphIdx];
+											auto glyph = vFontInfos->GetGlyph(vFontInfos->m_GlyphTable.GetCodePoint(glyphSlot));
+
+											// paged rasterization, the page will be added to the atlas at the next frame
+											vFontInfos->RequestGlyphPage(glyph.Codepoint);
 
-											std::string name = vFontInfos->m_GlyphCodePointToName[glyph.Codepoint];
-											bool colored = vFontInfos->m_ColoredGlyphs[glyph.Codepoint];
+											const char* name = vFontInfos->m_GlyphTable.GetName(glyphSlot);
+											bool colored = vFontInfos->m_GlyphTable.IsColored(glyphSlot);
 
 											uint32_t x = idx % glyphCountX;
 
@@ -416,7 +454,7 @@ void SourceFontPane::DrawFontAtlas_Virtual(ProjectFile *vProjectFile, std::share
 											{
 												if (ImGui::IsItemHovered())
 												{
-													ImGui::SetTooltip("name : %s\ncodepoint : %i", name.c_str(), (int)glyph.Codepoint);
+													ImGui::SetTooltip("name : %s\ncodepoint : %i", name, (int)glyph.Codepoint);
 												}
 											}
 
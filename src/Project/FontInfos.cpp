@@ -22,6 +22,10 @@
 #include <Project/ProjectFile.h>
 #include <Gui/ImGuiWidgets.h>
 #include <Helper/Messaging.h>
+#include <Helper/CommandLine.h>
+#include <Helper/AtlasCache.h>
+#include <Helper/FontDataService.h>
+#include <Project/ProjectJournal.h>
 #include <ctools/Logger.h>
 #include <Panes/ParamsPane.h>
 
@@ -33,9 +37,15 @@
 #include <glad/glad.h>
 
 #include <array>
+#include <cstring>
 
 using namespace ImGuiFreeType;
 
+// over this count of glyphs, the atlas is rasterized by pages of codepoints
+// only the pages visible in the source pane or used by the selection are rasterized
+#define PAGED_RASTERIZATION_MIN_GLYPHS 8192
+#define GLYPH_PAGE_SIZE 256U
+
 ///////////////////////////////////////////////////////////////////////////////////
 static ProjectFile defaultProjectValues;
 static FontInfos defaultFontInfosValues;
@@ -62,6 +72,16 @@ static std::string GetPrefixFromFontFileName(const std::string& vFileName)
     return res;
 }
 
+static int GetCountGlyphsInFont(const ImFontConfig& vFontConfig)
+{
+	stbtt_fontinfo fontInfo;
+	const int font_offset = stbtt_GetFontOffsetForIndex(
+		(unsigned char*)vFontConfig.FontData, vFontConfig.FontNo);
+	if (stbtt_InitFont(&fontInfo, (unsigned char*)vFontConfig.FontData, font_offset))
+		return fontInfo.numGlyphs;
+	return 0;
+}
+
 std::shared_ptr<FontInfos> FontInfos::Create()
 {
 	auto res = std::make_shared<FontInfos>();
@@ -80,10 +100,20 @@ void FontInfos::Clear()
 {
 	DestroyFontTexture();
 	m_ImFontAtlas.Clear();
-	m_GlyphNames.clear();
-	m_GlyphCodePointToName.clear();
+	m_FontFileDatas.reset(); // after the atlas, he point on it
+	m_GlyphTable.Clear();
+	m_GlyphNameIndex.Clear();
+	m_FilteredSlots.clear();
 	m_SelectedGlyphs.clear();
+	m_GlyphOrderedIndex.Clear();
 	m_Filters.clear();
+	m_PagedRasterization = false;
+	m_RasterizedPages.clear();
+	m_PendingPages.clear();
+	m_PagedRanges.clear();
+	m_CountSelectedGlyphsOfPages = 0;
+	m_PagesLastUse.clear();
+	m_PagesFrame = 0;
 	rasterizerMode = RasterizerEnum::RASTERIZER_FREETYPE;
 	freeTypeFlag = FreeType_Default;
 	fontMultiply = 1.0f;
@@ -98,6 +128,21 @@ bool FontInfos::LoadFont(ProjectFile *vProjectFile, const std::string& vFontFile
 	if (!vProjectFile || !vProjectFile->IsLoaded())
 		return res;
 
+	std::string fontFilePathName = GetFontFilePathNameToLoad(vProjectFile, vFontFilePathName);
+	if (!fontFilePathName.empty())
+	{
+		const bool datasLoaded = LoadFontDatas(fontFilePathName);
+		res = FinishLoading(vProjectFile, fontFilePathName, datasLoaded);
+	}
+
+	return res;
+}
+
+std::string FontInfos::GetFontFilePathNameToLoad(ProjectFile* vProjectFile, const std::string& vFontFilePathName)
+{
+	if (!vProjectFile || !vProjectFile->IsLoaded())
+		return "";
+
 	std::string fontFilePathName = FileHelper::Instance()->CorrectSlashTypeForFilePathName(vFontFilePathName);
 	
 	if (!FileHelper::Instance()->IsAbsolutePath(fontFilePathName))
@@ -105,106 +150,199 @@ bool FontInfos::LoadFont(ProjectFile *vProjectFile, const std::string& vFontFile
 		fontFilePathName = vProjectFile->GetAbsolutePath(fontFilePathName);
 	}
 	
-	if (FileHelper::Instance()->IsFileExist(fontFilePathName))
+	if (!FileHelper::Instance()->IsFileExist(fontFilePathName))
 	{
-		static const ImWchar ranges[] =
-		{
-			0x0020,
-			0xFFFF, // Full Range
-			0,
-		};
-		m_FontConfig.GlyphRanges = &ranges[0];
-		m_FontConfig.OversampleH = m_Oversample;
-		m_FontConfig.OversampleV = m_Oversample;
-		m_ImFontAtlas.Clear();
-		m_ImFontAtlas.Flags |= 
-			ImFontAtlasFlags_NoMouseCursors | // hte mouse cursors
-			ImFontAtlasFlags_NoBakedLines; // the big triangle
+		Messaging::Instance()->AddError(true, nullptr, nullptr, "font %s not found", fontFilePathName.c_str());
+		m_NeedFilePathResolve = true;
+		vProjectFile->SetProjectChange();
+		return "";
+	}
 
-		auto ps = FileHelper::Instance()->ParsePathFileName(fontFilePathName);
-		if (ps.isOk)
-		{
-			m_FontFileName = ps.name + "." + ps.ext;
+	return fontFilePathName;
+}
+
+// no opengl and no project access here, can be called by the FontLoader threads
+bool FontInfos::LoadFontDatas(const std::string& vFontFilePathName, std::atomic<int>* vStage)
+{
+	bool res = false;
 
-			ImFont *font = m_ImFontAtlas.AddFontFromFileTTF(
-				fontFilePathName.c_str(),
+	if (vStage) *vStage = FONT_LOADING_STAGE_READING;
+
+	static const ImWchar ranges[] =
+	{
+		0x0020,
+		0xFFFF, // Full Range
+		0,
+	};
+	m_FontConfig.GlyphRanges = &ranges[0];
+	m_FontConfig.OversampleH = m_Oversample;
+	m_FontConfig.OversampleV = m_Oversample;
+	m_ImFontAtlas.Clear();
+	m_ImFontAtlas.Flags |= 
+		ImFontAtlasFlags_NoMouseCursors | // hte mouse cursors
+		ImFontAtlasFlags_NoBakedLines; // the big triangle
+
+	auto ps = FileHelper::Instance()->ParsePathFileName(vFontFilePathName);
+	if (ps.isOk)
+	{
+		m_FontFileName = ps.name + "." + ps.ext;
+
+		// the file is read once for all the app, the atlas use the shared bytes without copy
+		ImFont *font = nullptr;
+		m_FontFileDatas = FontDataService::Instance()->GetFontFileDatas(vFontFilePathName);
+		if (m_FontFileDatas)
+		{
+			m_FontConfig.FontDataOwnedByAtlas = false;
+			font = m_ImFontAtlas.AddFontFromMemoryTTF(
+				(void*)m_FontFileDatas->GetDatas(),
+				(int)m_FontFileDatas->GetSize(),
 				(float)m_FontSize,
 				&m_FontConfig);
-			if (font)
-			{
-				bool success = false;
+		}
+		if (font)
+		{
+			bool success = false;
 
-				m_ImFontAtlas.TexGlyphPadding = fontPadding;
+			m_ImFontAtlas.TexGlyphPadding = fontPadding;
 
-				for (int n = 0; n < m_ImFontAtlas.ConfigData.Size; n++)
-				{
-					ImFontConfig* font_config = (ImFontConfig*)&m_ImFontAtlas.ConfigData[n];
-					font_config->RasterizerMultiply = fontMultiply;
-					font_config->RasterizerFlags = (rasterizerMode == RasterizerEnum::RASTERIZER_FREETYPE) ? freeTypeFlag : 0x00;
-					font_config->OversampleH = m_Oversample;
-					font_config->OversampleV = m_Oversample;
-				}
-				
-				FT_Error freetypeError = 0;
-				if (rasterizerMode == RasterizerEnum::RASTERIZER_FREETYPE)
-				{
-					success = BuildFontAtlas(&m_ImFontAtlas, freeTypeFlag, &freetypeError);
-				}
-				else if (rasterizerMode == RasterizerEnum::RASTERIZER_STB)
-				{
-					success = m_ImFontAtlas.Build();
-				}
+			for (int n = 0; n < m_ImFontAtlas.ConfigData.Size; n++)
+			{
+				ImFontConfig* font_config = (ImFontConfig*)&m_ImFontAtlas.ConfigData[n];
+				font_config->RasterizerMultiply = fontMultiply;
+				font_config->RasterizerFlags = (rasterizerMode == RasterizerEnum::RASTERIZER_FREETYPE) ? freeTypeFlag : 0x00;
+				font_config->OversampleH = m_Oversample;
+				font_config->OversampleV = m_Oversample;
+			}
 
-				m_FontFilePathName = vProjectFile->GetRelativePath(fontFilePathName);
+			m_PagedRasterization = false;
+			m_RasterizedPages.clear();
+			m_PendingPages.clear();
+			m_PagedRanges.clear();
+			m_CountSelectedGlyphsOfPages = 0;
+			m_PagesLastUse.clear();
+			m_PagesFrame = 0;
+			if (!CommandLine::Instance()->IsHeadless() &&
+				GetCountGlyphsInFont(m_ImFontAtlas.ConfigData[0]) > PAGED_RASTERIZATION_MIN_GLYPHS)
+			{
+				// first page for the first rows of the source pane, the others are requested when displayed
+				m_PagedRasterization = true;
+				m_PagesLastUse.resize(0xFFFFU / GLYPH_PAGE_SIZE + 1U, 0U);
+				RequestGlyphPage(0x0020);
+				RequestPagesOfSelectedGlyphs();
+				m_RasterizedPages.swap(m_PendingPages);
+				UpdatePagedRanges();
+				m_ImFontAtlas.ConfigData[0].GlyphRanges = m_PagedRanges.data();
+			}
 
-				if (success)
-				{
-					if (!m_ImFontAtlas.Fonts.empty())
-					{
-						if (m_FontPrefix.empty())
-							m_FontPrefix = GetPrefixFromFontFileName(ps.name);
+			if (vStage) *vStage = FONT_LOADING_STAGE_RASTERIZING;
+			
+			FT_Error freetypeError = 0;
+			std::string cacheKey; // empty if the atlas can't be cached
+			if (!CommandLine::Instance()->IsHeadless())
+				cacheKey = AtlasCache::Instance()->GetKey(this);
+			bool loadedFromCache = false;
+			if (CommandLine::Instance()->IsHeadless())
+			{
+				// no atlas build in headless mode
+				// the generation need only the font file datas, stored in ConfigData
+				success = true;
+			}
+			else if (AtlasCache::Instance()->Load(cacheKey, this))
+			{
+				// atlas, glyphs and names restored, no rasterization
+				success = loadedFromCache = true;
+			}
+			else
+			{
+				success = BuildAtlas(&freetypeError);
+			}
 
-						DestroyFontTexture();
-						CreateFontTexture();
+			if (success)
+			{
+				if (!m_ImFontAtlas.Fonts.empty())
+				{
+					if (vStage) *vStage = FONT_LOADING_STAGE_GLYPH_NAMES;
 
+					if (!loadedFromCache)
+					{
 						FillGlyphNames();
 						GenerateCodePointToGlypNamesDB();
 						FillGlyphColoreds();
-						UpdateInfos();
-						UpdateFiltering();
-						UpdateSelectedGlyphs(font);
+						AtlasCache::Instance()->Save(cacheKey, this);
+					}
 
-						m_NeedFilePathResolve = false;
+					m_GlyphNameIndex.Build(m_GlyphTable);
 
-						res = true;
-					}
-				}
-				else
-				{
-					if (rasterizerMode == RasterizerEnum::RASTERIZER_FREETYPE)
+					if (!CommandLine::Instance()->IsHeadless())
 					{
-						Messaging::Instance()->AddError(true, nullptr, nullptr,
-							"Feetype fail to load font file %s.%s. Reason : %s", 
-							ps.name.c_str(), ps.ext.c_str(), ImGuiFreeType::GetErrorMessage(freetypeError));
-					}
-					else
-					{
-						Messaging::Instance()->AddError(true, nullptr, nullptr,
-							"The  File %s.%s seem to be bad. Can't load", ps.name.c_str(), ps.ext.c_str());
+						// the rgba32 conversion is done here, so only the upload is left to CreateFontTexture
+						unsigned char* pixels = nullptr;
+						int width = 0, height = 0;
+						m_ImFontAtlas.GetTexDataAsRGBA32(&pixels, &width, &height);
 					}
+
+					res = true;
 				}
 			}
 			else
 			{
-				Messaging::Instance()->AddError(true, nullptr, nullptr,
-				        "The  File %s.%s seem to be bad. Can't load", ps.name.c_str(), ps.ext.c_str());
+				if (rasterizerMode == RasterizerEnum::RASTERIZER_FREETYPE)
+				{
+					Messaging::Instance()->AddError(true, nullptr, nullptr,
+						"Feetype fail to load font file %s.%s. Reason : %s", 
+						ps.name.c_str(), ps.ext.c_str(), ImGuiFreeType::GetErrorMessage(freetypeError));
+				}
+				else
+				{
+					Messaging::Instance()->AddError(true, nullptr, nullptr,
+						"The  File %s.%s seem to be bad. Can't load", ps.name.c_str(), ps.ext.c_str());
+				}
 			}
 		}
+		else
+		{
+			Messaging::Instance()->AddError(true, nullptr, nullptr,
+			        "The  File %s.%s seem to be bad. Can't load", ps.name.c_str(), ps.ext.c_str());
+		}
 	}
-	else
+
+	if (vStage) *vStage = FONT_LOADING_STAGE_UPLOAD;
+
+	return res;
+}
+
+// main thread, after LoadFontDatas
+bool FontInfos::FinishLoading(ProjectFile* vProjectFile, const std::string& vFontFilePathName, bool vDatasLoaded)
+{
+	bool res = false;
+
+	if (!vProjectFile)
+		return res;
+
+	m_FontFilePathName = vProjectFile->GetRelativePath(vFontFilePathName);
+
+	if (vDatasLoaded)
 	{
-		Messaging::Instance()->AddError(true, nullptr, nullptr, "font %s not found", fontFilePathName.c_str());
-		m_NeedFilePathResolve = true;
+		if (m_FontPrefix.empty())
+		{
+			auto ps = FileHelper::Instance()->ParsePathFileName(vFontFilePathName);
+			if (ps.isOk)
+				m_FontPrefix = GetPrefixFromFontFileName(ps.name);
+		}
+
+		if (!CommandLine::Instance()->IsHeadless())
+		{
+			DestroyFontTexture();
+			CreateFontTexture();
+		}
+
+		UpdateInfos();
+		UpdateFiltering();
+		UpdateSelectedGlyphs(GetImFont());
+
+		m_NeedFilePathResolve = false;
+
+		res = true;
 	}
 
 	vProjectFile->SetProjectChange();
@@ -242,7 +380,7 @@ void FontInfos::FillGlyphNames()
 {
 	if (!m_ImFontAtlas.ConfigData.empty())
 	{
-		m_GlyphNames.clear();
+		m_GlyphTable.Clear();
 
 		stbtt_fontinfo fontInfo;
 		const int font_offset = stbtt_GetFontOffsetForIndex(
@@ -307,11 +445,11 @@ void FontInfos::FillGlyphNames()
 				{
 					stbtt_uint16 idx = mapIdx - 258;
 					if (idx < pendingNames.size())
-						m_GlyphNames.push_back(pendingNames[idx]);
+						m_GlyphTable.AddGlyphName(pendingNames[idx]);
 				}
 				else
 				{
-					m_GlyphNames.emplace_back(standardMacNames[mapIdx]);
+					m_GlyphTable.AddGlyphName(standardMacNames[mapIdx]);
 				}
 			}
 		}
@@ -320,11 +458,7 @@ void FontInfos::FillGlyphNames()
 
 std::string FontInfos::GetGlyphName(uint32_t vCodePoint)
 {
-	std::string res;
-	if (m_GlyphCodePointToName.find(vCodePoint) != m_GlyphCodePointToName.end())
-	{
-		res = m_GlyphCodePointToName[vCodePoint];
-	}
+	std::string res = m_GlyphTable.GetNameOfCodePoint(vCodePoint);
 	if (res.empty())
 		res = ct::toStr("Symbol_%u", vCodePoint);
 	return res;
@@ -332,7 +466,7 @@ std::string FontInfos::GetGlyphName(uint32_t vCodePoint)
 
 void FontInfos::FillGlyphColoreds()
 {
-	m_ColoredGlyphs.clear();
+	m_GlyphTable.ClearFlags(GLYPH_FLAG_COLORED);
 
 	if (rasterizerMode != RasterizerEnum::RASTERIZER_FREETYPE) return;
 	if ((freeTypeFlag & FreeType_LoadColor) == 0) return;
@@ -381,10 +515,10 @@ void FontInfos::FillGlyphColoreds()
 					stbtt_int32 glyphID = ttUSHORT(data + offset);
 					stbtt_int32 numLayers = ttUSHORT(data + offset + 4);
 
-					if (m_GlyphGlyphIndexToCodePoint.find(glyphID) != m_GlyphGlyphIndexToCodePoint.end())
+					const uint32_t slot = m_GlyphTable.FindSlotOfGlyphIndex((uint32_t)glyphID);
+					if (slot != GlyphTable::INVALID_SLOT)
 					{
-						int cdp = m_GlyphGlyphIndexToCodePoint[glyphID];
-						m_ColoredGlyphs[cdp] = (numLayers > 1);
+						m_GlyphTable.SetFlags(slot, GLYPH_FLAG_COLORED, (numLayers > 1));
 					}
 				}
 			}
@@ -577,7 +711,15 @@ void FontInfos::UpdateInfos()
 	m_InfosToDisplay.push_back(std::pair<std::string, std::string>("Font", m_FontFilePathName));
 	if (GetImFont())
 	{
-		m_InfosToDisplay.push_back(std::pair<std::string, std::string>("N Glyphs :", ct::toStr(GetImFont()->Glyphs.size())));
+		if (m_PagedRasterization)
+		{
+			m_InfosToDisplay.push_back(std::pair<std::string, std::string>("N Glyphs :", ct::toStr("%u (%i rasterized)",
+				(uint32_t)m_GlyphTable.size(), GetImFont()->Glyphs.size())));
+		}
+		else
+		{
+			m_InfosToDisplay.push_back(std::pair<std::string, std::string>("N Glyphs :", ct::toStr(GetImFont()->Glyphs.size())));
+		}
 	}
 	//m_InfosToDisplay.push_back(std::pair<std::string, std::string>("N Sel Glyphs :", ct::toStr(m_SelectedGlyphs.size())));
 	m_InfosToDisplay.push_back(std::pair<std::string, std::string>("Texture Size :", ct::toStr("%i x %i", m_ImFontAtlas.TexWidth, m_ImFontAtlas.TexHeight)));
@@ -601,14 +743,17 @@ void FontInfos::UpdateSelectedGlyphs(ImFont *vFont)
 			uint32_t codePoint = it.first;
 
 			auto glyph = vFont->FindGlyphNoFallback((ImWchar)codePoint);
-			if (glyph)
+			if (glyph || !m_ImFontAtlas.IsBuilt() || // atlas not built in headless mode
+				!IsGlyphRasterized(codePoint)) // the page is not yet rasterized
 			{
 				if (it.second)
 				{
-					it.second->glyph = *glyph;
+					if (glyph)
+						it.second->glyph = *glyph;
 					it.second->oldHeaderName = GetGlyphName(codePoint);
-					it.second->glyphIndex = m_GlyphCodePointToGlyphIndex[codePoint];
-					it.second->m_Colored = m_ColoredGlyphs[codePoint];
+					const uint32_t slot = m_GlyphTable.FindSlot(codePoint);
+					it.second->glyphIndex = (slot != GlyphTable::INVALID_SLOT) ? m_GlyphTable.GetGlyphIndex(slot) : 0U;
+					it.second->m_Colored = (slot != GlyphTable::INVALID_SLOT) ? m_GlyphTable.IsColored(slot) : false;
 				}
 			}
 		}
@@ -619,7 +764,7 @@ void FontInfos::GenerateCodePointToGlypNamesDB()
 {
 	if (!m_ImFontAtlas.ConfigData.empty())
 	{
-		m_GlyphCodePointToName.clear();
+		m_GlyphTable.ClearCodePoints();
 
 		stbtt_fontinfo fontInfo;
 		const int font_offset = stbtt_GetFontOffsetForIndex(
@@ -627,7 +772,7 @@ void FontInfos::GenerateCodePointToGlypNamesDB()
 			m_ImFontAtlas.ConfigData[0].FontNo);
 		if (stbtt_InitFont(&fontInfo, (unsigned char*)m_ImFontAtlas.ConfigData[0].FontData, font_offset))
 		{
-			if (m_ImFontAtlas.IsBuilt())
+			if (m_ImFontAtlas.IsBuilt() && !m_PagedRasterization)
 			{
 				ImFont* font = GetImFont();
 				if (font)
@@ -635,54 +780,45 @@ void FontInfos::GenerateCodePointToGlypNamesDB()
 					for (auto glyph : font->Glyphs)
 					{
 						int glyphIndex = stbtt_FindGlyphIndex(&fontInfo, (uint32_t)glyph.Codepoint);
-						m_GlyphCodePointToGlyphIndex[(uint32_t)glyph.Codepoint] = glyphIndex;
-						m_GlyphGlyphIndexToCodePoint[(uint32_t)glyphIndex] = glyph.Codepoint;
-						if (glyphIndex < (int)m_GlyphNames.size())
-						{
-							std::string name = m_GlyphNames[glyphIndex];
-							m_GlyphCodePointToName[glyph.Codepoint] = name;
-						}
-						else
-						{
-							m_GlyphCodePointToName[glyph.Codepoint] = "";
-						}
+						m_GlyphTable.AddCodePoint((uint32_t)glyph.Codepoint, (uint32_t)glyphIndex);
+					}
+				}
+			}
+			else // headless mode (no atlas) or paged rasterization, so we scan the cmap on the same range as the atlas
+			{
+				for (uint32_t codePoint = 0x0020; codePoint <= 0xFFFF; codePoint++)
+				{
+					int glyphIndex = stbtt_FindGlyphIndex(&fontInfo, codePoint);
+					if (glyphIndex > 0)
+					{
+						m_GlyphTable.AddCodePoint(codePoint, (uint32_t)glyphIndex);
 					}
 				}
 			}
+
+			m_GlyphTable.Finalize();
 		}
 	}
 }
 
+// the filtered glyphs are slots of the glyph table, so all the glyphs of the cmap in paged rasterization,
+// the source pane request the pages of the not rasterized ones when displayed
 void FontInfos::UpdateFiltering()
 {
-	m_FilteredGlyphs.clear();
+	m_FilteredSlots.clear();
 
-	ImFont* font = GetImFont();
-	if (font)
+	if (GetImFont())
 	{
-		uint32_t countGlyphs = (uint32_t)font->Glyphs.size();
-		for (uint32_t idx = 0; idx < countGlyphs; idx++)
+		if (!m_Filters.empty())
 		{
-			auto glyph = *(font->Glyphs.begin() + idx);
-
-			if (!m_Filters.empty())
-			{
-				std::string name = m_GlyphCodePointToName[glyph.Codepoint];
-
-				if (!name.empty())
-				{
-					for (const auto& it : m_Filters)
-					{
-						if (name.find(it) != std::string::npos) // found
-						{
-							m_FilteredGlyphs.push_back(glyph);
-						}
-					}
-				}
-			}
-			else
+			m_GlyphNameIndex.Search(m_GlyphTable, m_Filters, &m_FilteredSlots);
+		}
+		else
+		{
+			m_FilteredSlots.resize(m_GlyphTable.size());
+			for (uint32_t slot = 0; slot < (uint32_t)m_FilteredSlots.size(); slot++)
 			{
-				m_FilteredGlyphs.push_back(glyph);
+				m_FilteredSlots[slot] = slot;
 			}
 		}
 	}
@@ -698,12 +834,14 @@ void FontInfos::ClearScales(ProjectFile* vProjectFile)
 {
 	if (vProjectFile)
 	{
+		auto fontInfos = m_This.lock();
 		for (auto glyph : m_SelectedGlyphs)
 		{
 			if (glyph.second)
 			{
 				glyph.second->m_Scale = 1.0f;
 				glyph.second->simpleGlyph.ClearScale();
+				ProjectJournal::Instance()->AddTransform(fontInfos, *glyph.second);
 			}
 		}
 
@@ -715,12 +853,14 @@ void FontInfos::ClearTranslations(ProjectFile* vProjectFile)
 {
 	if (vProjectFile)
 	{
+		auto fontInfos = m_This.lock();
 		for (auto glyph : m_SelectedGlyphs)
 		{
 			if (glyph.second)
 			{
 				glyph.second->m_Translation = 0.0f;
 				glyph.second->simpleGlyph.ClearTranslation();
+				ProjectJournal::Instance()->AddTransform(fontInfos, *glyph.second);
 			}
 		}
 
@@ -737,6 +877,152 @@ ImFont* FontInfos::GetImFont()
 	return nullptr;
 }
 
+//////////////////////////////////////////////////////////////////////////////
+//// PAGED RASTERIZATION /////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+bool FontInfos::IsGlyphRasterized(uint32_t vCodePoint)
+{
+	if (!m_PagedRasterization)
+		return true;
+	return (m_RasterizedPages.find(vCodePoint / GLYPH_PAGE_SIZE) != m_RasterizedPages.end());
+}
+
+ImFontGlyph FontInfos::GetGlyph(uint32_t vCodePoint)
+{
+	ImFontGlyph glyph;
+	memset(&glyph, 0, sizeof(ImFontGlyph));
+	glyph.Codepoint = vCodePoint;
+
+	ImFont* font = GetImFont();
+	if (font && IsGlyphRasterized(vCodePoint))
+	{
+		const ImFontGlyph* glyphPtr = font->FindGlyphNoFallback((ImWchar)vCodePoint);
+		if (glyphPtr)
+			glyph = *glyphPtr;
+	}
+
+	return glyph;
+}
+
+// called for each displayed glyph, the page is marked as used even if already rasterized
+void FontInfos::RequestGlyphPage(uint32_t vCodePoint)
+{
+	if (m_PagedRasterization && vCodePoint <= 0xFFFF)
+	{
+		const uint32_t page = vCodePoint / GLYPH_PAGE_SIZE;
+		if (page < m_PagesLastUse.size())
+			m_PagesLastUse[page] = m_PagesFrame;
+		if (!IsGlyphRasterized(vCodePoint))
+			m_PendingPages.emplace(page);
+	}
+}
+
+// rebuild the atlas with the requested pages, at most one time per frame
+// the pages not displayed at the last frame are dropped (except the ones of the selected glyphs)
+// so a rebuild cost the displayed pages only, not all the pages seen since the loading
+bool FontInfos::RasterizePendingPages()
+{
+	if (!m_PagedRasterization || m_ImFontAtlas.ConfigData.empty())
+		return false;
+
+	m_PagesFrame++;
+
+	if (m_CountSelectedGlyphsOfPages != m_SelectedGlyphs.size())
+		RequestPagesOfSelectedGlyphs();
+
+	if (m_PendingPages.empty())
+		return false;
+
+	std::set<uint32_t> pages;
+	pages.swap(m_PendingPages);
+	for (auto page : m_RasterizedPages)
+	{
+		if (page < m_PagesLastUse.size() && m_PagesLastUse[page] + 1U >= m_PagesFrame)
+			pages.emplace(page);
+	}
+	for (const auto& it : m_SelectedGlyphs)
+	{
+		if (it.first <= 0xFFFF)
+			pages.emplace(it.first / GLYPH_PAGE_SIZE);
+	}
+	m_RasterizedPages.swap(pages);
+	UpdatePagedRanges();
+	m_ImFontAtlas.ConfigData[0].GlyphRanges = m_PagedRanges.data();
+
+	FT_Error freetypeError = 0;
+	if (!BuildAtlas(&freetypeError))
+	{
+		if (rasterizerMode == RasterizerEnum::RASTERIZER_FREETYPE)
+		{
+			Messaging::Instance()->AddError(true, nullptr, nullptr,
+				"Feetype fail to rasterize the font file %s. Reason : %s",
+				m_FontFileName.c_str(), ImGuiFreeType::GetErrorMessage(freetypeError));
+		}
+		else
+		{
+			Messaging::Instance()->AddError(true, nullptr, nullptr,
+				"Fail to rasterize the font file %s", m_FontFileName.c_str());
+		}
+		return false;
+	}
+
+	DestroyFontTexture();
+	CreateFontTexture();
+
+	// the filtered slots are of the glyph table, not of the atlas, so no filtering update
+	UpdateInfos();
+	UpdateSelectedGlyphs(GetImFont());
+
+	return true;
+}
+
+bool FontInfos::BuildAtlas(FT_Error* vFreetypeError)
+{
+	if (rasterizerMode == RasterizerEnum::RASTERIZER_FREETYPE)
+	{
+		return BuildFontAtlas(&m_ImFontAtlas, freeTypeFlag, vFreetypeError);
+	}
+	else if (rasterizerMode == RasterizerEnum::RASTERIZER_STB)
+	{
+		return m_ImFontAtlas.Build();
+	}
+	return false;
+}
+
+// the contiguous pages are merged in one range
+void FontInfos::UpdatePagedRanges()
+{
+	m_PagedRanges.clear();
+
+	for (auto page : m_RasterizedPages)
+	{
+		const uint32_t rangeStart = ct::maxi<uint32_t>(page * GLYPH_PAGE_SIZE, 0x0020);
+		const uint32_t rangeEnd = page * GLYPH_PAGE_SIZE + GLYPH_PAGE_SIZE - 1U;
+		if (!m_PagedRanges.empty() && (uint32_t)m_PagedRanges.back() + 1U == rangeStart)
+		{
+			m_PagedRanges.back() = (ImWchar)rangeEnd;
+		}
+		else
+		{
+			m_PagedRanges.push_back((ImWchar)rangeStart);
+			m_PagedRanges.push_back((ImWchar)rangeEnd);
+		}
+	}
+
+	m_PagedRanges.push_back(0);
+}
+
+void FontInfos::RequestPagesOfSelectedGlyphs()
+{
+	for (const auto& it : m_SelectedGlyphs)
+	{
+		RequestGlyphPage(it.first);
+	}
+
+	m_CountSelectedGlyphsOfPages = m_SelectedGlyphs.size();
+}
+
 //////////////////////////////////////////////////////////////////////////////
 //// FONT TEXTURE ////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
@@ -794,51 +1080,101 @@ std::string FontInfos::getXml(const std::string& vOffset, const std::string& vUs
 
 	std::string res;
 
-	res += vOffset + "<font name=\"" + m_FontFileName + "\">\n";
+	XmlStreamWriter writer(&res);
+	WriteXml(writer, vOffset);
+
+	return res;
+}
+
+// the untouched glyphs with following codepoints are saved in one glyphrun element :
+// <glyphrun orgId="first codepoint" count="n" names="orgName of each glyph separated by a space"/>
+void FontInfos::WriteXml(XmlStreamWriter& vWriter, const std::string& vOffset)
+{
+	vWriter.Add(vOffset).Add("<font name=\"").Add(m_FontFileName).Add("\">\n");
 
 	if (!m_SelectedGlyphs.empty())
 	{
-		res += vOffset + "\t<glyphs>\n";
-		for (auto &it : m_SelectedGlyphs)
+		vWriter.Add(vOffset).Add("\t<glyphs>\n");
+		auto it = m_SelectedGlyphs.begin();
+		while (it != m_SelectedGlyphs.end())
 		{
-			if (it.second)
+			if (!it->second)
+			{
+				++it;
+				continue;
+			}
+
+			// search the end of the run
+			auto itEnd = it;
+			uint32_t nextCodePoint = it->first;
+			while (itEnd != m_SelectedGlyphs.end() && itEnd->first == nextCodePoint &&
+				itEnd->second && IsUntouchedGlyph(*itEnd->second))
+			{
+				++itEnd;
+				++nextCodePoint;
+			}
+
+			const uint32_t countGlyphs = nextCodePoint - it->first;
+			if (countGlyphs > 1U)
+			{
+				vWriter.Add(vOffset).Add("\t\t<glyphrun orgId=\"").AddUInt(it->first)
+					.Add("\" count=\"").AddUInt(countGlyphs).Add("\" names=\"");
+				for (auto itRun = it; itRun != itEnd; ++itRun)
+				{
+					if (itRun != it)
+						vWriter.Add(' ');
+					vWriter.Add(itRun->second->oldHeaderName);
+				}
+				vWriter.Add("\"/>\n");
+				it = itEnd;
+			}
+			else
 			{
-				res += vOffset + "\t\t<glyph orgId=\"" + ct::toStr(it.second->glyph.Codepoint) +
-					"\" newId=\"" + ct::toStr(it.second->newCodePoint) +
-					"\" orgName=\"" + it.second->oldHeaderName +
-					"\" newName=\"" + it.second->newHeaderName +
-					"\" trans=\"" + ct::fvec2(it.second->m_Translation).string() + 
-					"\" scale=\"" + ct::fvec2(it.second->m_Scale).string() +
-					"\"/>\n";
+				vWriter.Add(vOffset).Add("\t\t<glyph orgId=\"").AddUInt(it->second->glyph.Codepoint)
+					.Add("\" newId=\"").AddUInt(it->second->newCodePoint)
+					.Add("\" orgName=\"").Add(it->second->oldHeaderName)
+					.Add("\" newName=\"").Add(it->second->newHeaderName)
+					.Add("\" trans=\"").Add(ct::fvec2(it->second->m_Translation).string())
+					.Add("\" scale=\"").Add(ct::fvec2(it->second->m_Scale).string())
+					.Add("\"/>\n");
+				++it;
 			}
 		}
-		res += vOffset + "\t</glyphs>\n";
+		vWriter.Add(vOffset).Add("\t</glyphs>\n");
 	}
 
-	res += vOffset + "\t<prefix>" + m_FontPrefix + "</prefix>\n";
-	res += vOffset + "\t<pathfilename>" + m_FontFilePathName + "</pathfilename>\n";
-	res += vOffset + "\t<oversample>" + ct::toStr(m_Oversample) + "</oversample>\n";
-	res += vOffset + "\t<fontsize>" + ct::toStr(m_FontSize) + "</fontsize>\n";
+	vWriter.Add(vOffset).Add("\t<prefix>").Add(m_FontPrefix).Add("</prefix>\n");
+	vWriter.Add(vOffset).Add("\t<pathfilename>").Add(m_FontFilePathName).Add("</pathfilename>\n");
+	vWriter.Add(vOffset).Add("\t<oversample>").Add(ct::toStr(m_Oversample)).Add("</oversample>\n");
+	vWriter.Add(vOffset).Add("\t<fontsize>").Add(ct::toStr(m_FontSize)).Add("</fontsize>\n");
 
-	res += vOffset + "\t<rasterizer>" + ct::toStr(rasterizerMode) + "</rasterizer>\n";
-	res += vOffset + "\t<freetypeflag>" + ct::toStr(freeTypeFlag) + "</freetypeflag>\n";
-	res += vOffset + "\t<freetypemultiply>" + ct::toStr(fontMultiply) + "</freetypemultiply>\n";
-	res += vOffset + "\t<padding>" + ct::toStr(fontPadding) + "</padding>\n";
-	res += vOffset + "\t<filtering>" + ct::toStr(textureFiltering) + "</filtering>\n";
+	vWriter.Add(vOffset).Add("\t<rasterizer>").Add(ct::toStr(rasterizerMode)).Add("</rasterizer>\n");
+	vWriter.Add(vOffset).Add("\t<freetypeflag>").Add(ct::toStr(freeTypeFlag)).Add("</freetypeflag>\n");
+	vWriter.Add(vOffset).Add("\t<freetypemultiply>").Add(ct::toStr(fontMultiply)).Add("</freetypemultiply>\n");
+	vWriter.Add(vOffset).Add("\t<padding>").Add(ct::toStr(fontPadding)).Add("</padding>\n");
+	vWriter.Add(vOffset).Add("\t<filtering>").Add(ct::toStr(textureFiltering)).Add("</filtering>\n");
 
 	if (!m_Filters.empty())
 	{
-		res += vOffset + "\t<filters>\n";
+		vWriter.Add(vOffset).Add("\t<filters>\n");
 		for (auto &it : m_Filters)
 		{
-			res += vOffset + "\t\t<filter name=\"" + it + "\"/>\n";
+			vWriter.Add(vOffset).Add("\t\t<filter name=\"").Add(it).Add("\"/>\n");
 		}
-		res += vOffset + "\t</filters>\n";
+		vWriter.Add(vOffset).Add("\t</filters>\n");
 	}
 
-	res += vOffset + "</font>\n";
+	vWriter.Add(vOffset).Add("</font>\n");
+}
 
-	return res;
+bool FontInfos::IsUntouchedGlyph(const GlyphInfos& vGlyphInfos)
+{
+	return vGlyphInfos.newCodePoint == (uint32_t)vGlyphInfos.glyph.Codepoint &&
+		vGlyphInfos.newHeaderName == vGlyphInfos.oldHeaderName &&
+		!vGlyphInfos.oldHeaderName.empty() &&
+		vGlyphInfos.oldHeaderName.find_first_of(" \"") == std::string::npos && // the names are separated by a space
+		vGlyphInfos.m_Translation.x == 0.0f && vGlyphInfos.m_Translation.y == 0.0f &&
+		vGlyphInfos.m_Scale.x == 1.0f && vGlyphInfos.m_Scale.y == 1.0f;
 }
 
 bool FontInfos::setFromXml(tinyxml2::XMLElement* vElem, tinyxml2::XMLElement* vParent, const std::string& vUserDatas)
@@ -889,7 +1225,12 @@ bool FontInfos::setFromXml(tinyxml2::XMLElement* vElem, tinyxml2::XMLElement* vP
 			fontPadding = ct::ivariant(strValue).GetI();
 		else if (strName == "textureFiletring")
 			textureFiltering = (GLenum)ct::ivariant(strValue).GetI();
-		else if (strName == "glyphs" || strName == "filters")
+		else if (strName == "glyphs")
+		{
+			LoadGlyphsXml(vElem);
+			return false; // childs already loaded, no recursion
+		}
+		else if (strName == "filters")
 		{
 			for (tinyxml2::XMLElement* child = vElem->FirstChildElement(); child != nullptr; child = child->NextSiblingElement())
 			{
@@ -897,40 +1238,6 @@ bool FontInfos::setFromXml(tinyxml2::XMLElement* vElem, tinyxml2::XMLElement* vP
 			}
 		}
 	}
-	else if (strParentName == "glyphs" &&  strName == "glyph")
-	{
-		uint32_t oldcodepoint = 0;
-        uint32_t newcodepoint = 0;
-		std::string oldName;
-		std::string newName;
-		ImVec2 translation;
-		ImVec2 scale;
-
-		for (const tinyxml2::XMLAttribute* attr = vElem->FirstAttribute(); attr != nullptr; attr = attr->Next())
-		{
-			std::string attName = attr->Name();
-			std::string attValue = attr->Value();
-
-			if (attName == "orgId" ||
-				attName == "id") // for compatibility with first format, will be removed in few versions
-				oldcodepoint = (uint32_t)ct::ivariant(attValue).GetI();
-			else if (attName == "newId" ||
-				attName == "nid")  // for compatibility with first format, will be removed in few versions
-				newcodepoint = (uint32_t)ct::ivariant(attValue).GetI();
-			else if (attName == "orgName") oldName = attValue;
-			else if (attName == "newName" ||
-				attName == "name")  // for compatibility with first format, will be removed in few versions
-				newName = attValue;
-			else if (attName == "trans")
-				translation = ct::toImVec2(ct::fvariant(attValue).GetV2());
-			else if (attName == "scale")
-				scale = ct::toImVec2(ct::fvariant(attValue).GetV2());
-		}
-
-		ImFontGlyph g = {};
-		g.Codepoint = oldcodepoint;
-		m_SelectedGlyphs[oldcodepoint] = GlyphInfos::Create(m_This, g, oldName, newName, newcodepoint, translation, scale);
-	}
 	else if (strParentName == "filters" &&  strName == "filter")
 	{
 		ct::ResetBuffer(m_SearchBuffer);
@@ -947,3 +1254,106 @@ bool FontInfos::setFromXml(tinyxml2::XMLElement* vElem, tinyxml2::XMLElement* vP
 
 	return true;
 }
+
+// flat loop on the glyph elements, no RecursParsingConfig and no std::string per attribute
+// because a project can have tens of thousands of glyphs
+void FontInfos::LoadGlyphsXml(tinyxml2::XMLElement* vGlyphsElem)
+{
+	if (!vGlyphsElem)
+		return;
+
+	for (tinyxml2::XMLElement* child = vGlyphsElem->FirstChildElement(); child != nullptr; child = child->NextSiblingElement())
+	{
+		const char* name = child->Name();
+		if (strcmp(name, "glyph") == 0)
+		{
+			uint32_t oldcodepoint = 0;
+			uint32_t newcodepoint = 0;
+			std::string oldName;
+			std::string newName;
+			ImVec2 translation;
+			ImVec2 scale;
+
+			for (const tinyxml2::XMLAttribute* attr = child->FirstAttribute(); attr != nullptr; attr = attr->Next())
+			{
+				const char* attName = attr->Name();
+
+				if (strcmp(attName, "orgId") == 0 ||
+					strcmp(attName, "id") == 0) // for compatibility with first format, will be removed in few versions
+					oldcodepoint = attr->UnsignedValue();
+				else if (strcmp(attName, "newId") == 0 ||
+					strcmp(attName, "nid") == 0)  // for compatibility with first format, will be removed in few versions
+					newcodepoint = attr->UnsignedValue();
+				else if (strcmp(attName, "orgName") == 0)
+					oldName = attr->Value();
+				else if (strcmp(attName, "newName") == 0 ||
+					strcmp(attName, "name") == 0)  // for compatibility with first format, will be removed in few versions
+					newName = attr->Value();
+				else if (strcmp(attName, "trans") == 0)
+					translation = ct::toImVec2(ct::fvariant(std::string(attr->Value())).GetV2());
+				else if (strcmp(attName, "scale") == 0)
+					scale = ct::toImVec2(ct::fvariant(std::string(attr->Value())).GetV2());
+			}
+
+			SetSelectedGlyph(oldcodepoint, oldName, newName, newcodepoint, translation, scale);
+		}
+		else if (strcmp(name, "glyphrun") == 0)
+		{
+			const uint32_t firstCodePoint = child->UnsignedAttribute("orgId");
+			const uint32_t countGlyphs = ct::mini(child->UnsignedAttribute("count"), 0x110000U - ct::mini(firstCodePoint, 0x110000U));
+			const char* names = child->Attribute("names");
+
+			for (uint32_t i = 0U; i < countGlyphs; ++i)
+			{
+				const uint32_t codePoint = firstCodePoint + i;
+
+				// next name of the list
+				std::string glyphName;
+				if (names)
+				{
+					const char* nameEnd = names;
+					while (*nameEnd && *nameEnd != ' ')
+						++nameEnd;
+					glyphName.assign(names, nameEnd);
+					names = *nameEnd ? nameEnd + 1 : nullptr;
+				}
+				if (glyphName.empty()) // names missing, same default name as GetGlyphName
+					glyphName = ct::toStr("Symbol_%u", codePoint);
+
+				SetSelectedGlyph(codePoint, glyphName, glyphName, codePoint, ImVec2(0, 0), ImVec2(1, 1));
+			}
+		}
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//// SELECTED GLYPHS /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+void FontInfos::SetSelectedGlyph(
+	uint32_t vCodePoint, const std::string& vOldName, const std::string& vNewName,
+	uint32_t vNewCodePoint, ImVec2 vTranslation, ImVec2 vScale)
+{
+	ImFontGlyph g = {};
+	g.Codepoint = vCodePoint;
+	auto& glyphInfos = m_SelectedGlyphs[vCodePoint];
+	if (glyphInfos) // same glyph twice in the file, or already selected
+	{
+		m_GlyphOrderedIndex.RemoveGlyph(glyphInfos);
+	}
+	glyphInfos = GlyphInfos::Create(m_This, g, vOldName, vNewName, vNewCodePoint, vTranslation, vScale);
+	m_GlyphOrderedIndex.AddGlyph(glyphInfos);
+}
+
+void FontInfos::RemoveSelectedGlyph(uint32_t vCodePoint)
+{
+	auto it = m_SelectedGlyphs.find(vCodePoint);
+	if (it != m_SelectedGlyphs.end())
+	{
+		if (it->second)
+		{
+			m_GlyphOrderedIndex.RemoveGlyph(it->second);
+		}
+		m_SelectedGlyphs.erase(it);
+	}
+}
@@ -19,6 +19,10 @@
 #include <tinyxml2/tinyxml2.h>
 
 #include <Project/GlyphInfos.h>
+#include <Project/GlyphTable.h>
+#include <Project/GlyphNameIndex.h>
+#include <Project/GlyphOrderedIndex.h>
+#include <Helper/XmlStreamWriter.h>
 #include <ImguiImpl/freetype/imgui_freetype.h>
 #include <glad/glad.h>
 
@@ -28,6 +32,7 @@
 #include <vector>
 #include <utility>
 #include <memory>
+#include <atomic>
 
 enum RasterizerEnum
 {
@@ -36,6 +41,16 @@ enum RasterizerEnum
 	RASTERIZER_Count
 };
 
+enum FontLoadingStageEnum
+{
+	FONT_LOADING_STAGE_QUEUED = 0,
+	FONT_LOADING_STAGE_READING, // file reading
+	FONT_LOADING_STAGE_RASTERIZING, // atlas build, or restore from the atlas cache
+	FONT_LOADING_STAGE_GLYPH_NAMES, // glyph names db
+	FONT_LOADING_STAGE_UPLOAD, // wait the texture upload on the main thread
+	FONT_LOADING_STAGE_Count
+};
+
 struct GlyphsRange
 {
 //	std::set<uint32_t> datas;
@@ -44,6 +59,7 @@ struct GlyphsRange
 };
 
 class ProjectFile;
+class FontFileDatas;
 class FontInfos : public conf::ConfigAbstract
 {
 public:
@@ -52,18 +68,15 @@ public:
 public: // not to save
 	std::weak_ptr<FontInfos> m_This;
 	ImFontAtlas m_ImFontAtlas;
-	std::vector<std::string> m_GlyphNames;
-	std::map<uint32_t, std::string> m_GlyphCodePointToName;
-	std::map<uint32_t, uint32_t> m_GlyphCodePointToGlyphIndex;
-	std::map<uint32_t, uint32_t> m_GlyphGlyphIndexToCodePoint;
-	std::map<uint32_t, bool> m_ColoredGlyphs; // codepoint, true/false if colored
+	GlyphTable m_GlyphTable; // codepoint, glyph index, name and flags of the glyphs of the cmap
+	GlyphNameIndex m_GlyphNameIndex; // for the filtering
 	char m_SearchBuffer[1024] = "\0";
 	ImFontConfig m_FontConfig;
+	std::shared_ptr<FontFileDatas> m_FontFileDatas; // bytes of the font file, shared with the other users, not owned by the atlas
 	bool m_NeedFilePathResolve = false; // the path is not found, need resolve for not lost glyphs datas
 	bool m_NameInDoubleFound = false;
 	bool m_CodePointInDoubleFound = false;
-	std::map<uint32_t, std::vector<std::shared_ptr<GlyphInfos>>> m_GlyphsOrderedByCodePoints;
-	std::map<std::string, std::vector<std::shared_ptr<GlyphInfos>>> m_GlyphsOrderedByGlyphName;
+	GlyphOrderedIndex m_GlyphOrderedIndex; // m_SelectedGlyphs by new codepoint and by new name, with the doubles, linked to the project one
 	int m_Ascent = 0;
 	int m_Descent = 0;
 	int m_LineGap = 0;
@@ -72,7 +85,15 @@ public: // not to save
 	std::string m_FontFileName;
 	std::vector<std::pair<std::string, std::string>> m_InfosToDisplay;
 	ImGuiListClipper m_InfosToDisplayClipper;
-	std::vector<ImFontGlyph> m_FilteredGlyphs;
+	std::vector<uint32_t> m_FilteredSlots; // glyph table slots of the filtered glyphs
+	bool m_PagedRasterization = false; // huge font, only the needed pages of codepoints are rasterized
+	std::set<uint32_t> m_RasterizedPages; // page = codepoint / GLYPH_PAGE_SIZE
+	std::set<uint32_t> m_PendingPages; // requested, rasterized at the next RasterizePendingPages
+	std::vector<ImWchar> m_PagedRanges; // glyph ranges of the rasterized pages, used by the atlas
+	size_t m_CountSelectedGlyphsOfPages = 0; // count of selected glyphs when theirs pages was requested
+	std::vector<uint32_t> m_PagesLastUse; // per page, value of m_PagesFrame at his last request
+	uint32_t m_PagesFrame = 0; // incremented by RasterizePendingPages, one call per frame
+	bool m_IsLoading = false; // loaded by the FontLoader threads, must not be displayed (main thread only)
 
 public: // to save
 	std::map<uint32_t, std::shared_ptr<GlyphInfos>> m_SelectedGlyphs;
@@ -100,6 +121,29 @@ public: // callable
 	void ClearTranslations(ProjectFile* vProjectFile);
 	ImFont* GetImFont();
 
+	// add or replace / remove a selected glyph, with the doubles and ordered index update
+	// used by the project load and the journal replay
+	void SetSelectedGlyph(
+		uint32_t vCodePoint, const std::string& vOldName, const std::string& vNewName,
+		uint32_t vNewCodePoint, ImVec2 vTranslation, ImVec2 vScale);
+	void RemoveSelectedGlyph(uint32_t vCodePoint);
+
+public: // loading steps, LoadFont call them in a row, the FontLoader call LoadFontDatas in a thread
+	std::string GetFontFilePathNameToLoad(ProjectFile* vProjectFile, const std::string& vFontFilePathName); // absolute, empty if not found
+	bool LoadFontDatas(const std::string& vFontFilePathName, std::atomic<int>* vStage = nullptr); // file, atlas and glyph names, no opengl
+	bool FinishLoading(ProjectFile* vProjectFile, const std::string& vFontFilePathName, bool vDatasLoaded); // texture upload, infos, selected glyphs
+
+public: // paged rasterization
+	bool IsGlyphRasterized(uint32_t vCodePoint);
+	ImFontGlyph GetGlyph(uint32_t vCodePoint); // empty glyph with only the codepoint if not rasterized
+	void RequestGlyphPage(uint32_t vCodePoint);
+	bool RasterizePendingPages(); // return true if the atlas was rebuilt
+
+private:
+	bool BuildAtlas(FT_Error* vFreetypeError);
+	void UpdatePagedRanges();
+	void RequestPagesOfSelectedGlyphs();
+
 private: // Glyph Names Extraction / DB
 	void FillGlyphNames();
 	void GenerateCodePointToGlypNamesDB();
@@ -111,8 +155,13 @@ private: // Opengl Texture
 
 public: // Configuration
 	std::string getXml(const std::string& vOffset, const std::string& vUserDatas = "");
+	void WriteXml(XmlStreamWriter& vWriter, const std::string& vOffset); // used by getXml and the project save
 	bool setFromXml(tinyxml2::XMLElement* vElem, tinyxml2::XMLElement* vParent, const std::string& vUserDatas = "");
 
+private: // Configuration
+	static bool IsUntouchedGlyph(const GlyphInfos& vGlyphInfos); // can be saved in a glyphrun
+	void LoadGlyphsXml(tinyxml2::XMLElement* vGlyphsElem);
+
 public: // Cons/Des tructors
 	FontInfos();
 	~FontInfos();
@@ -19,6 +19,7 @@
 #include "GlyphInfos.h"
 
 #include <Project/ProjectFile.h>
+#include <Project/ProjectJournal.h>
 
 #include <utility>
 
@@ -904,7 +905,7 @@ GlyphInfos::GlyphInfos(
 		auto fontInfosPtr = fontInfos.lock();
 		if (fontInfosPtr.use_count())
 		{
-			m_Colored = fontInfosPtr->m_ColoredGlyphs[glyph.Codepoint];
+			m_Colored = fontInfosPtr->m_GlyphTable.IsCodePointColored(glyph.Codepoint);
 		}
 	}
 }
@@ -925,11 +926,51 @@ void GlyphInfos::SetFontInfos(std::weak_ptr<FontInfos> vFontInfos)
 		auto fontInfosPtr = fontInfos.lock();
 		if (fontInfosPtr.use_count())
 		{
-			m_Colored = fontInfosPtr->m_ColoredGlyphs[glyph.Codepoint];
+			m_Colored = fontInfosPtr->m_GlyphTable.IsCodePointColored(glyph.Codepoint);
 		}
 	}
 }
 
+// the ordered index of the font is only for its selected glyphs
+static bool IsSelectedGlyphOfFont(const std::shared_ptr<FontInfos>& vFontInfos, const GlyphInfos* vGlyphInfos)
+{
+	if (vFontInfos)
+	{
+		auto it = vFontInfos->m_SelectedGlyphs.find(vGlyphInfos->glyph.Codepoint);
+		if (it != vFontInfos->m_SelectedGlyphs.end() && it->second.get() == vGlyphInfos)
+			return true;
+	}
+	return false;
+}
+
+void GlyphInfos::SetNewHeaderName(const std::string& vNewName)
+{
+	const std::string oldName = newHeaderName;
+	newHeaderName = vNewName; // before the index, he update his lists with it
+
+	auto fontInfosPtr = fontInfos.lock();
+	if (IsSelectedGlyphOfFont(fontInfosPtr, this))
+	{
+		fontInfosPtr->m_GlyphOrderedIndex.RenameGlyph(this, oldName, vNewName);
+		if (vNewName != oldName)
+			ProjectJournal::Instance()->AddRename(fontInfosPtr, glyph.Codepoint, vNewName);
+	}
+}
+
+void GlyphInfos::SetNewCodePoint(uint32_t vNewCodePoint)
+{
+	const uint32_t oldCodePoint = newCodePoint;
+	newCodePoint = vNewCodePoint; // before the index, he update his lists with it
+
+	auto fontInfosPtr = fontInfos.lock();
+	if (IsSelectedGlyphOfFont(fontInfosPtr, this))
+	{
+		fontInfosPtr->m_GlyphOrderedIndex.ReCodeGlyph(this, oldCodePoint, vNewCodePoint);
+		if (vNewCodePoint != oldCodePoint)
+			ProjectJournal::Instance()->AddReCode(fontInfosPtr, glyph.Codepoint, vNewCodePoint);
+	}
+}
+
 int GlyphInfos::DrawGlyphButton(
 	int &vWidgetPushId, // by adress because we want modify it
 	ProjectFile* vProjectFile, ImFont* vFont,
@@ -205,4 +205,8 @@ public:
 
 	std::weak_ptr<FontInfos> GetFontInfos();
 	void SetFontInfos(std::weak_ptr<FontInfos> vFontInfos);
+
+	// change newHeaderName / newCodePoint and update the doubles counter of the font
+	void SetNewHeaderName(const std::string& vNewName);
+	void SetNewCodePoint(uint32_t vNewCodePoint);
 };
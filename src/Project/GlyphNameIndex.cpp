@@ -0,0 +1,180 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "GlyphNameIndex.h"
+
+#include <Project/GlyphTable.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+static uint32_t GetTrigramKey(const char* vStr)
+{
+	return
+		((uint32_t)(uint8_t)vStr[0] << 16) |
+		((uint32_t)(uint8_t)vStr[1] << 8) |
+		(uint32_t)(uint8_t)vStr[2];
+}
+
+void GlyphNameIndex::Clear()
+{
+	m_Keys.clear();
+	m_Starts.clear();
+	m_Slots.clear();
+	m_LastResults.clear();
+}
+
+void GlyphNameIndex::Build(const GlyphTable& vGlyphTable)
+{
+	Clear();
+
+	// all the (trigram, slot) pairs, then sorted by trigram then by slot
+	std::vector<uint64_t> pairs;
+	pairs.reserve(vGlyphTable.size() * 8U);
+	for (uint32_t slot = 0; slot < (uint32_t)vGlyphTable.size(); slot++)
+	{
+		const char* name = vGlyphTable.GetName(slot);
+		const size_t len = strlen(name);
+		for (size_t i = 0; i + 3U <= len; i++)
+		{
+			pairs.push_back(((uint64_t)GetTrigramKey(name + i) << 32) | slot);
+		}
+	}
+	std::sort(pairs.begin(), pairs.end());
+	pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end()); // a trigram twice in a name
+
+	m_Slots.reserve(pairs.size());
+	for (auto p : pairs)
+	{
+		const uint32_t key = (uint32_t)(p >> 32);
+		if (m_Keys.empty() || m_Keys.back() != key)
+		{
+			m_Keys.push_back(key);
+			m_Starts.push_back((uint32_t)m_Slots.size());
+		}
+		m_Slots.push_back((uint32_t)(p & 0xFFFFFFFFU));
+	}
+	m_Starts.push_back((uint32_t)m_Slots.size());
+}
+
+bool GlyphNameIndex::GetSlotsOfKey(uint32_t vKey, const uint32_t** vBegin, const uint32_t** vEnd) const
+{
+	auto it = std::lower_bound(m_Keys.begin(), m_Keys.end(), vKey);
+	if (it == m_Keys.end() || *it != vKey)
+		return false;
+
+	const size_t idx = (size_t)(it - m_Keys.begin());
+	*vBegin = m_Slots.data() + m_Starts[idx];
+	*vEnd = m_Slots.data() + m_Starts[idx + 1U];
+	return true;
+}
+
+void GlyphNameIndex::SearchTerm(const GlyphTable& vGlyphTable, const std::string& vTerm, std::vector<uint32_t>* vSlots)
+{
+	vSlots->clear();
+
+	if (vTerm.empty())
+	{
+		vSlots->resize(vGlyphTable.size());
+		for (uint32_t slot = 0; slot < (uint32_t)vGlyphTable.size(); slot++)
+			(*vSlots)[slot] = slot;
+		return;
+	}
+
+	auto check = [&vGlyphTable, &vTerm, vSlots](uint32_t vSlot)
+	{
+		if (strstr(vGlyphTable.GetName(vSlot), vTerm.c_str()))
+			vSlots->push_back(vSlot);
+	};
+
+	// incremental, the results of a previous term contained in this one
+	const std::vector<uint32_t>* previousResults = nullptr;
+	size_t previousTermSize = 0U;
+	for (const auto& it : m_LastResults)
+	{
+		if (it.first.size() > previousTermSize &&
+			vTerm.find(it.first) != std::string::npos)
+		{
+			previousResults = &it.second;
+			previousTermSize = it.first.size();
+		}
+	}
+
+	if (previousResults)
+	{
+		for (auto slot : *previousResults)
+			check(slot);
+	}
+	else if (vTerm.size() >= 3U)
+	{
+		// the smallest list of slots among the trigrams of the term
+		const uint32_t* bestBegin = nullptr;
+		const uint32_t* bestEnd = nullptr;
+		for (size_t i = 0; i + 3U <= vTerm.size(); i++)
+		{
+			const uint32_t* begin = nullptr;
+			const uint32_t* end = nullptr;
+			if (!GetSlotsOfKey(GetTrigramKey(vTerm.c_str() + i), &begin, &end))
+				return; // a trigram is in no name
+			if (!bestBegin || end - begin < bestEnd - bestBegin)
+			{
+				bestBegin = begin;
+				bestEnd = end;
+			}
+		}
+
+		for (auto it = bestBegin; it != bestEnd; ++it)
+			check(*it);
+	}
+	else
+	{
+		for (uint32_t slot = 0; slot < (uint32_t)vGlyphTable.size(); slot++)
+			check(slot);
+	}
+}
+
+void GlyphNameIndex::Search(const GlyphTable& vGlyphTable, const std::set<std::string>& vTerms, std::vector<uint32_t>* vSlots)
+{
+	vSlots->clear();
+
+	std::map<std::string, std::vector<uint32_t>> results;
+	for (const auto& term : vTerms)
+	{
+		SearchTerm(vGlyphTable, term, &results[term]);
+	}
+
+	if (results.size() == 1U)
+	{
+		*vSlots = results.begin()->second;
+	}
+	else
+	{
+		// union of the terms results, each list is ordered
+		for (const auto& it : results)
+		{
+			std::vector<uint32_t> merged;
+			merged.reserve(vSlots->size() + it.second.size());
+			std::set_union(vSlots->begin(), vSlots->end(), it.second.begin(), it.second.end(), std::back_inserter(merged));
+			vSlots->swap(merged);
+		}
+	}
+
+	m_LastResults.swap(results);
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <cstdint>
+
+/*
+trigram index over the glyph names of a GlyphTable, built once at the font loading
+a search term of 3 chars or more only check the slots having all the trigrams of the term
+a term starting like a term of the previous search only check the results of this previous term (typing)
+the terms of less than 3 chars are checked on all the names
+the results are the glyph table slots, ordered, without duplicates
+*/
+
+class GlyphTable;
+class GlyphNameIndex
+{
+private:
+	// trigram => slots, in one array : the slots of m_Keys[i] are m_Slots[m_Starts[i]] to m_Slots[m_Starts[i + 1] - 1]
+	std::vector<uint32_t> m_Keys; // ordered
+	std::vector<uint32_t> m_Starts;
+	std::vector<uint32_t> m_Slots;
+
+	std::map<std::string, std::vector<uint32_t>> m_LastResults; // term, slots of the last search
+
+public:
+	void Clear();
+	void Build(const GlyphTable& vGlyphTable);
+	void Search(const GlyphTable& vGlyphTable, const std::set<std::string>& vTerms, std::vector<uint32_t>* vSlots);
+
+private:
+	void SearchTerm(const GlyphTable& vGlyphTable, const std::string& vTerm, std::vector<uint32_t>* vSlots);
+	bool GetSlotsOfKey(uint32_t vKey, const uint32_t** vBegin, const uint32_t** vEnd) const;
+};
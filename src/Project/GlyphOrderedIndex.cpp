@@ -0,0 +1,276 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "GlyphOrderedIndex.h"
+
+#include <Project/GlyphInfos.h>
+
+#include <algorithm>
+
+GlyphOrderedIndex::GlyphOrderedIndex() = default;
+
+GlyphOrderedIndex::~GlyphOrderedIndex()
+{
+	UnLink();
+
+	for (auto child : m_Childs)
+		child->m_Parent = nullptr;
+}
+
+void GlyphOrderedIndex::Clear()
+{
+	if (m_Parent)
+	{
+		for (const auto& it : m_GlyphsOrderedByCodePoints)
+			for (const auto& glyph : it.second)
+				m_Parent->RemoveGlyph(glyph);
+	}
+
+	m_GlyphsOrderedByCodePoints.clear();
+	m_GlyphsOrderedByGlyphName.clear();
+	m_GlyphsOrderedBySourceCodePoint.clear();
+	m_CountGlyphs = 0U;
+	m_CountNamesInDouble = 0U;
+	m_CountCodePointsInDouble = 0U;
+	SetAllFlatsNeedUpdate();
+}
+
+void GlyphOrderedIndex::AddGlyph(const std::shared_ptr<GlyphInfos>& vGlyph)
+{
+	if (!vGlyph)
+		return;
+
+	Insert(m_GlyphsOrderedByCodePoints, vGlyph->newCodePoint, vGlyph, &m_CountCodePointsInDouble);
+	Insert(m_GlyphsOrderedByGlyphName, vGlyph->newHeaderName, vGlyph, &m_CountNamesInDouble);
+	Insert(m_GlyphsOrderedBySourceCodePoint, (uint32_t)vGlyph->glyph.Codepoint, vGlyph, nullptr);
+	m_CountGlyphs++;
+	SetAllFlatsNeedUpdate();
+
+	if (m_Parent)
+		m_Parent->AddGlyph(vGlyph);
+}
+
+void GlyphOrderedIndex::RemoveGlyph(const std::shared_ptr<GlyphInfos>& vGlyph)
+{
+	if (!vGlyph)
+		return;
+
+	if (Erase(m_GlyphsOrderedByCodePoints, vGlyph->newCodePoint, vGlyph.get(), &m_CountCodePointsInDouble))
+	{
+		Erase(m_GlyphsOrderedByGlyphName, vGlyph->newHeaderName, vGlyph.get(), &m_CountNamesInDouble);
+		Erase(m_GlyphsOrderedBySourceCodePoint, (uint32_t)vGlyph->glyph.Codepoint, vGlyph.get(), nullptr);
+		m_CountGlyphs--;
+		SetAllFlatsNeedUpdate();
+
+		if (m_Parent)
+			m_Parent->RemoveGlyph(vGlyph);
+	}
+}
+
+void GlyphOrderedIndex::RenameGlyph(const GlyphInfos* vGlyph, const std::string& vOldName, const std::string& vNewName)
+{
+	if (vOldName == vNewName)
+		return;
+
+	auto glyph = Erase(m_GlyphsOrderedByGlyphName, vOldName, vGlyph, &m_CountNamesInDouble);
+	if (glyph)
+	{
+		Insert(m_GlyphsOrderedByGlyphName, vNewName, glyph, &m_CountNamesInDouble);
+		m_NeedFlatByGlyphNameUpdate = true;
+
+		if (m_Parent)
+			m_Parent->RenameGlyph(vGlyph, vOldName, vNewName);
+	}
+}
+
+void GlyphOrderedIndex::ReCodeGlyph(const GlyphInfos* vGlyph, uint32_t vOldCodePoint, uint32_t vNewCodePoint)
+{
+	if (vOldCodePoint == vNewCodePoint)
+		return;
+
+	auto glyph = Erase(m_GlyphsOrderedByCodePoints, vOldCodePoint, vGlyph, &m_CountCodePointsInDouble);
+	if (glyph)
+	{
+		Insert(m_GlyphsOrderedByCodePoints, vNewCodePoint, glyph, &m_CountCodePointsInDouble);
+		m_NeedFlatByCodePointsUpdate = true;
+
+		// the order of the other lists is the same, only the range starts around the glyph change
+		if (!m_NeedFlatByGlyphNameUpdate)
+		{
+			UpdateRangeStarts(&m_FlatGlyphsByGlyphName, Find(m_FlatGlyphsByGlyphName, vGlyph->newHeaderName,
+				[](const GlyphInfos* g) -> const std::string& { return g->newHeaderName; }, vGlyph));
+		}
+		if (!m_NeedFlatBySourceCodePointUpdate)
+		{
+			UpdateRangeStarts(&m_FlatGlyphsBySourceCodePoint, Find(m_FlatGlyphsBySourceCodePoint, (uint32_t)vGlyph->glyph.Codepoint,
+				[](const GlyphInfos* g) { return (uint32_t)g->glyph.Codepoint; }, vGlyph));
+		}
+
+		if (m_Parent)
+			m_Parent->ReCodeGlyph(vGlyph, vOldCodePoint, vNewCodePoint);
+	}
+}
+
+const std::map<uint32_t, GlyphOrderedIndex::GlyphInfosVector>& GlyphOrderedIndex::GetGlyphsOrderedByCodePoints() const
+{
+	return m_GlyphsOrderedByCodePoints;
+}
+
+const std::map<std::string, GlyphOrderedIndex::GlyphInfosVector>& GlyphOrderedIndex::GetGlyphsOrderedByGlyphName() const
+{
+	return m_GlyphsOrderedByGlyphName;
+}
+
+size_t GlyphOrderedIndex::GetCountGlyphs() const
+{
+	return m_CountGlyphs;
+}
+
+bool GlyphOrderedIndex::IsNameInDouble() const
+{
+	return m_CountNamesInDouble > 0U;
+}
+
+bool GlyphOrderedIndex::IsCodePointInDouble() const
+{
+	return m_CountCodePointsInDouble > 0U;
+}
+
+const GlyphOrderedIndex::FlatGlyphVector& GlyphOrderedIndex::GetFlatGlyphsByCodePoints()
+{
+	if (m_NeedFlatByCodePointsUpdate)
+	{
+		Flatten(m_GlyphsOrderedByCodePoints, &m_FlatGlyphsByCodePoints);
+		ComputeRangeStarts(&m_FlatGlyphsByCodePoints);
+		m_NeedFlatByCodePointsUpdate = false;
+	}
+	return m_FlatGlyphsByCodePoints;
+}
+
+const GlyphOrderedIndex::FlatGlyphVector& GlyphOrderedIndex::GetFlatGlyphsByGlyphName()
+{
+	if (m_NeedFlatByGlyphNameUpdate)
+	{
+		Flatten(m_GlyphsOrderedByGlyphName, &m_FlatGlyphsByGlyphName);
+		ComputeRangeStarts(&m_FlatGlyphsByGlyphName);
+		m_NeedFlatByGlyphNameUpdate = false;
+	}
+	return m_FlatGlyphsByGlyphName;
+}
+
+const GlyphOrderedIndex::FlatGlyphVector& GlyphOrderedIndex::GetFlatGlyphsBySourceCodePoint()
+{
+	if (m_NeedFlatBySourceCodePointUpdate)
+	{
+		Flatten(m_GlyphsOrderedBySourceCodePoint, &m_FlatGlyphsBySourceCodePoint);
+		ComputeRangeStarts(&m_FlatGlyphsBySourceCodePoint);
+
+		uint32_t lastCodePoint = 0U, rangeStart = 0U;
+		for (auto& flat : m_FlatGlyphsBySourceCodePoint)
+		{
+			flat.inDouble = false; // the source codepoint is not a key of the final font
+			const uint32_t codePoint = (uint32_t)flat.glyph->glyph.Codepoint;
+			if (codePoint != lastCodePoint + 1U)
+				rangeStart = codePoint;
+			flat.rangeStartSourceCodePoint = rangeStart;
+			lastCodePoint = codePoint;
+		}
+		m_NeedFlatBySourceCodePointUpdate = false;
+	}
+	return m_FlatGlyphsBySourceCodePoint;
+}
+
+void GlyphOrderedIndex::LinkTo(GlyphOrderedIndex* vParent)
+{
+	if (vParent == m_Parent)
+		return;
+
+	UnLink();
+
+	if (vParent)
+	{
+		m_Parent = vParent;
+		m_Parent->m_Childs.push_back(this);
+
+		for (const auto& it : m_GlyphsOrderedByCodePoints)
+			for (const auto& glyph : it.second)
+				m_Parent->AddGlyph(glyph);
+	}
+}
+
+void GlyphOrderedIndex::UnLink()
+{
+	if (m_Parent)
+	{
+		for (const auto& it : m_GlyphsOrderedByCodePoints)
+			for (const auto& glyph : it.second)
+				m_Parent->RemoveGlyph(glyph);
+
+		auto& childs = m_Parent->m_Childs;
+		childs.erase(std::remove(childs.begin(), childs.end(), this), childs.end());
+		m_Parent = nullptr;
+	}
+}
+
+bool GlyphOrderedIndex::IsLinkedTo(const GlyphOrderedIndex* vParent) const
+{
+	return m_Parent == vParent;
+}
+
+const std::vector<GlyphOrderedIndex*>& GlyphOrderedIndex::GetChilds() const
+{
+	return m_Childs;
+}
+
+void GlyphOrderedIndex::SetAllFlatsNeedUpdate()
+{
+	m_NeedFlatByCodePointsUpdate = true;
+	m_NeedFlatByGlyphNameUpdate = true;
+	m_NeedFlatBySourceCodePointUpdate = true;
+}
+
+// a new range start when the new codepoint is not the next of the previous glyph
+void GlyphOrderedIndex::ComputeRangeStarts(FlatGlyphVector* vFlat)
+{
+	uint32_t lastCodePoint = 0U, rangeStart = 0U;
+	for (auto& flat : *vFlat)
+	{
+		const uint32_t codePoint = flat.glyph->newCodePoint;
+		if (codePoint != lastCodePoint + 1U)
+			rangeStart = codePoint;
+		flat.rangeStartCodePoint = rangeStart;
+		lastCodePoint = codePoint;
+	}
+}
+
+// after a re range of the glyph at vIdx, the next glyphs change until one keep his range start
+void GlyphOrderedIndex::UpdateRangeStarts(FlatGlyphVector* vFlat, size_t vIdx)
+{
+	auto& flats = *vFlat;
+	for (size_t idx = vIdx; idx < flats.size(); ++idx)
+	{
+		const uint32_t lastCodePoint = idx ? flats[idx - 1U].glyph->newCodePoint : 0U;
+		const uint32_t lastRangeStart = idx ? flats[idx - 1U].rangeStartCodePoint : 0U;
+		const uint32_t codePoint = flats[idx].glyph->newCodePoint;
+		const uint32_t rangeStart = (codePoint == lastCodePoint + 1U) ? lastRangeStart : codePoint;
+		if (idx > vIdx && flats[idx].rangeStartCodePoint == rangeStart)
+			break;
+		flats[idx].rangeStartCodePoint = rangeStart;
+	}
+}
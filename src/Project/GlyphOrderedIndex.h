@@ -0,0 +1,169 @@
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <memory>
+#include <cstdint>
+
+/*
+the selected glyphs ordered by new codepoint, by new name and by source codepoint, for the final pane views
+updated at each select / unselect / rename / re range, so never rebuilt
+each font have one, linked to the merged one of the project
+more than one glyph for a key mean the codepoint or the name is in double,
+the count of these keys is kept at each change, so the doubles are known in constant time
+the flat lists are for the virtual grids (random access), rebuilt only at the next get after a change of their order,
+a re range only update in place the range starts of the lists not ordered by new codepoint
+*/
+
+class GlyphInfos;
+class GlyphOrderedIndex
+{
+public:
+	typedef std::vector<std::shared_ptr<GlyphInfos>> GlyphInfosVector;
+	struct FlatGlyph
+	{
+		std::shared_ptr<GlyphInfos> glyph;
+		bool inDouble = false; // the key of this list is shared with another glyph
+		uint32_t rangeStartCodePoint = 0U; // first new codepoint of the contiguous range of this glyph, for the range coloring
+		uint32_t rangeStartSourceCodePoint = 0U; // same by source codepoint, only in the list by source codepoint
+	};
+	typedef std::vector<FlatGlyph> FlatGlyphVector;
+
+private:
+	std::map<uint32_t, GlyphInfosVector> m_GlyphsOrderedByCodePoints;
+	std::map<std::string, GlyphInfosVector> m_GlyphsOrderedByGlyphName;
+	std::map<uint32_t, GlyphInfosVector> m_GlyphsOrderedBySourceCodePoint;
+	size_t m_CountGlyphs = 0U;
+	size_t m_CountNamesInDouble = 0U; // count of names used by more than one glyph
+	size_t m_CountCodePointsInDouble = 0U; // count of codepoints used by more than one glyph
+
+	FlatGlyphVector m_FlatGlyphsByCodePoints;
+	FlatGlyphVector m_FlatGlyphsByGlyphName;
+	FlatGlyphVector m_FlatGlyphsBySourceCodePoint;
+	bool m_NeedFlatByCodePointsUpdate = true;
+	bool m_NeedFlatByGlyphNameUpdate = true;
+	bool m_NeedFlatBySourceCodePointUpdate = true;
+
+	GlyphOrderedIndex* m_Parent = nullptr; // receive the changes of this index
+	std::vector<GlyphOrderedIndex*> m_Childs;
+
+public:
+	GlyphOrderedIndex();
+	~GlyphOrderedIndex();
+	GlyphOrderedIndex(const GlyphOrderedIndex&) = delete;
+	GlyphOrderedIndex& operator =(const GlyphOrderedIndex&) = delete;
+
+	void Clear(); // the glyphs only, the links are kept
+
+	// must be called with the newHeaderName and newCodePoint of the glyph in the index
+	void AddGlyph(const std::shared_ptr<GlyphInfos>& vGlyph);
+	void RemoveGlyph(const std::shared_ptr<GlyphInfos>& vGlyph);
+	// must be called after the change of the glyph
+	void RenameGlyph(const GlyphInfos* vGlyph, const std::string& vOldName, const std::string& vNewName);
+	void ReCodeGlyph(const GlyphInfos* vGlyph, uint32_t vOldCodePoint, uint32_t vNewCodePoint);
+
+	const std::map<uint32_t, GlyphInfosVector>& GetGlyphsOrderedByCodePoints() const;
+	const std::map<std::string, GlyphInfosVector>& GetGlyphsOrderedByGlyphName() const;
+	size_t GetCountGlyphs() const;
+	bool IsNameInDouble() const;
+	bool IsCodePointInDouble() const;
+
+	// the glyphs in the order of the maps, the vectors stay valid until the next get
+	const FlatGlyphVector& GetFlatGlyphsByCodePoints();
+	const FlatGlyphVector& GetFlatGlyphsByGlyphName();
+	const FlatGlyphVector& GetFlatGlyphsBySourceCodePoint(); // order of FontInfos::m_SelectedGlyphs
+
+	// add all the glyphs of this index to vParent, and the next changes too
+	void LinkTo(GlyphOrderedIndex* vParent);
+	void UnLink();
+	bool IsLinkedTo(const GlyphOrderedIndex* vParent) const;
+	const std::vector<GlyphOrderedIndex*>& GetChilds() const;
+
+private:
+	void SetAllFlatsNeedUpdate();
+	static void ComputeRangeStarts(FlatGlyphVector* vFlat);
+	static void UpdateRangeStarts(FlatGlyphVector* vFlat, size_t vIdx);
+
+	template<typename TKey>
+	static void Flatten(const std::map<TKey, GlyphInfosVector>& vMap, FlatGlyphVector* vFlat)
+	{
+		vFlat->clear();
+		for (const auto& it : vMap)
+		{
+			for (const auto& glyph : it.second)
+			{
+				FlatGlyph flat;
+				flat.glyph = glyph;
+				flat.inDouble = it.second.size() > 1;
+				vFlat->push_back(flat);
+			}
+		}
+	}
+
+	// the position of vGlyph in vFlat, ordered by vKey, vFlat->size() if not found
+	template<typename TKey, typename TGetKey>
+	static size_t Find(const FlatGlyphVector& vFlat, const TKey& vKey, TGetKey vGetKey, const GlyphInfos* vGlyph)
+	{
+		auto it = std::lower_bound(vFlat.begin(), vFlat.end(), vKey,
+			[&vGetKey](const FlatGlyph& a, const TKey& b) { return vGetKey(a.glyph.get()) < b; });
+		for (; it != vFlat.end() && !(vKey < vGetKey(it->glyph.get())); ++it)
+		{
+			if (it->glyph.get() == vGlyph)
+				return (size_t)(it - vFlat.begin());
+		}
+		return vFlat.size();
+	}
+
+	template<typename TKey>
+	static void Insert(std::map<TKey, GlyphInfosVector>& vMap, const TKey& vKey, const std::shared_ptr<GlyphInfos>& vGlyph, size_t* vCountInDouble)
+	{
+		auto& glyphs = vMap[vKey];
+		glyphs.push_back(vGlyph);
+		if (vCountInDouble && glyphs.size() == 2U)
+			(*vCountInDouble)++;
+	}
+
+	// vCountInDouble is the count of keys with more than one glyph, can be null
+	// return the removed glyph, empty if not found
+	template<typename TKey>
+	static std::shared_ptr<GlyphInfos> Erase(std::map<TKey, GlyphInfosVector>& vMap, const TKey& vKey, const GlyphInfos* vGlyph, size_t* vCountInDouble)
+	{
+		std::shared_ptr<GlyphInfos> res;
+		auto it = vMap.find(vKey);
+		if (it != vMap.end())
+		{
+			auto& glyphs = it->second;
+			for (auto itGlyph = glyphs.begin(); itGlyph != glyphs.end(); ++itGlyph)
+			{
+				if (itGlyph->get() == vGlyph)
+				{
+					res = *itGlyph;
+					glyphs.erase(itGlyph);
+					if (vCountInDouble && glyphs.size() == 1U)
+						(*vCountInDouble)--;
+					break;
+				}
+			}
+			if (glyphs.empty())
+				vMap.erase(it);
+		}
+		return res;
+	}
+};
@@ -0,0 +1,207 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "GlyphTable.h"
+
+#include <algorithm>
+
+const uint32_t GlyphTable::INVALID_SLOT;
+
+void GlyphTable::Clear()
+{
+	ClearCodePoints();
+	m_GlyphNameOffsets.clear();
+	m_NamesPool.clear();
+}
+
+void GlyphTable::ClearCodePoints()
+{
+	m_CodePoints.clear();
+	m_GlyphIndexs.clear();
+	m_NameOffsets.clear();
+	m_Flags.clear();
+	m_GlyphIndexToSlot.clear();
+}
+
+void GlyphTable::ClearFlags(GlyphFlags vFlags)
+{
+	for (auto& flags : m_Flags)
+		flags &= ~vFlags;
+}
+
+void GlyphTable::AddGlyphName(const std::string& vName)
+{
+	if (m_NamesPool.empty())
+		m_NamesPool.push_back('\0'); // offset 0 => empty name
+
+	if (vName.empty())
+	{
+		m_GlyphNameOffsets.push_back(0U);
+	}
+	else
+	{
+		m_GlyphNameOffsets.push_back((uint32_t)m_NamesPool.size());
+		m_NamesPool += vName;
+		m_NamesPool.push_back('\0');
+	}
+}
+
+size_t GlyphTable::GetCountGlyphNames() const
+{
+	return m_GlyphNameOffsets.size();
+}
+
+void GlyphTable::AddCodePoint(uint32_t vCodePoint, uint32_t vGlyphIndex)
+{
+	if (m_NamesPool.empty())
+		m_NamesPool.push_back('\0');
+
+	m_CodePoints.push_back(vCodePoint);
+	m_GlyphIndexs.push_back(vGlyphIndex);
+	if (vGlyphIndex < m_GlyphNameOffsets.size())
+		m_NameOffsets.push_back(m_GlyphNameOffsets[vGlyphIndex]);
+	else
+		m_NameOffsets.push_back(0U);
+	m_Flags.push_back(GLYPH_FLAG_NONE);
+}
+
+void GlyphTable::Finalize()
+{
+	// the atlas glyphs are already in the codepoint order, so the sort is rarely needed
+	bool sorted = true;
+	for (size_t i = 1; i < m_CodePoints.size() && sorted; i++)
+		sorted = (m_CodePoints[i - 1] < m_CodePoints[i]);
+
+	if (!sorted)
+	{
+		std::vector<uint32_t> order(m_CodePoints.size());
+		for (size_t i = 0; i < order.size(); i++)
+			order[i] = (uint32_t)i;
+		std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b)
+		{
+			return m_CodePoints[a] < m_CodePoints[b];
+		});
+
+		std::vector<uint32_t> codePoints, glyphIndexs, nameOffsets;
+		std::vector<GlyphFlags> flags;
+		codePoints.reserve(order.size());
+		glyphIndexs.reserve(order.size());
+		nameOffsets.reserve(order.size());
+		flags.reserve(order.size());
+		for (auto idx : order)
+		{
+			if (!codePoints.empty() && codePoints.back() == m_CodePoints[idx])
+			{
+				// codepoint added twice, the last add win
+				glyphIndexs.back() = m_GlyphIndexs[idx];
+				nameOffsets.back() = m_NameOffsets[idx];
+				flags.back() = m_Flags[idx];
+				continue;
+			}
+			codePoints.push_back(m_CodePoints[idx]);
+			glyphIndexs.push_back(m_GlyphIndexs[idx]);
+			nameOffsets.push_back(m_NameOffsets[idx]);
+			flags.push_back(m_Flags[idx]);
+		}
+		m_CodePoints.swap(codePoints);
+		m_GlyphIndexs.swap(glyphIndexs);
+		m_NameOffsets.swap(nameOffsets);
+		m_Flags.swap(flags);
+	}
+
+	m_CodePoints.shrink_to_fit();
+	m_GlyphIndexs.shrink_to_fit();
+	m_NameOffsets.shrink_to_fit();
+	m_Flags.shrink_to_fit();
+	m_GlyphNameOffsets.shrink_to_fit();
+	m_NamesPool.shrink_to_fit();
+
+	// glyph index => first slot of the glyph
+	uint32_t maxGlyphIndex = 0U;
+	for (auto glyphIndex : m_GlyphIndexs)
+		maxGlyphIndex = std::max(maxGlyphIndex, glyphIndex);
+	m_GlyphIndexToSlot.clear();
+	if (!m_GlyphIndexs.empty())
+		m_GlyphIndexToSlot.resize((size_t)maxGlyphIndex + 1U, INVALID_SLOT);
+	for (uint32_t slot = 0; slot < (uint32_t)m_GlyphIndexs.size(); slot++)
+	{
+		auto& glyphSlot = m_GlyphIndexToSlot[m_GlyphIndexs[slot]];
+		if (glyphSlot == INVALID_SLOT)
+			glyphSlot = slot;
+	}
+}
+
+size_t GlyphTable::GetMemorySize() const
+{
+	return
+		m_CodePoints.capacity() * sizeof(uint32_t) +
+		m_GlyphIndexs.capacity() * sizeof(uint32_t) +
+		m_NameOffsets.capacity() * sizeof(uint32_t) +
+		m_Flags.capacity() * sizeof(GlyphFlags) +
+		m_GlyphNameOffsets.capacity() * sizeof(uint32_t) +
+		m_GlyphIndexToSlot.capacity() * sizeof(uint32_t) +
+		m_NamesPool.capacity();
+}
+
+uint32_t GlyphTable::FindSlot(uint32_t vCodePoint) const
+{
+	auto it = std::lower_bound(m_CodePoints.begin(), m_CodePoints.end(), vCodePoint);
+	if (it != m_CodePoints.end() && *it == vCodePoint)
+		return (uint32_t)(it - m_CodePoints.begin());
+	return INVALID_SLOT;
+}
+
+uint32_t GlyphTable::FindSlotOfGlyphIndex(uint32_t vGlyphIndex) const
+{
+	if (vGlyphIndex < m_GlyphIndexToSlot.size())
+		return m_GlyphIndexToSlot[vGlyphIndex];
+	return INVALID_SLOT;
+}
+
+void GlyphTable::SetFlags(uint32_t vSlot, GlyphFlags vFlags, bool vEnabled)
+{
+	if (vEnabled)
+		m_Flags[vSlot] |= vFlags;
+	else
+		m_Flags[vSlot] &= ~vFlags;
+}
+
+uint32_t GlyphTable::GetGlyphIndexOfCodePoint(uint32_t vCodePoint) const
+{
+	const uint32_t slot = FindSlot(vCodePoint);
+	if (slot != INVALID_SLOT)
+		return m_GlyphIndexs[slot];
+	return 0U;
+}
+
+const char* GlyphTable::GetNameOfCodePoint(uint32_t vCodePoint) const
+{
+	const uint32_t slot = FindSlot(vCodePoint);
+	if (slot != INVALID_SLOT)
+		return GetName(slot);
+	return "";
+}
+
+bool GlyphTable::IsCodePointColored(uint32_t vCodePoint) const
+{
+	const uint32_t slot = FindSlot(vCodePoint);
+	if (slot != INVALID_SLOT)
+		return IsColored(slot);
+	return false;
+}
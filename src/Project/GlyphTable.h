@@ -0,0 +1,89 @@
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/*
+glyph table of a font, one slot per codepoint of the cmap, the slots are ordered by codepoint
+struct of arrays : codepoint, glyph index, name offset and flags are in contiguous arrays
+the names are in a shared pool, zero terminated, the offset 0 is the empty name
+~13 bytes per glyph + the names, instead of the nodes of 4 maps and a string per glyph
+*/
+
+typedef uint8_t GlyphFlags;
+enum _GlyphFlags
+{
+	GLYPH_FLAG_NONE = 0,
+	GLYPH_FLAG_COLORED = (1 << 0), // more than one layer in the COLR table
+};
+
+class GlyphTable
+{
+public:
+	static const uint32_t INVALID_SLOT = 0xFFFFFFFFU;
+
+private:
+	// one per slot
+	std::vector<uint32_t> m_CodePoints;
+	std::vector<uint32_t> m_GlyphIndexs;
+	std::vector<uint32_t> m_NameOffsets; // offset in m_NamesPool
+	std::vector<GlyphFlags> m_Flags;
+
+	// one per glyph index
+	std::vector<uint32_t> m_GlyphNameOffsets; // names of the post table, offset in m_NamesPool
+	std::vector<uint32_t> m_GlyphIndexToSlot; // INVALID_SLOT if the glyph have no codepoint
+
+	std::string m_NamesPool;
+
+public:
+	void Clear();
+	void ClearCodePoints(); // keep the glyph names
+	void ClearFlags(GlyphFlags vFlags);
+
+	// glyph names, to add in the glyph index order, before the codepoints
+	void AddGlyphName(const std::string& vName);
+	size_t GetCountGlyphNames() const;
+
+	// codepoints, Finalize sort the slots and must be called after the adds
+	void AddCodePoint(uint32_t vCodePoint, uint32_t vGlyphIndex);
+	void Finalize();
+
+	size_t size() const { return m_CodePoints.size(); }
+	bool empty() const { return m_CodePoints.empty(); }
+	size_t GetMemorySize() const; // bytes used by the arrays and the names pool
+
+	uint32_t FindSlot(uint32_t vCodePoint) const; // binary search, INVALID_SLOT if not found
+	uint32_t FindSlotOfGlyphIndex(uint32_t vGlyphIndex) const;
+
+	// by slot, the slot must be valid
+	uint32_t GetCodePoint(uint32_t vSlot) const { return m_CodePoints[vSlot]; }
+	uint32_t GetGlyphIndex(uint32_t vSlot) const { return m_GlyphIndexs[vSlot]; }
+	const char* GetName(uint32_t vSlot) const { return m_NamesPool.c_str() + m_NameOffsets[vSlot]; }
+	GlyphFlags GetFlags(uint32_t vSlot) const { return m_Flags[vSlot]; }
+	bool IsColored(uint32_t vSlot) const { return (m_Flags[vSlot] & GLYPH_FLAG_COLORED) != 0; }
+	void SetFlags(uint32_t vSlot, GlyphFlags vFlags, bool vEnabled);
+
+	// by codepoint, 0 / "" / false if the codepoint is not in the table
+	uint32_t GetGlyphIndexOfCodePoint(uint32_t vCodePoint) const;
+	const char* GetNameOfCodePoint(uint32_t vCodePoint) const;
+	bool IsCodePointColored(uint32_t vCodePoint) const;
+
+private:
+	friend class AtlasCache; // the arrays are saved / restored as blocks
+};
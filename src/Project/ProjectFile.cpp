@@ -20,10 +20,15 @@
 
 #include <Helper/Messaging.h>
 #include <Helper/SelectionHelper.h>
+#include <Helper/FontLoader.h>
+#include <Helper/CommandLine.h>
+#include <Project/ProjectJournal.h>
 #include <ctools/FileHelper.h>
 
 #include <Panes/Manager/LayoutManager.h>
 
+#include <set>
+
 ProjectFile::ProjectFile() = default;
 
 ProjectFile::ProjectFile(const std::string& vFilePathName)
@@ -36,30 +41,39 @@ ProjectFile::ProjectFile(const std::string& vFilePathName)
 	}
 }
 
-ProjectFile::~ProjectFile() = default;
+ProjectFile::~ProjectFile()
+{
+	ProjectJournal::Instance()->Discard(this); // normal close, the journal is not needed
+}
 
 void ProjectFile::Clear()
 {
+	ProjectJournal::Instance()->Discard(this);
 	m_ProjectFilePathName.clear();
 	m_ProjectFilePath.clear();
 	m_MergedFontPrefix.clear();
 	m_Fonts.clear();
+	UpdateGlyphOrderedIndexLinks();
 	m_ShowRangeColoring = false;
 	m_RangeColoringHash = ImVec4(10, 15, 35, 0.5f);
 	m_Preview_Glyph_CountX = 20;
 	m_Preview_Glyph_Width = 50;
 	m_CardGlyphHeightInPixel = 40U; // ine item height in card
 	m_CardCountRowsMax = 20U; // after this max, new columns
+	m_BatchThreadsCount = 0U; // count of threads for the batch generation, 0 mean count of cores
 	m_SelectedFont = nullptr;
 	m_CountSelectedGlyphs = 0; // for all fonts
 	m_IsLoaded = false;
 	m_IsThereAnyNotSavedChanged = false;
 	m_GenModeFlags = GENERATOR_MODE_CURRENT_HEADER_CARD |
-		GENERATOR_MODE_FONT_SETTINGS_USE_POST_TABLES;
+		GENERATOR_MODE_FONT_SETTINGS_USE_POST_TABLES |
+		GENERATOR_MODE_SRC_CODEC_STB;
 	m_SourcePane_ShowGlyphTooltip = true;
+	m_SourcePane_FilterAllFonts = false;
 	m_FinalPane_ShowGlyphTooltip = true;
 	m_CurrentPane_ShowGlyphTooltip = true;
 	m_FontTestInfos.Clear();
+	FontLoader::Instance()->Cancel();
 	SelectionHelper::Instance()->Clear();
 	Messaging::Instance()->Clear();
 }
@@ -110,6 +124,14 @@ bool ProjectFile::LoadAs(const std::string vFilePathName)
 		m_IsLoaded = true;
 		SetProjectChange(false);
 
+		// the edits not saved before a crash, not in headless mode for keep the journal to the gui
+		if (!CommandLine::Instance()->IsHeadless() &&
+			ProjectJournal::Instance()->Open(this))
+		{
+			UpdateCountSelectedGlyphs();
+			SetProjectChange();
+		}
+
 		// we do that after m_IsLoaded
 		SelectionHelper::Instance()->Load(this); // first
 		m_FontTestInfos.Load(this); // then because use final selection from SelectionHelper
@@ -127,12 +149,27 @@ bool ProjectFile::Save()
 	if (m_NeverSaved) 
 		return false;
 
-	if (SaveConfigFile(m_ProjectFilePathName))
+	// the fonts in loading are not in m_Fonts
+	FontLoader::Instance()->WaitAndFinishAll(this);
+
+	// streamed in the file, same content as SaveConfigFile but without the whole document in a string
+	XmlStreamWriter writer;
+	if (writer.Open(m_ProjectFilePathName))
 	{
-		SetProjectChange(false);
-		return true;
+		writer.Add("<config>\n");
+		WriteXml(writer, "\t");
+		writer.Add("</config>\n");
+		if (writer.Close())
+		{
+			if (!CommandLine::Instance()->IsHeadless())
+				ProjectJournal::Instance()->Reset(this); // the edits are in the project file now
+			SetProjectChange(false);
+			return true;
+		}
 	}
 
+	Messaging::Instance()->AddError(true, nullptr, nullptr, "Failed to save the project file %s", m_ProjectFilePathName.c_str());
+
 	return false;
 }
 
@@ -190,6 +227,27 @@ void ProjectFile::UpdateCountSelectedGlyphs()
 	SelectionHelper::Instance()->AnalyseSourceSelection(this);
 }
 
+void ProjectFile::UpdateGlyphOrderedIndexLinks()
+{
+	std::set<GlyphOrderedIndex*> indexs; // of the indexed fonts
+	for (const auto& it : m_Fonts)
+	{
+		if (it.second && !it.second->m_NeedFilePathResolve) // if font have issue not take it into account
+		{
+			it.second->m_GlyphOrderedIndex.LinkTo(&m_GlyphOrderedIndex);
+			indexs.emplace(&it.second->m_GlyphOrderedIndex);
+		}
+	}
+
+	// the fonts removed from the project, or with a path to resolve now
+	auto childs = m_GlyphOrderedIndex.GetChilds(); // copy, modified by UnLink
+	for (auto child : childs)
+	{
+		if (indexs.find(child) == indexs.end())
+			child->UnLink();
+	}
+}
+
 bool ProjectFile::IsRangeColoringShown() const
 {
 	return m_ShowRangeColoring || SelectionHelper::Instance()->IsSelectionType(GlyphSelectionTypeFlags::GLYPH_SELECTION_TYPE_BY_RANGE);
@@ -237,47 +295,56 @@ std::string ProjectFile::getXml(const std::string& vOffset, const std::string& /
 {
 	std::string str;
 
-	str += vOffset + "<project>\n";
+	XmlStreamWriter writer(&str);
+	WriteXml(writer, vOffset);
+
+	return str;
+}
+
+void ProjectFile::WriteXml(XmlStreamWriter& vWriter, const std::string& vOffset)
+{
+	vWriter.Add(vOffset).Add("<project>\n");
 	if (!m_Fonts.empty())
 	{
-		for (auto it : m_Fonts)
+		const std::string fontOffset = vOffset + "\t";
+		for (const auto& it : m_Fonts)
 		{
 			if (it.second)
 			{
-				str += it.second->getXml(vOffset + "\t");
+				it.second->WriteXml(vWriter, fontOffset);
 			}
 		}
 	}
-	str += LayoutManager::Instance()->getXml(vOffset, "project");
-	str += vOffset + "\t<rangecoloring show=\"" + (m_ShowRangeColoring ? "true" : "false") + 
-		"\" hash=\"" + ct::fvec4(m_RangeColoringHash).string() + "\"/>\n";
-	str += vOffset + "\t<previewglyphcount>" + ct::toStr(m_Preview_Glyph_CountX) + "</previewglyphcount>\n";
-	str += vOffset + "\t<previewglyphwidth>" + ct::toStr(m_Preview_Glyph_Width) + "</previewglyphwidth>\n";
-	str += vOffset + "\t<mergedfontprefix>" + m_MergedFontPrefix + "</mergedfontprefix>\n";
-	str += vOffset + "\t<curglyphtooltip>" + (m_CurrentPane_ShowGlyphTooltip ? "true" : "false") + "</curglyphtooltip>\n";
-	str += vOffset + "\t<srcglyphtooltip>" + (m_SourcePane_ShowGlyphTooltip ? "true" : "false") +"</srcglyphtooltip>\n";
-	str += vOffset + "\t<dstglyphtooltip>" + (m_FinalPane_ShowGlyphTooltip ? "true" : "false") +"</dstglyphtooltip>\n";
-	str += vOffset + "\t<glyphpreviewscale>" + ct::toStr(m_GlyphPreview_Scale) + "</glyphpreviewscale>\n";
-	str += vOffset + "\t<glyphdrawingflags>" + ct::toStr(m_GlyphDrawingFlags) + "</glyphdrawingflags>\n";
-	str += vOffset + "\t<glyphpreviewquadbeziercounsegment>" + ct::toStr(m_GlyphPreview_QuadBezierCountSegments) + "</glyphpreviewquadbeziercounsegment>\n";
-	str += vOffset + "\t<glyphpreviewzoomprecision>" + ct::toStr(m_GlyphPreviewZoomPrecision) + "</glyphpreviewzoomprecision>\n";
-	str += vOffset + "\t<genmodeflags>" + ct::toStr(m_GenModeFlags) + "</genmodeflags>\n";
-	str += vOffset + "\t<fonttomergein>" + m_FontToMergeIn + "</fonttomergein>\n";
-	str += vOffset + "\t<glyphdisplaytuningmode>" + ct::toStr(m_GlyphDisplayTuningMode) + "</glyphdisplaytuningmode>\n";
-	str += vOffset + "\t<sourcefontpaneflags>" + ct::toStr(m_SourceFontPaneFlags) + "</sourcefontpaneflags>\n";
-	str += vOffset + "\t<cardglyhpheight>" + ct::toStr(m_CardGlyphHeightInPixel) + "</cardglyhpheight>\n";
-	str += vOffset + "\t<cardcountrowsmax>" + ct::toStr(m_CardCountRowsMax) + "</cardcountrowsmax>\n";
-	str += vOffset + "\t<lastgeneratedpath>" + m_LastGeneratedPath + "</lastgeneratedpath>\n";
-	str += vOffset + "\t<lastgeneratedfilename>" + m_LastGeneratedFileName + "</lastgeneratedfilename>\n";
-	str += vOffset + "\t<zoomglyphs>" + (m_ZoomGlyphs ? "true" : "false") +"</zoomglyphs>\n";
-	str += vOffset + "\t<showbaseline>" + (m_ShowBaseLine ? "true" : "false") + "</showbaseline>\n";
-	str += vOffset + "\t<showadvancex>" + (m_ShowAdvanceX ? "true" : "false") + "</showadvancex>\n";
-	str += vOffset + "\t<glyphdrawingflags>" + ct::toStr(m_GlyphDrawingFlags) + "</glyphdrawingflags>\n";
-	str += SelectionHelper::Instance()->getXml(vOffset + "\t");
-	str += m_FontTestInfos.getXml(vOffset + "\t");
-	str += vOffset + "</project>\n";
-
-	return str;
+	vWriter.Add(LayoutManager::Instance()->getXml(vOffset, "project"));
+	vWriter.Add(vOffset).Add("\t<rangecoloring show=\"").AddBool(m_ShowRangeColoring)
+		.Add("\" hash=\"").Add(ct::fvec4(m_RangeColoringHash).string()).Add("\"/>\n");
+	vWriter.Add(vOffset).Add("\t<previewglyphcount>").Add(ct::toStr(m_Preview_Glyph_CountX)).Add("</previewglyphcount>\n");
+	vWriter.Add(vOffset).Add("\t<previewglyphwidth>").Add(ct::toStr(m_Preview_Glyph_Width)).Add("</previewglyphwidth>\n");
+	vWriter.Add(vOffset).Add("\t<mergedfontprefix>").Add(m_MergedFontPrefix).Add("</mergedfontprefix>\n");
+	vWriter.Add(vOffset).Add("\t<curglyphtooltip>").AddBool(m_CurrentPane_ShowGlyphTooltip).Add("</curglyphtooltip>\n");
+	vWriter.Add(vOffset).Add("\t<srcglyphtooltip>").AddBool(m_SourcePane_ShowGlyphTooltip).Add("</srcglyphtooltip>\n");
+	vWriter.Add(vOffset).Add("\t<srcfilterallfonts>").AddBool(m_SourcePane_FilterAllFonts).Add("</srcfilterallfonts>\n");
+	vWriter.Add(vOffset).Add("\t<dstglyphtooltip>").AddBool(m_FinalPane_ShowGlyphTooltip).Add("</dstglyphtooltip>\n");
+	vWriter.Add(vOffset).Add("\t<glyphpreviewscale>").Add(ct::toStr(m_GlyphPreview_Scale)).Add("</glyphpreviewscale>\n");
+	vWriter.Add(vOffset).Add("\t<glyphdrawingflags>").Add(ct::toStr(m_GlyphDrawingFlags)).Add("</glyphdrawingflags>\n");
+	vWriter.Add(vOffset).Add("\t<glyphpreviewquadbeziercounsegment>").Add(ct::toStr(m_GlyphPreview_QuadBezierCountSegments)).Add("</glyphpreviewquadbeziercounsegment>\n");
+	vWriter.Add(vOffset).Add("\t<glyphpreviewzoomprecision>").Add(ct::toStr(m_GlyphPreviewZoomPrecision)).Add("</glyphpreviewzoomprecision>\n");
+	vWriter.Add(vOffset).Add("\t<genmodeflags>").Add(ct::toStr(m_GenModeFlags)).Add("</genmodeflags>\n");
+	vWriter.Add(vOffset).Add("\t<fonttomergein>").Add(m_FontToMergeIn).Add("</fonttomergein>\n");
+	vWriter.Add(vOffset).Add("\t<glyphdisplaytuningmode>").Add(ct::toStr(m_GlyphDisplayTuningMode)).Add("</glyphdisplaytuningmode>\n");
+	vWriter.Add(vOffset).Add("\t<sourcefontpaneflags>").Add(ct::toStr(m_SourceFontPaneFlags)).Add("</sourcefontpaneflags>\n");
+	vWriter.Add(vOffset).Add("\t<cardglyhpheight>").Add(ct::toStr(m_CardGlyphHeightInPixel)).Add("</cardglyhpheight>\n");
+	vWriter.Add(vOffset).Add("\t<cardcountrowsmax>").Add(ct::toStr(m_CardCountRowsMax)).Add("</cardcountrowsmax>\n");
+	vWriter.Add(vOffset).Add("\t<batchthreadscount>").Add(ct::toStr(m_BatchThreadsCount)).Add("</batchthreadscount>\n");
+	vWriter.Add(vOffset).Add("\t<lastgeneratedpath>").Add(m_LastGeneratedPath).Add("</lastgeneratedpath>\n");
+	vWriter.Add(vOffset).Add("\t<lastgeneratedfilename>").Add(m_LastGeneratedFileName).Add("</lastgeneratedfilename>\n");
+	vWriter.Add(vOffset).Add("\t<zoomglyphs>").AddBool(m_ZoomGlyphs).Add("</zoomglyphs>\n");
+	vWriter.Add(vOffset).Add("\t<showbaseline>").AddBool(m_ShowBaseLine).Add("</showbaseline>\n");
+	vWriter.Add(vOffset).Add("\t<showadvancex>").AddBool(m_ShowAdvanceX).Add("</showadvancex>\n");
+	vWriter.Add(vOffset).Add("\t<glyphdrawingflags>").Add(ct::toStr(m_GlyphDrawingFlags)).Add("</glyphdrawingflags>\n");
+	SelectionHelper::Instance()->WriteXml(vWriter, vOffset + "\t");
+	vWriter.Add(m_FontTestInfos.getXml(vOffset + "\t"));
+	vWriter.Add(vOffset).Add("</project>\n");
 }
 
 bool ProjectFile::setFromXml(tinyxml2::XMLElement* vElem, tinyxml2::XMLElement* vParent, const std::string& /*vUserDatas*/)
@@ -314,6 +381,7 @@ bool ProjectFile::setFromXml(tinyxml2::XMLElement* vElem, tinyxml2::XMLElement*
 			{
 				f.reset();
 			}
+			return false; // childs already loaded by the font
 		}
 		else if (strName == "rangecoloring")
 		{
@@ -342,6 +410,8 @@ bool ProjectFile::setFromXml(tinyxml2::XMLElement* vElem, tinyxml2::XMLElement*
 			m_CurrentPane_ShowGlyphTooltip = ct::ivariant(strValue).GetB();
 		else if (strName == "srcglyphtooltip")
 			m_SourcePane_ShowGlyphTooltip = ct::ivariant(strValue).GetB();
+		else if (strName == "srcfilterallfonts")
+			m_SourcePane_FilterAllFonts = ct::ivariant(strValue).GetB();
 		else if (strName == "dstglyphtooltip")
 			m_FinalPane_ShowGlyphTooltip = ct::ivariant(strValue).GetB();
 		else if (strName == "glyphpreviewscale")
@@ -360,6 +430,8 @@ bool ProjectFile::setFromXml(tinyxml2::XMLElement* vElem, tinyxml2::XMLElement*
 			m_CardGlyphHeightInPixel = ct::uvariant(strValue).GetU();
 		else if (strName == "cardcountrowsmax")
 			m_CardCountRowsMax = ct::uvariant(strValue).GetU();
+		else if (strName == "batchthreadscount")
+			m_BatchThreadsCount = ct::uvariant(strValue).GetU();
 		else if (strName == "lastgeneratedpath")
 			m_LastGeneratedPath = strValue;
 		else if (strName == "lastgeneratedfilename")
@@ -373,7 +445,10 @@ bool ProjectFile::setFromXml(tinyxml2::XMLElement* vElem, tinyxml2::XMLElement*
 		else if (strName == "fonttest")
 			m_FontTestInfos.setFromXml(vElem, vParent);
 		else if (strName == "finalselection")
+		{
 			SelectionHelper::Instance()->setFromXml(vElem, vParent);
+			return false; // childs already loaded by the SelectionHelper
+		}
 	}
 
 	return true;
@@ -414,3 +489,9 @@ GenModeFlags ProjectFile::GetGenMode() const
 	return (m_GenModeFlags & vFlags);
 }
 
+CompressCodecEnum ProjectFile::GetCompressCodec() const
+{
+	if (IsGenMode(GENERATOR_MODE_SRC_CODEC_NONE)) return COMPRESS_CODEC_NONE;
+	if (IsGenMode(GENERATOR_MODE_SRC_CODEC_LZ4)) return COMPRESS_CODEC_LZ4;
+	return COMPRESS_CODEC_STB;
+}
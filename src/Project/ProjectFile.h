@@ -22,7 +22,9 @@
 
 #include <Project/FontInfos.h>
 #include <Project/FontTestInfos.h>
+#include <Helper/XmlStreamWriter.h>
 #include <Generator/Generator.h>
+#include <Generator/Compress.h>
 
 enum SourceFontPaneFlags
 {
@@ -54,9 +56,11 @@ public: // to save
 	GenModeFlags m_GenModeFlags =
 		GENERATOR_MODE_CURRENT_HEADER |					// current font + header
 		GENERATOR_MODE_FONT_SETTINGS_USE_POST_TABLES |	// tables exported in font
-		GENERATOR_MODE_LANG_CPP;						// cpp style for header or source
+		GENERATOR_MODE_LANG_CPP |						// cpp style for header or source
+		GENERATOR_MODE_SRC_CODEC_STB;					// ImGui compressed base85 for the source
 	bool m_CurrentPane_ShowGlyphTooltip = true;
 	bool m_SourcePane_ShowGlyphTooltip = true;
+	bool m_SourcePane_FilterAllFonts = false; // the filter bar apply the filters to all the fonts
 	bool m_FinalPane_ShowGlyphTooltip = true;
 	std::string m_FontToMergeIn;
 	float m_GlyphPreview_Scale = 1.0f;
@@ -69,6 +73,7 @@ public: // to save
 		SourceFontPaneFlags::SOURCE_FONT_PANE_GLYPH;
 	uint32_t m_CardGlyphHeightInPixel = 40U; // glyph item height in card
 	uint32_t m_CardCountRowsMax = 20U; // after this max, new columns
+	uint32_t m_BatchThreadsCount = 0U; // count of threads for the batch generation, 0 mean count of cores
 	bool m_ZoomGlyphs = false; // keep the glyph aligned to font glyph bounding box
 	bool m_ShowBaseLine = false; // show the base line of the glyph only when m_ZoomGlyphs is false
 	bool m_ShowAdvanceX = false; // show the advance x of the glyph only when m_ZoomGlyphs is false
@@ -82,6 +87,7 @@ public: // dont save
 	size_t m_CountFontWithSelectedGlyphs = 0; // for all fonts
     bool m_NameFoundInDouble = false;
     bool m_CodePointFoundInDouble = false;
+	GlyphOrderedIndex m_GlyphOrderedIndex; // the selected glyphs of all fonts, for the doubles and the merged views of the final pane
 	bool m_GlyphSizePolicyChangeFromWidgetUse = false; // say if the user is chnaging the size policy by the widget, for avoid change when via the resize on another pane
 
 private: // dont save
@@ -108,6 +114,7 @@ public:
 	void SetProjectChange(bool vChange = true);
 
 	void UpdateCountSelectedGlyphs();
+	void UpdateGlyphOrderedIndexLinks(); // link the fonts indexs to the project one, except the fonts with a path to resolve
 
 	bool IsRangeColoringShown() const;
 
@@ -121,9 +128,11 @@ public: // Generation Mode
 	void RemoveGenMode(GenModeFlags vFlags);
 	GenModeFlags GetGenMode() const;
 	bool IsGenMode(GenModeFlags vFlags) const;
+	CompressCodecEnum GetCompressCodec() const; // stb if not set (old projects)
 
 public:
 	std::string getXml(const std::string& vOffset, const std::string& vUserDatas = "") override;
+	void WriteXml(XmlStreamWriter& vWriter, const std::string& vOffset); // used by getXml and Save
 	bool setFromXml(tinyxml2::XMLElement* vElem, tinyxml2::XMLElement* vParent, const std::string& vUserDatas = "") override;
 
 public: // utils
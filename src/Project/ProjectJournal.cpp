@@ -0,0 +1,512 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ProjectJournal.h"
+
+#include <Project/ProjectFile.h>
+#include <Project/FontInfos.h>
+#include <Project/GlyphInfos.h>
+#include <Helper/Messaging.h>
+
+#include <cstring>
+
+static const char* JOURNAL_MAGIC = "IFSJ";
+static const size_t JOURNAL_HEADER_SIZE = 8U; // magic + version
+static const size_t RECORD_HEADER_SIZE = 3U; // type + size
+static const size_t RECORD_CHECKSUM_SIZE = 4U;
+
+ProjectJournal::ProjectJournal() = default;
+ProjectJournal::~ProjectJournal()
+{
+	Close();
+}
+
+std::string ProjectJournal::GetJournalFilePathName(const std::string& vProjectFilePathName)
+{
+	return vProjectFilePathName + ".journal";
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//// OPEN / RESET / DISCARD //////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+size_t ProjectJournal::Open(ProjectFile* vProjectFile)
+{
+	size_t countEdits = 0U;
+
+	if (!vProjectFile || vProjectFile->m_ProjectFilePathName.empty())
+		return countEdits;
+
+	Close();
+
+	m_ProjectFile = vProjectFile;
+	m_JournalFilePathName = GetJournalFilePathName(vProjectFile->m_ProjectFilePathName);
+
+	// read the previous journal if any
+	std::vector<uint8_t> datas;
+#ifdef MSVC
+	FILE* f = nullptr;
+	if (fopen_s(&f, m_JournalFilePathName.c_str(), "rb") != 0)
+		f = nullptr;
+#else
+	FILE* f = fopen(m_JournalFilePathName.c_str(), "rb");
+#endif
+	if (f)
+	{
+		uint8_t buf[4096];
+		size_t len = 0U;
+		while ((len = fread(buf, 1, sizeof(buf), f)) > 0U)
+			datas.insert(datas.end(), buf, buf + len);
+		fclose(f);
+	}
+
+	size_t validSize = 0U;
+	if (!datas.empty())
+	{
+		countEdits = Replay(vProjectFile, datas, &validSize);
+		if (countEdits)
+		{
+			Messaging::Instance()->AddWarning(true, nullptr, nullptr,
+				"%u unsaved edits restored from %s", (uint32_t)countEdits, m_JournalFilePathName.c_str());
+		}
+	}
+
+	if (validSize == datas.size() && validSize >= JOURNAL_HEADER_SIZE)
+	{
+		// good journal, the next edits are appended
+#ifdef MSVC
+		if (fopen_s(&m_File, m_JournalFilePathName.c_str(), "ab") != 0)
+			m_File = nullptr;
+#else
+		m_File = fopen(m_JournalFilePathName.c_str(), "ab");
+#endif
+	}
+	else if (CreateJournalFile() && validSize > JOURNAL_HEADER_SIZE)
+	{
+		// the end was not completely written (crash), we keep the good records only
+		fwrite(datas.data() + JOURNAL_HEADER_SIZE, 1, validSize - JOURNAL_HEADER_SIZE, m_File);
+		fflush(m_File);
+	}
+
+	return countEdits;
+}
+
+void ProjectJournal::Reset(ProjectFile* vProjectFile)
+{
+	if (!vProjectFile || vProjectFile->m_ProjectFilePathName.empty())
+		return;
+
+	const std::string journalFilePathName = GetJournalFilePathName(vProjectFile->m_ProjectFilePathName);
+	if (m_ProjectFile == vProjectFile && !m_JournalFilePathName.empty() &&
+		m_JournalFilePathName != journalFilePathName) // save as
+	{
+		Discard(vProjectFile);
+	}
+
+	Close();
+
+	m_ProjectFile = vProjectFile;
+	m_JournalFilePathName = journalFilePathName;
+	CreateJournalFile();
+}
+
+void ProjectJournal::Discard(const ProjectFile* vProjectFile)
+{
+	if (!vProjectFile || vProjectFile != m_ProjectFile)
+		return;
+
+	m_PendingDatas.clear();
+	Close();
+
+	if (!m_JournalFilePathName.empty())
+		remove(m_JournalFilePathName.c_str());
+
+	m_JournalFilePathName.clear();
+	m_ProjectFile = nullptr;
+}
+
+void ProjectJournal::Close()
+{
+	if (m_File)
+	{
+		Flush();
+		fclose(m_File);
+		m_File = nullptr;
+	}
+
+	m_PendingDatas.clear();
+	m_FontIds.clear(); // the font records are in the file, but the file can be recreated
+	m_LastTransformRecordOffset = SIZE_MAX;
+}
+
+bool ProjectJournal::CreateJournalFile()
+{
+#ifdef MSVC
+	if (fopen_s(&m_File, m_JournalFilePathName.c_str(), "wb") != 0)
+		m_File = nullptr;
+#else
+	m_File = fopen(m_JournalFilePathName.c_str(), "wb");
+#endif
+
+	if (m_File)
+	{
+		uint8_t header[JOURNAL_HEADER_SIZE];
+		memcpy(header, JOURNAL_MAGIC, 4U);
+		const uint32_t version = JOURNAL_VERSION;
+		memcpy(header + 4U, &version, 4U);
+		fwrite(header, 1, JOURNAL_HEADER_SIZE, m_File);
+		fflush(m_File);
+		m_LastFlushTime = std::chrono::steady_clock::now();
+		return true;
+	}
+
+	return false;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//// FLUSH ///////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+void ProjectJournal::Flush()
+{
+	if (m_File && !m_PendingDatas.empty())
+	{
+		fwrite(m_PendingDatas.data(), 1, m_PendingDatas.size(), m_File);
+		fflush(m_File);
+	}
+
+	m_PendingDatas.clear();
+	m_LastTransformRecordOffset = SIZE_MAX;
+	m_LastFlushTime = std::chrono::steady_clock::now();
+}
+
+void ProjectJournal::FlushIfNeeded()
+{
+	if (m_File && !m_PendingDatas.empty())
+	{
+		const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+			std::chrono::steady_clock::now() - m_LastFlushTime).count();
+		if (elapsed >= FLUSH_DELAY_IN_MS)
+			Flush();
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//// RECORDS /////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+void ProjectJournal::AddSelect(const std::shared_ptr<FontInfos>& vFontInfos, uint32_t vCodePoint, const std::string& vGlyphName)
+{
+	if (!m_File || m_IsReplaying || !vFontInfos)
+		return;
+
+	const uint16_t fontId = GetFontId(vFontInfos);
+	const size_t offset = BeginRecord(RecordTypeEnum::RECORD_TYPE_SELECT);
+	PushUInt16(fontId);
+	PushUInt32(vCodePoint);
+	PushString(vGlyphName);
+	EndRecord(offset);
+}
+
+void ProjectJournal::AddUnSelect(const std::shared_ptr<FontInfos>& vFontInfos, uint32_t vCodePoint)
+{
+	if (!m_File || m_IsReplaying || !vFontInfos)
+		return;
+
+	const uint16_t fontId = GetFontId(vFontInfos);
+	const size_t offset = BeginRecord(RecordTypeEnum::RECORD_TYPE_UNSELECT);
+	PushUInt16(fontId);
+	PushUInt32(vCodePoint);
+	EndRecord(offset);
+}
+
+void ProjectJournal::AddRename(const std::shared_ptr<FontInfos>& vFontInfos, uint32_t vCodePoint, const std::string& vNewName)
+{
+	if (!m_File || m_IsReplaying || !vFontInfos)
+		return;
+
+	const uint16_t fontId = GetFontId(vFontInfos);
+	const size_t offset = BeginRecord(RecordTypeEnum::RECORD_TYPE_RENAME);
+	PushUInt16(fontId);
+	PushUInt32(vCodePoint);
+	PushString(vNewName);
+	EndRecord(offset);
+}
+
+void ProjectJournal::AddReCode(const std::shared_ptr<FontInfos>& vFontInfos, uint32_t vCodePoint, uint32_t vNewCodePoint)
+{
+	if (!m_File || m_IsReplaying || !vFontInfos)
+		return;
+
+	const uint16_t fontId = GetFontId(vFontInfos);
+	const size_t offset = BeginRecord(RecordTypeEnum::RECORD_TYPE_RECODE);
+	PushUInt16(fontId);
+	PushUInt32(vCodePoint);
+	PushUInt32(vNewCodePoint);
+	EndRecord(offset);
+}
+
+void ProjectJournal::AddTransform(const std::shared_ptr<FontInfos>& vFontInfos, const GlyphInfos& vGlyphInfos)
+{
+	if (!m_File || m_IsReplaying || !vFontInfos)
+		return;
+
+	const uint16_t fontId = GetFontId(vFontInfos);
+	const uint32_t codePoint = vGlyphInfos.glyph.Codepoint;
+
+	// a slider drag give a transform per frame, only the last one is kept for the same glyph
+	if (m_LastTransformRecordOffset != SIZE_MAX)
+	{
+		uint16_t lastFontId = 0U;
+		uint32_t lastCodePoint = 0U;
+		memcpy(&lastFontId, m_PendingDatas.data() + m_LastTransformRecordOffset + RECORD_HEADER_SIZE, 2U);
+		memcpy(&lastCodePoint, m_PendingDatas.data() + m_LastTransformRecordOffset + RECORD_HEADER_SIZE + 2U, 4U);
+		if (lastFontId == fontId && lastCodePoint == codePoint)
+			m_PendingDatas.resize(m_LastTransformRecordOffset);
+	}
+
+	const size_t offset = BeginRecord(RecordTypeEnum::RECORD_TYPE_TRANSFORM);
+	PushUInt16(fontId);
+	PushUInt32(codePoint);
+	PushFloat(vGlyphInfos.m_Translation.x);
+	PushFloat(vGlyphInfos.m_Translation.y);
+	PushFloat(vGlyphInfos.m_Scale.x);
+	PushFloat(vGlyphInfos.m_Scale.y);
+	EndRecord(offset);
+
+	m_LastTransformRecordOffset = offset;
+}
+
+uint16_t ProjectJournal::GetFontId(const std::shared_ptr<FontInfos>& vFontInfos)
+{
+	auto it = m_FontIds.find(vFontInfos->m_FontFileName);
+	if (it != m_FontIds.end())
+		return it->second;
+
+	const uint16_t fontId = (uint16_t)m_FontIds.size();
+	m_FontIds[vFontInfos->m_FontFileName] = fontId;
+
+	const size_t offset = BeginRecord(RecordTypeEnum::RECORD_TYPE_FONT);
+	PushUInt16(fontId);
+	PushString(vFontInfos->m_FontFileName);
+	EndRecord(offset);
+
+	return fontId;
+}
+
+size_t ProjectJournal::BeginRecord(RecordTypeEnum vType)
+{
+	const size_t offset = m_PendingDatas.size();
+	m_PendingDatas.push_back((uint8_t)vType);
+	PushUInt16(0U); // size, set by EndRecord
+	m_LastTransformRecordOffset = SIZE_MAX; // the merge is only with the last record
+	return offset;
+}
+
+void ProjectJournal::EndRecord(size_t vRecordOffset)
+{
+	const uint16_t size = (uint16_t)(m_PendingDatas.size() - vRecordOffset - RECORD_HEADER_SIZE);
+	memcpy(m_PendingDatas.data() + vRecordOffset + 1U, &size, 2U);
+	PushUInt32(Checksum(m_PendingDatas.data() + vRecordOffset, m_PendingDatas.size() - vRecordOffset));
+}
+
+void ProjectJournal::PushUInt16(uint16_t vValue)
+{
+	const uint8_t* p = (const uint8_t*)&vValue;
+	m_PendingDatas.insert(m_PendingDatas.end(), p, p + sizeof(vValue));
+}
+
+void ProjectJournal::PushUInt32(uint32_t vValue)
+{
+	const uint8_t* p = (const uint8_t*)&vValue;
+	m_PendingDatas.insert(m_PendingDatas.end(), p, p + sizeof(vValue));
+}
+
+void ProjectJournal::PushFloat(float vValue)
+{
+	const uint8_t* p = (const uint8_t*)&vValue;
+	m_PendingDatas.insert(m_PendingDatas.end(), p, p + sizeof(vValue));
+}
+
+void ProjectJournal::PushString(const std::string& vStr)
+{
+	const uint16_t len = (uint16_t)(vStr.size() < 1024U ? vStr.size() : 1024U); // a glyph name, not a book
+	PushUInt16(len);
+	m_PendingDatas.insert(m_PendingDatas.end(), vStr.begin(), vStr.begin() + len);
+}
+
+// fnv1a
+uint32_t ProjectJournal::Checksum(const uint8_t* vDatas, size_t vSize)
+{
+	uint32_t hash = 2166136261U;
+	for (size_t i = 0U; i < vSize; ++i)
+	{
+		hash ^= vDatas[i];
+		hash *= 16777619U;
+	}
+	return hash;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//// REPLAY //////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+size_t ProjectJournal::Replay(ProjectFile* vProjectFile, const std::vector<uint8_t>& vDatas, size_t* vValidSize)
+{
+	size_t countEdits = 0U;
+	*vValidSize = 0U;
+
+	uint32_t version = 0U;
+	if (vDatas.size() < JOURNAL_HEADER_SIZE || memcmp(vDatas.data(), JOURNAL_MAGIC, 4U) != 0)
+		return countEdits;
+	memcpy(&version, vDatas.data() + 4U, 4U);
+	if (version != JOURNAL_VERSION)
+		return countEdits;
+
+	m_IsReplaying = true;
+
+	std::vector<std::string> fontNames; // by font id
+	size_t pos = JOURNAL_HEADER_SIZE;
+	*vValidSize = pos;
+	while (pos + RECORD_HEADER_SIZE + RECORD_CHECKSUM_SIZE <= vDatas.size())
+	{
+		const uint8_t* record = vDatas.data() + pos;
+		uint16_t size = 0U;
+		memcpy(&size, record + 1U, 2U);
+		const size_t recordSize = RECORD_HEADER_SIZE + size + RECORD_CHECKSUM_SIZE;
+		if (pos + recordSize > vDatas.size())
+			break; // not completely written
+
+		uint32_t checksum = 0U;
+		memcpy(&checksum, record + RECORD_HEADER_SIZE + size, 4U);
+		if (checksum != Checksum(record, RECORD_HEADER_SIZE + size))
+			break; // bad record
+
+		const auto type = (RecordTypeEnum)record[0];
+		if (type >= RecordTypeEnum::RECORD_TYPE_Count)
+			break;
+
+		if (ReplayRecord(vProjectFile, type, record + RECORD_HEADER_SIZE, size, &fontNames) &&
+			type != RecordTypeEnum::RECORD_TYPE_FONT)
+		{
+			countEdits++;
+		}
+
+		pos += recordSize;
+		*vValidSize = pos;
+	}
+
+	m_IsReplaying = false;
+
+	// the font ids of the file are kept for the next records
+	for (size_t i = 0U; i < fontNames.size(); ++i)
+		if (!fontNames[i].empty())
+			m_FontIds[fontNames[i]] = (uint16_t)i;
+
+	return countEdits;
+}
+
+bool ProjectJournal::ReplayRecord(ProjectFile* vProjectFile, RecordTypeEnum vType, const uint8_t* vDatas, size_t vSize,
+	std::vector<std::string>* vFontNames)
+{
+	// small reader of the record datas
+	size_t pos = 0U;
+	bool valid = true;
+	auto readUInt16 = [&]() { uint16_t v = 0U; if (pos + 2U <= vSize) memcpy(&v, vDatas + pos, 2U); else valid = false; pos += 2U; return v; };
+	auto readUInt32 = [&]() { uint32_t v = 0U; if (pos + 4U <= vSize) memcpy(&v, vDatas + pos, 4U); else valid = false; pos += 4U; return v; };
+	auto readFloat = [&]() { float v = 0.0f; if (pos + 4U <= vSize) memcpy(&v, vDatas + pos, 4U); else valid = false; pos += 4U; return v; };
+	auto readString = [&]()
+	{
+		std::string s;
+		const uint16_t len = readUInt16();
+		if (valid && pos + len <= vSize) s.assign((const char*)vDatas + pos, len); else valid = false;
+		pos += len;
+		return s;
+	};
+
+	const uint16_t fontId = readUInt16();
+
+	if (vType == RecordTypeEnum::RECORD_TYPE_FONT)
+	{
+		const std::string fontName = readString();
+		if (valid)
+		{
+			if (vFontNames->size() <= fontId)
+				vFontNames->resize(fontId + 1U);
+			(*vFontNames)[fontId] = fontName;
+		}
+		return valid;
+	}
+
+	const uint32_t codePoint = readUInt32();
+	if (!valid || fontId >= vFontNames->size())
+		return false;
+
+	auto fontInfos = vProjectFile->GetFontWithFontName((*vFontNames)[fontId]);
+	if (!fontInfos)
+		return false; // font removed from the project
+
+	std::shared_ptr<GlyphInfos> glyphInfos;
+	auto it = fontInfos->m_SelectedGlyphs.find(codePoint);
+	if (it != fontInfos->m_SelectedGlyphs.end())
+		glyphInfos = it->second;
+
+	switch (vType)
+	{
+	case RecordTypeEnum::RECORD_TYPE_SELECT:
+	{
+		const std::string glyphName = readString();
+		if (valid)
+			fontInfos->SetSelectedGlyph(codePoint, glyphName, glyphName, codePoint, ImVec2(0, 0), ImVec2(1, 1));
+		break;
+	}
+	case RecordTypeEnum::RECORD_TYPE_UNSELECT:
+		fontInfos->RemoveSelectedGlyph(codePoint);
+		break;
+	case RecordTypeEnum::RECORD_TYPE_RENAME:
+	{
+		const std::string newName = readString();
+		if (valid && glyphInfos)
+			glyphInfos->SetNewHeaderName(newName);
+		break;
+	}
+	case RecordTypeEnum::RECORD_TYPE_RECODE:
+	{
+		const uint32_t newCodePoint = readUInt32();
+		if (valid && glyphInfos)
+			glyphInfos->SetNewCodePoint(newCodePoint);
+		break;
+	}
+	case RecordTypeEnum::RECORD_TYPE_TRANSFORM:
+	{
+		const float tx = readFloat(), ty = readFloat();
+		const float sx = readFloat(), sy = readFloat();
+		if (valid && glyphInfos)
+		{
+			glyphInfos->m_Translation = ct::fvec2(tx, ty);
+			glyphInfos->m_Scale = ct::fvec2(sx, sy);
+		}
+		break;
+	}
+	default:
+		break;
+	}
+
+	return valid;
+}
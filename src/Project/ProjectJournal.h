@@ -0,0 +1,117 @@
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+
+/*
+append-only journal of the glyph edits, next to the project file (project.ifs.journal)
+the edits since the last save are written as small binary records, flushed every few seconds
+replayed at the next open if the app was not closed normally (crash, kill..)
+reset at each save, since the project file contain the edits, and removed at the normal close
+
+file : "IFSJ" + version (uint32)
+record : type (uint8) + size of the datas (uint16) + datas + checksum (uint32, fnv1a of type, size and datas)
+the replay stop at the first bad record (crash during a write), the bad end is cut
+the fonts are numbered by a font record, the glyph records use the font number
+*/
+
+class FontInfos;
+class GlyphInfos;
+class ProjectFile;
+class ProjectJournal
+{
+public:
+	static const uint32_t JOURNAL_VERSION = 1U;
+	static const int64_t FLUSH_DELAY_IN_MS = 3000; // max time of the edits in memory
+
+	enum class RecordTypeEnum : uint8_t
+	{
+		RECORD_TYPE_FONT = 0,		// font id (uint16) + font name
+		RECORD_TYPE_SELECT,			// font id (uint16) + codepoint (uint32) + glyph name
+		RECORD_TYPE_UNSELECT,		// font id (uint16) + codepoint (uint32)
+		RECORD_TYPE_RENAME,			// font id (uint16) + codepoint (uint32) + new name
+		RECORD_TYPE_RECODE,			// font id (uint16) + codepoint (uint32) + new codepoint (uint32)
+		RECORD_TYPE_TRANSFORM,		// font id (uint16) + codepoint (uint32) + translation and scale (4 floats)
+		RECORD_TYPE_Count
+	};
+
+private:
+	const ProjectFile* m_ProjectFile = nullptr; // owner of the journal
+	std::string m_JournalFilePathName;
+	FILE* m_File = nullptr;
+	std::vector<uint8_t> m_PendingDatas; // records not yet written
+	std::map<std::string, uint16_t> m_FontIds; // font name => font id in the journal
+	std::chrono::steady_clock::time_point m_LastFlushTime;
+	size_t m_LastTransformRecordOffset = SIZE_MAX; // in m_PendingDatas, for merge the transforms of the same glyph
+	bool m_IsReplaying = false; // no record during the replay
+
+public:
+	// replay the journal of the project if any, and keep it opened for the next edits
+	// return the count of replayed edits
+	size_t Open(ProjectFile* vProjectFile);
+	// empty journal after a save, the journal of the previous path is removed
+	void Reset(ProjectFile* vProjectFile);
+	// close and remove the journal, only if vProjectFile is the owner
+	void Discard(const ProjectFile* vProjectFile);
+
+	void Flush();
+	void FlushIfNeeded(); // each frame, flush if FLUSH_DELAY_IN_MS is elapsed since the last flush
+
+	void AddSelect(const std::shared_ptr<FontInfos>& vFontInfos, uint32_t vCodePoint, const std::string& vGlyphName);
+	void AddUnSelect(const std::shared_ptr<FontInfos>& vFontInfos, uint32_t vCodePoint);
+	void AddRename(const std::shared_ptr<FontInfos>& vFontInfos, uint32_t vCodePoint, const std::string& vNewName);
+	void AddReCode(const std::shared_ptr<FontInfos>& vFontInfos, uint32_t vCodePoint, uint32_t vNewCodePoint);
+	void AddTransform(const std::shared_ptr<FontInfos>& vFontInfos, const GlyphInfos& vGlyphInfos);
+
+	static std::string GetJournalFilePathName(const std::string& vProjectFilePathName);
+
+private:
+	void Close();
+	bool CreateJournalFile(); // new file with only the header
+	size_t Replay(ProjectFile* vProjectFile, const std::vector<uint8_t>& vDatas, size_t* vValidSize);
+	bool ReplayRecord(ProjectFile* vProjectFile, RecordTypeEnum vType, const uint8_t* vDatas, size_t vSize,
+		std::vector<std::string>* vFontNames);
+
+	uint16_t GetFontId(const std::shared_ptr<FontInfos>& vFontInfos); // add a font record if not known
+	size_t BeginRecord(RecordTypeEnum vType); // return the offset of the record
+	void EndRecord(size_t vRecordOffset); // write the size and the checksum
+	void PushUInt16(uint16_t vValue);
+	void PushUInt32(uint32_t vValue);
+	void PushFloat(float vValue);
+	void PushString(const std::string& vStr); // size (uint16) + chars
+
+	static uint32_t Checksum(const uint8_t* vDatas, size_t vSize);
+
+public: // singleton
+	static ProjectJournal* Instance()
+	{
+		static ProjectJournal* _instance = new ProjectJournal();
+		return _instance;
+	}
+
+protected:
+	ProjectJournal(); // Prevent construction
+	ProjectJournal(const ProjectJournal&) {}; // Prevent construction by copying
+	ProjectJournal& operator =(const ProjectJournal&) { return *this; }; // Prevent assignment
+	~ProjectJournal(); // Prevent unwanted destruction
+};